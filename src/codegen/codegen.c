@@ -0,0 +1,237 @@
+/*
+ * filename: codegen.c
+ *
+ * Purpose:
+ * Implementation of the architecture-agnostic code generation driver
+ * for the ћ++ compiler. Distributes independent IR functions over a
+ * pool of worker threads, then stitches their output together in
+ * program order so the object file never depends on scheduling.
+ *
+ * Key Components:
+ * - codegen_generate_program(): Spawn workers, join, concatenate
+ * - codegen_worker(): Claim-and-emit loop each thread runs
+ * - codegen_emit_data(): Pooled, deduplicated literal emission
+ * - emit_buffer_append() / emit_buffer_free(): Per-function buffers
+ *
+ * Interactions:
+ * - Calls the backend emit hook registered in codegen_init
+ * - Pools literals through data_pool.h before they reach .data
+ * - Appends finished code and symbols through elf_writer.h
+ *
+ * Notes:
+ * - Functions are claimed from a single atomic cursor: every task is
+ *   one small function, so a shared counter balances the pool as well
+ *   as per-worker deques would, without the stealing machinery
+ * - Each function encodes into its own buffer, so workers never share
+ *   mutable state and emission needs no locks
+ * - A failed emit flips a shared flag; remaining workers drain the
+ *   queue without emitting and the driver reports failure once
+ */
+
+#include "codegen.h"
+#include "data_pool.h"
+#include "../utils/intern.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+size_t emit_buffer_append(EmitBuffer* buffer, const void* bytes, size_t size) {
+    if (!buffer || !bytes) return SIZE_MAX;
+    if (buffer->size + size > buffer->capacity) {
+        size_t grown = buffer->capacity == 0 ? 64 : buffer->capacity;
+        while (grown < buffer->size + size) grown *= 2;
+        uint8_t* resized = realloc(buffer->bytes, grown);
+        if (!resized) return SIZE_MAX;
+        buffer->bytes = resized;
+        buffer->capacity = grown;
+    }
+    memcpy(buffer->bytes + buffer->size, bytes, size);
+    size_t offset = buffer->size;
+    buffer->size += size;
+    return offset;
+}
+
+void emit_buffer_free(EmitBuffer* buffer) {
+    if (!buffer) return;
+    free(buffer->bytes);
+    buffer->bytes = NULL;
+    buffer->size = 0;
+    buffer->capacity = 0;
+}
+
+CodeGenerator* codegen_init(int worker_count, CodegenEmitFunction emit,
+                            void* user) {
+    if (!emit) return NULL;
+    CodeGenerator* generator = malloc(sizeof(CodeGenerator));
+    if (!generator) return NULL;
+    generator->worker_count = worker_count < 1 ? 1 : worker_count;
+    generator->emit = emit;
+    generator->user = user;
+    return generator;
+}
+
+void codegen_free(CodeGenerator* generator) {
+    free(generator);
+}
+
+// Shared state of one generation run; workers only write their own
+// claimed buffers plus the two atomics
+typedef struct {
+    const CodeGenerator* generator;
+    const IrProgram* program;
+    EmitBuffer* buffers;         // One per function, in program order
+    atomic_uint cursor;          // Next unclaimed function
+    atomic_bool failed;          // Any emit reported failure
+} CodegenRun;
+
+/**
+ * Claim-and-emit loop. Each worker grabs the next unclaimed function
+ * until the program is exhausted
+ */
+static void* codegen_worker(void* argument) {
+    CodegenRun* run = argument;
+    for (;;) {
+        uint32_t index = atomic_fetch_add(&run->cursor, 1);
+        if (index >= run->program->function_count) break;
+        if (atomic_load(&run->failed)) continue;
+        if (!run->generator->emit(&run->program->functions[index],
+                                  run->program, &run->buffers[index],
+                                  run->generator->user)) {
+            atomic_store(&run->failed, true);
+        }
+    }
+    return NULL;
+}
+
+bool codegen_generate_program(CodeGenerator* generator,
+                              const IrProgram* program, ElfWriter* writer) {
+    if (!generator || !program || !writer) return false;
+    if (program->function_count == 0) return true;
+
+    CodegenRun run;
+    run.generator = generator;
+    run.program = program;
+    run.buffers = calloc(program->function_count, sizeof(EmitBuffer));
+    atomic_init(&run.cursor, 0);
+    atomic_init(&run.failed, false);
+    if (!run.buffers) return false;
+
+    // More workers than functions would only spawn idle threads
+    int workers = generator->worker_count;
+    if ((uint32_t)workers > program->function_count)
+        workers = (int)program->function_count;
+
+    bool ok = true;
+    if (workers == 1) {
+        codegen_worker(&run);
+    } else {
+        pthread_t* threads = malloc(workers * sizeof(pthread_t));
+        if (!threads) {
+            ok = false;
+        } else {
+            int spawned = 0;
+            for (int w = 0; w < workers; w++) {
+                if (pthread_create(&threads[w], NULL, codegen_worker, &run) != 0)
+                    break;
+                spawned++;
+            }
+            if (spawned == 0) codegen_worker(&run);
+            for (int w = 0; w < spawned; w++) pthread_join(threads[w], NULL);
+            free(threads);
+        }
+    }
+    if (atomic_load(&run.failed)) ok = false;
+
+    // Deterministic concatenation: program order, regardless of which
+    // worker finished when
+    if (ok) {
+        for (uint32_t f = 0; f < program->function_count && ok; f++) {
+            uint64_t offset = elf_writer_append_text(writer,
+                                                     run.buffers[f].bytes
+                                                         ? run.buffers[f].bytes
+                                                         : (const void*)"",
+                                                     run.buffers[f].size);
+            if (offset == UINT64_MAX && run.buffers[f].size > 0) {
+                ok = false;
+                break;
+            }
+            if (elf_writer_add_symbol(writer, program->functions[f].name,
+                                      ELF_SECTION_TEXT, offset,
+                                      true) == UINT32_MAX) {
+                ok = false;
+            }
+        }
+    }
+
+    for (uint32_t f = 0; f < program->function_count; f++)
+        emit_buffer_free(&run.buffers[f]);
+    free(run.buffers);
+    return ok;
+}
+
+bool codegen_emit_data(const IrProgram* program, ElfWriter* writer,
+                       uint64_t** string_offsets_out) {
+    if (!program || !writer) return false;
+
+    DataPool* pool = data_pool_init();
+    if (!pool) return false;
+
+    uint32_t* entry_of = NULL;
+    uint64_t* offsets = NULL;
+    bool ok = true;
+
+    if (program->string_count > 0) {
+        entry_of = malloc(program->string_count * sizeof(uint32_t));
+        offsets = malloc(program->string_count * sizeof(uint64_t));
+        if (!entry_of || !offsets) ok = false;
+    }
+
+    // The IR pool holds one copy per literal occurrence; hashing them
+    // through the data pool collapses equal values to one entry
+    for (uint32_t s = 0; ok && s < program->string_count; s++) {
+        entry_of[s] = data_pool_add_string(pool, program->strings[s]);
+        if (entry_of[s] == DATA_POOL_INVALID) ok = false;
+    }
+
+    if (ok) ok = data_pool_layout(pool);
+
+    uint64_t base = 0;
+    if (ok && data_pool_image_size(pool) > 0) {
+        base = elf_writer_append_data(writer, data_pool_image(pool),
+                                      data_pool_image_size(pool));
+        if (base == UINT64_MAX) ok = false;
+    }
+
+    // One local label per distinct value; every reference to an equal
+    // literal resolves against the same label. Names are interned so
+    // they outlive the pool, as the writer does not copy them
+    for (uint32_t e = 0; ok && e < data_pool_entry_count(pool); e++) {
+        char label[32];
+        snprintf(label, sizeof(label), ".Lниска%u", e);
+        const char* name = intern_cstring(label);
+        if (!name ||
+            elf_writer_add_symbol(writer, name, ELF_SECTION_DATA,
+                                  base + data_pool_offset(pool, e),
+                                  false) == UINT32_MAX) {
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        for (uint32_t s = 0; s < program->string_count; s++) {
+            offsets[s] = base + data_pool_offset(pool, entry_of[s]);
+        }
+        if (string_offsets_out) {
+            *string_offsets_out = offsets;
+        } else {
+            free(offsets);
+        }
+    } else {
+        free(offsets);
+    }
+    free(entry_of);
+    data_pool_free(pool);
+    return ok;
+}
@@ -1,33 +1,137 @@
 /*
  * filename: codegen.h
- * 
+ *
  * Purpose:
  * Header file for the code generator component of the ћ++ compiler.
- * Defines the interface for translating IR into target-specific assembly code.
- * 
+ * Defines the architecture-agnostic driver that turns an IrProgram
+ * into an object file, farming independent functions out to a worker
+ * pool and concatenating their code deterministically.
+ *
  * Key Components:
+ * - EmitBuffer struct: Growable code bytes for one function
+ * - CodegenEmitFunction: Per-function emit hook the backends implement
  * - CodeGenerator struct: Maintains state during code generation
  * - codegen_init(): Initialize a code generator for a specific target
- * - codegen_generate_program(): Entry point for generating assembly from IR
- * - codegen_generate_function(): Generate assembly for a function
- * - codegen_generate_prologue(): Generate function preamble (stack setup, etc.)
- * - codegen_generate_epilogue(): Generate function cleanup code
- * 
+ * - codegen_generate_program(): Entry point for generating code from IR
+ * - codegen_emit_data(): Pooled emission of the program's literals
+ *
  * Interactions:
  * - Takes IR from ir.c/ir_optimizer.c as input
- * - Uses target_info.h for architecture-specific details
- * - Produces assembly output files
- * 
+ * - Backends in x86.c/x86_64.c provide the emit hook
+ * - Output goes through the ELF writer in elf_writer.h
+ *
  * Notes:
- * - Architecture-agnostic interface with specific implementations
- *   for x86 and x86_64 in separate files
- * - Handles register allocation and calling conventions
- * - Manages stack frame layout for local variables and parameters
+ * - ћ++ functions share no mutable state at the IR level, so each one
+ *   is an independent unit of work; workers claim functions from a
+ *   shared queue and encode into private buffers
+ * - Worker count and scheduling never affect the output: buffers are
+ *   concatenated in function order after all workers join
+ * - Handles register allocation and calling conventions through the
+ *   backend hook; the driver itself is word-size agnostic
  */
 
 #ifndef CODEGEN_H
 #define CODEGEN_H
 
-// Header content will be implemented later
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "../ir/ir.h"
+#include "elf_writer.h"
 
-#endif /* CODEGEN_H */
\ No newline at end of file
+// Growable byte buffer one function's encoded code lands in. Each
+// worker owns the buffers of the functions it claimed, so emission
+// needs no locks
+typedef struct {
+    uint8_t* bytes;
+    size_t size;
+    size_t capacity;
+} EmitBuffer;
+
+/**
+ * Per-function emit hook. Encodes one IR function into the given
+ * buffer; runs concurrently with other functions' hooks and must only
+ * read the program
+ *
+ * @param function The function to encode
+ * @param program The owning program (names and string pools)
+ * @param out The function's private emit buffer
+ * @param user The pointer passed to codegen_init
+ * @return true on success, false to fail the whole generation
+ */
+typedef bool (*CodegenEmitFunction)(const IrFunction* function,
+                                    const IrProgram* program,
+                                    EmitBuffer* out, void* user);
+
+// Driver state for one program's code generation
+typedef struct {
+    int worker_count;            // Worker threads to spawn (>= 1)
+    CodegenEmitFunction emit;    // Backend emit hook
+    void* user;                  // Opaque backend state
+} CodeGenerator;
+
+/**
+ * Create a code generator
+ *
+ * @param worker_count Worker threads to use; values below 1 become 1
+ * @param emit The backend's per-function emit hook
+ * @param user Opaque pointer handed to every emit call
+ * @return The generator, or NULL on allocation failure
+ */
+CodeGenerator* codegen_init(int worker_count, CodegenEmitFunction emit,
+                            void* user);
+
+/**
+ * Free a code generator
+ *
+ * @param generator The generator to free
+ */
+void codegen_free(CodeGenerator* generator);
+
+/**
+ * Generate code for a whole program. Functions are distributed over
+ * the worker pool, encoded into per-function buffers, then appended
+ * to the writer in program order with one text symbol per function
+ *
+ * @param generator The generator
+ * @param program The IR program
+ * @param writer The object writer receiving code and symbols
+ * @return true when every function emitted successfully
+ */
+bool codegen_generate_program(CodeGenerator* generator,
+                              const IrProgram* program, ElfWriter* writer);
+
+/**
+ * Emit a program's literals into .data, pooled: equal values are
+ * hashed down to one labeled copy, and a string that is a tail of a
+ * longer one shares its storage. Every IR string index maps to the
+ * .data offset of its pooled copy
+ *
+ * @param program The IR program whose string pool is emitted
+ * @param writer The object writer receiving data and labels
+ * @param string_offsets_out When non-NULL, receives a malloc'd array
+ *        of one .data offset per IR string index (NULL when the
+ *        program has no strings); the caller frees it
+ * @return true on success, false on allocation or writer failure
+ */
+bool codegen_emit_data(const IrProgram* program, ElfWriter* writer,
+                       uint64_t** string_offsets_out);
+
+/**
+ * Append bytes to an emit buffer, growing it as needed
+ *
+ * @param buffer The buffer
+ * @param bytes The bytes to append
+ * @param size Number of bytes
+ * @return The offset the run was placed at, or SIZE_MAX on failure
+ */
+size_t emit_buffer_append(EmitBuffer* buffer, const void* bytes, size_t size);
+
+/**
+ * Release a buffer's storage
+ *
+ * @param buffer The buffer
+ */
+void emit_buffer_free(EmitBuffer* buffer);
+
+#endif /* CODEGEN_H */
@@ -0,0 +1,278 @@
+/*
+ * filename: data_pool.c
+ *
+ * Purpose:
+ * Implementation of the deduplicating constant pool for the ћ++
+ * compiler's data-section emission. Payloads are interned through a
+ * chained hash table on entry; layout then suffix-merges strings and
+ * assigns every entry its final section offset.
+ *
+ * Key Components:
+ * - pool_find()/pool_append(): Hash-consing of payloads
+ * - reversed_compare(): Orders strings so suffixes become adjacent
+ * - data_pool_layout(): Offset assignment and image construction
+ *
+ * Interactions:
+ * - Driven by codegen_emit_data() in codegen.c
+ * - ENC_WORD_BYTES from encoder.h aligns raw payloads to the target's
+ *   word size
+ *
+ * Notes:
+ * - Suffix merging uses the classic string-table trick: sorting the
+ *   strings by their reversed bytes makes every suffix relation an
+ *   adjacency, so one comparison against the previous unmerged string
+ *   finds all merges without a quadratic scan
+ * - The hash is FNV-1a, as in the interning pools elsewhere in the
+ *   tree; strings and raw payloads never unify even when their bytes
+ *   match, because raw entries promise word alignment
+ */
+
+#include "data_pool.h"
+#include "encoder.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define DATA_POOL_BUCKETS 256
+#define DATA_POOL_INITIAL_ENTRIES 64
+
+// One distinct payload. Merged string entries own no storage in the
+// image; they point into their merge root's bytes
+typedef struct {
+    uint8_t* bytes;          // Owned copy (strings include the NUL)
+    size_t size;
+    bool is_string;
+    uint32_t hash;
+    uint32_t next;           // Bucket chain, DATA_POOL_INVALID ends it
+    uint32_t merged_into;    // Root entry, or DATA_POOL_INVALID
+    uint64_t offset;         // Image offset, assigned by layout
+} PoolEntry;
+
+struct DataPool {
+    PoolEntry* entries;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t buckets[DATA_POOL_BUCKETS];
+
+    uint8_t* image;          // Built by layout
+    size_t image_size;
+    bool laid_out;
+    size_t saved;            // Bytes not emitted thanks to the pool
+};
+
+/**
+ * FNV-1a over a payload, salted with its kind so equal bytes in the
+ * two kinds land in different chains
+ */
+static uint32_t pool_hash(const void* bytes, size_t size, bool is_string) {
+    uint32_t hash = is_string ? 2166136261u : 2166136279u;
+    const uint8_t* p = bytes;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Find an existing entry with this exact payload and kind
+ */
+static uint32_t pool_find(const DataPool* pool, const void* bytes, size_t size,
+                          bool is_string, uint32_t hash) {
+    uint32_t index = pool->buckets[hash % DATA_POOL_BUCKETS];
+    while (index != DATA_POOL_INVALID) {
+        const PoolEntry* entry = &pool->entries[index];
+        if (entry->hash == hash && entry->is_string == is_string &&
+            entry->size == size && memcmp(entry->bytes, bytes, size) == 0) {
+            return index;
+        }
+        index = entry->next;
+    }
+    return DATA_POOL_INVALID;
+}
+
+/**
+ * Append a new entry with an owned copy of the payload
+ */
+static uint32_t pool_append(DataPool* pool, const void* bytes, size_t size,
+                            bool is_string, uint32_t hash) {
+    if (pool->count == pool->capacity) {
+        uint32_t new_capacity = pool->capacity == 0 ? DATA_POOL_INITIAL_ENTRIES
+                                                    : pool->capacity * 2;
+        PoolEntry* grown = realloc(pool->entries,
+                                   new_capacity * sizeof(PoolEntry));
+        if (!grown) return DATA_POOL_INVALID;
+        pool->entries = grown;
+        pool->capacity = new_capacity;
+    }
+
+    uint8_t* copy = malloc(size > 0 ? size : 1);
+    if (!copy) return DATA_POOL_INVALID;
+    memcpy(copy, bytes, size);
+
+    PoolEntry* entry = &pool->entries[pool->count];
+    entry->bytes = copy;
+    entry->size = size;
+    entry->is_string = is_string;
+    entry->hash = hash;
+    entry->next = pool->buckets[hash % DATA_POOL_BUCKETS];
+    entry->merged_into = DATA_POOL_INVALID;
+    entry->offset = 0;
+    pool->buckets[hash % DATA_POOL_BUCKETS] = pool->count;
+    return pool->count++;
+}
+
+/**
+ * Shared add path for both kinds
+ */
+static uint32_t pool_add(DataPool* pool, const void* bytes, size_t size,
+                         bool is_string) {
+    if (!pool || !bytes || pool->laid_out) return DATA_POOL_INVALID;
+
+    uint32_t hash = pool_hash(bytes, size, is_string);
+    uint32_t existing = pool_find(pool, bytes, size, is_string, hash);
+    if (existing != DATA_POOL_INVALID) {
+        pool->saved += size;
+        return existing;
+    }
+    return pool_append(pool, bytes, size, is_string, hash);
+}
+
+DataPool* data_pool_init(void) {
+    DataPool* pool = calloc(1, sizeof(DataPool));
+    if (!pool) return NULL;
+    for (int b = 0; b < DATA_POOL_BUCKETS; b++) {
+        pool->buckets[b] = DATA_POOL_INVALID;
+    }
+    return pool;
+}
+
+void data_pool_free(DataPool* pool) {
+    if (!pool) return;
+    for (uint32_t i = 0; i < pool->count; i++) {
+        free(pool->entries[i].bytes);
+    }
+    free(pool->entries);
+    free(pool->image);
+    free(pool);
+}
+
+uint32_t data_pool_add_string(DataPool* pool, const char* text) {
+    if (!text) return DATA_POOL_INVALID;
+    return pool_add(pool, text, strlen(text) + 1, true);
+}
+
+uint32_t data_pool_add_bytes(DataPool* pool, const void* bytes, size_t size) {
+    return pool_add(pool, bytes, size, false);
+}
+
+/**
+ * qsort comparator ordering strings by their reversed bytes,
+ * descending, longer first on a shared reversed prefix. Any string
+ * that is a suffix of another then directly follows a string it can
+ * merge into
+ */
+static int reversed_compare(const void* left, const void* right) {
+    const PoolEntry* a = *(const PoolEntry* const*)left;
+    const PoolEntry* b = *(const PoolEntry* const*)right;
+    size_t common = a->size < b->size ? a->size : b->size;
+    for (size_t i = 1; i <= common; i++) {
+        uint8_t ca = a->bytes[a->size - i];
+        uint8_t cb = b->bytes[b->size - i];
+        if (ca != cb) return ca > cb ? -1 : 1;
+    }
+    if (a->size != b->size) return a->size > b->size ? -1 : 1;
+    return 0;
+}
+
+bool data_pool_layout(DataPool* pool) {
+    if (!pool || pool->laid_out) return false;
+
+    // Sort the string entries by reversed bytes so every suffix
+    // relation is an adjacency in the order
+    const PoolEntry** strings = malloc((pool->count ? pool->count : 1) *
+                                       sizeof(PoolEntry*));
+    if (!strings) return false;
+    uint32_t string_count = 0;
+    for (uint32_t i = 0; i < pool->count; i++) {
+        if (pool->entries[i].is_string) {
+            strings[string_count++] = &pool->entries[i];
+        }
+    }
+    qsort(strings, string_count, sizeof(PoolEntry*), reversed_compare);
+
+    // Raw payloads first, WORD-aligned in add order; strings need no
+    // alignment and pack the tail of the image
+    size_t offset = 0;
+    for (uint32_t i = 0; i < pool->count; i++) {
+        PoolEntry* entry = &pool->entries[i];
+        if (entry->is_string) continue;
+        offset = (offset + ENC_WORD_BYTES - 1) & ~(size_t)(ENC_WORD_BYTES - 1);
+        entry->offset = offset;
+        offset += entry->size;
+    }
+
+    // A string that is a tail of the previous unmerged string
+    // (terminator included) shares its storage; everything a merged
+    // string is a suffix of, its merge root contains too
+    const PoolEntry* root = NULL;
+    for (uint32_t s = 0; s < string_count; s++) {
+        PoolEntry* entry = (PoolEntry*)strings[s];
+        if (root && entry->size <= root->size &&
+            memcmp(root->bytes + (root->size - entry->size), entry->bytes,
+                   entry->size) == 0) {
+            entry->merged_into = (uint32_t)(root - pool->entries);
+            pool->saved += entry->size;
+            continue;
+        }
+        entry->offset = offset;
+        offset += entry->size;
+        root = entry;
+    }
+
+    // Merged entries sit at their root's tail
+    for (uint32_t s = 0; s < string_count; s++) {
+        PoolEntry* entry = (PoolEntry*)strings[s];
+        if (entry->merged_into == DATA_POOL_INVALID) continue;
+        const PoolEntry* into = &pool->entries[entry->merged_into];
+        entry->offset = into->offset + (into->size - entry->size);
+    }
+    free(strings);
+
+    pool->image = calloc(offset > 0 ? offset : 1, 1);
+    if (!pool->image) return false;
+    pool->image_size = offset;
+    for (uint32_t i = 0; i < pool->count; i++) {
+        const PoolEntry* entry = &pool->entries[i];
+        if (entry->merged_into != DATA_POOL_INVALID) continue;
+        memcpy(pool->image + entry->offset, entry->bytes, entry->size);
+    }
+
+    pool->laid_out = true;
+    return true;
+}
+
+uint32_t data_pool_entry_count(const DataPool* pool) {
+    return pool ? pool->count : 0;
+}
+
+bool data_pool_entry_is_string(const DataPool* pool, uint32_t entry) {
+    if (!pool || entry >= pool->count) return false;
+    return pool->entries[entry].is_string;
+}
+
+uint64_t data_pool_offset(const DataPool* pool, uint32_t entry) {
+    if (!pool || entry >= pool->count) return UINT64_MAX;
+    return pool->entries[entry].offset;
+}
+
+const uint8_t* data_pool_image(const DataPool* pool) {
+    return pool ? pool->image : NULL;
+}
+
+size_t data_pool_image_size(const DataPool* pool) {
+    return pool ? pool->image_size : 0;
+}
+
+size_t data_pool_saved(const DataPool* pool) {
+    return pool ? pool->saved : 0;
+}
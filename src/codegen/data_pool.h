@@ -0,0 +1,144 @@
+/*
+ * filename: data_pool.h
+ *
+ * Purpose:
+ * Header file for the deduplicating constant pool behind the ћ++
+ * compiler's data-section emission. String literals and raw
+ * initializer payloads are hashed on entry, so every distinct value
+ * is stored exactly once no matter how many functions reference it.
+ *
+ * Key Components:
+ * - DataPool struct: Accumulates payloads, then lays them out
+ * - data_pool_add_string()/data_pool_add_bytes(): Deduplicating adds
+ * - data_pool_layout(): Assign offsets, suffix-merging strings
+ * - data_pool_offset()/data_pool_image(): The laid-out section
+ * - data_pool_saved(): Bytes the pooling avoided emitting
+ *
+ * Interactions:
+ * - codegen.c builds a pool from the IrProgram's string literal pool
+ *   and appends the image to .data through elf_writer.h
+ *
+ * Notes:
+ * - The IR string pool in ir.c appends one copy per literal
+ *   occurrence, so generated sources that repeat the same literals
+ *   across thousands of functions multiply them; the pool collapses
+ *   them back to one labeled copy per distinct value
+ * - Strings additionally suffix-merge: a string that is a tail of
+ *   another (terminator included) points into the longer one's
+ *   storage instead of occupying its own
+ * - Raw payloads (низ initializer lists, once the frontend lowers
+ *   them to data) are deduplicated byte-exact and WORD-aligned, but
+ *   never suffix-merged — interior offsets would break alignment
+ * - Adding is a two-phase protocol: all adds, one layout, then reads;
+ *   adds after layout fail
+ */
+
+#ifndef DATA_POOL_H
+#define DATA_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Returned by the add functions when allocation fails or the pool was
+// already laid out
+#define DATA_POOL_INVALID UINT32_MAX
+
+typedef struct DataPool DataPool;
+
+/**
+ * Create an empty pool
+ *
+ * @return The pool, or NULL on allocation failure
+ */
+DataPool* data_pool_init(void);
+
+/**
+ * Free a pool and everything it owns
+ *
+ * @param pool The pool to free
+ */
+void data_pool_free(DataPool* pool);
+
+/**
+ * Add a NUL-terminated string payload. An identical string returns
+ * the entry it was first added as
+ *
+ * @param pool The pool
+ * @param text The string (copied; the terminator is part of the payload)
+ * @return The entry handle, or DATA_POOL_INVALID on failure
+ */
+uint32_t data_pool_add_string(DataPool* pool, const char* text);
+
+/**
+ * Add a raw byte payload, such as an array initializer list. An
+ * identical payload returns the entry it was first added as
+ *
+ * @param pool The pool
+ * @param bytes The payload (copied)
+ * @param size Payload size in bytes
+ * @return The entry handle, or DATA_POOL_INVALID on failure
+ */
+uint32_t data_pool_add_bytes(DataPool* pool, const void* bytes, size_t size);
+
+/**
+ * Lay the pool out: raw payloads WORD-aligned in add order, then
+ * strings with every suffix of a longer string merged into it
+ *
+ * @param pool The pool
+ * @return true on success, false on allocation failure
+ */
+bool data_pool_layout(DataPool* pool);
+
+/**
+ * Number of distinct entries in the pool
+ *
+ * @param pool The pool
+ * @return The entry count
+ */
+uint32_t data_pool_entry_count(const DataPool* pool);
+
+/**
+ * Whether an entry holds a string payload
+ *
+ * @param pool The pool
+ * @param entry The entry handle
+ * @return true for strings, false for raw payloads
+ */
+bool data_pool_entry_is_string(const DataPool* pool, uint32_t entry);
+
+/**
+ * An entry's offset within the laid-out image. Only valid after
+ * data_pool_layout
+ *
+ * @param pool The pool
+ * @param entry The entry handle
+ * @return The offset, or UINT64_MAX for an invalid entry
+ */
+uint64_t data_pool_offset(const DataPool* pool, uint32_t entry);
+
+/**
+ * The laid-out section image. Only valid after data_pool_layout
+ *
+ * @param pool The pool
+ * @return The image bytes, owned by the pool
+ */
+const uint8_t* data_pool_image(const DataPool* pool);
+
+/**
+ * Size of the laid-out image in bytes
+ *
+ * @param pool The pool
+ * @return The image size
+ */
+size_t data_pool_image_size(const DataPool* pool);
+
+/**
+ * Bytes that deduplication and suffix merging avoided emitting
+ *
+ * @param pool The pool
+ * @return The saved byte count
+ */
+size_t data_pool_saved(const DataPool* pool);
+
+#endif /* DATA_POOL_H */
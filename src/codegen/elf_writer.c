@@ -0,0 +1,390 @@
+/*
+ * filename: elf_writer.c
+ *
+ * Purpose:
+ * Implementation of the direct ELF object writer for the ћ++ compiler.
+ * Accumulates encoded machine code, data, symbols and relocations in
+ * memory and lays them out as a relocatable object file in one write,
+ * so no assembly text is produced and no assembler subprocess runs.
+ *
+ * Key Components:
+ * - elf_writer_append_text() / elf_writer_append_data(): Growable byte runs
+ * - elf_writer_add_symbol() / elf_writer_add_call_relocation(): Bookkeeping
+ * - elf_writer_write(): Section layout and the single output pass
+ *
+ * Interactions:
+ * - Fed by the instruction encoders in x86.c/x86_64.c
+ * - Uses error.h to report output failures
+ *
+ * Notes:
+ * - The word size follows the backend: ELF64/EM_X86_64 under
+ *   ARCH_X86_64, ELF32/EM_386 otherwise
+ * - x86-64 uses .rela.text with explicit addends; x86 uses .rel.text,
+ *   so there the addend is patched into the displacement field before
+ *   the text section is written
+ * - Locals are placed before globals in .symtab because sh_info must
+ *   name the first global entry
+ */
+
+#include "elf_writer.h"
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils/error.h"
+
+// One set of structure names for both word sizes, following the
+// ARCH_X86_64 convention used across the backend
+#ifdef ARCH_X86_64
+typedef Elf64_Ehdr ElfHeader;
+typedef Elf64_Shdr ElfSectionHeader;
+typedef Elf64_Sym ElfSymbolEntry;
+typedef Elf64_Rela ElfRelocationEntry;
+#define ELF_CLASS ELFCLASS64
+#define ELF_MACHINE EM_X86_64
+#define ELF_RELOC_TYPE R_X86_64_PLT32
+#define ELF_ST_INFO ELF64_ST_INFO
+#define ELF_R_INFO ELF64_R_INFO
+#define ELF_USES_RELA 1
+#else
+typedef Elf32_Ehdr ElfHeader;
+typedef Elf32_Shdr ElfSectionHeader;
+typedef Elf32_Sym ElfSymbolEntry;
+typedef Elf32_Rel ElfRelocationEntry;
+#define ELF_CLASS ELFCLASS32
+#define ELF_MACHINE EM_386
+#define ELF_RELOC_TYPE R_386_PC32
+#define ELF_ST_INFO ELF32_ST_INFO
+#define ELF_R_INFO ELF32_R_INFO
+#define ELF_USES_RELA 0
+#endif
+
+// Section numbering inside the object file
+enum {
+    SECTION_NULL,
+    SECTION_TEXT,
+    SECTION_DATA,
+    SECTION_RELA_TEXT,
+    SECTION_SYMTAB,
+    SECTION_STRTAB,
+    SECTION_NOTE_GNU_STACK,
+    SECTION_SHSTRTAB,
+    SECTION_COUNT
+};
+
+ElfWriter* elf_writer_init(void) {
+    ElfWriter* writer = calloc(1, sizeof(ElfWriter));
+    return writer;
+}
+
+void elf_writer_free(ElfWriter* writer) {
+    if (!writer) return;
+    free(writer->text);
+    free(writer->data);
+    free(writer->symbols);
+    free(writer->relocations);
+    free(writer);
+}
+
+/**
+ * Append bytes to a growable buffer, doubling as needed
+ *
+ * @return The offset the run was placed at, or UINT64_MAX on failure
+ */
+static uint64_t append_bytes(uint8_t** buffer, size_t* size, size_t* capacity,
+                             const void* bytes, size_t count) {
+    if (*size + count > *capacity) {
+        size_t grown = *capacity == 0 ? 256 : *capacity;
+        while (grown < *size + count) grown *= 2;
+        uint8_t* resized = realloc(*buffer, grown);
+        if (!resized) return UINT64_MAX;
+        *buffer = resized;
+        *capacity = grown;
+    }
+    memcpy(*buffer + *size, bytes, count);
+    uint64_t offset = *size;
+    *size += count;
+    return offset;
+}
+
+uint64_t elf_writer_append_text(ElfWriter* writer, const void* bytes, size_t size) {
+    if (!writer || !bytes) return UINT64_MAX;
+    return append_bytes(&writer->text, &writer->text_size,
+                        &writer->text_capacity, bytes, size);
+}
+
+uint64_t elf_writer_append_data(ElfWriter* writer, const void* bytes, size_t size) {
+    if (!writer || !bytes) return UINT64_MAX;
+    return append_bytes(&writer->data, &writer->data_size,
+                        &writer->data_capacity, bytes, size);
+}
+
+uint32_t elf_writer_add_symbol(ElfWriter* writer, const char* name,
+                               ElfSection section, uint64_t offset, bool global) {
+    if (!writer || !name) return UINT32_MAX;
+    if (writer->symbol_count == writer->symbol_capacity) {
+        uint32_t grown = writer->symbol_capacity == 0
+                             ? 16 : writer->symbol_capacity * 2;
+        ElfSymbol* resized = realloc(writer->symbols, grown * sizeof(ElfSymbol));
+        if (!resized) return UINT32_MAX;
+        writer->symbols = resized;
+        writer->symbol_capacity = grown;
+    }
+    ElfSymbol* symbol = &writer->symbols[writer->symbol_count];
+    symbol->name = name;
+    symbol->section = section;
+    symbol->offset = offset;
+    // Undefined symbols must be global or the linker cannot bind them
+    symbol->global = global || section == ELF_SECTION_UNDEFINED;
+    return writer->symbol_count++;
+}
+
+bool elf_writer_add_call_relocation(ElfWriter* writer, uint64_t offset,
+                                    uint32_t symbol, int64_t addend) {
+    if (!writer || symbol >= writer->symbol_count) return false;
+    if (writer->relocation_count == writer->relocation_capacity) {
+        uint32_t grown = writer->relocation_capacity == 0
+                             ? 16 : writer->relocation_capacity * 2;
+        ElfRelocation* resized = realloc(writer->relocations,
+                                         grown * sizeof(ElfRelocation));
+        if (!resized) return false;
+        writer->relocations = resized;
+        writer->relocation_capacity = grown;
+    }
+    ElfRelocation* relocation = &writer->relocations[writer->relocation_count++];
+    relocation->offset = offset;
+    relocation->symbol = symbol;
+    relocation->addend = addend;
+    return true;
+}
+
+/**
+ * Append a name to a string table buffer and return its offset
+ */
+static uint32_t strtab_add(char** table, size_t* size, size_t* capacity,
+                           const char* name) {
+    uint64_t offset = append_bytes((uint8_t**)table, size, capacity,
+                                   name, strlen(name) + 1);
+    return offset == UINT64_MAX ? 0 : (uint32_t)offset;
+}
+
+bool elf_writer_write(ElfWriter* writer, const char* path) {
+    if (!writer || !path) return false;
+
+    // Section name table is fixed, so build it up front
+    static const char* section_names[SECTION_COUNT] = {
+        "", ".text", ".data",
+        ELF_USES_RELA ? ".rela.text" : ".rel.text",
+        ".symtab", ".strtab", ".note.GNU-stack", ".shstrtab"
+    };
+    char* shstrtab = NULL;
+    size_t shstrtab_size = 0, shstrtab_capacity = 0;
+    uint32_t section_name_offset[SECTION_COUNT];
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        section_name_offset[s] = strtab_add(&shstrtab, &shstrtab_size,
+                                            &shstrtab_capacity, section_names[s]);
+    }
+
+    // Symbol table: null entry, then locals, then globals, remembering
+    // where each writer symbol landed so relocations can follow
+    uint32_t entry_count = writer->symbol_count + 1;
+    ElfSymbolEntry* symtab = calloc(entry_count, sizeof(ElfSymbolEntry));
+    uint32_t* output_index = malloc(writer->symbol_count > 0
+                                        ? writer->symbol_count * sizeof(uint32_t)
+                                        : 4);
+    char* strtab = NULL;
+    size_t strtab_size = 0, strtab_capacity = 0;
+    if (!symtab || !output_index) {
+        free(symtab); free(output_index); free(shstrtab);
+        return false;
+    }
+    strtab_add(&strtab, &strtab_size, &strtab_capacity, "");
+
+    uint32_t next = 1;
+    for (int pass = 0; pass < 2; pass++) {
+        bool want_global = pass == 1;
+        for (uint32_t i = 0; i < writer->symbol_count; i++) {
+            ElfSymbol* symbol = &writer->symbols[i];
+            if (symbol->global != want_global) continue;
+            ElfSymbolEntry* entry = &symtab[next];
+            entry->st_name = strtab_add(&strtab, &strtab_size,
+                                        &strtab_capacity, symbol->name);
+            entry->st_value = symbol->offset;
+            switch (symbol->section) {
+                case ELF_SECTION_TEXT:
+                    entry->st_shndx = SECTION_TEXT;
+                    entry->st_info = ELF_ST_INFO(
+                        want_global ? STB_GLOBAL : STB_LOCAL, STT_FUNC);
+                    break;
+                case ELF_SECTION_DATA:
+                    entry->st_shndx = SECTION_DATA;
+                    entry->st_info = ELF_ST_INFO(
+                        want_global ? STB_GLOBAL : STB_LOCAL, STT_OBJECT);
+                    break;
+                case ELF_SECTION_UNDEFINED:
+                    entry->st_shndx = SHN_UNDEF;
+                    entry->st_value = 0;
+                    entry->st_info = ELF_ST_INFO(STB_GLOBAL, STT_NOTYPE);
+                    break;
+            }
+            output_index[i] = next++;
+        }
+    }
+    uint32_t first_global = next;
+    for (uint32_t e = 1; e < entry_count; e++) {
+        unsigned char bind = symtab[e].st_info >> 4;
+        if (bind == STB_GLOBAL && e < first_global) first_global = e;
+    }
+
+    // Relocation entries; without addends (x86) the addend is patched
+    // straight into the displacement field in .text
+    ElfRelocationEntry* relocations = calloc(
+        writer->relocation_count > 0 ? writer->relocation_count : 1,
+        sizeof(ElfRelocationEntry));
+    if (!relocations) {
+        free(symtab); free(output_index); free(strtab); free(shstrtab);
+        return false;
+    }
+    for (uint32_t r = 0; r < writer->relocation_count; r++) {
+        ElfRelocation* fixup = &writer->relocations[r];
+        relocations[r].r_offset = fixup->offset;
+        relocations[r].r_info = ELF_R_INFO(output_index[fixup->symbol],
+                                           ELF_RELOC_TYPE);
+#if ELF_USES_RELA
+        relocations[r].r_addend = fixup->addend;
+#else
+        if (fixup->offset + 4 <= writer->text_size) {
+            int32_t patched = (int32_t)fixup->addend;
+            memcpy(writer->text + fixup->offset, &patched, 4);
+        }
+#endif
+    }
+
+    // Lay the sections out back to back after the header, section
+    // header table last
+    ElfHeader header;
+    memset(&header, 0, sizeof(header));
+    uint64_t cursor = sizeof(ElfHeader);
+    uint64_t text_offset = cursor;      cursor += writer->text_size;
+    uint64_t data_offset = cursor;      cursor += writer->data_size;
+    uint64_t rela_offset = cursor;
+    uint64_t rela_size = writer->relocation_count * sizeof(ElfRelocationEntry);
+    cursor += rela_size;
+    uint64_t symtab_offset = cursor;    cursor += entry_count * sizeof(ElfSymbolEntry);
+    uint64_t strtab_offset = cursor;    cursor += strtab_size;
+    uint64_t shstrtab_offset = cursor;  cursor += shstrtab_size;
+    cursor = (cursor + 7) & ~(uint64_t)7;
+    uint64_t shdr_offset = cursor;
+
+    header.e_ident[EI_MAG0] = ELFMAG0;
+    header.e_ident[EI_MAG1] = ELFMAG1;
+    header.e_ident[EI_MAG2] = ELFMAG2;
+    header.e_ident[EI_MAG3] = ELFMAG3;
+    header.e_ident[EI_CLASS] = ELF_CLASS;
+    header.e_ident[EI_DATA] = ELFDATA2LSB;
+    header.e_ident[EI_VERSION] = EV_CURRENT;
+    header.e_type = ET_REL;
+    header.e_machine = ELF_MACHINE;
+    header.e_version = EV_CURRENT;
+    header.e_shoff = shdr_offset;
+    header.e_ehsize = sizeof(ElfHeader);
+    header.e_shentsize = sizeof(ElfSectionHeader);
+    header.e_shnum = SECTION_COUNT;
+    header.e_shstrndx = SECTION_SHSTRTAB;
+
+    ElfSectionHeader sections[SECTION_COUNT];
+    memset(sections, 0, sizeof(sections));
+
+    sections[SECTION_TEXT].sh_name = section_name_offset[SECTION_TEXT];
+    sections[SECTION_TEXT].sh_type = SHT_PROGBITS;
+    sections[SECTION_TEXT].sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+    sections[SECTION_TEXT].sh_offset = text_offset;
+    sections[SECTION_TEXT].sh_size = writer->text_size;
+    sections[SECTION_TEXT].sh_addralign = 16;
+
+    sections[SECTION_DATA].sh_name = section_name_offset[SECTION_DATA];
+    sections[SECTION_DATA].sh_type = SHT_PROGBITS;
+    sections[SECTION_DATA].sh_flags = SHF_ALLOC | SHF_WRITE;
+    sections[SECTION_DATA].sh_offset = data_offset;
+    sections[SECTION_DATA].sh_size = writer->data_size;
+    sections[SECTION_DATA].sh_addralign = 8;
+
+    sections[SECTION_RELA_TEXT].sh_name = section_name_offset[SECTION_RELA_TEXT];
+    sections[SECTION_RELA_TEXT].sh_type = ELF_USES_RELA ? SHT_RELA : SHT_REL;
+    sections[SECTION_RELA_TEXT].sh_offset = rela_offset;
+    sections[SECTION_RELA_TEXT].sh_size = rela_size;
+    sections[SECTION_RELA_TEXT].sh_link = SECTION_SYMTAB;
+    sections[SECTION_RELA_TEXT].sh_info = SECTION_TEXT;
+    sections[SECTION_RELA_TEXT].sh_entsize = sizeof(ElfRelocationEntry);
+    sections[SECTION_RELA_TEXT].sh_addralign = 8;
+
+    sections[SECTION_SYMTAB].sh_name = section_name_offset[SECTION_SYMTAB];
+    sections[SECTION_SYMTAB].sh_type = SHT_SYMTAB;
+    sections[SECTION_SYMTAB].sh_offset = symtab_offset;
+    sections[SECTION_SYMTAB].sh_size = entry_count * sizeof(ElfSymbolEntry);
+    sections[SECTION_SYMTAB].sh_link = SECTION_STRTAB;
+    sections[SECTION_SYMTAB].sh_info = first_global;
+    sections[SECTION_SYMTAB].sh_entsize = sizeof(ElfSymbolEntry);
+    sections[SECTION_SYMTAB].sh_addralign = 8;
+
+    sections[SECTION_STRTAB].sh_name = section_name_offset[SECTION_STRTAB];
+    sections[SECTION_STRTAB].sh_type = SHT_STRTAB;
+    sections[SECTION_STRTAB].sh_offset = strtab_offset;
+    sections[SECTION_STRTAB].sh_size = strtab_size;
+    sections[SECTION_STRTAB].sh_addralign = 1;
+
+    // Empty marker telling the linker we do not need an executable stack
+    sections[SECTION_NOTE_GNU_STACK].sh_name =
+        section_name_offset[SECTION_NOTE_GNU_STACK];
+    sections[SECTION_NOTE_GNU_STACK].sh_type = SHT_PROGBITS;
+    sections[SECTION_NOTE_GNU_STACK].sh_offset = shstrtab_offset;
+    sections[SECTION_NOTE_GNU_STACK].sh_addralign = 1;
+
+    sections[SECTION_SHSTRTAB].sh_name = section_name_offset[SECTION_SHSTRTAB];
+    sections[SECTION_SHSTRTAB].sh_type = SHT_STRTAB;
+    sections[SECTION_SHSTRTAB].sh_offset = shstrtab_offset;
+    sections[SECTION_SHSTRTAB].sh_size = shstrtab_size;
+    sections[SECTION_SHSTRTAB].sh_addralign = 1;
+
+    bool ok = false;
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        ERROR_IO_ERROR(path, 0, 0, "Cannot open object file for writing",
+                       "Check the output path and permissions");
+    } else {
+        static const uint8_t padding[8] = {0};
+        ok = fwrite(&header, sizeof(header), 1, file) == 1;
+        if (ok && writer->text_size > 0)
+            ok = fwrite(writer->text, writer->text_size, 1, file) == 1;
+        if (ok && writer->data_size > 0)
+            ok = fwrite(writer->data, writer->data_size, 1, file) == 1;
+        if (ok && rela_size > 0)
+            ok = fwrite(relocations, rela_size, 1, file) == 1;
+        if (ok)
+            ok = fwrite(symtab, entry_count * sizeof(ElfSymbolEntry), 1, file) == 1;
+        if (ok && strtab_size > 0)
+            ok = fwrite(strtab, strtab_size, 1, file) == 1;
+        if (ok && shstrtab_size > 0)
+            ok = fwrite(shstrtab, shstrtab_size, 1, file) == 1;
+        uint64_t unaligned = sizeof(ElfHeader) + writer->text_size +
+                             writer->data_size + rela_size +
+                             entry_count * sizeof(ElfSymbolEntry) +
+                             strtab_size + shstrtab_size;
+        if (ok && shdr_offset > unaligned)
+            ok = fwrite(padding, shdr_offset - unaligned, 1, file) == 1;
+        if (ok)
+            ok = fwrite(sections, sizeof(sections), 1, file) == 1;
+        if (!ok) {
+            ERROR_IO_ERROR(path, 0, 0, "Failed to write the object file",
+                           "Check the free space on the output device");
+        }
+        fclose(file);
+    }
+
+    free(relocations);
+    free(symtab);
+    free(output_index);
+    free(strtab);
+    free(shstrtab);
+    return ok;
+}
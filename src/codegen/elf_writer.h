@@ -0,0 +1,152 @@
+/*
+ * filename: elf_writer.h
+ *
+ * Purpose:
+ * Header file for the direct ELF object writer of the ћ++ compiler.
+ * Lets the backend emit relocatable .o files straight from encoded
+ * machine code, without serializing assembly text and forking an
+ * external assembler.
+ *
+ * Key Components:
+ * - ElfSection enum: The sections a symbol or byte run can live in
+ * - ElfWriter struct: Accumulates code, data, symbols and relocations
+ * - elf_writer_init() / elf_writer_free(): Writer lifetime
+ * - elf_writer_append_text() / elf_writer_append_data(): Raw byte runs
+ * - elf_writer_add_symbol(): Define a symbol at a section offset
+ * - elf_writer_add_call_relocation(): PC-relative fixup for a call site
+ * - elf_writer_write(): Lay out and write the object file
+ *
+ * Interactions:
+ * - Fed by the shared instruction encoder in encoder.c
+ * - The -S flag in main.c remains the textual debugging path; this
+ *   writer is the default object path
+ *
+ * Notes:
+ * - Emits ELF64 for x86-64 and ELF32 for x86, selected by the same
+ *   ARCH_X86_64 flag the rest of the backend uses
+ * - Produces the minimal relocatable layout: .text, .data, .rela.text
+ *   (.rel.text on x86), .symtab, .strtab and .shstrtab
+ * - Call sites use PC-relative relocations with the usual -4 addend
+ *   so the linker resolves both local and external callees
+ */
+
+#ifndef ELF_WRITER_H
+#define ELF_WRITER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Where a symbol lives. Undefined symbols are external callees the
+// linker must resolve
+typedef enum {
+    ELF_SECTION_UNDEFINED,
+    ELF_SECTION_TEXT,
+    ELF_SECTION_DATA
+} ElfSection;
+
+// One symbol table entry before layout
+typedef struct {
+    const char* name;        // Interned, not owned
+    ElfSection section;
+    uint64_t offset;         // Offset within the section
+    bool global;             // Visible to the linker
+} ElfSymbol;
+
+// One pending PC-relative fixup in .text
+typedef struct {
+    uint64_t offset;         // Location of the 32-bit field in .text
+    uint32_t symbol;         // Index into the writer's symbol list
+    int64_t addend;          // Usually -4 for call rel32
+} ElfRelocation;
+
+// Accumulates a whole object file in memory; nothing touches the disk
+// until elf_writer_write
+typedef struct {
+    uint8_t* text;           // Encoded machine code
+    size_t text_size;
+    size_t text_capacity;
+
+    uint8_t* data;           // Initialized data (string literals, arrays)
+    size_t data_size;
+    size_t data_capacity;
+
+    ElfSymbol* symbols;
+    uint32_t symbol_count;
+    uint32_t symbol_capacity;
+
+    ElfRelocation* relocations;
+    uint32_t relocation_count;
+    uint32_t relocation_capacity;
+} ElfWriter;
+
+/**
+ * Create an empty writer
+ *
+ * @return The writer, or NULL on allocation failure
+ */
+ElfWriter* elf_writer_init(void);
+
+/**
+ * Free a writer and everything it owns
+ *
+ * @param writer The writer to free
+ */
+void elf_writer_free(ElfWriter* writer);
+
+/**
+ * Append encoded machine code to .text
+ *
+ * @param writer The writer
+ * @param bytes The encoded bytes
+ * @param size Number of bytes
+ * @return The offset the run was placed at, or UINT64_MAX on failure
+ */
+uint64_t elf_writer_append_text(ElfWriter* writer, const void* bytes, size_t size);
+
+/**
+ * Append initialized bytes to .data
+ *
+ * @param writer The writer
+ * @param bytes The bytes
+ * @param size Number of bytes
+ * @return The offset the run was placed at, or UINT64_MAX on failure
+ */
+uint64_t elf_writer_append_data(ElfWriter* writer, const void* bytes, size_t size);
+
+/**
+ * Add a symbol. Use ELF_SECTION_UNDEFINED for external callees
+ *
+ * @param writer The writer
+ * @param name Symbol name (interned; the writer does not copy it)
+ * @param section The section the symbol points into
+ * @param offset Offset within that section (ignored for undefined)
+ * @param global Whether the linker may see it
+ * @return The symbol's index, or UINT32_MAX on failure
+ */
+uint32_t elf_writer_add_symbol(ElfWriter* writer, const char* name,
+                               ElfSection section, uint64_t offset, bool global);
+
+/**
+ * Record a PC-relative call fixup at a .text offset
+ *
+ * @param writer The writer
+ * @param offset Offset of the 32-bit displacement field in .text
+ * @param symbol Index returned by elf_writer_add_symbol
+ * @param addend Relocation addend, -4 for a call rel32
+ * @return true on success, false on allocation failure
+ */
+bool elf_writer_add_call_relocation(ElfWriter* writer, uint64_t offset,
+                                    uint32_t symbol, int64_t addend);
+
+/**
+ * Lay the accumulated contents out as a relocatable object and write
+ * it to disk. Reports failures through error.h
+ *
+ * @param writer The writer
+ * @param path Output file path
+ * @return true on success, false when the file could not be written
+ */
+bool elf_writer_write(ElfWriter* writer, const char* path);
+
+#endif /* ELF_WRITER_H */
@@ -0,0 +1,344 @@
+/*
+ * filename: encoder.c
+ *
+ * Purpose:
+ * Implementation of the shared x86 instruction encoder for the ћ++
+ * compiler. The same source is compiled for both targets; the
+ * ARCH_X86/ARCH_X86_64 flag specializes word size, prefixes and
+ * stack-slot arithmetic at build time.
+ *
+ * Key Components:
+ * - emit_rex()/emit_rex_indexed(): The only width-dependent helpers;
+ *   they emit REX prefixes on 64-bit and compile to nothing on 32-bit
+ * - emit_modrm_*(): The addressing forms the backends use
+ * - One encoder function per instruction shape, all width-agnostic
+ *
+ * Interactions:
+ * - Appends through emit_buffer_append from codegen.c
+ * - The backend emit hooks in x86.c/x86_64.c call these encoders
+ *
+ * Notes:
+ * - Every encoder body is written once against the shared opcode map;
+ *   after preprocessing, neither build contains a test on the target
+ *   word size, so the per-instruction hot path is branch-free on both
+ * - mov reg, imm is the one shape whose immediate width follows the
+ *   word size (B8+r takes imm32 without REX.W and imm64 with it), so
+ *   emit_word_immediate writes ENC_WORD_BYTES bytes and stays correct
+ *   on both targets
+ * - Indexed addressing falls back from [base + index*W] to
+ *   [base + index*W + disp8 0] when the base's low encoding bits
+ *   collide with the no-base form (bp, and r13 on 64-bit)
+ */
+
+#include "encoder.h"
+#include <string.h>
+
+/**
+ * Append one byte
+ */
+static bool emit_byte(EmitBuffer* out, uint8_t value) {
+    return emit_buffer_append(out, &value, 1) != SIZE_MAX;
+}
+
+/**
+ * Append a 32-bit little-endian value
+ */
+static bool emit_u32(EmitBuffer* out, uint32_t value) {
+    uint8_t bytes[4] = {
+        (uint8_t)value, (uint8_t)(value >> 8),
+        (uint8_t)(value >> 16), (uint8_t)(value >> 24)
+    };
+    return emit_buffer_append(out, bytes, 4) != SIZE_MAX;
+}
+
+/**
+ * Append a WORD-sized little-endian immediate
+ */
+static bool emit_word_immediate(EmitBuffer* out, intptr_t value) {
+    uint8_t bytes[ENC_WORD_BYTES];
+    for (int i = 0; i < ENC_WORD_BYTES; i++) {
+        bytes[i] = (uint8_t)((uintptr_t)value >> (8 * i));
+    }
+    return emit_buffer_append(out, bytes, ENC_WORD_BYTES) != SIZE_MAX;
+}
+
+#ifdef ARCH_X86_64
+
+/**
+ * REX.W plus the extension bits of the reg and r/m fields
+ */
+static bool emit_rex(EmitBuffer* out, EncoderRegister reg, EncoderRegister rm) {
+    return emit_byte(out, (uint8_t)(0x48 | ((reg >> 3) << 2) | (rm >> 3)));
+}
+
+/**
+ * REX.W for a SIB form: reg, index and base extension bits
+ */
+static bool emit_rex_indexed(EmitBuffer* out, EncoderRegister reg,
+                             EncoderRegister index, EncoderRegister base) {
+    return emit_byte(out, (uint8_t)(0x48 | ((reg >> 3) << 2) |
+                                    ((index >> 3) << 1) | (base >> 3)));
+}
+
+/**
+ * Extension-bit-only prefix for the short push/pop forms, whose
+ * operand size is the word size already; low registers need none
+ */
+static bool emit_rex_base(EmitBuffer* out, EncoderRegister rm) {
+    if (rm < ENC_R8) return true;
+    return emit_byte(out, 0x41);
+}
+
+#else /* !ARCH_X86_64 */
+
+/**
+ * 32-bit operand size is the default encoding; no prefix exists
+ */
+static bool emit_rex(EmitBuffer* out, EncoderRegister reg, EncoderRegister rm) {
+    (void)out; (void)reg; (void)rm;
+    return true;
+}
+
+static bool emit_rex_indexed(EmitBuffer* out, EncoderRegister reg,
+                             EncoderRegister index, EncoderRegister base) {
+    (void)out; (void)reg; (void)index; (void)base;
+    return true;
+}
+
+static bool emit_rex_base(EmitBuffer* out, EncoderRegister rm) {
+    (void)out; (void)rm;
+    return true;
+}
+
+#endif /* ARCH_X86_64 */
+
+/**
+ * ModRM for a register-to-register form
+ */
+static bool emit_modrm_reg(EmitBuffer* out, EncoderRegister reg,
+                           EncoderRegister rm) {
+    return emit_byte(out, (uint8_t)(0xC0 | ((reg & 7) << 3) | (rm & 7)));
+}
+
+/**
+ * ModRM plus disp32 for [bp + displacement]
+ */
+static bool emit_modrm_frame(EmitBuffer* out, EncoderRegister reg,
+                             int32_t displacement) {
+    return emit_byte(out, (uint8_t)(0x80 | ((reg & 7) << 3) | ENC_BP)) &&
+           emit_u32(out, (uint32_t)displacement);
+}
+
+/**
+ * ModRM plus SIB for [base + index * WORD]. A base whose low encoding
+ * bits equal bp has no no-displacement form, so it takes a zero disp8
+ */
+static bool emit_modrm_indexed(EmitBuffer* out, EncoderRegister reg,
+                               EncoderRegister base, EncoderRegister index) {
+    uint8_t sib = (uint8_t)((ENC_WORD_SHIFT << 6) | ((index & 7) << 3) |
+                            (base & 7));
+    if ((base & 7) == ENC_BP) {
+        return emit_byte(out, (uint8_t)(0x44 | ((reg & 7) << 3))) &&
+               emit_byte(out, sib) && emit_byte(out, 0x00);
+    }
+    return emit_byte(out, (uint8_t)(0x04 | ((reg & 7) << 3))) &&
+           emit_byte(out, sib);
+}
+
+int32_t encoder_slot_displacement(uint32_t slot) {
+    return -(int32_t)(ENC_WORD_BYTES * (slot + 1));
+}
+
+bool encoder_prologue(EmitBuffer* out, uint32_t frame_bytes) {
+    return encoder_push(out, ENC_BP) &&
+           encoder_move(out, ENC_BP, ENC_SP) &&
+           encoder_arithmetic_imm(out, ENC_ALU_SUB, ENC_SP,
+                                  (int32_t)frame_bytes);
+}
+
+bool encoder_epilogue(EmitBuffer* out) {
+    return encoder_move(out, ENC_SP, ENC_BP) &&
+           encoder_pop(out, ENC_BP) &&
+           encoder_return(out);
+}
+
+bool encoder_load_const(EmitBuffer* out, EncoderRegister dst, intptr_t value) {
+    return emit_rex(out, 0, dst) &&
+           emit_byte(out, (uint8_t)(0xB8 + (dst & 7))) &&
+           emit_word_immediate(out, value);
+}
+
+bool encoder_move(EmitBuffer* out, EncoderRegister dst, EncoderRegister src) {
+    return emit_rex(out, src, dst) &&
+           emit_byte(out, 0x89) &&
+           emit_modrm_reg(out, src, dst);
+}
+
+bool encoder_load_slot(EmitBuffer* out, EncoderRegister dst, uint32_t slot) {
+    return emit_rex(out, dst, ENC_BP) &&
+           emit_byte(out, 0x8B) &&
+           emit_modrm_frame(out, dst, encoder_slot_displacement(slot));
+}
+
+bool encoder_store_slot(EmitBuffer* out, EncoderRegister src, uint32_t slot) {
+    return emit_rex(out, src, ENC_BP) &&
+           emit_byte(out, 0x89) &&
+           emit_modrm_frame(out, src, encoder_slot_displacement(slot));
+}
+
+bool encoder_load_address(EmitBuffer* out, EncoderRegister dst,
+                          int32_t displacement) {
+    return emit_rex(out, dst, ENC_BP) &&
+           emit_byte(out, 0x8D) &&
+           emit_modrm_frame(out, dst, displacement);
+}
+
+bool encoder_arithmetic(EmitBuffer* out, EncoderAluOp op,
+                        EncoderRegister dst, EncoderRegister src) {
+    return emit_rex(out, src, dst) &&
+           emit_byte(out, (uint8_t)op) &&
+           emit_modrm_reg(out, src, dst);
+}
+
+bool encoder_arithmetic_imm(EmitBuffer* out, EncoderAluOp op,
+                            EncoderRegister dst, int32_t value) {
+    // The /reg extension of the 0x81 immediate group is the reg-reg
+    // opcode's high bits, so the EncoderAluOp map covers this form too
+    return emit_rex(out, 0, dst) &&
+           emit_byte(out, 0x81) &&
+           emit_modrm_reg(out, (EncoderRegister)(op >> 3), dst) &&
+           emit_u32(out, (uint32_t)value);
+}
+
+bool encoder_increment(EmitBuffer* out, EncoderRegister reg) {
+    // The one-byte 0x40 forms became REX prefixes on 64-bit, so both
+    // builds share the FF group encoding
+    return emit_rex(out, 0, reg) &&
+           emit_byte(out, 0xFF) &&
+           emit_modrm_reg(out, 0, reg);
+}
+
+bool encoder_decrement(EmitBuffer* out, EncoderRegister reg) {
+    return emit_rex(out, 0, reg) &&
+           emit_byte(out, 0xFF) &&
+           emit_modrm_reg(out, 1, reg);
+}
+
+bool encoder_multiply(EmitBuffer* out, EncoderRegister dst,
+                      EncoderRegister src) {
+    return emit_rex(out, dst, src) &&
+           emit_byte(out, 0x0F) && emit_byte(out, 0xAF) &&
+           emit_modrm_reg(out, dst, src);
+}
+
+bool encoder_divide(EmitBuffer* out, EncoderRegister divisor) {
+    // cdq/cqo share the opcode; the width prefix picks the wide form
+    return emit_rex(out, 0, 0) &&
+           emit_byte(out, 0x99) &&
+           emit_rex(out, 0, divisor) &&
+           emit_byte(out, 0xF7) &&
+           emit_modrm_reg(out, 7, divisor);
+}
+
+bool encoder_negate(EmitBuffer* out, EncoderRegister reg) {
+    return emit_rex(out, 0, reg) &&
+           emit_byte(out, 0xF7) &&
+           emit_modrm_reg(out, 3, reg);
+}
+
+bool encoder_test(EmitBuffer* out, EncoderRegister a, EncoderRegister b) {
+    return emit_rex(out, b, a) &&
+           emit_byte(out, 0x85) &&
+           emit_modrm_reg(out, b, a);
+}
+
+bool encoder_set_condition(EmitBuffer* out, EncoderCondition condition,
+                           EncoderRegister dst) {
+    // setcc only reaches the classic byte registers without a prefix,
+    // so the flag goes through al on both targets
+    return emit_byte(out, 0x0F) &&
+           emit_byte(out, (uint8_t)(0x90 + condition)) &&
+           emit_modrm_reg(out, 0, ENC_AX) &&
+           emit_rex(out, dst, ENC_AX) &&
+           emit_byte(out, 0x0F) && emit_byte(out, 0xB6) &&
+           emit_modrm_reg(out, dst, ENC_AX);
+}
+
+bool encoder_load_indexed(EmitBuffer* out, EncoderRegister dst,
+                          EncoderRegister base, EncoderRegister index) {
+    return emit_rex_indexed(out, dst, index, base) &&
+           emit_byte(out, 0x8B) &&
+           emit_modrm_indexed(out, dst, base, index);
+}
+
+bool encoder_store_indexed(EmitBuffer* out, EncoderRegister src,
+                           EncoderRegister base, EncoderRegister index) {
+    return emit_rex_indexed(out, src, index, base) &&
+           emit_byte(out, 0x89) &&
+           emit_modrm_indexed(out, src, base, index);
+}
+
+bool encoder_push(EmitBuffer* out, EncoderRegister reg) {
+    return emit_rex_base(out, reg) &&
+           emit_byte(out, (uint8_t)(0x50 + (reg & 7)));
+}
+
+bool encoder_pop(EmitBuffer* out, EncoderRegister reg) {
+    return emit_rex_base(out, reg) &&
+           emit_byte(out, (uint8_t)(0x58 + (reg & 7)));
+}
+
+bool encoder_return(EmitBuffer* out) {
+    return emit_byte(out, 0xC3);
+}
+
+size_t encoder_jump(EmitBuffer* out) {
+    if (!emit_byte(out, 0xE9)) return SIZE_MAX;
+    size_t at = out->size;
+    if (!emit_u32(out, 0)) return SIZE_MAX;
+    return at;
+}
+
+size_t encoder_jump_condition(EmitBuffer* out, EncoderCondition condition) {
+    if (!emit_byte(out, 0x0F) ||
+        !emit_byte(out, (uint8_t)(0x80 + condition))) {
+        return SIZE_MAX;
+    }
+    size_t at = out->size;
+    if (!emit_u32(out, 0)) return SIZE_MAX;
+    return at;
+}
+
+size_t encoder_call(EmitBuffer* out) {
+    if (!emit_byte(out, 0xE8)) return SIZE_MAX;
+    size_t at = out->size;
+    if (!emit_u32(out, 0)) return SIZE_MAX;
+    return at;
+}
+
+bool encoder_call_register(EmitBuffer* out, EncoderRegister target) {
+    // call has no operand-size choice, so the width bit emit_rex sets
+    // is ignored; only the extension bit for r8-r15 matters
+    return emit_rex(out, 0, target) &&
+           emit_byte(out, 0xFF) &&
+           emit_modrm_reg(out, 2, target);
+}
+
+void encoder_patch_rel32(EmitBuffer* out, size_t at, size_t target) {
+    if (!out || at + 4 > out->size) return;
+    int32_t rel = (int32_t)((int64_t)target - (int64_t)(at + 4));
+    memcpy(out->bytes + at, &rel, 4);
+}
+
+const char* encoder_register_name(EncoderRegister reg) {
+    static const char* names[ENC_REGISTER_COUNT] = {
+#ifdef ARCH_X86_64
+        "rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi",
+        "r8",  "r9",  "r10", "r11", "r12", "r13", "r14", "r15"
+#else
+        "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi"
+#endif
+    };
+    if (reg < 0 || reg >= ENC_REGISTER_COUNT) return "???";
+    return names[reg];
+}
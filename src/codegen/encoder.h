@@ -0,0 +1,368 @@
+/*
+ * filename: encoder.h
+ *
+ * Purpose:
+ * Header file for the shared x86 instruction encoder of the ћ++
+ * compiler. One encoder source serves both backends: the Makefile's
+ * ARCH_X86/ARCH_X86_64 flag selects the word size at compile time, so
+ * the 32-bit and 64-bit builds each get a fully specialized encoder
+ * from the same code.
+ *
+ * Key Components:
+ * - EncoderRegister enum: Registers in hardware encoding order
+ * - EncoderAluOp/EncoderCondition enums: Opcode and condition maps
+ * - ENC_WORD_BYTES/ENC_WORD_SHIFT: Word size resolved at build time
+ * - encoder_prologue()/encoder_epilogue(): Stack frame bracketing
+ * - encoder_load_slot()/encoder_store_slot(): Frame slot traffic
+ * - encoder_jump()/encoder_call()/encoder_patch_rel32(): Control flow
+ *   with rel32 placeholders patched once targets are known
+ *
+ * Interactions:
+ * - Emits into the EmitBuffer from codegen.h, so the backend emit
+ *   hooks in x86.c/x86_64.c build on it directly
+ * - Encoded bytes flow to elf_writer.h unchanged
+ *
+ * Notes:
+ * - Register width, operand-size prefixes and stack-slot arithmetic
+ *   are all resolved when the flag is chosen: the per-instruction
+ *   paths contain no branch on TargetInfo.word_size, which matters
+ *   because both cross-compiled targets run through CI on every push
+ * - The two instruction sets share their opcode maps; the 64-bit
+ *   build differs only in adding REX prefixes, widening immediates
+ *   and admitting r8-r15, all of which compile away on 32-bit
+ * - Registers are numbered by their hardware encoding (ax=0, cx=1,
+ *   ...), not by the allocator's preference order in x86_64.h;
+ *   backends map allocator registers to encodings when emitting
+ */
+
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "codegen.h"
+
+// Word size of the compilation target, fixed when the Makefile picks
+// the architecture flag
+#ifdef ARCH_X86_64
+#define ENC_WORD_BYTES 8
+#define ENC_WORD_SHIFT 3
+#else
+#define ENC_WORD_BYTES 4
+#define ENC_WORD_SHIFT 2
+#endif
+
+// General-purpose registers in hardware encoding order. The 32-bit
+// target has only the first eight
+typedef enum {
+    ENC_AX = 0, ENC_CX = 1, ENC_DX = 2, ENC_BX = 3,
+    ENC_SP = 4, ENC_BP = 5, ENC_SI = 6, ENC_DI = 7,
+#ifdef ARCH_X86_64
+    ENC_R8 = 8,  ENC_R9 = 9,  ENC_R10 = 10, ENC_R11 = 11,
+    ENC_R12 = 12, ENC_R13 = 13, ENC_R14 = 14, ENC_R15 = 15,
+#endif
+    ENC_REGISTER_COUNT
+} EncoderRegister;
+
+// Two-operand ALU operations, carrying their reg-reg opcode byte
+typedef enum {
+    ENC_ALU_ADD = 0x01,
+    ENC_ALU_OR  = 0x09,
+    ENC_ALU_AND = 0x21,
+    ENC_ALU_SUB = 0x29,
+    ENC_ALU_XOR = 0x31,
+    ENC_ALU_CMP = 0x39
+} EncoderAluOp;
+
+// Condition codes as the low nibble shared by setcc and jcc. Signed
+// comparisons only: every ћ++ value is a signed WORD
+typedef enum {
+    ENC_CONDITION_EQUAL         = 0x4,
+    ENC_CONDITION_NOT_EQUAL     = 0x5,
+    ENC_CONDITION_LESS          = 0xC,
+    ENC_CONDITION_GREATER_EQUAL = 0xD,
+    ENC_CONDITION_LESS_EQUAL    = 0xE,
+    ENC_CONDITION_GREATER       = 0xF
+} EncoderCondition;
+
+/**
+ * Frame displacement of a WORD-sized stack slot
+ *
+ * @param slot The slot index (0 is closest to the frame pointer)
+ * @return The displacement off the frame pointer, always negative
+ */
+int32_t encoder_slot_displacement(uint32_t slot);
+
+/**
+ * push bp; mov bp, sp; sub sp, frame_bytes
+ *
+ * @param out The emit buffer
+ * @param frame_bytes Frame size; the caller is responsible for any
+ *        stack alignment the ABI requires at call sites
+ * @return true on success, false on allocation failure
+ */
+bool encoder_prologue(EmitBuffer* out, uint32_t frame_bytes);
+
+/**
+ * mov sp, bp; pop bp; ret
+ *
+ * @param out The emit buffer
+ * @return true on success, false on allocation failure
+ */
+bool encoder_epilogue(EmitBuffer* out);
+
+/**
+ * Load a WORD immediate into a register
+ *
+ * @param out The emit buffer
+ * @param dst The destination register
+ * @param value The immediate; the full word range of the target
+ * @return true on success, false on allocation failure
+ */
+bool encoder_load_const(EmitBuffer* out, EncoderRegister dst, intptr_t value);
+
+/**
+ * Register-to-register move
+ *
+ * @param out The emit buffer
+ * @param dst The destination register
+ * @param src The source register
+ * @return true on success, false on allocation failure
+ */
+bool encoder_move(EmitBuffer* out, EncoderRegister dst, EncoderRegister src);
+
+/**
+ * Load a register from a frame slot
+ *
+ * @param out The emit buffer
+ * @param dst The destination register
+ * @param slot The slot index
+ * @return true on success, false on allocation failure
+ */
+bool encoder_load_slot(EmitBuffer* out, EncoderRegister dst, uint32_t slot);
+
+/**
+ * Store a register into a frame slot
+ *
+ * @param out The emit buffer
+ * @param src The source register
+ * @param slot The slot index
+ * @return true on success, false on allocation failure
+ */
+bool encoder_store_slot(EmitBuffer* out, EncoderRegister src, uint32_t slot);
+
+/**
+ * lea dst, [bp + displacement] — materialize a frame address, used
+ * for the statically placed array regions
+ *
+ * @param out The emit buffer
+ * @param dst The destination register
+ * @param displacement Signed displacement off the frame pointer
+ * @return true on success, false on allocation failure
+ */
+bool encoder_load_address(EmitBuffer* out, EncoderRegister dst,
+                          int32_t displacement);
+
+/**
+ * Two-operand ALU operation: dst = dst op src (cmp only sets flags)
+ *
+ * @param out The emit buffer
+ * @param op The operation
+ * @param dst The destination register
+ * @param src The source register
+ * @return true on success, false on allocation failure
+ */
+bool encoder_arithmetic(EmitBuffer* out, EncoderAluOp op,
+                        EncoderRegister dst, EncoderRegister src);
+
+/**
+ * Two-operand ALU operation with an immediate: dst = dst op imm (cmp
+ * only sets flags). The immediate is sign-extended to the word size
+ *
+ * @param out The emit buffer
+ * @param op The operation
+ * @param dst The destination register
+ * @param value The immediate
+ * @return true on success, false on allocation failure
+ */
+bool encoder_arithmetic_imm(EmitBuffer* out, EncoderAluOp op,
+                            EncoderRegister dst, int32_t value);
+
+/**
+ * Increment a register in place
+ *
+ * @param out The emit buffer
+ * @param reg The register
+ * @return true on success, false on allocation failure
+ */
+bool encoder_increment(EmitBuffer* out, EncoderRegister reg);
+
+/**
+ * Decrement a register in place
+ *
+ * @param out The emit buffer
+ * @param reg The register
+ * @return true on success, false on allocation failure
+ */
+bool encoder_decrement(EmitBuffer* out, EncoderRegister reg);
+
+/**
+ * Signed multiply: dst = dst * src
+ *
+ * @param out The emit buffer
+ * @param dst The destination register
+ * @param src The source register
+ * @return true on success, false on allocation failure
+ */
+bool encoder_multiply(EmitBuffer* out, EncoderRegister dst, EncoderRegister src);
+
+/**
+ * Signed divide of the ax:dx pair by a register: sign-extend ax into
+ * dx, then idiv. Quotient lands in ax, remainder in dx
+ *
+ * @param out The emit buffer
+ * @param divisor The divisor register (not ax or dx)
+ * @return true on success, false on allocation failure
+ */
+bool encoder_divide(EmitBuffer* out, EncoderRegister divisor);
+
+/**
+ * Arithmetic negation in place
+ *
+ * @param out The emit buffer
+ * @param reg The register to negate
+ * @return true on success, false on allocation failure
+ */
+bool encoder_negate(EmitBuffer* out, EncoderRegister reg);
+
+/**
+ * test a, b — sets flags for a following jump or setcc
+ *
+ * @param out The emit buffer
+ * @param a First operand
+ * @param b Second operand
+ * @return true on success, false on allocation failure
+ */
+bool encoder_test(EmitBuffer* out, EncoderRegister a, EncoderRegister b);
+
+/**
+ * Materialize the flags as 0 or 1: setcc al; movzx dst, al
+ *
+ * @param out The emit buffer
+ * @param condition The condition to test
+ * @param dst The destination register
+ * @return true on success, false on allocation failure
+ */
+bool encoder_set_condition(EmitBuffer* out, EncoderCondition condition,
+                           EncoderRegister dst);
+
+/**
+ * Load a WORD element: dst = [base + index * WORD]
+ *
+ * @param out The emit buffer
+ * @param dst The destination register
+ * @param base Register holding the element-0 address
+ * @param index Register holding the element index (not sp)
+ * @return true on success, false on allocation failure
+ */
+bool encoder_load_indexed(EmitBuffer* out, EncoderRegister dst,
+                          EncoderRegister base, EncoderRegister index);
+
+/**
+ * Store a WORD element: [base + index * WORD] = src
+ *
+ * @param out The emit buffer
+ * @param src The source register
+ * @param base Register holding the element-0 address
+ * @param index Register holding the element index (not sp)
+ * @return true on success, false on allocation failure
+ */
+bool encoder_store_indexed(EmitBuffer* out, EncoderRegister src,
+                           EncoderRegister base, EncoderRegister index);
+
+/**
+ * Push a register onto the stack
+ *
+ * @param out The emit buffer
+ * @param reg The register
+ * @return true on success, false on allocation failure
+ */
+bool encoder_push(EmitBuffer* out, EncoderRegister reg);
+
+/**
+ * Pop the stack top into a register
+ *
+ * @param out The emit buffer
+ * @param reg The register
+ * @return true on success, false on allocation failure
+ */
+bool encoder_pop(EmitBuffer* out, EncoderRegister reg);
+
+/**
+ * Return to the caller. encoder_epilogue() tears the frame down
+ * first; this is the bare instruction
+ *
+ * @param out The emit buffer
+ * @return true on success, false on allocation failure
+ */
+bool encoder_return(EmitBuffer* out);
+
+/**
+ * Unconditional jump with a rel32 placeholder
+ *
+ * @param out The emit buffer
+ * @return Buffer offset of the placeholder for encoder_patch_rel32,
+ *         or SIZE_MAX on allocation failure
+ */
+size_t encoder_jump(EmitBuffer* out);
+
+/**
+ * Conditional jump on the current flags with a rel32 placeholder
+ *
+ * @param out The emit buffer
+ * @param condition The condition to jump on
+ * @return Buffer offset of the placeholder for encoder_patch_rel32,
+ *         or SIZE_MAX on allocation failure
+ */
+size_t encoder_jump_condition(EmitBuffer* out, EncoderCondition condition);
+
+/**
+ * call rel32 with a placeholder displacement. Local callees are
+ * patched with encoder_patch_rel32; cross-object callees keep the
+ * placeholder and get an elf_writer_add_call_relocation instead
+ *
+ * @param out The emit buffer
+ * @return Buffer offset of the placeholder, or SIZE_MAX on failure
+ */
+size_t encoder_call(EmitBuffer* out);
+
+/**
+ * Indirect call through a register, for callees whose absolute
+ * address is already materialized (the JIT's external calls)
+ *
+ * @param out The emit buffer
+ * @param target Register holding the callee address
+ * @return true on success, false on allocation failure
+ */
+bool encoder_call_register(EmitBuffer* out, EncoderRegister target);
+
+/**
+ * Resolve a rel32 placeholder against a target offset in the same
+ * buffer
+ *
+ * @param out The emit buffer
+ * @param at Placeholder offset returned by the emitting call
+ * @param target Buffer offset the displacement should reach
+ */
+void encoder_patch_rel32(EmitBuffer* out, size_t at, size_t target);
+
+/**
+ * Get the assembly name of a register for the build's word size
+ *
+ * @param reg The register
+ * @return A static name string such as "rax" or "eax"
+ */
+const char* encoder_register_name(EncoderRegister reg);
+
+#endif /* ENCODER_H */
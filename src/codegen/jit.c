@@ -0,0 +1,708 @@
+/*
+ * filename: jit.c
+ *
+ * Purpose:
+ * Implementation of in-memory JIT execution for the ћ++ compiler.
+ * Lowers the flat IR to a machine instruction stream, runs the
+ * peephole optimizer over it, encodes the survivors through the
+ * shared instruction encoder, resolves calls, flips the buffer
+ * executable, and jumps to главна().
+ *
+ * Key Components:
+ * - jit_run_program(): Entry point; compile, resolve, protect, run
+ * - lower_function(): IR to MachInstruction stream for one function
+ * - encode_stream(): MachInstruction stream to bytes via encoder.h
+ *
+ * Interactions:
+ * - Consumes IrProgram/IrFunction from ir/ir.h
+ * - Produces the MachInstruction stream from peephole.h and runs
+ *   peephole_optimize() on it between lowering and encoding
+ * - All instruction bytes come from encoder.h; encoding records label
+ *   offsets and patches rel32 placeholders once targets are known
+ * - Resolves names without an IR definition through dlsym so екстерно
+ *   declarations bind to host process symbols
+ * - Uses error.h for reporting problems
+ *
+ * Notes:
+ * - Every virtual register gets a WORD-sized stack slot and the
+ *   lowering loads and stores through the frame pointer, so no
+ *   register allocation is needed and compile time stays linear; the
+ *   peephole's slot forwarding then removes the reloads that
+ *   consecutive instructions would otherwise pay for
+ * - Array storage is carved out of the frame below the value slots,
+ *   one statically placed region per IR_ALLOC_ARRAY site
+ * - Arguments travel in the System V registers (rdi, rsi, rdx, rcx,
+ *   r8, r9); calls with more than 6 arguments are rejected
+ * - ax holds the first operand and results, cx the second operand,
+ *   dx stored values and division remainders
+ */
+
+#define _GNU_SOURCE  /* RTLD_DEFAULT */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include "jit.h"
+#include "encoder.h"
+#include "peephole.h"
+#include "../utils/error.h"
+
+#ifdef ARCH_X86_64
+
+// How many arguments fit in the System V integer registers
+#define JIT_MAX_ARGUMENTS 6
+
+// Pending IR_ARG operands between emission of ARG and CALL
+#define JIT_MAX_PENDING_ARGS 64
+
+// The System V integer argument registers, in passing order
+static const EncoderRegister argument_registers[JIT_MAX_ARGUMENTS] =
+    { ENC_DI, ENC_SI, ENC_DX, ENC_CX, ENC_R8, ENC_R9 };
+
+// Machine code buffer plus the fixups that are resolved once every
+// function's final position is known
+typedef struct {
+    EmitBuffer code;
+
+    // Call sites waiting for a function's buffer offset
+    struct {
+        size_t offset;       // Position of the rel32 displacement
+        uint32_t function;   // Callee index in program->functions
+    }* call_fixups;
+    uint32_t call_fixup_count;
+    uint32_t call_fixup_capacity;
+
+    const IrProgram* program;
+    size_t* function_offsets;    // Buffer offset of each function
+} JitBuffer;
+
+// Growable machine instruction stream for one function
+typedef struct {
+    MachInstruction* code;
+    uint32_t count;
+    uint32_t capacity;
+} MachStream;
+
+/**
+ * Append one instruction to the stream, growing it as needed
+ */
+static bool mach(MachStream* stream, MachInstruction inst) {
+    if (stream->count == stream->capacity) {
+        uint32_t new_capacity = stream->capacity ? stream->capacity * 2 : 64;
+        void* grown = realloc(stream->code,
+                              new_capacity * sizeof(*stream->code));
+        if (!grown) return false;
+        stream->code = grown;
+        stream->capacity = new_capacity;
+    }
+    stream->code[stream->count++] = inst;
+    return true;
+}
+
+// Shorthand constructors for the common instruction shapes
+static bool mach_rr(MachStream* s, MachOpcode opcode, int dst, int src) {
+    return mach(s, (MachInstruction){ .opcode = opcode,
+                                      .dst = dst, .src = src });
+}
+
+static bool mach_imm(MachStream* s, MachOpcode opcode, int dst, intptr_t imm) {
+    return mach(s, (MachInstruction){ .opcode = opcode,
+                                      .dst = dst, .imm = imm });
+}
+
+static bool mach_load_slot(MachStream* s, int reg, uint32_t slot) {
+    return mach(s, (MachInstruction){ .opcode = MACH_LOAD_SLOT,
+                                      .dst = reg, .imm = (intptr_t)slot });
+}
+
+static bool mach_store_slot(MachStream* s, int reg, uint32_t slot) {
+    return mach(s, (MachInstruction){ .opcode = MACH_STORE_SLOT,
+                                      .src = reg, .imm = (intptr_t)slot });
+}
+
+static bool mach_jump(MachStream* s, MachOpcode opcode,
+                      MachCondition condition, int label) {
+    return mach(s, (MachInstruction){ .opcode = opcode,
+                                      .condition = condition,
+                                      .label = label });
+}
+
+/**
+ * mov sp, bp; pop bp; ret — the frame teardown before every return
+ */
+static bool mach_epilogue(MachStream* s) {
+    return mach_rr(s, MACH_MOV_RR, ENC_SP, ENC_BP) &&
+           mach(s, (MachInstruction){ .opcode = MACH_POP_R, .dst = ENC_BP }) &&
+           mach(s, (MachInstruction){ .opcode = MACH_RET });
+}
+
+/**
+ * Find the IR definition of a name pool entry, or IR_NO_OPERAND when
+ * the name is external to the program
+ */
+static uint32_t find_function(const IrProgram* program, uint32_t name_index) {
+    if (name_index >= program->name_count) return IR_NO_OPERAND;
+    const char* name = program->names[name_index];
+    for (uint32_t f = 0; f < program->function_count; f++) {
+        if (strcmp(program->functions[f].name, name) == 0) return f;
+    }
+    return IR_NO_OPERAND;
+}
+
+/**
+ * Record a call site whose rel32 placeholder is patched after all
+ * functions have been emitted
+ */
+static bool add_call_fixup(JitBuffer* buffer, size_t offset, uint32_t function) {
+    if (buffer->call_fixup_count == buffer->call_fixup_capacity) {
+        uint32_t new_capacity = buffer->call_fixup_capacity
+                                    ? buffer->call_fixup_capacity * 2 : 16;
+        void* grown = realloc(buffer->call_fixups,
+                              new_capacity * sizeof(*buffer->call_fixups));
+        if (!grown) return false;
+        buffer->call_fixups = grown;
+        buffer->call_fixup_capacity = new_capacity;
+    }
+    buffer->call_fixups[buffer->call_fixup_count].offset = offset;
+    buffer->call_fixups[buffer->call_fixup_count].function = function;
+    buffer->call_fixup_count++;
+    return true;
+}
+
+/**
+ * Lower one function's IR into a machine instruction stream. Block
+ * ids become MACH_LABEL targets; calls carry the callee's function
+ * index in their label field
+ */
+static bool lower_function(const IrProgram* program,
+                           const IrFunction* function, MachStream* stream) {
+    if (function->parameter_count > JIT_MAX_ARGUMENTS) {
+        ERROR_CODEGEN_ERROR(function->name, 0, 0,
+                           "Function has more than 6 parameters",
+                           "The JIT passes arguments in registers only");
+        return false;
+    }
+
+    // The frame holds one WORD slot per virtual register, then the
+    // array regions, padded so sp stays 16-byte aligned at calls
+    size_t slot_bytes = (size_t)function->value_count * ENC_WORD_BYTES;
+    size_t array_bytes = 0;
+    for (uint32_t i = 0; i < function->instruction_count; i++) {
+        if (function->instructions[i].opcode == IR_ALLOC_ARRAY) {
+            array_bytes += (size_t)function->instructions[i].imm
+                               * ENC_WORD_BYTES;
+        }
+    }
+    size_t frame_bytes = (slot_bytes + array_bytes + 15) & ~(size_t)15;
+
+    // push bp; mov bp, sp; sub sp, frame
+    bool ok = mach(stream, (MachInstruction){ .opcode = MACH_PUSH_R,
+                                              .src = ENC_BP }) &&
+              mach_rr(stream, MACH_MOV_RR, ENC_BP, ENC_SP) &&
+              mach_imm(stream, MACH_SUB_RI, ENC_SP, (intptr_t)frame_bytes);
+
+    // Spill the incoming parameters into their slots
+    for (int p = 0; ok && p < function->parameter_count; p++) {
+        ok = mach_store_slot(stream, argument_registers[p], (uint32_t)p);
+    }
+
+    uint32_t pending_args[JIT_MAX_PENDING_ARGS];
+    uint32_t pending_count = 0;
+    size_t array_taken = 0;
+
+    for (uint32_t b = 0; ok && b < function->block_count; b++) {
+        ok = mach(stream, (MachInstruction){ .opcode = MACH_LABEL,
+                                             .label = (int)b });
+        const IrBasicBlock* block = &function->blocks[b];
+
+        for (uint32_t i = block->first;
+             ok && i < block->first + block->count; i++) {
+            const IrInstruction* inst = &function->instructions[i];
+
+            switch (inst->opcode) {
+                case IR_NOP:
+                    break;
+
+                case IR_LOAD_CONST:
+                    ok = mach_imm(stream, MACH_MOV_RI, ENC_AX,
+                                  (intptr_t)inst->imm) &&
+                         mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+
+                case IR_LOAD_STRING:
+                    // The string pool outlives execution, so its
+                    // addresses can be baked in directly
+                    ok = inst->b < program->string_count &&
+                         mach_imm(stream, MACH_MOV_RI, ENC_AX,
+                                  (intptr_t)(uintptr_t)
+                                      program->strings[inst->b]) &&
+                         mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+
+                case IR_MOVE:
+                    ok = mach_load_slot(stream, ENC_AX, inst->a) &&
+                         mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+
+                case IR_ALLOC_ARRAY: {
+                    // lea ax, [bp - (slots + taken + size)]
+                    size_t size = (size_t)inst->imm * ENC_WORD_BYTES;
+                    int32_t disp = -(int32_t)(slot_bytes + array_taken + size);
+                    array_taken += size;
+                    ok = mach_imm(stream, MACH_LEA_FRAME, ENC_AX, disp) &&
+                         mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+                }
+
+                case IR_LOAD_ARRAY:
+                    ok = mach_load_slot(stream, ENC_AX, inst->a) &&
+                         mach_load_slot(stream, ENC_CX, inst->b) &&
+                         mach(stream, (MachInstruction){
+                                 .opcode = MACH_LOAD_INDEXED,
+                                 .dst = ENC_AX, .src = ENC_AX,
+                                 .imm = ENC_CX }) &&
+                         mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+
+                case IR_STORE_ARRAY:
+                    // dest holds the value being stored
+                    ok = mach_load_slot(stream, ENC_AX, inst->a) &&
+                         mach_load_slot(stream, ENC_CX, inst->b) &&
+                         mach_load_slot(stream, ENC_DX, inst->dest) &&
+                         mach(stream, (MachInstruction){
+                                 .opcode = MACH_STORE_INDEXED,
+                                 .dst = ENC_AX, .src = ENC_DX,
+                                 .imm = ENC_CX });
+                    break;
+
+                case IR_ADD:
+                case IR_SUB:
+                case IR_MUL:
+                case IR_AND:
+                case IR_OR:
+                case IR_XOR: {
+                    static const MachOpcode alu_map[] = {
+                        MACH_ADD_RR, MACH_SUB_RR, MACH_MUL_RR,
+                        MACH_AND_RR, MACH_OR_RR, MACH_XOR_RR
+                    };
+                    ok = mach_load_slot(stream, ENC_AX, inst->a) &&
+                         mach_load_slot(stream, ENC_CX, inst->b) &&
+                         mach_rr(stream, alu_map[inst->opcode - IR_ADD],
+                                 ENC_AX, ENC_CX) &&
+                         mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+                }
+
+                case IR_DIV:
+                case IR_MOD:
+                    // Quotient lands in ax, remainder in dx
+                    ok = mach_load_slot(stream, ENC_AX, inst->a) &&
+                         mach_load_slot(stream, ENC_CX, inst->b) &&
+                         mach_rr(stream, MACH_DIV_R, 0, ENC_CX);
+                    if (ok && inst->opcode == IR_MOD) {
+                        ok = mach_rr(stream, MACH_MOV_RR, ENC_AX, ENC_DX);
+                    }
+                    if (ok) ok = mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+
+                case IR_NEG:
+                    ok = mach_load_slot(stream, ENC_AX, inst->a) &&
+                         mach_rr(stream, MACH_NEG_R, ENC_AX, 0) &&
+                         mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+
+                case IR_NOT:
+                    // Logical not: a zero value becomes 1, else 0
+                    ok = mach_load_slot(stream, ENC_AX, inst->a) &&
+                         mach_rr(stream, MACH_TEST_RR, ENC_AX, ENC_AX) &&
+                         mach(stream, (MachInstruction){
+                                 .opcode = MACH_SETCC_R, .dst = ENC_AX,
+                                 .condition = COND_EQ }) &&
+                         mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+
+                case IR_CMP_EQ:
+                case IR_CMP_NE:
+                case IR_CMP_LT:
+                case IR_CMP_LE:
+                case IR_CMP_GT:
+                case IR_CMP_GE:
+                    // MachCondition mirrors the IR comparison order
+                    ok = mach_load_slot(stream, ENC_AX, inst->a) &&
+                         mach_load_slot(stream, ENC_CX, inst->b) &&
+                         mach_rr(stream, MACH_CMP_RR, ENC_AX, ENC_CX) &&
+                         mach(stream, (MachInstruction){
+                                 .opcode = MACH_SETCC_R, .dst = ENC_AX,
+                                 .condition = (MachCondition)
+                                     (inst->opcode - IR_CMP_EQ) }) &&
+                         mach_store_slot(stream, ENC_AX, inst->dest);
+                    break;
+
+                case IR_JUMP:
+                    ok = mach_jump(stream, MACH_JMP, COND_EQ, (int)inst->b);
+                    break;
+
+                case IR_BRANCH:
+                    // test ax, ax; jnz true-block; jmp false-block
+                    ok = mach_load_slot(stream, ENC_AX, inst->a) &&
+                         mach_rr(stream, MACH_TEST_RR, ENC_AX, ENC_AX) &&
+                         mach_jump(stream, MACH_JCC, COND_NE, (int)inst->b) &&
+                         mach_jump(stream, MACH_JMP, COND_EQ, (int)inst->c);
+                    break;
+
+                case IR_ARG:
+                    if (pending_count == JIT_MAX_PENDING_ARGS) {
+                        ERROR_CODEGEN_ERROR(function->name, 0, 0,
+                                           "Too many outstanding call arguments",
+                                           "Simplify the call expression");
+                        ok = false;
+                        break;
+                    }
+                    pending_args[pending_count++] = inst->a;
+                    break;
+
+                case IR_CALL: {
+                    uint32_t argument_count = inst->a;
+                    if (argument_count > JIT_MAX_ARGUMENTS ||
+                        argument_count > pending_count) {
+                        ERROR_CODEGEN_ERROR(function->name, 0, 0,
+                                           "Call has more than 6 arguments",
+                                           "The JIT passes arguments in registers only");
+                        ok = false;
+                        break;
+                    }
+
+                    // The innermost call consumes the newest arguments
+                    uint32_t first = pending_count - argument_count;
+                    for (uint32_t a = 0; ok && a < argument_count; a++) {
+                        ok = mach_load_slot(stream, argument_registers[a],
+                                            pending_args[first + a]);
+                    }
+                    pending_count = first;
+                    if (!ok) break;
+
+                    uint32_t callee = find_function(program, inst->b);
+                    if (callee != IR_NO_OPERAND) {
+                        ok = mach(stream, (MachInstruction){
+                                      .opcode = MACH_CALL,
+                                      .label = (int)callee });
+                    } else {
+                        // External: resolve against the host process.
+                        // al must be zero in case the callee is variadic
+                        const char* name = inst->b < program->name_count
+                                               ? program->names[inst->b] : "";
+                        void* address = dlsym(RTLD_DEFAULT, name);
+                        if (!address) {
+                            ERROR_CODEGEN_ERROR(name[0] ? name : function->name,
+                                               0, 0,
+                                               "Cannot resolve external function in the host process",
+                                               "Check the екстерно declaration against the host's symbols");
+                            ok = false;
+                            break;
+                        }
+                        ok = mach_imm(stream, MACH_MOV_RI, ENC_AX, 0) &&
+                             mach_imm(stream, MACH_MOV_RI, ENC_R10,
+                                      (intptr_t)(uintptr_t)address) &&
+                             mach_rr(stream, MACH_CALL_REG, 0, ENC_R10);
+                    }
+                    if (ok && inst->dest != IR_NO_OPERAND) {
+                        ok = mach_store_slot(stream, ENC_AX, inst->dest);
+                    }
+                    break;
+                }
+
+                case IR_RETURN:
+                    if (inst->a != IR_NO_OPERAND) {
+                        ok = mach_load_slot(stream, ENC_AX, inst->a);
+                    } else {
+                        ok = mach_imm(stream, MACH_MOV_RI, ENC_AX, 0);
+                    }
+                    if (ok) ok = mach_epilogue(stream);
+                    break;
+
+                default:
+                    ERROR_CODEGEN_ERROR(function->name, 0, 0,
+                                       "IR opcode not supported by the JIT",
+                                       "This is an internal compiler inconsistency");
+                    ok = false;
+                    break;
+            }
+        }
+    }
+
+    // A function whose last block is not terminated still has to
+    // return to its caller
+    if (ok) {
+        ok = mach_imm(stream, MACH_MOV_RI, ENC_AX, 0) &&
+             mach_epilogue(stream);
+    }
+    return ok;
+}
+
+/**
+ * Encode the optimized stream through encoder.h. Label offsets are
+ * recorded as they are reached and jumps patched afterwards; calls
+ * are left as fixups for jit_run_program
+ */
+static bool encode_stream(JitBuffer* buffer, const IrFunction* function,
+                          const MachStream* stream) {
+    EmitBuffer* out = &buffer->code;
+
+    // Conditions in MachCondition order (EQ NE LT LE GT GE)
+    static const EncoderCondition condition_map[] = {
+        ENC_CONDITION_EQUAL, ENC_CONDITION_NOT_EQUAL,
+        ENC_CONDITION_LESS, ENC_CONDITION_LESS_EQUAL,
+        ENC_CONDITION_GREATER, ENC_CONDITION_GREATER_EQUAL
+    };
+
+    size_t* block_offsets = calloc(function->block_count
+                                       ? function->block_count : 1,
+                                   sizeof(size_t));
+    struct { size_t offset; int block; }* jump_fixups =
+        malloc((stream->count ? stream->count : 1) * sizeof(*jump_fixups));
+    uint32_t jump_fixup_count = 0;
+    bool ok = (block_offsets != NULL && jump_fixups != NULL);
+
+    for (uint32_t i = 0; ok && i < stream->count; i++) {
+        const MachInstruction* inst = &stream->code[i];
+        EncoderRegister dst = (EncoderRegister)inst->dst;
+        EncoderRegister src = (EncoderRegister)inst->src;
+
+        switch (inst->opcode) {
+            case MACH_NOP:
+                break;
+
+            case MACH_MOV_RR:
+                ok = encoder_move(out, dst, src);
+                break;
+            case MACH_MOV_RI:
+                ok = encoder_load_const(out, dst, inst->imm);
+                break;
+
+            case MACH_ADD_RR:
+                ok = encoder_arithmetic(out, ENC_ALU_ADD, dst, src);
+                break;
+            case MACH_SUB_RR:
+                ok = encoder_arithmetic(out, ENC_ALU_SUB, dst, src);
+                break;
+            case MACH_AND_RR:
+                ok = encoder_arithmetic(out, ENC_ALU_AND, dst, src);
+                break;
+            case MACH_OR_RR:
+                ok = encoder_arithmetic(out, ENC_ALU_OR, dst, src);
+                break;
+            case MACH_XOR_RR:
+                ok = encoder_arithmetic(out, ENC_ALU_XOR, dst, src);
+                break;
+            case MACH_ADD_RI:
+                ok = encoder_arithmetic_imm(out, ENC_ALU_ADD, dst,
+                                            (int32_t)inst->imm);
+                break;
+            case MACH_SUB_RI:
+                ok = encoder_arithmetic_imm(out, ENC_ALU_SUB, dst,
+                                            (int32_t)inst->imm);
+                break;
+            case MACH_MUL_RR:
+                ok = encoder_multiply(out, dst, src);
+                break;
+            case MACH_DIV_R:
+                ok = encoder_divide(out, src);
+                break;
+            case MACH_NEG_R:
+                ok = encoder_negate(out, dst);
+                break;
+            case MACH_INC_R:
+                ok = encoder_increment(out, dst);
+                break;
+            case MACH_DEC_R:
+                ok = encoder_decrement(out, dst);
+                break;
+
+            case MACH_LOAD_SLOT:
+                ok = encoder_load_slot(out, dst, (uint32_t)inst->imm);
+                break;
+            case MACH_STORE_SLOT:
+                ok = encoder_store_slot(out, src, (uint32_t)inst->imm);
+                break;
+            case MACH_LEA_FRAME:
+                ok = encoder_load_address(out, dst, (int32_t)inst->imm);
+                break;
+            case MACH_LOAD_INDEXED:
+                ok = encoder_load_indexed(out, dst, src,
+                                          (EncoderRegister)inst->imm);
+                break;
+            case MACH_STORE_INDEXED:
+                ok = encoder_store_indexed(out, src, dst,
+                                           (EncoderRegister)inst->imm);
+                break;
+
+            case MACH_CMP_RR:
+                ok = encoder_arithmetic(out, ENC_ALU_CMP, dst, src);
+                break;
+            case MACH_CMP_RI:
+                ok = encoder_arithmetic_imm(out, ENC_ALU_CMP, dst,
+                                            (int32_t)inst->imm);
+                break;
+            case MACH_TEST_RR:
+                ok = encoder_test(out, dst, src);
+                break;
+            case MACH_SETCC_R:
+                ok = encoder_set_condition(out,
+                                           condition_map[inst->condition],
+                                           dst);
+                break;
+
+            case MACH_JMP:
+            case MACH_JCC: {
+                size_t at = inst->opcode == MACH_JMP
+                                ? encoder_jump(out)
+                                : encoder_jump_condition(
+                                      out, condition_map[inst->condition]);
+                ok = (at != SIZE_MAX);
+                if (!ok) break;
+                jump_fixups[jump_fixup_count].offset = at;
+                jump_fixups[jump_fixup_count].block = inst->label;
+                jump_fixup_count++;
+                break;
+            }
+            case MACH_LABEL:
+                if ((uint32_t)inst->label >= function->block_count) {
+                    ok = false;
+                    break;
+                }
+                block_offsets[inst->label] = out->size;
+                break;
+
+            case MACH_PUSH_R:
+                ok = encoder_push(out, src);
+                break;
+            case MACH_POP_R:
+                ok = encoder_pop(out, dst);
+                break;
+            case MACH_CALL: {
+                // call rel32, patched once the callee is placed
+                size_t at = encoder_call(out);
+                ok = (at != SIZE_MAX) &&
+                     add_call_fixup(buffer, at, (uint32_t)inst->label);
+                break;
+            }
+            case MACH_CALL_REG:
+                ok = encoder_call_register(out, src);
+                break;
+            case MACH_RET:
+                ok = encoder_return(out);
+                break;
+        }
+    }
+
+    // Resolve jumps now that every block's position is known
+    for (uint32_t j = 0; ok && j < jump_fixup_count; j++) {
+        if ((uint32_t)jump_fixups[j].block >= function->block_count) {
+            ok = false;
+            break;
+        }
+        encoder_patch_rel32(out, jump_fixups[j].offset,
+                            block_offsets[jump_fixups[j].block]);
+    }
+
+    free(block_offsets);
+    free(jump_fixups);
+    return ok;
+}
+
+/**
+ * Lower, optimize and encode one function
+ */
+static bool compile_function(JitBuffer* buffer, const IrFunction* function) {
+    MachStream stream;
+    memset(&stream, 0, sizeof(stream));
+
+    bool ok = lower_function(buffer->program, function, &stream);
+    if (ok) {
+        peephole_optimize(stream.code, &stream.count);
+        ok = encode_stream(buffer, function, &stream);
+    }
+
+    free(stream.code);
+    return ok;
+}
+
+bool jit_run_program(const IrProgram* program, intptr_t* result) {
+    if (!program || !result) return false;
+
+    JitBuffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.program = program;
+    buffer.function_offsets = calloc(program->function_count
+                                         ? program->function_count : 1,
+                                     sizeof(size_t));
+    if (!buffer.function_offsets) return false;
+
+    // Compile every function into one contiguous buffer
+    bool ok = true;
+    uint32_t entry = IR_NO_OPERAND;
+    for (uint32_t f = 0; ok && f < program->function_count; f++) {
+        buffer.function_offsets[f] = buffer.code.size;
+        if (strcmp(program->functions[f].name, "главна") == 0) entry = f;
+        ok = compile_function(&buffer, &program->functions[f]);
+    }
+
+    if (ok && entry == IR_NO_OPERAND) {
+        ERROR_CODEGEN_ERROR("главна", 0, 0,
+                           "Program has no главна() function to run",
+                           "Define главна() or compile without --run");
+        ok = false;
+    }
+
+    // Patch the cross-function calls
+    for (uint32_t c = 0; ok && c < buffer.call_fixup_count; c++) {
+        encoder_patch_rel32(&buffer.code, buffer.call_fixups[c].offset,
+                            buffer.function_offsets[buffer.call_fixups[c].function]);
+    }
+
+    // Move the code into executable memory and jump to главна()
+    if (ok) {
+        void* memory = mmap(NULL, buffer.code.size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            ERROR_CODEGEN_ERROR("главна", 0, 0,
+                               "Cannot allocate executable memory for the JIT",
+                               "Check process memory limits");
+            ok = false;
+        } else {
+            memcpy(memory, buffer.code.bytes, buffer.code.size);
+            if (mprotect(memory, buffer.code.size, PROT_READ | PROT_EXEC) != 0) {
+                ERROR_CODEGEN_ERROR("главна", 0, 0,
+                                   "Cannot make the JIT buffer executable",
+                                   "The host may forbid executable mappings (W^X policy)");
+                ok = false;
+            } else {
+                intptr_t (*entry_point)(void) =
+                    (intptr_t (*)(void))((uint8_t*)memory +
+                                         buffer.function_offsets[entry]);
+                *result = entry_point();
+            }
+            munmap(memory, buffer.code.size);
+        }
+    }
+
+    emit_buffer_free(&buffer.code);
+    free(buffer.call_fixups);
+    free(buffer.function_offsets);
+    return ok;
+}
+
+#else /* !ARCH_X86_64 */
+
+bool jit_run_program(const IrProgram* program, intptr_t* result) {
+    (void)program;
+    (void)result;
+    ERROR_CODEGEN_ERROR("главна", 0, 0,
+                       "JIT execution is only supported on x86-64 hosts",
+                       "Compile to an object file instead of using --run");
+    return false;
+}
+
+#endif /* ARCH_X86_64 */
@@ -0,0 +1,46 @@
+/*
+ * filename: jit.h
+ *
+ * Purpose:
+ * In-memory JIT execution for the ћ++ compiler (--run mode). Lowers a
+ * whole IR program straight into an executable buffer and jumps to
+ * главна(), skipping the assembler, linker, and process spawn that a
+ * normal compile-and-exec cycle pays for.
+ *
+ * Key Components:
+ * - jit_run_program(): Compile an IrProgram to memory and execute it
+ *
+ * Interactions:
+ * - Consumes the flat IR from ir/ir.h
+ * - Calls between IR functions are resolved inside the buffer; names
+ *   with no IR definition (екстерно declarations) are resolved against
+ *   the host process with dlsym
+ * - Uses error.h for reporting compilation and resolution problems
+ *
+ * Notes:
+ * - x86-64 hosts only; on other hosts jit_run_program reports an error
+ * - Every virtual register lives in a stack slot, so the generated
+ *   code favours compile speed over execution speed — the target use
+ *   case is running many small test programs
+ * - Calls follow the System V ABI, so host C functions with WORD-sized
+ *   (intptr_t) arguments and results can be called directly
+ */
+
+#ifndef JIT_H
+#define JIT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../ir/ir.h"
+
+/**
+ * Compile an IR program into executable memory and run its главна()
+ * function with no arguments
+ *
+ * @param program The IR program to execute
+ * @param result Receives the return value of главна() on success
+ * @return True when the program was compiled and executed
+ */
+bool jit_run_program(const IrProgram* program, intptr_t* result);
+
+#endif /* JIT_H */
@@ -0,0 +1,183 @@
+/*
+ * filename: peephole.c
+ *
+ * Purpose:
+ * Implementation of the peephole optimizer for the ћ++ compiler backend.
+ * Slides a short window over the machine instruction stream and rewrites
+ * the wasteful sequences that naive three-address lowering produces.
+ *
+ * Key Components:
+ * - peephole_optimize(): Apply all rules to fixpoint, then compact
+ * - rule_* helpers: One recognizer per pattern family
+ * - next_real(): Skip NOPs left behind by earlier rewrites
+ *
+ * Interactions:
+ * - Operates on the MachInstruction stream from peephole.h
+ * - Called by the emitters before the stream is encoded; jit.c runs
+ *   it on every function between lowering and encoding
+ *
+ * Notes:
+ * - Victims become MACH_NOP and one compaction pass at the end closes
+ *   the gaps, the same discipline the IR optimizer uses
+ * - The setcc/test/jcc rule relies on setcc preserving flags: the
+ *   compare's flags are still valid at the jump once the test is gone
+ * - Labels are never removed; an unused label costs nothing in the
+ *   object writer and may be the target of a jump outside the window
+ */
+
+#include "peephole.h"
+
+/**
+ * Index of the next non-NOP instruction at or after i, or count
+ */
+static uint32_t next_real(const MachInstruction* code, uint32_t count, uint32_t i) {
+    while (i < count && code[i].opcode == MACH_NOP) i++;
+    return i;
+}
+
+/**
+ * The condition a jump must take when the tested value was zero
+ */
+static MachCondition condition_negate(MachCondition condition) {
+    switch (condition) {
+        case COND_EQ: return COND_NE;
+        case COND_NE: return COND_EQ;
+        case COND_LT: return COND_GE;
+        case COND_LE: return COND_GT;
+        case COND_GT: return COND_LE;
+        case COND_GE: return COND_LT;
+    }
+    return COND_NE;
+}
+
+/**
+ * Delete self moves and no-op arithmetic, shrink add/sub by one
+ */
+static bool rule_single(MachInstruction* inst) {
+    switch (inst->opcode) {
+        case MACH_MOV_RR:
+            if (inst->dst == inst->src) { inst->opcode = MACH_NOP; return true; }
+            return false;
+        case MACH_ADD_RI:
+        case MACH_SUB_RI:
+            if (inst->imm == 0) { inst->opcode = MACH_NOP; return true; }
+            if (inst->imm == 1) {
+                inst->opcode = inst->opcode == MACH_ADD_RI ? MACH_INC_R
+                                                           : MACH_DEC_R;
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+/**
+ * A slot store immediately reloaded re-reads a value that is still in
+ * a register. The store stays, because the slot may be read again
+ * later; the reload becomes a register move, or disappears entirely
+ * when it targets the register that was just stored
+ */
+static bool rule_store_load_slot(MachInstruction* code, uint32_t count, uint32_t i) {
+    if (code[i].opcode != MACH_STORE_SLOT) return false;
+    uint32_t l = next_real(code, count, i + 1);
+    if (l >= count || code[l].opcode != MACH_LOAD_SLOT) return false;
+    if (code[l].imm != code[i].imm) return false;
+
+    if (code[l].dst == code[i].src) {
+        code[l].opcode = MACH_NOP;
+    } else {
+        code[l].opcode = MACH_MOV_RR;
+        code[l].src = code[i].src;
+    }
+    return true;
+}
+
+/**
+ * setcc t / test t, t / jcc: the test re-derives flags the compare
+ * already produced, so drop it and jump on the setcc condition (or its
+ * negation when the jump looked for zero). The setcc itself stays in
+ * case its result is read later; a spill of t between the setcc and
+ * the test touches neither the flags nor t, so it is looked past
+ */
+static bool rule_set_test_jump(MachInstruction* code, uint32_t count, uint32_t i) {
+    if (code[i].opcode != MACH_SETCC_R) return false;
+    uint32_t t = next_real(code, count, i + 1);
+    if (t < count && code[t].opcode == MACH_STORE_SLOT &&
+        code[t].src == code[i].dst) {
+        t = next_real(code, count, t + 1);
+    }
+    if (t >= count || code[t].opcode != MACH_TEST_RR) return false;
+    if (code[t].dst != code[i].dst || code[t].src != code[i].dst) return false;
+    uint32_t j = next_real(code, count, t + 1);
+    if (j >= count || code[j].opcode != MACH_JCC) return false;
+    if (code[j].condition != COND_NE && code[j].condition != COND_EQ) return false;
+
+    code[j].condition = code[j].condition == COND_NE
+                            ? code[i].condition
+                            : condition_negate(code[i].condition);
+    code[t].opcode = MACH_NOP;
+    return true;
+}
+
+/**
+ * push a / pop a cancels out; push a / pop b is a roundabout move
+ */
+static bool rule_push_pop(MachInstruction* code, uint32_t count, uint32_t i) {
+    if (code[i].opcode != MACH_PUSH_R) return false;
+    uint32_t p = next_real(code, count, i + 1);
+    if (p >= count || code[p].opcode != MACH_POP_R) return false;
+
+    if (code[p].dst == code[i].src) {
+        code[i].opcode = MACH_NOP;
+        code[p].opcode = MACH_NOP;
+    } else {
+        code[p].opcode = MACH_MOV_RR;
+        code[p].src = code[i].src;
+        code[i].opcode = MACH_NOP;
+    }
+    return true;
+}
+
+/**
+ * A jump to the label that immediately follows it falls through anyway
+ */
+static bool rule_jump_next(MachInstruction* code, uint32_t count, uint32_t i) {
+    if (code[i].opcode != MACH_JMP && code[i].opcode != MACH_JCC) return false;
+    uint32_t l = next_real(code, count, i + 1);
+    if (l >= count || code[l].opcode != MACH_LABEL) return false;
+    if (code[l].label != code[i].label) return false;
+    code[i].opcode = MACH_NOP;
+    return true;
+}
+
+int peephole_optimize(MachInstruction* code, uint32_t* count) {
+    if (!code || !count) return 0;
+
+    int rewrites = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint32_t i = 0; i < *count; i++) {
+            if (code[i].opcode == MACH_NOP) continue;
+            if (rule_single(&code[i]) ||
+                rule_store_load_slot(code, *count, i) ||
+                rule_set_test_jump(code, *count, i) ||
+                rule_push_pop(code, *count, i) ||
+                rule_jump_next(code, *count, i)) {
+                rewrites++;
+                changed = true;
+            }
+        }
+    }
+
+    // Close the gaps the rules left behind
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < *count; i++) {
+        if (code[i].opcode == MACH_NOP) continue;
+        if (kept != i) code[kept] = code[i];
+        kept++;
+    }
+    *count = kept;
+    return rewrites;
+}
@@ -0,0 +1,127 @@
+/*
+ * filename: peephole.h
+ *
+ * Purpose:
+ * Header file for the peephole optimizer of the ћ++ compiler backend.
+ * Defines the machine instruction stream the emitters produce before
+ * encoding, and a windowed pass that rewrites short wasteful
+ * sequences in that stream.
+ *
+ * Key Components:
+ * - MachOpcode enum: Machine-level instruction forms shared by the
+ *   emitters
+ * - MachCondition enum: Condition codes for setcc and conditional jumps
+ * - MachInstruction struct: One machine instruction before encoding
+ * - peephole_optimize(): Rewrite the stream in place
+ *
+ * Interactions:
+ * - Sits between the instruction emitters and the encoder: jit.c
+ *   lowers IR into this stream, runs the pass, and encodes the
+ *   surviving instructions through encoder.h
+ * - Registers are plain numbers, so the pass is word-size agnostic
+ *
+ * Notes:
+ * - Naive lowering through frame slots produces exactly the patterns
+ *   handled here: self moves, slot stores immediately reloaded,
+ *   add/sub by one, compare-setcc-test-jump chains, and push/pop
+ *   traffic around calls
+ * - Rewrites mark victims as MACH_NOP and the stream is compacted once
+ *   at the end, mirroring the IR optimizer's NOP-then-compact scheme
+ * - Every rule is sound without liveness information; setcc results
+ *   and slot stores are kept alive and only redundant re-reads are
+ *   removed
+ */
+
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Machine-level instruction forms. RR = register/register,
+// RI = register/immediate
+typedef enum {
+    MACH_NOP,        // Removed by compaction
+
+    MACH_MOV_RR,     // dst = src
+    MACH_MOV_RI,     // dst = imm
+
+    MACH_ADD_RR,     // dst += src
+    MACH_ADD_RI,     // dst += imm
+    MACH_SUB_RR,     // dst -= src
+    MACH_SUB_RI,     // dst -= imm
+    MACH_AND_RR,     // dst &= src
+    MACH_OR_RR,      // dst |= src
+    MACH_XOR_RR,     // dst ^= src
+    MACH_MUL_RR,     // dst *= src (signed)
+    MACH_DIV_R,      // Sign-extend ax and divide the pair by src;
+                     // quotient lands in ax, remainder in dx
+    MACH_NEG_R,      // dst = -dst
+    MACH_INC_R,      // dst += 1 (shorter encoding than add)
+    MACH_DEC_R,      // dst -= 1
+
+    MACH_LOAD_SLOT,  // dst = frame slot imm
+    MACH_STORE_SLOT, // frame slot imm = src
+    MACH_LEA_FRAME,  // dst = frame pointer + displacement imm
+    MACH_LOAD_INDEXED,  // dst = [src + index * WORD], index reg in imm
+    MACH_STORE_INDEXED, // [dst + index * WORD] = src, index reg in imm
+
+    MACH_CMP_RR,     // flags = dst - src
+    MACH_CMP_RI,     // flags = dst - imm
+    MACH_TEST_RR,    // flags = dst & src
+    MACH_SETCC_R,    // dst = condition ? 1 : 0 (flags preserved)
+
+    MACH_JMP,        // jump to label
+    MACH_JCC,        // jump to label when condition holds
+    MACH_LABEL,      // branch target, label names this point
+
+    MACH_PUSH_R,     // push src
+    MACH_POP_R,      // pop into dst
+    MACH_CALL,       // call, label indexes the callee
+    MACH_CALL_REG,   // call through the address in src
+    MACH_RET         // return
+} MachOpcode;
+
+// Condition codes, shared by MACH_SETCC_R and MACH_JCC
+typedef enum {
+    COND_EQ, COND_NE, COND_LT, COND_LE, COND_GT, COND_GE
+} MachCondition;
+
+// One machine instruction before encoding. Registers are numbers from
+// the owning backend's register enum; imm doubles as the slot index,
+// frame displacement or index register of the memory forms; label is
+// a branch target id or, for MACH_CALL, an index naming the callee
+typedef struct {
+    MachOpcode opcode;
+    int dst;             // Destination register
+    int src;             // Source register
+    intptr_t imm;        // Immediate, slot, displacement or index
+    MachCondition condition;
+    int label;           // Branch target or callee index
+} MachInstruction;
+
+/**
+ * Run the windowed peephole pass over an instruction stream, in place.
+ * Rules are applied to fixpoint and the stream is compacted before
+ * returning, so count shrinks but instructions never move apart
+ *
+ * Handled patterns:
+ * - mov r, r and add/sub r, 0 are deleted
+ * - add/sub r, 1 become inc/dec
+ * - a slot store immediately reloaded forwards the stored register:
+ *   the store stays, the reload becomes a move or disappears
+ * - setcc t / test t, t / jcc becomes setcc t / jcc on the original
+ *   condition (the re-test of a fresh flag value is redundant); a
+ *   spill of t between the setcc and the test is looked past, since
+ *   it touches neither the flags nor t
+ * - push a / pop a is deleted, push a / pop b becomes mov b, a
+ * - a jump to the label that immediately follows it is deleted
+ *
+ * @param code The instruction stream
+ * @param count In: instructions in the stream; out: instructions kept
+ * @return The number of rewrites performed
+ */
+int peephole_optimize(MachInstruction* code, uint32_t* count);
+
+#endif /* PEEPHOLE_H */
@@ -20,6 +20,9 @@
  * - Handles x86 specific registers (eax, ebx, ecx, etc.)
  * - Implements cdecl calling convention
  * - 32-bit word size for all operations
+ * - Instruction encoding lives in the shared encoder.h, which the
+ *   ARCH_X86 flag specializes to this word size at build time; this
+ *   header keeps only the 32-bit calling-convention specifics
  */
 
 #ifndef X86_H
@@ -1,28 +1,389 @@
 /*
  * filename: x86_64.c
- * 
+ *
  * Purpose:
  * Implementation of x86-64 specific code generation for the ћ++ compiler.
- * Contains functions to translate IR instructions into x86-64 assembly code.
- * 
+ * Currently provides the register allocator: live intervals are computed
+ * from a function's flat IR and hardware registers are assigned by linear
+ * scan, so most values never touch the stack.
+ *
  * Key Components:
- * - x86_64_codegen_init(): Initialize the x86-64 code generator
- * - x86_64_generate_instruction(): Convert IR instruction to x86-64 assembly
- * - x86_64_allocate_registers(): Perform register allocation
- * - x86_64_generate_function_prologue(): Set up stack frame and saved registers
- * - x86_64_generate_function_epilogue(): Clean up stack frame and restore registers
- * - x86_64_handle_function_call(): Implement function calling sequence
- * 
+ * - x86_64_compute_intervals(): Live intervals in one pass over the buffer
+ * - x86_64_allocate_registers(): Linear scan over the sorted intervals
+ * - x86_64_allocation_free(): Release an allocation result
+ * - x86_64_get_register_name(): Convert register enum to string representation
+ *
  * Interactions:
  * - Implements architecture-specific part of codegen.h interface
+ * - Consumes the flat IR from ir/ir.h
  * - Uses target_info.h for architecture information
- * 
+ *
  * Notes:
- * - Uses 64-bit registers (rax, rbx, etc.)
- * - Implements System V AMD64 calling convention
- * - Optimizes register usage based on instruction patterns
- * - Special handling for array access and operations
+ * - Implements System V AMD64 calling convention register classes:
+ *   rcx, rdx, rsi, rdi, r8-r11 are caller-saved, rbx and r12-r15 are
+ *   callee-saved; rsp/rbp frame the stack and rax is kept for returns
+ * - Intervals that are live across an IR_CALL are given callee-saved
+ *   registers so calls do not force reloads of loop variables
+ * - When no register is free the interval that ends furthest away is
+ *   spilled, which keeps short-lived temporaries in registers
+ * - Live ranges are extended over loop back edges: a variable that
+ *   enters a loop and is rewritten inside it stays live for the whole
+ *   loop, so the value carried around the back edge keeps its register
  */
 
 #include "x86_64.h"
-// Other includes will go here
\ No newline at end of file
+#include <stdlib.h>
+#include <string.h>
+
+// Caller-saved pool, tried first for values that do not cross a call
+static const X86_64Register caller_saved[] = {
+    X86_64_RCX, X86_64_RDX, X86_64_RSI, X86_64_RDI,
+    X86_64_R8,  X86_64_R9,  X86_64_R10, X86_64_R11
+};
+#define CALLER_SAVED_COUNT (sizeof(caller_saved) / sizeof(caller_saved[0]))
+
+// Callee-saved pool, reserved primarily for call-crossing values
+static const X86_64Register callee_saved[] = {
+    X86_64_RBX, X86_64_R12, X86_64_R13, X86_64_R14, X86_64_R15
+};
+#define CALLEE_SAVED_COUNT (sizeof(callee_saved) / sizeof(callee_saved[0]))
+
+/**
+ * Does this instruction define its dest register? IR_STORE_ARRAY reads
+ * dest (the stored value) and IR_RETURN/jumps have no dest at all
+ */
+static bool defines_dest(const IrInstruction* inst) {
+    if (inst->dest == IR_NO_OPERAND) return false;
+    switch (inst->opcode) {
+        case IR_STORE_ARRAY:
+        case IR_JUMP:
+        case IR_BRANCH:
+        case IR_ARG:
+        case IR_RETURN:
+        case IR_NOP:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/**
+ * Collect the virtual registers an instruction reads. Block numbers,
+ * pool indices and argument counts are not registers and never appear
+ *
+ * @return The number of registers written into uses
+ */
+static int collect_uses(const IrInstruction* inst, uint32_t uses[3]) {
+    switch (inst->opcode) {
+        case IR_MOVE:
+        case IR_NEG:
+        case IR_NOT:
+            uses[0] = inst->a;
+            return 1;
+        case IR_LOAD_ARRAY:
+        case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+        case IR_AND: case IR_OR: case IR_XOR:
+        case IR_CMP_EQ: case IR_CMP_NE: case IR_CMP_LT:
+        case IR_CMP_LE: case IR_CMP_GT: case IR_CMP_GE:
+            uses[0] = inst->a;
+            uses[1] = inst->b;
+            return 2;
+        case IR_STORE_ARRAY:
+            uses[0] = inst->dest;
+            uses[1] = inst->a;
+            uses[2] = inst->b;
+            return 3;
+        case IR_BRANCH:
+        case IR_ARG:
+            uses[0] = inst->a;
+            return 1;
+        case IR_RETURN:
+            if (inst->a == IR_NO_OPERAND) return 0;
+            uses[0] = inst->a;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * qsort comparator ordering intervals by start index
+ */
+static int interval_compare(const void* left, const void* right) {
+    const LiveInterval* a = (const LiveInterval*)left;
+    const LiveInterval* b = (const LiveInterval*)right;
+    if (a->start != b->start) return a->start < b->start ? -1 : 1;
+    return a->vreg < b->vreg ? -1 : (a->vreg > b->vreg ? 1 : 0);
+}
+
+bool x86_64_compute_intervals(const IrFunction* fn, LiveInterval** intervals_out,
+                              uint32_t* count_out) {
+    if (!fn || !intervals_out || !count_out) return false;
+
+    uint32_t n = fn->value_count;
+    uint32_t* start = malloc(n * sizeof(uint32_t));
+    uint32_t* end = malloc(n * sizeof(uint32_t));
+    bool* seen = calloc(n, sizeof(bool));
+    if ((n > 0 && (!start || !end || !seen))) {
+        free(start); free(end); free(seen);
+        return false;
+    }
+
+    // Parameters occupy vregs 0..parameter_count-1 and are live from
+    // the top of the function
+    for (int p = 0; p < fn->parameter_count; p++) {
+        seen[p] = true;
+        start[p] = 0;
+        end[p] = 0;
+    }
+
+    // One linear pass: first definition opens a range, every use
+    // (and redefinition) pushes its end forward
+    for (uint32_t i = 0; i < fn->instruction_count; i++) {
+        const IrInstruction* inst = &fn->instructions[i];
+        uint32_t uses[3];
+        int use_count = collect_uses(inst, uses);
+        for (int u = 0; u < use_count; u++) {
+            uint32_t v = uses[u];
+            if (v >= n) continue;
+            if (!seen[v]) { seen[v] = true; start[v] = i; }
+            end[v] = i;
+        }
+        if (defines_dest(inst) && inst->dest < n) {
+            uint32_t v = inst->dest;
+            if (!seen[v]) { seen[v] = true; start[v] = i; }
+            end[v] = i;
+        }
+    }
+
+    // Extend over loop back edges: a latch is a block whose terminator
+    // jumps to an earlier block. Any value that enters the loop from
+    // outside and dies inside it is in fact carried around the back
+    // edge, so its range grows to cover the whole loop. Repeated until
+    // stable so nested loops compose
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint32_t l = 0; l < fn->block_count; l++) {
+            const IrBasicBlock* latch = &fn->blocks[l];
+            if (latch->count == 0) continue;
+            const IrInstruction* term =
+                &fn->instructions[latch->first + latch->count - 1];
+            uint32_t header = IR_NO_OPERAND;
+            if (term->opcode == IR_JUMP && term->b <= l) header = term->b;
+            if (term->opcode == IR_BRANCH) {
+                if (term->b <= l) header = term->b;
+                if (term->c <= l && (header == IR_NO_OPERAND || term->c < header))
+                    header = term->c;
+            }
+            if (header == IR_NO_OPERAND) continue;
+
+            uint32_t loop_start = fn->blocks[header].first;
+            uint32_t loop_end = latch->first + latch->count - 1;
+            for (uint32_t v = 0; v < n; v++) {
+                if (!seen[v]) continue;
+                if (start[v] < loop_start && end[v] >= loop_start &&
+                    end[v] < loop_end) {
+                    end[v] = loop_end;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    uint32_t count = 0;
+    for (uint32_t v = 0; v < n; v++) {
+        if (seen[v]) count++;
+    }
+
+    LiveInterval* intervals = malloc(count > 0 ? count * sizeof(LiveInterval)
+                                               : sizeof(LiveInterval));
+    if (!intervals) {
+        free(start); free(end); free(seen);
+        return false;
+    }
+
+    uint32_t out = 0;
+    for (uint32_t v = 0; v < n; v++) {
+        if (!seen[v]) continue;
+        intervals[out].vreg = v;
+        intervals[out].start = start[v];
+        intervals[out].end = end[v];
+        intervals[out].crosses_call = false;
+        out++;
+    }
+
+    // A range that straddles a call site must survive the call
+    for (uint32_t i = 0; i < fn->instruction_count; i++) {
+        if (fn->instructions[i].opcode != IR_CALL) continue;
+        for (uint32_t k = 0; k < count; k++) {
+            if (intervals[k].start < i && intervals[k].end > i)
+                intervals[k].crosses_call = true;
+        }
+    }
+
+    qsort(intervals, count, sizeof(LiveInterval), interval_compare);
+
+    free(start); free(end); free(seen);
+    *intervals_out = intervals;
+    *count_out = count;
+    return true;
+}
+
+/**
+ * Pick a free register from a pool, or X86_64_NO_REGISTER
+ */
+static int take_free_register(bool* in_use, const X86_64Register* pool,
+                              size_t pool_count) {
+    for (size_t i = 0; i < pool_count; i++) {
+        if (!in_use[pool[i]]) {
+            in_use[pool[i]] = true;
+            return pool[i];
+        }
+    }
+    return X86_64_NO_REGISTER;
+}
+
+/**
+ * Is a register acceptable for an interval? Call-crossing values may
+ * only live in callee-saved registers
+ */
+static bool register_acceptable(int reg, bool crosses_call) {
+    if (!crosses_call) return true;
+    for (size_t i = 0; i < CALLEE_SAVED_COUNT; i++) {
+        if ((int)callee_saved[i] == reg) return true;
+    }
+    return false;
+}
+
+bool x86_64_allocate_registers(const IrFunction* fn,
+                               X86_64Allocation* allocation_out) {
+    if (!fn || !allocation_out) return false;
+
+    LiveInterval* intervals = NULL;
+    uint32_t interval_count = 0;
+    if (!x86_64_compute_intervals(fn, &intervals, &interval_count)) return false;
+
+    uint32_t n = fn->value_count;
+    int8_t* reg_of = malloc(n > 0 ? n * sizeof(int8_t) : 1);
+    int32_t* slot_of = malloc(n > 0 ? n * sizeof(int32_t) : 4);
+    // Active list: indices into intervals, kept sorted by end
+    uint32_t* active = malloc(interval_count > 0
+                                  ? interval_count * sizeof(uint32_t)
+                                  : sizeof(uint32_t));
+    if (!reg_of || !slot_of || !active) {
+        free(reg_of); free(slot_of); free(active); free(intervals);
+        return false;
+    }
+    for (uint32_t v = 0; v < n; v++) {
+        reg_of[v] = X86_64_NO_REGISTER;
+        slot_of[v] = -1;
+    }
+
+    bool in_use[X86_64_REGISTER_COUNT] = {false};
+    in_use[X86_64_RAX] = true;   // Return value and scratch
+    in_use[X86_64_RSP] = true;   // Stack pointer
+    in_use[X86_64_RBP] = true;   // Frame pointer
+
+    uint32_t active_count = 0;
+    uint32_t spill_count = 0;
+
+    for (uint32_t i = 0; i < interval_count; i++) {
+        LiveInterval* current = &intervals[i];
+
+        // Expire intervals that ended before this one starts
+        uint32_t kept = 0;
+        for (uint32_t k = 0; k < active_count; k++) {
+            LiveInterval* act = &intervals[active[k]];
+            if (act->end < current->start) {
+                in_use[(int)reg_of[act->vreg]] = false;
+            } else {
+                active[kept++] = active[k];
+            }
+        }
+        active_count = kept;
+
+        // Call-crossing values go to the callee-saved pool; the rest
+        // prefer caller-saved and overflow into callee-saved
+        int reg;
+        if (current->crosses_call) {
+            reg = take_free_register(in_use, callee_saved, CALLEE_SAVED_COUNT);
+        } else {
+            reg = take_free_register(in_use, caller_saved, CALLER_SAVED_COUNT);
+            if (reg == X86_64_NO_REGISTER)
+                reg = take_free_register(in_use, callee_saved,
+                                         CALLEE_SAVED_COUNT);
+        }
+
+        uint32_t changed_pos;
+        if (reg == X86_64_NO_REGISTER) {
+            // Spill whichever acceptable interval ends furthest away:
+            // the current one, or an active holder whose register the
+            // current interval may take over
+            uint32_t victim_slot = IR_NO_OPERAND;
+            for (uint32_t k = 0; k < active_count; k++) {
+                LiveInterval* act = &intervals[active[k]];
+                if (!register_acceptable(reg_of[act->vreg],
+                                         current->crosses_call))
+                    continue;
+                if (victim_slot == IR_NO_OPERAND ||
+                    act->end > intervals[active[victim_slot]].end)
+                    victim_slot = k;
+            }
+
+            if (victim_slot != IR_NO_OPERAND &&
+                intervals[active[victim_slot]].end > current->end) {
+                LiveInterval* victim = &intervals[active[victim_slot]];
+                reg_of[current->vreg] = reg_of[victim->vreg];
+                reg_of[victim->vreg] = X86_64_NO_REGISTER;
+                slot_of[victim->vreg] = (int32_t)spill_count++;
+                active[victim_slot] = i;
+                changed_pos = victim_slot;
+            } else {
+                slot_of[current->vreg] = (int32_t)spill_count++;
+                continue;
+            }
+        } else {
+            reg_of[current->vreg] = (int8_t)reg;
+            active[active_count++] = i;
+            changed_pos = active_count - 1;
+        }
+
+        // Keep the active list sorted by end so expiry scans stay short
+        for (uint32_t k = changed_pos; k > 0; k--) {
+            if (intervals[active[k]].end >= intervals[active[k - 1]].end)
+                break;
+            uint32_t tmp = active[k];
+            active[k] = active[k - 1];
+            active[k - 1] = tmp;
+        }
+    }
+
+    free(active);
+    free(intervals);
+
+    allocation_out->reg_of = reg_of;
+    allocation_out->slot_of = slot_of;
+    allocation_out->spill_count = spill_count;
+    allocation_out->value_count = n;
+    return true;
+}
+
+void x86_64_allocation_free(X86_64Allocation* allocation) {
+    if (!allocation) return;
+    free(allocation->reg_of);
+    free(allocation->slot_of);
+    allocation->reg_of = NULL;
+    allocation->slot_of = NULL;
+    allocation->spill_count = 0;
+    allocation->value_count = 0;
+}
+
+const char* x86_64_get_register_name(X86_64Register reg) {
+    static const char* names[X86_64_REGISTER_COUNT] = {
+        "rax", "rbx", "rcx", "rdx", "rsi", "rdi", "rbp", "rsp",
+        "r8",  "r9",  "r10", "r11", "r12", "r13", "r14", "r15"
+    };
+    if (reg < 0 || reg >= X86_64_REGISTER_COUNT) return "???";
+    return names[reg];
+}
@@ -1,30 +1,113 @@
 /*
  * filename: x86_64.h
- * 
+ *
  * Purpose:
  * Header file for x86-64 specific code generation in the ћ++ compiler.
  * Defines constants, structures, and functions specific to generating
  * 64-bit x86 assembly code.
- * 
+ *
  * Key Components:
- * - X86_64_Register enum: Defines available registers on x86-64
- * - x86_64_codegen_init(): Initialize x86-64 specific code generator
+ * - X86_64Register enum: Defines available registers on x86-64
+ * - LiveInterval struct: One virtual register's live range in the flat IR
+ * - X86_64Allocation struct: The result of register allocation
+ * - x86_64_compute_intervals(): Live intervals from a function's IR
+ * - x86_64_allocate_registers(): Linear-scan allocation over the intervals
  * - x86_64_get_register_name(): Convert register enum to string representation
- * - x86_64_calling_convention: Information about parameter passing and return values
- * 
+ *
  * Interactions:
  * - Used by codegen.c to implement architecture-specific code generation
+ * - Consumes the flat IR from ir/ir.h
  * - Uses target_info.h for general architecture information
- * 
+ *
  * Notes:
  * - Handles x86-64 specific registers (rax, rbx, rcx, etc.)
  * - Implements System V AMD64 ABI calling convention
- * - 64-bit word size for all operations
+ * - 64-bit word size for all operations; every ћ++ value is WORD-sized,
+ *   so there is a single register class and allocation is linear-scan
+ *   over live intervals rather than spill-everything-to-stack
+ * - Values live across a call are placed in callee-saved registers so
+ *   calls do not force reloads of loop variables
  */
 
 #ifndef X86_64_H
 #define X86_64_H
 
-// Header content will be implemented later
+#include <stdbool.h>
+#include <stdint.h>
+#include "../ir/ir.h"
 
-#endif /* X86_64_H */
\ No newline at end of file
+// The sixteen general-purpose registers. rsp and rbp are reserved for
+// the stack frame and rax for return values and scratch.
+typedef enum {
+    X86_64_RAX, X86_64_RBX, X86_64_RCX, X86_64_RDX,
+    X86_64_RSI, X86_64_RDI, X86_64_RBP, X86_64_RSP,
+    X86_64_R8,  X86_64_R9,  X86_64_R10, X86_64_R11,
+    X86_64_R12, X86_64_R13, X86_64_R14, X86_64_R15,
+    X86_64_REGISTER_COUNT
+} X86_64Register;
+
+// Marks a virtual register without a hardware register
+#define X86_64_NO_REGISTER (-1)
+
+// One virtual register's live range, as instruction indices into the
+// function's flat buffer. Ranges are extended over loop back edges so
+// a value read inside a loop stays live for the whole loop.
+typedef struct {
+    uint32_t vreg;           // The virtual register
+    uint32_t start;          // Index of the first definition
+    uint32_t end;            // Index of the last use (inclusive)
+    bool crosses_call;       // Live across an IR_CALL
+} LiveInterval;
+
+// The result of register allocation for one function. Every virtual
+// register ends up either in a hardware register or in a spill slot.
+typedef struct {
+    int8_t* reg_of;          // Per vreg: X86_64Register or X86_64_NO_REGISTER
+    int32_t* slot_of;        // Per vreg: spill slot number or -1
+    uint32_t spill_count;    // Stack slots used by spills
+    uint32_t value_count;    // Size of the per-vreg arrays
+} X86_64Allocation;
+
+/**
+ * Compute live intervals for every virtual register in a function.
+ * One linear pass over the instruction buffer plus an extension pass
+ * over loop back edges
+ *
+ * @param fn The IR function
+ * @param intervals_out Receives a malloc'd array sorted by start
+ * @param count_out Receives the number of intervals
+ * @return true on success, false on allocation failure
+ */
+bool x86_64_compute_intervals(const IrFunction* fn, LiveInterval** intervals_out,
+                              uint32_t* count_out);
+
+/**
+ * Allocate hardware registers to a function's virtual registers by
+ * linear scan over its live intervals. Intervals that cross a call are
+ * given callee-saved registers; when registers run out, the interval
+ * that ends last is spilled to a stack slot
+ *
+ * @param fn The IR function
+ * @param allocation_out Receives the allocation (arrays are malloc'd;
+ *        release with x86_64_allocation_free)
+ * @return true on success, false on allocation failure
+ */
+bool x86_64_allocate_registers(const IrFunction* fn,
+                               X86_64Allocation* allocation_out);
+
+/**
+ * Release the arrays owned by an allocation result
+ *
+ * @param allocation The allocation to release
+ */
+void x86_64_allocation_free(X86_64Allocation* allocation);
+
+/**
+ * Get the assembly name of a register
+ *
+ * @param reg The register
+ * @return A static name string such as "rax"
+ */
+const char* x86_64_get_register_name(X86_64Register reg);
+
+#endif /* X86_64_H */
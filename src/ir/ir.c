@@ -1,29 +1,870 @@
 /*
  * filename: ir.c
- * 
+ *
  * Purpose:
  * Implementation of the Intermediate Representation (IR) generator for the ћ++ compiler.
  * This file contains functions that translate the AST into a three-address code
  * representation that's easier to optimize and translate to assembly.
- * 
+ *
  * Key Components:
- * - ir_generate_program(): Entry point for IR generation from an AST
- * - ir_generate_function(): Generate IR for a function definition
- * - ir_generate_statement(): Generate IR for statements (conditionals, loops, etc.)
- * - ir_generate_expression(): Generate IR for expressions with temporary variables
- * - ir_create_basic_block(): Create and manage basic blocks for control flow
- * - ir_optimize(): Apply basic optimizations to the generated IR
- * 
+ * - ir_generate(): Entry point for IR generation from an AST
+ * - generate_function(): Generate IR for a function definition
+ * - generate_statement(): Generate IR for statements (conditionals, loops, etc.)
+ * - generate_expression(): Generate IR for expressions with virtual registers
+ * - block_reserve()/block_begin(): Create and manage basic blocks
+ * - ir_program_print(): Readable listing of a generated program
+ *
  * Interactions:
  * - Takes input from the semantic analyzer's validated AST
- * - Uses symbol_table.h for variable information
  * - Output is used by codegen components for target-specific code generation
- * 
+ * - Uses error.h for reporting generation problems
+ *
  * Notes:
  * - All operations are on WORD-sized values (architecture dependent)
- * - Uses SSA (Static Single Assignment) form for better optimization potential
+ * - Instructions append to one contiguous per-function buffer; a basic
+ *   block is begun by recording the current instruction index and is
+ *   sealed when the next block begins, so block ranges are always
+ *   contiguous and in buffer order
+ * - Virtual registers are numbered from 0; parameters occupy the first
+ *   parameter_count registers
+ * - && and || lower to short-circuit branches with a result register
+ *   written on both paths
  * - Special handling for array operations and function calls
  */
 
 #include "ir.h"
-// Other includes will go here
\ No newline at end of file
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "../utils/error.h"
+#include "../utils/intern.h"
+
+#define IR_INITIAL_INSTRUCTIONS 32
+#define IR_INITIAL_BLOCKS       8
+#define IR_INITIAL_LOCALS       16
+
+// One name visible during generation, mapped to its virtual register
+typedef struct {
+    const char* name;        // Interned identifier
+    uint32_t reg;            // Register holding the value or array base
+} IrLocal;
+
+// State carried through the generation of one program
+typedef struct {
+    IrProgram* program;      // Program being built
+    IrFunction* function;    // Function currently being generated
+    const char* filename;    // Source file name for error messages
+    int error_count;         // Problems reported so far
+
+    IrLocal* locals;         // Names visible at the current point
+    size_t local_count;
+    size_t local_capacity;
+
+    uint32_t current_block;  // Block currently receiving instructions
+    uint32_t break_target;   // Block a break jumps to (IR_NO_OPERAND outside loops)
+} IrGenContext;
+
+/*
+ * Report one generation problem against a node and count it.
+ */
+static void ir_error(IrGenContext* ctx, AstNode* node,
+                     const char* message, const char* suggestion) {
+    ERROR_ERROR_MSG(ERROR_CODEGEN, ctx->filename,
+                    node ? node->location.line : 0,
+                    node ? node->location.column : 0,
+                    message, suggestion);
+    ctx->error_count++;
+}
+
+/*
+ * Grow an array to hold at least one more element. Returns the array
+ * (possibly moved) or NULL on allocation failure.
+ */
+static void* grow_array(void* items, uint32_t count, uint32_t* capacity,
+                        size_t element_size, uint32_t initial) {
+    if (count < *capacity) return items;
+
+    uint32_t new_capacity = *capacity == 0 ? initial : *capacity * 2;
+    void* grown = realloc(items, (size_t)new_capacity * element_size);
+    if (!grown) return NULL;
+
+    *capacity = new_capacity;
+    return grown;
+}
+
+/*
+ * Allocate a fresh virtual register in the current function.
+ */
+static uint32_t new_value(IrGenContext* ctx) {
+    return ctx->function->value_count++;
+}
+
+/*
+ * Append one instruction to the current function's buffer.
+ */
+static void emit(IrGenContext* ctx, IrOpcode opcode, uint32_t dest,
+                 uint32_t a, uint32_t b, uint32_t c, intptr_t imm) {
+    IrFunction* fn = ctx->function;
+
+    IrInstruction* grown = (IrInstruction*)grow_array(
+        fn->instructions, fn->instruction_count, &fn->instruction_capacity,
+        sizeof(IrInstruction), IR_INITIAL_INSTRUCTIONS);
+    if (!grown) {
+        error_report(ERROR_INTERNAL, ERROR_FATAL, ctx->filename, 0, 0,
+                     "Out of memory growing IR instruction buffer",
+                     "The compiler cannot continue", __FILE__, __LINE__);
+        return;
+    }
+    fn->instructions = grown;
+
+    IrInstruction* inst = &fn->instructions[fn->instruction_count++];
+    inst->opcode = opcode;
+    inst->dest = dest;
+    inst->a = a;
+    inst->b = b;
+    inst->c = c;
+    inst->imm = imm;
+}
+
+/*
+ * Check whether the current block already ends in a terminator.
+ */
+static bool block_terminated(IrGenContext* ctx) {
+    IrFunction* fn = ctx->function;
+    IrBasicBlock* block = &fn->blocks[ctx->current_block];
+
+    if (fn->instruction_count == block->first) return false;
+
+    IrOpcode last = fn->instructions[fn->instruction_count - 1].opcode;
+    return last == IR_JUMP || last == IR_BRANCH || last == IR_RETURN;
+}
+
+/*
+ * Reserve a block number without beginning it, so forward jumps can
+ * name their target before its instructions exist.
+ */
+static uint32_t block_reserve(IrGenContext* ctx) {
+    IrFunction* fn = ctx->function;
+
+    IrBasicBlock* grown = (IrBasicBlock*)grow_array(
+        fn->blocks, fn->block_count, &fn->block_capacity,
+        sizeof(IrBasicBlock), IR_INITIAL_BLOCKS);
+    if (!grown) {
+        error_report(ERROR_INTERNAL, ERROR_FATAL, ctx->filename, 0, 0,
+                     "Out of memory growing IR block array",
+                     "The compiler cannot continue", __FILE__, __LINE__);
+        return IR_NO_OPERAND;
+    }
+    fn->blocks = grown;
+
+    uint32_t block = fn->block_count++;
+    fn->blocks[block].first = 0;
+    fn->blocks[block].count = 0;
+    return block;
+}
+
+/*
+ * Seal the current block and begin receiving instructions into another
+ * (previously reserved) one.
+ */
+static void block_begin(IrGenContext* ctx, uint32_t block) {
+    IrFunction* fn = ctx->function;
+
+    IrBasicBlock* current = &fn->blocks[ctx->current_block];
+    current->count = fn->instruction_count - current->first;
+
+    fn->blocks[block].first = fn->instruction_count;
+    ctx->current_block = block;
+}
+
+/*
+ * Jump to a block unless the current one already ended.
+ */
+static void ensure_jump(IrGenContext* ctx, uint32_t target) {
+    if (!block_terminated(ctx)) {
+        emit(ctx, IR_JUMP, IR_NO_OPERAND, IR_NO_OPERAND, target, IR_NO_OPERAND, 0);
+    }
+}
+
+/*
+ * Add a call target name to the program-level pool, reusing an
+ * existing entry. Names are interned, so comparison is by pointer.
+ */
+static uint32_t name_pool_add(IrGenContext* ctx, const char* name) {
+    IrProgram* program = ctx->program;
+
+    for (uint32_t i = 0; i < program->name_count; i++) {
+        if (program->names[i] == name) return i;
+    }
+
+    const char** grown = (const char**)grow_array(
+        program->names, program->name_count, &program->name_capacity,
+        sizeof(const char*), 8);
+    if (!grown) return IR_NO_OPERAND;
+    program->names = grown;
+
+    program->names[program->name_count] = name;
+    return program->name_count++;
+}
+
+/*
+ * Add a string literal to the program-level pool.
+ */
+static uint32_t string_pool_add(IrGenContext* ctx, const char* value) {
+    IrProgram* program = ctx->program;
+
+    char** grown = (char**)grow_array(
+        program->strings, program->string_count, &program->string_capacity,
+        sizeof(char*), 8);
+    if (!grown) return IR_NO_OPERAND;
+    program->strings = grown;
+
+    size_t length = strlen(value);
+    char* copy = (char*)malloc(length + 1);
+    if (!copy) return IR_NO_OPERAND;
+    memcpy(copy, value, length + 1);
+
+    program->strings[program->string_count] = copy;
+    return program->string_count++;
+}
+
+/*
+ * Make a name visible at the current point.
+ */
+static bool local_add(IrGenContext* ctx, const char* name, uint32_t reg) {
+    if (ctx->local_count == ctx->local_capacity) {
+        size_t new_capacity = ctx->local_capacity == 0
+                                  ? IR_INITIAL_LOCALS
+                                  : ctx->local_capacity * 2;
+        IrLocal* grown = (IrLocal*)realloc(ctx->locals,
+                                           new_capacity * sizeof(IrLocal));
+        if (!grown) return false;
+        ctx->locals = grown;
+        ctx->local_capacity = new_capacity;
+    }
+
+    ctx->locals[ctx->local_count].name = name;
+    ctx->locals[ctx->local_count].reg = reg;
+    ctx->local_count++;
+    return true;
+}
+
+/*
+ * Find the innermost visible register for a name. Scanned newest-first
+ * so shadowing declarations win.
+ */
+static uint32_t local_lookup(IrGenContext* ctx, const char* name) {
+    for (size_t i = ctx->local_count; i > 0; i--) {
+        if (ctx->locals[i - 1].name == name) return ctx->locals[i - 1].reg;
+    }
+    return IR_NO_OPERAND;
+}
+
+static uint32_t generate_expression(IrGenContext* ctx, AstNode* node);
+static void generate_statement(IrGenContext* ctx, AstNode* node);
+
+/*
+ * Map a binary operator token to its IR opcode; IR_NOP for the
+ * short-circuit operators that need control flow instead.
+ */
+static IrOpcode binary_opcode(TokenType operator) {
+    switch (operator) {
+        case TOKEN_PLUS:           return IR_ADD;
+        case TOKEN_MINUS:          return IR_SUB;
+        case TOKEN_STAR:           return IR_MUL;
+        case TOKEN_SLASH:          return IR_DIV;
+        case TOKEN_PERCENT:        return IR_MOD;
+        case TOKEN_AND:            return IR_AND;
+        case TOKEN_OR:             return IR_OR;
+        case TOKEN_CARET:          return IR_XOR;
+        case TOKEN_DOUBLE_EQUALS:  return IR_CMP_EQ;
+        case TOKEN_NOT_EQUALS:     return IR_CMP_NE;
+        case TOKEN_LESS:           return IR_CMP_LT;
+        case TOKEN_LESS_EQUALS:    return IR_CMP_LE;
+        case TOKEN_GREATER:        return IR_CMP_GT;
+        case TOKEN_GREATER_EQUALS: return IR_CMP_GE;
+        default:                   return IR_NOP;
+    }
+}
+
+/*
+ * Lower && and || to short-circuit branches. The result register is
+ * written on both paths before they converge.
+ */
+static uint32_t generate_short_circuit(IrGenContext* ctx, AstNode* node) {
+    bool is_and = node->as.binary_expr.operator == TOKEN_DOUBLE_AND;
+    uint32_t result = new_value(ctx);
+
+    uint32_t left = generate_expression(ctx, node->as.binary_expr.left);
+    // Assume the skipped value, then evaluate the right operand only
+    // when it can still change the outcome
+    emit(ctx, IR_LOAD_CONST, result, IR_NO_OPERAND, IR_NO_OPERAND, IR_NO_OPERAND,
+         is_and ? 0 : 1);
+
+    uint32_t rhs_block = block_reserve(ctx);
+    uint32_t end_block = block_reserve(ctx);
+    if (is_and) {
+        emit(ctx, IR_BRANCH, IR_NO_OPERAND, left, rhs_block, end_block, 0);
+    } else {
+        emit(ctx, IR_BRANCH, IR_NO_OPERAND, left, end_block, rhs_block, 0);
+    }
+
+    block_begin(ctx, rhs_block);
+    uint32_t right = generate_expression(ctx, node->as.binary_expr.right);
+    emit(ctx, IR_MOVE, result, right, IR_NO_OPERAND, IR_NO_OPERAND, 0);
+    emit(ctx, IR_JUMP, IR_NO_OPERAND, IR_NO_OPERAND, end_block, IR_NO_OPERAND, 0);
+
+    block_begin(ctx, end_block);
+    return result;
+}
+
+/*
+ * Lower one expression subtree; returns the register holding its value.
+ */
+static uint32_t generate_expression(IrGenContext* ctx, AstNode* node) {
+    if (!node) return IR_NO_OPERAND;
+
+    switch (node->type) {
+        case AST_LITERAL_INT: {
+            uint32_t dest = new_value(ctx);
+            emit(ctx, IR_LOAD_CONST, dest, IR_NO_OPERAND, IR_NO_OPERAND,
+                 IR_NO_OPERAND, node->as.int_literal.value);
+            return dest;
+        }
+
+        case AST_LITERAL_CHAR: {
+            uint32_t dest = new_value(ctx);
+            emit(ctx, IR_LOAD_CONST, dest, IR_NO_OPERAND, IR_NO_OPERAND,
+                 IR_NO_OPERAND, (intptr_t)node->as.char_literal.value);
+            return dest;
+        }
+
+        case AST_LITERAL_BOOL: {
+            uint32_t dest = new_value(ctx);
+            emit(ctx, IR_LOAD_CONST, dest, IR_NO_OPERAND, IR_NO_OPERAND,
+                 IR_NO_OPERAND, node->as.bool_literal.value ? 1 : 0);
+            return dest;
+        }
+
+        case AST_LITERAL_STRING: {
+            uint32_t dest = new_value(ctx);
+            uint32_t index = string_pool_add(ctx, node->as.string_literal.value);
+            emit(ctx, IR_LOAD_STRING, dest, IR_NO_OPERAND, index, IR_NO_OPERAND, 0);
+            return dest;
+        }
+
+        case AST_IDENTIFIER: {
+            uint32_t reg = local_lookup(ctx, node->as.identifier.name);
+            if (reg == IR_NO_OPERAND) {
+                ir_error(ctx, node, "Identifier has no register",
+                         "This should have been caught by semantic analysis");
+                return IR_NO_OPERAND;
+            }
+            return reg;
+        }
+
+        case AST_ARRAY_ACCESS: {
+            uint32_t base = generate_expression(ctx, node->as.array_access.array);
+            uint32_t index = generate_expression(ctx, node->as.array_access.index);
+            uint32_t dest = new_value(ctx);
+            emit(ctx, IR_LOAD_ARRAY, dest, base, index, IR_NO_OPERAND, 0);
+            return dest;
+        }
+
+        case AST_UNARY_EXPR: {
+            uint32_t operand = generate_expression(ctx, node->as.unary_expr.operand);
+            switch (node->as.unary_expr.operator) {
+                case TOKEN_PLUS:
+                    return operand;
+                case TOKEN_MINUS: {
+                    uint32_t dest = new_value(ctx);
+                    emit(ctx, IR_NEG, dest, operand, IR_NO_OPERAND, IR_NO_OPERAND, 0);
+                    return dest;
+                }
+                case TOKEN_NOT: {
+                    uint32_t dest = new_value(ctx);
+                    emit(ctx, IR_NOT, dest, operand, IR_NO_OPERAND, IR_NO_OPERAND, 0);
+                    return dest;
+                }
+                default:
+                    ir_error(ctx, node, "Unsupported unary operator",
+                             "This should have been caught earlier");
+                    return operand;
+            }
+        }
+
+        case AST_BINARY_EXPR: {
+            TokenType operator = node->as.binary_expr.operator;
+            if (operator == TOKEN_DOUBLE_AND || operator == TOKEN_DOUBLE_OR) {
+                return generate_short_circuit(ctx, node);
+            }
+
+            IrOpcode opcode = binary_opcode(operator);
+            if (opcode == IR_NOP) {
+                ir_error(ctx, node, "Unsupported binary operator",
+                         "This should have been caught earlier");
+                return IR_NO_OPERAND;
+            }
+
+            uint32_t left = generate_expression(ctx, node->as.binary_expr.left);
+            uint32_t right = generate_expression(ctx, node->as.binary_expr.right);
+            uint32_t dest = new_value(ctx);
+            emit(ctx, opcode, dest, left, right, IR_NO_OPERAND, 0);
+            return dest;
+        }
+
+        case AST_ASSIGNMENT: {
+            AstNode* target = node->as.assignment.target;
+            uint32_t value = generate_expression(ctx, node->as.assignment.value);
+
+            if (target->type == AST_IDENTIFIER) {
+                uint32_t reg = local_lookup(ctx, target->as.identifier.name);
+                if (reg == IR_NO_OPERAND) {
+                    ir_error(ctx, node, "Assignment target has no register",
+                             "This should have been caught by semantic analysis");
+                    return value;
+                }
+                emit(ctx, IR_MOVE, reg, value, IR_NO_OPERAND, IR_NO_OPERAND, 0);
+                return reg;
+            }
+
+            if (target->type == AST_ARRAY_ACCESS) {
+                uint32_t base = generate_expression(ctx, target->as.array_access.array);
+                uint32_t index = generate_expression(ctx, target->as.array_access.index);
+                emit(ctx, IR_STORE_ARRAY, value, base, index, IR_NO_OPERAND, 0);
+                return value;
+            }
+
+            ir_error(ctx, node, "Assignment target is not assignable",
+                     "This should have been caught by semantic analysis");
+            return value;
+        }
+
+        case AST_CALL_EXPR: {
+            // Arguments are evaluated left to right and passed in order
+            uint32_t arg_regs[16];
+            int argument_count = node->as.call_expr.argument_count;
+            uint32_t* regs = arg_regs;
+            if (argument_count > 16) {
+                regs = (uint32_t*)malloc((size_t)argument_count * sizeof(uint32_t));
+                if (!regs) return IR_NO_OPERAND;
+            }
+
+            for (int i = 0; i < argument_count; i++) {
+                regs[i] = generate_expression(ctx, node->as.call_expr.arguments[i]);
+            }
+            for (int i = 0; i < argument_count; i++) {
+                emit(ctx, IR_ARG, IR_NO_OPERAND, regs[i], IR_NO_OPERAND,
+                     IR_NO_OPERAND, 0);
+            }
+            if (regs != arg_regs) free(regs);
+
+            AstNode* callee = node->as.call_expr.callee;
+            uint32_t name_index = IR_NO_OPERAND;
+            if (callee && callee->type == AST_IDENTIFIER) {
+                name_index = name_pool_add(ctx, callee->as.identifier.name);
+            } else {
+                ir_error(ctx, node, "Called expression is not a function name",
+                         "This should have been caught by semantic analysis");
+            }
+
+            uint32_t dest = new_value(ctx);
+            emit(ctx, IR_CALL, dest, (uint32_t)argument_count, name_index,
+                 IR_NO_OPERAND, 0);
+            return dest;
+        }
+
+        default:
+            ir_error(ctx, node, "Node cannot appear in an expression",
+                     "This is an internal compiler inconsistency");
+            return IR_NO_OPERAND;
+    }
+}
+
+/*
+ * Lower one statement into the current block, splitting blocks at
+ * control flow.
+ */
+static void generate_statement(IrGenContext* ctx, AstNode* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case AST_BLOCK: {
+            size_t outer_locals = ctx->local_count;
+            for (int i = 0; i < node->as.block.statement_count; i++) {
+                generate_statement(ctx, node->as.block.statements[i]);
+            }
+            ctx->local_count = outer_locals;
+            break;
+        }
+
+        case AST_VAR_DECL: {
+            uint32_t reg = new_value(ctx);
+            if (node->as.var_decl.initializer) {
+                uint32_t value = generate_expression(ctx, node->as.var_decl.initializer);
+                emit(ctx, IR_MOVE, reg, value, IR_NO_OPERAND, IR_NO_OPERAND, 0);
+            } else {
+                emit(ctx, IR_LOAD_CONST, reg, IR_NO_OPERAND, IR_NO_OPERAND,
+                     IR_NO_OPERAND, 0);
+            }
+            local_add(ctx, node->as.var_decl.name, reg);
+            break;
+        }
+
+        case AST_ARRAY_DECL: {
+            uint32_t base = new_value(ctx);
+            emit(ctx, IR_ALLOC_ARRAY, base, IR_NO_OPERAND, IR_NO_OPERAND,
+                 IR_NO_OPERAND, (intptr_t)node->as.array_decl.size);
+            local_add(ctx, node->as.array_decl.name, base);
+
+            for (int i = 0; i < node->as.array_decl.initializer_count; i++) {
+                uint32_t value = generate_expression(ctx, node->as.array_decl.initializers[i]);
+                uint32_t index = new_value(ctx);
+                emit(ctx, IR_LOAD_CONST, index, IR_NO_OPERAND, IR_NO_OPERAND,
+                     IR_NO_OPERAND, (intptr_t)i);
+                emit(ctx, IR_STORE_ARRAY, value, base, index, IR_NO_OPERAND, 0);
+            }
+            break;
+        }
+
+        case AST_IF_STMT: {
+            uint32_t condition = generate_expression(ctx, node->as.if_stmt.condition);
+            bool has_else = node->as.if_stmt.else_branch != NULL;
+
+            uint32_t then_block = block_reserve(ctx);
+            uint32_t else_block = has_else ? block_reserve(ctx) : IR_NO_OPERAND;
+            uint32_t end_block = block_reserve(ctx);
+
+            emit(ctx, IR_BRANCH, IR_NO_OPERAND, condition, then_block,
+                 has_else ? else_block : end_block, 0);
+
+            block_begin(ctx, then_block);
+            generate_statement(ctx, node->as.if_stmt.then_branch);
+            ensure_jump(ctx, end_block);
+
+            if (has_else) {
+                block_begin(ctx, else_block);
+                generate_statement(ctx, node->as.if_stmt.else_branch);
+                ensure_jump(ctx, end_block);
+            }
+
+            block_begin(ctx, end_block);
+            break;
+        }
+
+        case AST_WHILE_STMT: {
+            uint32_t cond_block = block_reserve(ctx);
+            uint32_t body_block = block_reserve(ctx);
+            uint32_t end_block = block_reserve(ctx);
+
+            ensure_jump(ctx, cond_block);
+            block_begin(ctx, cond_block);
+            uint32_t condition = generate_expression(ctx, node->as.while_stmt.condition);
+            emit(ctx, IR_BRANCH, IR_NO_OPERAND, condition, body_block, end_block, 0);
+
+            block_begin(ctx, body_block);
+            uint32_t outer_break = ctx->break_target;
+            ctx->break_target = end_block;
+            generate_statement(ctx, node->as.while_stmt.body);
+            ctx->break_target = outer_break;
+            ensure_jump(ctx, cond_block);
+
+            block_begin(ctx, end_block);
+            break;
+        }
+
+        case AST_DO_WHILE_STMT: {
+            uint32_t body_block = block_reserve(ctx);
+            uint32_t cond_block = block_reserve(ctx);
+            uint32_t end_block = block_reserve(ctx);
+
+            ensure_jump(ctx, body_block);
+            block_begin(ctx, body_block);
+            uint32_t outer_break = ctx->break_target;
+            ctx->break_target = end_block;
+            generate_statement(ctx, node->as.while_stmt.body);
+            ctx->break_target = outer_break;
+            ensure_jump(ctx, cond_block);
+
+            block_begin(ctx, cond_block);
+            uint32_t condition = generate_expression(ctx, node->as.while_stmt.condition);
+            emit(ctx, IR_BRANCH, IR_NO_OPERAND, condition, body_block, end_block, 0);
+
+            block_begin(ctx, end_block);
+            break;
+        }
+
+        case AST_FOR_STMT: {
+            size_t outer_locals = ctx->local_count;
+            generate_statement(ctx, node->as.for_stmt.initializer);
+
+            uint32_t cond_block = block_reserve(ctx);
+            uint32_t body_block = block_reserve(ctx);
+            uint32_t end_block = block_reserve(ctx);
+
+            ensure_jump(ctx, cond_block);
+            block_begin(ctx, cond_block);
+            if (node->as.for_stmt.condition) {
+                uint32_t condition = generate_expression(ctx, node->as.for_stmt.condition);
+                emit(ctx, IR_BRANCH, IR_NO_OPERAND, condition, body_block, end_block, 0);
+            } else {
+                emit(ctx, IR_JUMP, IR_NO_OPERAND, IR_NO_OPERAND, body_block,
+                     IR_NO_OPERAND, 0);
+            }
+
+            block_begin(ctx, body_block);
+            uint32_t outer_break = ctx->break_target;
+            ctx->break_target = end_block;
+            generate_statement(ctx, node->as.for_stmt.body);
+            ctx->break_target = outer_break;
+            if (node->as.for_stmt.increment) {
+                generate_expression(ctx, node->as.for_stmt.increment);
+            }
+            ensure_jump(ctx, cond_block);
+
+            block_begin(ctx, end_block);
+            ctx->local_count = outer_locals;
+            break;
+        }
+
+        case AST_BREAK_STMT:
+            if (ctx->break_target == IR_NO_OPERAND) {
+                ir_error(ctx, node, "break outside of a loop",
+                         "Remove the break or move it into a loop");
+            } else {
+                ensure_jump(ctx, ctx->break_target);
+            }
+            break;
+
+        case AST_RETURN_STMT: {
+            uint32_t value = IR_NO_OPERAND;
+            if (node->as.return_stmt.value) {
+                value = generate_expression(ctx, node->as.return_stmt.value);
+            }
+            emit(ctx, IR_RETURN, IR_NO_OPERAND, value, IR_NO_OPERAND,
+                 IR_NO_OPERAND, 0);
+            break;
+        }
+
+        case AST_EXPR_STMT:
+            generate_expression(ctx, node->as.expr_stmt.expression);
+            break;
+
+        default:
+            generate_expression(ctx, node);
+            break;
+    }
+}
+
+/*
+ * Lower one function definition. Parameters land in registers
+ * 0..parameter_count-1; block 0 is the entry block.
+ */
+static void generate_function(IrGenContext* ctx, AstNode* node) {
+    IrProgram* program = ctx->program;
+
+    IrFunction* grown = (IrFunction*)grow_array(
+        program->functions, program->function_count, &program->function_capacity,
+        sizeof(IrFunction), 4);
+    if (!grown) {
+        ctx->error_count++;
+        return;
+    }
+    program->functions = grown;
+
+    IrFunction* fn = &program->functions[program->function_count++];
+    memset(fn, 0, sizeof(IrFunction));
+    fn->name = node->as.function_decl.name;
+    fn->parameter_count = node->as.function_decl.parameter_count;
+
+    ctx->function = fn;
+    ctx->local_count = 0;
+    ctx->break_target = IR_NO_OPERAND;
+
+    for (int i = 0; i < fn->parameter_count; i++) {
+        AstNode* parameter = node->as.function_decl.parameters[i];
+        uint32_t reg = new_value(ctx);
+        if (parameter && parameter->type == AST_VAR_DECL) {
+            local_add(ctx, parameter->as.var_decl.name, reg);
+        }
+    }
+
+    uint32_t entry = block_reserve(ctx);
+    ctx->current_block = entry;
+    fn->blocks[entry].first = 0;
+
+    generate_statement(ctx, node->as.function_decl.body);
+
+    // Fall off the end of a function: return nothing
+    if (!block_terminated(ctx)) {
+        emit(ctx, IR_RETURN, IR_NO_OPERAND, IR_NO_OPERAND, IR_NO_OPERAND,
+             IR_NO_OPERAND, 0);
+    }
+
+    IrBasicBlock* last = &fn->blocks[ctx->current_block];
+    last->count = fn->instruction_count - last->first;
+    ctx->function = NULL;
+}
+
+IrProgram* ir_generate(AstNode* program, const char* filename) {
+    if (!program || program->type != AST_PROGRAM) return NULL;
+
+    IrProgram* ir = (IrProgram*)calloc(1, sizeof(IrProgram));
+    if (!ir) return NULL;
+
+    IrGenContext ctx = {0};
+    ctx.program = ir;
+    ctx.filename = filename;
+    ctx.break_target = IR_NO_OPERAND;
+
+    for (int i = 0; i < program->as.program.declaration_count; i++) {
+        AstNode* declaration = program->as.program.declarations[i];
+        if (!declaration) continue;
+
+        if (declaration->type == AST_FUNCTION_DECL) {
+            // External declarations carry no body to lower
+            if (!declaration->as.function_decl.is_external) {
+                generate_function(&ctx, declaration);
+            }
+        } else {
+            ir_error(&ctx, declaration,
+                     "Only function declarations are supported at top level",
+                     "Move the declaration into a function");
+        }
+    }
+
+    free(ctx.locals);
+
+    if (ctx.error_count > 0) {
+        ir_program_free(ir);
+        return NULL;
+    }
+    return ir;
+}
+
+void ir_program_free(IrProgram* program) {
+    if (!program) return;
+
+    for (uint32_t i = 0; i < program->function_count; i++) {
+        free(program->functions[i].instructions);
+        free(program->functions[i].blocks);
+    }
+    free(program->functions);
+    free(program->names);
+
+    for (uint32_t i = 0; i < program->string_count; i++) {
+        free(program->strings[i]);
+    }
+    free(program->strings);
+    free(program);
+}
+
+const char* ir_opcode_name(IrOpcode opcode) {
+    switch (opcode) {
+        case IR_NOP:         return "nop";
+        case IR_LOAD_CONST:  return "load_const";
+        case IR_LOAD_STRING: return "load_string";
+        case IR_MOVE:        return "move";
+        case IR_ALLOC_ARRAY: return "alloc_array";
+        case IR_LOAD_ARRAY:  return "load_array";
+        case IR_STORE_ARRAY: return "store_array";
+        case IR_ADD:         return "add";
+        case IR_SUB:         return "sub";
+        case IR_MUL:         return "mul";
+        case IR_DIV:         return "div";
+        case IR_MOD:         return "mod";
+        case IR_NEG:         return "neg";
+        case IR_AND:         return "and";
+        case IR_OR:          return "or";
+        case IR_XOR:         return "xor";
+        case IR_NOT:         return "not";
+        case IR_CMP_EQ:      return "cmp_eq";
+        case IR_CMP_NE:      return "cmp_ne";
+        case IR_CMP_LT:      return "cmp_lt";
+        case IR_CMP_LE:      return "cmp_le";
+        case IR_CMP_GT:      return "cmp_gt";
+        case IR_CMP_GE:      return "cmp_ge";
+        case IR_JUMP:        return "jump";
+        case IR_BRANCH:      return "branch";
+        case IR_ARG:         return "arg";
+        case IR_CALL:        return "call";
+        case IR_RETURN:      return "return";
+        default:             return "unknown";
+    }
+}
+
+/*
+ * Print one operand as vN, or _ when unused.
+ */
+static void print_operand(uint32_t operand) {
+    if (operand == IR_NO_OPERAND) {
+        printf(" _");
+    } else {
+        printf(" v%u", operand);
+    }
+}
+
+void ir_program_print(const IrProgram* program) {
+    if (!program) return;
+
+    for (uint32_t f = 0; f < program->function_count; f++) {
+        const IrFunction* fn = &program->functions[f];
+        printf("function %s (%d params, %u values, %u blocks):\n",
+               fn->name, fn->parameter_count, fn->value_count, fn->block_count);
+
+        for (uint32_t b = 0; b < fn->block_count; b++) {
+            const IrBasicBlock* block = &fn->blocks[b];
+            printf("  block %u:\n", b);
+
+            for (uint32_t i = block->first; i < block->first + block->count; i++) {
+                const IrInstruction* inst = &fn->instructions[i];
+                printf("    %4u: %-12s", i, ir_opcode_name(inst->opcode));
+
+                switch (inst->opcode) {
+                    case IR_LOAD_CONST:
+                        print_operand(inst->dest);
+                        printf(", %ld", (long)inst->imm);
+                        break;
+                    case IR_LOAD_STRING:
+                        print_operand(inst->dest);
+                        printf(", str%u", inst->b);
+                        break;
+                    case IR_ALLOC_ARRAY:
+                        print_operand(inst->dest);
+                        printf(", %ld elems", (long)inst->imm);
+                        break;
+                    case IR_JUMP:
+                        printf(" block %u", inst->b);
+                        break;
+                    case IR_BRANCH:
+                        print_operand(inst->a);
+                        printf(", block %u, block %u", inst->b, inst->c);
+                        break;
+                    case IR_CALL:
+                        print_operand(inst->dest);
+                        printf(", %s, %u args",
+                               inst->b < program->name_count
+                                   ? program->names[inst->b] : "?",
+                               inst->a);
+                        break;
+                    case IR_RETURN:
+                        print_operand(inst->a);
+                        break;
+                    default:
+                        if (inst->dest != IR_NO_OPERAND) print_operand(inst->dest);
+                        if (inst->a != IR_NO_OPERAND) {
+                            printf(",");
+                            print_operand(inst->a);
+                        }
+                        if (inst->b != IR_NO_OPERAND) {
+                            printf(",");
+                            print_operand(inst->b);
+                        }
+                        break;
+                }
+                printf("\n");
+            }
+        }
+        printf("\n");
+    }
+}
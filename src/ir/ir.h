@@ -1,34 +1,173 @@
 /*
  * filename: ir.h
- * 
+ *
  * Purpose:
  * Header file for the Intermediate Representation (IR) in the ћ++ compiler.
  * Defines the structures and interfaces for translating the AST into a lower-level
  * representation that's closer to machine code but still architecture-independent.
- * 
+ *
  * Key Components:
  * - IrOpcode enum: Defines all possible IR instruction types
- * - IrOperand struct: Represents operands (variables, constants, etc.)
- * - IrInstruction struct: Represents a single IR instruction
- * - IrBasicBlock struct: Contains a sequence of IR instructions
+ * - IrInstruction struct: One three-address instruction with index operands
+ * - IrBasicBlock struct: An index range into a function's instruction buffer
  * - IrFunction struct: Represents a function in IR form
  * - IrProgram struct: Top-level container for all IR components
  * - ir_generate(): Convert an AST into IR representation
- * 
+ *
  * Interactions:
  * - Takes input from the semantic analyzer's validated AST
- * - Output is used by codegen.h for target code generation
- * - Uses symbol_table.h for variable information
- * 
+ * - Output is used by codegen components for target code generation
+ * - Uses error.h for reporting generation problems
+ *
  * Notes:
  * - All values are WORD-sized (architecture dependent)
  * - Uses three-address code format for instructions
- * - Basic blocks enable future control-flow optimizations
+ * - The whole IR is flat arrays: each function stores its instructions
+ *   in one contiguous growable buffer, basic blocks are index ranges
+ *   into that buffer, and every operand is a 32-bit index (virtual
+ *   register, block number, or pool entry) rather than a pointer, so
+ *   passes stream through memory linearly and the IR serializes as-is
+ * - Basic blocks enable future control-flow optimizations; block
+ *   successors are read off the block's terminator instruction
  */
 
 #ifndef IR_H
 #define IR_H
 
-// Header content will be implemented later
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "../parser/ast.h"
 
-#endif /* IR_H */
\ No newline at end of file
+// Marks an unused 32-bit operand slot
+#define IR_NO_OPERAND UINT32_MAX
+
+// All IR instruction types (three-address code)
+typedef enum {
+    IR_NOP,          // No operation
+
+    // Data movement
+    IR_LOAD_CONST,   // dest = imm
+    IR_LOAD_STRING,  // dest = address of string pool entry b
+    IR_MOVE,         // dest = a
+
+    // Arrays
+    IR_ALLOC_ARRAY,  // dest = base of a fresh array of imm elements
+    IR_LOAD_ARRAY,   // dest = a[b]
+    IR_STORE_ARRAY,  // a[b] = dest (dest holds the stored value)
+
+    // Arithmetic
+    IR_ADD,          // dest = a + b
+    IR_SUB,          // dest = a - b
+    IR_MUL,          // dest = a * b
+    IR_DIV,          // dest = a / b
+    IR_MOD,          // dest = a % b
+    IR_NEG,          // dest = -a
+
+    // Bitwise and logic
+    IR_AND,          // dest = a & b
+    IR_OR,           // dest = a | b
+    IR_XOR,          // dest = a ^ b
+    IR_NOT,          // dest = !a (logical)
+
+    // Comparisons (dest = 0 or 1)
+    IR_CMP_EQ,       // dest = a == b
+    IR_CMP_NE,       // dest = a != b
+    IR_CMP_LT,       // dest = a < b
+    IR_CMP_LE,       // dest = a <= b
+    IR_CMP_GT,       // dest = a > b
+    IR_CMP_GE,       // dest = a >= b
+
+    // Control flow (block operands are basic block numbers)
+    IR_JUMP,         // jump to block b
+    IR_BRANCH,       // if a != 0 jump to block b, else to block c
+    IR_ARG,          // pass a as the next call argument
+    IR_CALL,         // dest = call name pool entry b with a arguments
+    IR_RETURN        // return a (IR_NO_OPERAND for void)
+} IrOpcode;
+
+// One three-address instruction. All operands are 32-bit indices:
+// virtual registers for values, block numbers for jump targets, pool
+// indices for names and strings. Immediates live in imm.
+typedef struct {
+    IrOpcode opcode;
+    uint32_t dest;       // Destination virtual register (or IR_NO_OPERAND)
+    uint32_t a;          // First operand
+    uint32_t b;          // Second operand
+    uint32_t c;          // Third operand (false target of IR_BRANCH)
+    intptr_t imm;        // Immediate constant (IR_LOAD_CONST, array sizes)
+} IrInstruction;
+
+// One basic block: a contiguous index range into the owning function's
+// instruction buffer. Successors are read off the final (terminator)
+// instruction of the range.
+typedef struct {
+    uint32_t first;      // Index of the block's first instruction
+    uint32_t count;      // Number of instructions in the block
+} IrBasicBlock;
+
+// One function lowered to IR. Virtual registers 0..parameter_count-1
+// hold the parameters on entry; block 0 is the entry block.
+typedef struct {
+    const char* name;            // Interned function name
+    int parameter_count;         // Number of parameters
+    uint32_t value_count;        // Virtual registers in use
+
+    IrInstruction* instructions; // One contiguous growable buffer
+    uint32_t instruction_count;
+    uint32_t instruction_capacity;
+
+    IrBasicBlock* blocks;        // Index ranges into instructions
+    uint32_t block_count;
+    uint32_t block_capacity;
+} IrFunction;
+
+// A whole program in IR form. Call targets and string literals live in
+// program-level pools so instructions only carry 32-bit indices.
+typedef struct {
+    IrFunction* functions;       // Functions defined in the program
+    uint32_t function_count;
+    uint32_t function_capacity;
+
+    const char** names;          // Interned call target names
+    uint32_t name_count;
+    uint32_t name_capacity;
+
+    char** strings;              // Owned string literal pool
+    uint32_t string_count;
+    uint32_t string_capacity;
+} IrProgram;
+
+/**
+ * Lower a semantically checked program AST to IR
+ *
+ * @param program The AST_PROGRAM root
+ * @param filename Source file name used in error messages (not owned)
+ * @return The IR program, or NULL when generation failed
+ */
+IrProgram* ir_generate(AstNode* program, const char* filename);
+
+/**
+ * Free an IR program and everything it owns
+ *
+ * @param program The program to free
+ */
+void ir_program_free(IrProgram* program);
+
+/**
+ * Get the printable mnemonic of an opcode
+ *
+ * @param opcode The opcode
+ * @return A static mnemonic string
+ */
+const char* ir_opcode_name(IrOpcode opcode);
+
+/**
+ * Print a readable listing of an IR program to stdout, one function at
+ * a time with block boundaries marked
+ *
+ * @param program The program to print
+ */
+void ir_program_print(const IrProgram* program);
+
+#endif /* IR_H */
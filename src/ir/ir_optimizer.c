@@ -1,28 +1,854 @@
 /*
  * filename: ir_optimizer.c
- * 
+ *
  * Purpose:
  * Implementation of the IR optimizer for the ћ++ compiler.
  * Contains optimization passes that improve the efficiency of the
  * intermediate representation before code generation.
- * 
+ *
  * Key Components:
- * - ir_optimizer_init(): Set up optimization passes
- * - ir_optimize_program(): Apply all optimizations to an IR program
- * - ir_constant_folding_pass(): Evaluate constant expressions at compile time
- * - ir_dead_code_elimination(): Remove unused code
- * - ir_common_subexpression_elimination(): Eliminate redundant calculations
- * - ir_copy_propagation(): Replace variables with their values when possible
- * 
+ * - ir_optimizer_init(): Set up an optimizer instance
+ * - ir_optimize_program(): Apply the level's pass schedule to a program
+ * - ir_pass_constant_fold(): Evaluate constant expressions at compile time
+ * - ir_pass_dead_code(): Remove unused code and compact the buffer
+ * - ir_pass_cse(): Eliminate redundant calculations within a block
+ * - ir_pass_licm(): Hoist loop-invariant computations to the preheader
+ * - ir_pass_inline(): Substitute small callees into their call sites
+ *
  * Interactions:
  * - Takes IR from ir.c as input
- * - Produces optimized IR for codegen.c
- * 
+ * - Produces optimized IR for the code generators
+ *
  * Notes:
  * - All operations on WORD-sized values (architecture dependent)
- * - Optimization level can be configurable
+ * - Registers defined exactly once are treated as SSA values; the
+ *   def-count arrays computed per pass make that test O(1)
+ * - Removal is two-phase: passes rewrite victims to IR_NOP, then
+ *   compact_nops() squeezes the buffer and recomputes the block ranges
+ *   so blocks keep tiling the instruction stream; blocks tile the
+ *   buffer but are not necessarily numbered in buffer order, so all
+ *   range fixups go by position, never by block number
+ * - Loops are recognized by their back edge (a block whose terminator
+ *   jumps to an earlier block); the generator emits loop bodies
+ *   contiguously, so the loop is exactly that block range and the
+ *   block before the header is its preheader
  * - Preserves program semantics while improving efficiency
  */
 
 #include "ir_optimizer.h"
-// Other includes will go here
\ No newline at end of file
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Does this instruction write a result register into dest?
+ * (IR_STORE_ARRAY keeps the stored value in dest, which is a use.)
+ */
+static bool defines_dest(const IrInstruction* inst) {
+    switch (inst->opcode) {
+        case IR_LOAD_CONST:
+        case IR_LOAD_STRING:
+        case IR_MOVE:
+        case IR_ALLOC_ARRAY:
+        case IR_LOAD_ARRAY:
+        case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+        case IR_NEG:
+        case IR_AND: case IR_OR: case IR_XOR: case IR_NOT:
+        case IR_CMP_EQ: case IR_CMP_NE: case IR_CMP_LT:
+        case IR_CMP_LE: case IR_CMP_GT: case IR_CMP_GE:
+        case IR_CALL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Collect the registers an instruction reads. Returns how many were
+ * written into uses[]. Non-register operands (block numbers, pool
+ * indices, argument counts) are never reported.
+ */
+static int collect_uses(const IrInstruction* inst, uint32_t uses[3]) {
+    int count = 0;
+
+    switch (inst->opcode) {
+        case IR_MOVE: case IR_NEG: case IR_NOT:
+            uses[count++] = inst->a;
+            break;
+        case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+        case IR_AND: case IR_OR: case IR_XOR:
+        case IR_CMP_EQ: case IR_CMP_NE: case IR_CMP_LT:
+        case IR_CMP_LE: case IR_CMP_GT: case IR_CMP_GE:
+        case IR_LOAD_ARRAY:
+            uses[count++] = inst->a;
+            uses[count++] = inst->b;
+            break;
+        case IR_STORE_ARRAY:
+            uses[count++] = inst->dest;
+            uses[count++] = inst->a;
+            uses[count++] = inst->b;
+            break;
+        case IR_BRANCH:
+        case IR_ARG:
+            uses[count++] = inst->a;
+            break;
+        case IR_RETURN:
+            if (inst->a != IR_NO_OPERAND) uses[count++] = inst->a;
+            break;
+        default:
+            break;
+    }
+    return count;
+}
+
+/*
+ * Is this instruction free of side effects, so it may be removed,
+ * reused, or hoisted? Array loads are excluded: a store through
+ * another name may change what they read.
+ */
+static bool is_pure(const IrInstruction* inst) {
+    switch (inst->opcode) {
+        case IR_LOAD_CONST:
+        case IR_LOAD_STRING:
+        case IR_MOVE:
+        case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+        case IR_NEG:
+        case IR_AND: case IR_OR: case IR_XOR: case IR_NOT:
+        case IR_CMP_EQ: case IR_CMP_NE: case IR_CMP_LT:
+        case IR_CMP_LE: case IR_CMP_GT: case IR_CMP_GE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Count how many times each register is defined.
+ */
+static uint32_t* compute_def_counts(const IrFunction* fn) {
+    uint32_t* def_count = (uint32_t*)calloc(fn->value_count ? fn->value_count : 1,
+                                            sizeof(uint32_t));
+    if (!def_count) return NULL;
+
+    for (uint32_t i = 0; i < fn->instruction_count; i++) {
+        const IrInstruction* inst = &fn->instructions[i];
+        if (defines_dest(inst) && inst->dest != IR_NO_OPERAND) {
+            def_count[inst->dest]++;
+        }
+    }
+
+    // Parameters are defined on entry
+    for (int p = 0; p < fn->parameter_count; p++) {
+        def_count[p]++;
+    }
+    return def_count;
+}
+
+/*
+ * Squeeze IR_NOP instructions out of the buffer and recompute the
+ * block ranges. Blocks tile the buffer, but not necessarily in block
+ * number order: the generator reserves a construct's end block before
+ * its body, so nested control flow places some blocks out of numeric
+ * order. The copy therefore walks the blocks by buffer position.
+ */
+static void compact_nops(IrFunction* fn) {
+    uint32_t* order = (uint32_t*)malloc(
+        (fn->block_count ? fn->block_count : 1) * sizeof(uint32_t));
+    if (!order) return;  // NOPs are harmless; the backends skip them
+
+    // Insertion sort of the block numbers by first offset; functions
+    // have few enough blocks that simplicity wins
+    for (uint32_t b = 0; b < fn->block_count; b++) {
+        uint32_t at = b;
+        while (at > 0 &&
+               fn->blocks[order[at - 1]].first > fn->blocks[b].first) {
+            order[at] = order[at - 1];
+            at--;
+        }
+        order[at] = b;
+    }
+
+    uint32_t write = 0;
+
+    for (uint32_t p = 0; p < fn->block_count; p++) {
+        IrBasicBlock* block = &fn->blocks[order[p]];
+        uint32_t new_first = write;
+
+        for (uint32_t i = block->first; i < block->first + block->count; i++) {
+            if (fn->instructions[i].opcode == IR_NOP) continue;
+            if (write != i) {
+                fn->instructions[write] = fn->instructions[i];
+            }
+            write++;
+        }
+
+        block->first = new_first;
+        block->count = write - new_first;
+    }
+
+    fn->instruction_count = write;
+    free(order);
+}
+
+/*
+ * Evaluate one pure operation over constant operands.
+ * Returns false when the result is not defined (division by zero).
+ */
+static bool fold_compute(IrOpcode opcode, intptr_t a, intptr_t b, intptr_t* out) {
+    switch (opcode) {
+        case IR_ADD:    *out = a + b; return true;
+        case IR_SUB:    *out = a - b; return true;
+        case IR_MUL:    *out = a * b; return true;
+        case IR_DIV:    if (b == 0) return false; *out = a / b; return true;
+        case IR_MOD:    if (b == 0) return false; *out = a % b; return true;
+        case IR_NEG:    *out = -a; return true;
+        case IR_AND:    *out = a & b; return true;
+        case IR_OR:     *out = a | b; return true;
+        case IR_XOR:    *out = a ^ b; return true;
+        case IR_NOT:    *out = !a; return true;
+        case IR_CMP_EQ: *out = a == b; return true;
+        case IR_CMP_NE: *out = a != b; return true;
+        case IR_CMP_LT: *out = a < b; return true;
+        case IR_CMP_LE: *out = a <= b; return true;
+        case IR_CMP_GT: *out = a > b; return true;
+        case IR_CMP_GE: *out = a >= b; return true;
+        case IR_MOVE:   *out = a; return true;
+        default:        return false;
+    }
+}
+
+bool ir_pass_constant_fold(IrOptimizer* optimizer, IrFunction* fn) {
+    uint32_t values = fn->value_count ? fn->value_count : 1;
+    uint32_t* def_count = compute_def_counts(fn);
+    bool* is_const = (bool*)calloc(values, sizeof(bool));
+    intptr_t* const_value = (intptr_t*)calloc(values, sizeof(intptr_t));
+    if (!def_count || !is_const || !const_value) {
+        free(def_count);
+        free(is_const);
+        free(const_value);
+        return false;
+    }
+
+    bool folded_any = false;
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+
+        for (uint32_t i = 0; i < fn->instruction_count; i++) {
+            IrInstruction* inst = &fn->instructions[i];
+
+            // Seed and refresh the lattice from constants already in place
+            if (inst->opcode == IR_LOAD_CONST && inst->dest != IR_NO_OPERAND &&
+                def_count[inst->dest] == 1 && !is_const[inst->dest]) {
+                is_const[inst->dest] = true;
+                const_value[inst->dest] = inst->imm;
+                changed = true;
+                continue;
+            }
+
+            // A branch on a constant condition becomes a jump
+            if (inst->opcode == IR_BRANCH && inst->a != IR_NO_OPERAND &&
+                is_const[inst->a]) {
+                uint32_t target = const_value[inst->a] ? inst->b : inst->c;
+                inst->opcode = IR_JUMP;
+                inst->a = IR_NO_OPERAND;
+                inst->b = target;
+                inst->c = IR_NO_OPERAND;
+                optimizer->folded++;
+                folded_any = true;
+                changed = true;
+                continue;
+            }
+
+            if (!is_pure(inst) || inst->opcode == IR_LOAD_CONST ||
+                inst->opcode == IR_LOAD_STRING) {
+                continue;
+            }
+            if (inst->dest == IR_NO_OPERAND || def_count[inst->dest] != 1) continue;
+
+            uint32_t uses[3];
+            int use_count = collect_uses(inst, uses);
+            bool all_const = use_count > 0;
+            for (int u = 0; u < use_count; u++) {
+                if (uses[u] == IR_NO_OPERAND || !is_const[uses[u]]) {
+                    all_const = false;
+                    break;
+                }
+            }
+            if (!all_const) continue;
+
+            intptr_t result;
+            intptr_t a = const_value[inst->a];
+            intptr_t b = use_count > 1 ? const_value[inst->b] : 0;
+            if (!fold_compute(inst->opcode, a, b, &result)) continue;
+
+            inst->opcode = IR_LOAD_CONST;
+            inst->a = IR_NO_OPERAND;
+            inst->b = IR_NO_OPERAND;
+            inst->c = IR_NO_OPERAND;
+            inst->imm = result;
+
+            is_const[inst->dest] = true;
+            const_value[inst->dest] = result;
+            optimizer->folded++;
+            folded_any = true;
+            changed = true;
+        }
+    }
+
+    free(def_count);
+    free(is_const);
+    free(const_value);
+    return folded_any;
+}
+
+bool ir_pass_dead_code(IrOptimizer* optimizer, IrFunction* fn) {
+    uint32_t values = fn->value_count ? fn->value_count : 1;
+    uint32_t* use_count = (uint32_t*)calloc(values, sizeof(uint32_t));
+    if (!use_count) return false;
+
+    for (uint32_t i = 0; i < fn->instruction_count; i++) {
+        uint32_t uses[3];
+        int count = collect_uses(&fn->instructions[i], uses);
+        for (int u = 0; u < count; u++) {
+            if (uses[u] != IR_NO_OPERAND) use_count[uses[u]]++;
+        }
+    }
+
+    bool removed_any = false;
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+
+        for (uint32_t i = 0; i < fn->instruction_count; i++) {
+            IrInstruction* inst = &fn->instructions[i];
+            if (!is_pure(inst) || inst->dest == IR_NO_OPERAND) continue;
+            if (use_count[inst->dest] != 0) continue;
+
+            uint32_t uses[3];
+            int count = collect_uses(inst, uses);
+            for (int u = 0; u < count; u++) {
+                if (uses[u] != IR_NO_OPERAND) use_count[uses[u]]--;
+            }
+
+            inst->opcode = IR_NOP;
+            optimizer->removed++;
+            removed_any = true;
+            changed = true;
+        }
+    }
+
+    if (removed_any) {
+        compact_nops(fn);
+    }
+
+    free(use_count);
+    return removed_any;
+}
+
+// One remembered computation during local CSE
+typedef struct {
+    IrOpcode opcode;
+    uint32_t a;
+    uint32_t b;
+    intptr_t imm;
+    uint32_t dest;
+} CseEntry;
+
+bool ir_pass_cse(IrOptimizer* optimizer, IrFunction* fn) {
+    uint32_t values = fn->value_count ? fn->value_count : 1;
+    uint32_t* def_count = compute_def_counts(fn);
+    uint32_t* replacement = (uint32_t*)malloc(values * sizeof(uint32_t));
+    CseEntry* table = (CseEntry*)malloc(fn->instruction_count * sizeof(CseEntry));
+    if (!def_count || !replacement || (!table && fn->instruction_count > 0)) {
+        free(def_count);
+        free(replacement);
+        free(table);
+        return false;
+    }
+    for (uint32_t v = 0; v < values; v++) replacement[v] = v;
+
+    bool reused_any = false;
+
+    for (uint32_t blk = 0; blk < fn->block_count; blk++) {
+        IrBasicBlock* block = &fn->blocks[blk];
+        uint32_t table_count = 0;
+
+        for (uint32_t i = block->first; i < block->first + block->count; i++) {
+            IrInstruction* inst = &fn->instructions[i];
+
+            // Rewrite uses through the replacement map first
+            switch (inst->opcode) {
+                case IR_STORE_ARRAY:
+                    inst->dest = replacement[inst->dest];
+                    inst->a = replacement[inst->a];
+                    inst->b = replacement[inst->b];
+                    break;
+                case IR_MOVE: case IR_NEG: case IR_NOT:
+                case IR_ARG: case IR_BRANCH:
+                    inst->a = replacement[inst->a];
+                    break;
+                case IR_RETURN:
+                    if (inst->a != IR_NO_OPERAND) inst->a = replacement[inst->a];
+                    break;
+                case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+                case IR_AND: case IR_OR: case IR_XOR:
+                case IR_CMP_EQ: case IR_CMP_NE: case IR_CMP_LT:
+                case IR_CMP_LE: case IR_CMP_GT: case IR_CMP_GE:
+                case IR_LOAD_ARRAY:
+                    inst->a = replacement[inst->a];
+                    inst->b = replacement[inst->b];
+                    break;
+                default:
+                    break;
+            }
+
+            if (!is_pure(inst) || inst->opcode == IR_MOVE) continue;
+            if (inst->dest == IR_NO_OPERAND || def_count[inst->dest] != 1) continue;
+
+            // Only single-assignment operands make the value stable for
+            // the rest of the block
+            uint32_t uses[3];
+            int use_count = collect_uses(inst, uses);
+            bool stable = true;
+            for (int u = 0; u < use_count; u++) {
+                if (uses[u] == IR_NO_OPERAND || def_count[uses[u]] != 1) {
+                    stable = false;
+                    break;
+                }
+            }
+            if (!stable) continue;
+
+            // Look for the same computation earlier in this block
+            bool matched = false;
+            for (uint32_t t = 0; t < table_count; t++) {
+                if (table[t].opcode == inst->opcode &&
+                    table[t].a == inst->a && table[t].b == inst->b &&
+                    table[t].imm == inst->imm) {
+                    replacement[inst->dest] = table[t].dest;
+                    inst->opcode = IR_NOP;
+                    optimizer->reused++;
+                    reused_any = true;
+                    matched = true;
+                    break;
+                }
+            }
+            if (!matched) {
+                table[table_count].opcode = inst->opcode;
+                table[table_count].a = inst->a;
+                table[table_count].b = inst->b;
+                table[table_count].imm = inst->imm;
+                table[table_count].dest = inst->dest;
+                table_count++;
+            }
+        }
+    }
+
+    if (reused_any) {
+        compact_nops(fn);
+    }
+
+    free(def_count);
+    free(replacement);
+    free(table);
+    return reused_any;
+}
+
+/*
+ * Physically move the instruction at index i to just before the
+ * terminator of the preheader block, shifting everything between.
+ * The fixup compares each block range against the shifted region the
+ * way open_gap() does, because block numbers do not track buffer
+ * position once control flow nests.
+ */
+static void hoist_instruction(IrFunction* fn, uint32_t i, uint32_t preheader) {
+    IrBasicBlock* pre = &fn->blocks[preheader];
+    uint32_t insert = pre->first + pre->count - 1;  // Before the terminator
+
+    IrInstruction saved = fn->instructions[i];
+    memmove(&fn->instructions[insert + 1], &fn->instructions[insert],
+            (size_t)(i - insert) * sizeof(IrInstruction));
+    fn->instructions[insert] = saved;
+
+    pre->count++;
+    for (uint32_t b = 0; b < fn->block_count; b++) {
+        IrBasicBlock* block = &fn->blocks[b];
+        if (b == preheader) continue;
+        if (i >= block->first && i < block->first + block->count) {
+            // The source block lost its instruction to the preheader
+            block->first++;
+            block->count--;
+        } else if (block->first > insert && block->first <= i) {
+            block->first++;
+        }
+    }
+}
+
+bool ir_pass_licm(IrOptimizer* optimizer, IrFunction* fn) {
+    uint32_t values = fn->value_count ? fn->value_count : 1;
+    uint32_t* def_count = compute_def_counts(fn);
+    bool* defined_in_loop = (bool*)malloc(values * sizeof(bool));
+    if (!def_count || !defined_in_loop) {
+        free(def_count);
+        free(defined_in_loop);
+        return false;
+    }
+
+    bool hoisted_any = false;
+
+    // A back edge is a block whose terminator jumps to an earlier
+    // block; the generator emits loops contiguously, so the loop is
+    // exactly the block range [header, latch]
+    for (uint32_t latch = 0; latch < fn->block_count; latch++) {
+        IrBasicBlock* latch_block = &fn->blocks[latch];
+        if (latch_block->count == 0) continue;
+
+        IrInstruction* term = &fn->instructions[latch_block->first + latch_block->count - 1];
+        uint32_t header;
+        if (term->opcode == IR_JUMP && term->b <= latch) {
+            header = term->b;
+        } else if (term->opcode == IR_BRANCH && term->b <= latch) {
+            header = term->b;  // do-while latch branches back to the body
+        } else {
+            continue;
+        }
+        if (header == 0) continue;  // No block before the header to hoist into
+
+        // The preheader must fall through (jump) into the header alone
+        IrBasicBlock* pre = &fn->blocks[header - 1];
+        if (pre->count == 0) continue;
+        IrInstruction* pre_term = &fn->instructions[pre->first + pre->count - 1];
+        if (pre_term->opcode != IR_JUMP || pre_term->b != header) continue;
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+
+            uint32_t lo = fn->blocks[header].first;
+            uint32_t hi = fn->blocks[latch].first + fn->blocks[latch].count;
+
+            memset(defined_in_loop, 0, values * sizeof(bool));
+            for (uint32_t i = lo; i < hi; i++) {
+                IrInstruction* inst = &fn->instructions[i];
+                if (defines_dest(inst) && inst->dest != IR_NO_OPERAND) {
+                    defined_in_loop[inst->dest] = true;
+                }
+            }
+
+            for (uint32_t i = lo; i < hi; i++) {
+                IrInstruction* inst = &fn->instructions[i];
+                if (!is_pure(inst) || inst->dest == IR_NO_OPERAND) continue;
+                if (def_count[inst->dest] != 1) continue;
+
+                // Division faults on a zero divisor, and the preheader
+                // runs unconditionally: hoisting would execute a
+                // division the loop guarded (or never reached) and
+                // crash valid programs, so it stays where it is
+                if (inst->opcode == IR_DIV || inst->opcode == IR_MOD) continue;
+
+                uint32_t uses[3];
+                int use_count = collect_uses(inst, uses);
+                bool invariant = true;
+                for (int u = 0; u < use_count; u++) {
+                    if (uses[u] == IR_NO_OPERAND || defined_in_loop[uses[u]] ||
+                        def_count[uses[u]] != 1) {
+                        invariant = false;
+                        break;
+                    }
+                }
+                if (!invariant) continue;
+
+                hoist_instruction(fn, i, header - 1);
+                optimizer->hoisted++;
+                hoisted_any = true;
+                changed = true;
+                break;  // Indices shifted; rescan the loop
+            }
+        }
+    }
+
+    free(def_count);
+    free(defined_in_loop);
+    return hoisted_any;
+}
+
+// How large a callee body may be (in IR instructions) and still be
+// substituted into its callers
+#define INLINE_MAX_INSTRUCTIONS 16
+
+// Deepest pending-argument nesting the call-site scan tracks; mirrors
+// the argument limit of the code generators
+#define INLINE_MAX_PENDING_ARGS 64
+
+/*
+ * Find the defined function an interned call target refers to, or
+ * NULL for externals.
+ */
+static IrFunction* find_function(IrProgram* program, const char* name) {
+    for (uint32_t f = 0; f < program->function_count; f++) {
+        if (strcmp(program->functions[f].name, name) == 0) {
+            return &program->functions[f];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * A callee qualifies for inlining when it is one small straight-line
+ * block terminated by its only return, and is not self-recursive.
+ * All values are WORD-sized and the language has no pointers to
+ * locals, so such a body can be substituted verbatim.
+ */
+static bool can_inline(const IrProgram* program, const IrFunction* fn) {
+    if (fn->block_count != 1) return false;
+    if (fn->instruction_count == 0 ||
+        fn->instruction_count > INLINE_MAX_INSTRUCTIONS) return false;
+    if (fn->instructions[fn->instruction_count - 1].opcode != IR_RETURN) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i + 1 < fn->instruction_count; i++) {
+        const IrInstruction* inst = &fn->instructions[i];
+        if (inst->opcode == IR_RETURN || inst->opcode == IR_JUMP ||
+            inst->opcode == IR_BRANCH) {
+            return false;
+        }
+        if (inst->opcode == IR_CALL &&
+            strcmp(program->names[inst->b], fn->name) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Shift every register operand of a copied callee instruction by the
+ * caller's register base. Non-register operands (block numbers, pool
+ * indices, argument counts, immediates) stay as they are.
+ */
+static void shift_registers(IrInstruction* inst, uint32_t base) {
+    switch (inst->opcode) {
+        case IR_LOAD_CONST:
+        case IR_LOAD_STRING:   // b is a string pool index
+        case IR_ALLOC_ARRAY:
+        case IR_CALL:          // a is a count, b a name pool index
+            inst->dest += base;
+            break;
+        case IR_MOVE: case IR_NEG: case IR_NOT:
+            inst->dest += base;
+            inst->a += base;
+            break;
+        case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+        case IR_AND: case IR_OR: case IR_XOR:
+        case IR_CMP_EQ: case IR_CMP_NE: case IR_CMP_LT:
+        case IR_CMP_LE: case IR_CMP_GT: case IR_CMP_GE:
+        case IR_LOAD_ARRAY:
+        case IR_STORE_ARRAY:   // dest holds the stored value, a use
+            inst->dest += base;
+            inst->a += base;
+            inst->b += base;
+            break;
+        case IR_ARG:
+            inst->a += base;
+            break;
+        case IR_RETURN:
+            if (inst->a != IR_NO_OPERAND) inst->a += base;
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+ * Open a gap of `gap` instruction slots at index `at`, growing the
+ * buffer when needed and keeping the block ranges tiling it.
+ */
+static bool open_gap(IrFunction* fn, uint32_t at, uint32_t gap) {
+    if (gap == 0) return true;
+
+    if (fn->instruction_count + gap > fn->instruction_capacity) {
+        uint32_t capacity = fn->instruction_capacity ? fn->instruction_capacity : 16;
+        while (capacity < fn->instruction_count + gap) {
+            capacity *= 2;
+        }
+        IrInstruction* grown = (IrInstruction*)realloc(
+            fn->instructions, capacity * sizeof(IrInstruction));
+        if (!grown) return false;
+        fn->instructions = grown;
+        fn->instruction_capacity = capacity;
+    }
+
+    memmove(&fn->instructions[at + gap], &fn->instructions[at],
+            (fn->instruction_count - at) * sizeof(IrInstruction));
+    fn->instruction_count += gap;
+
+    for (uint32_t b = 0; b < fn->block_count; b++) {
+        IrBasicBlock* block = &fn->blocks[b];
+        if (at >= block->first && at < block->first + block->count) {
+            block->count += gap;
+        } else if (block->first >= at) {
+            block->first += gap;
+        }
+    }
+    return true;
+}
+
+bool ir_pass_inline(IrOptimizer* optimizer, IrProgram* program) {
+    bool inlined_any = false;
+
+    for (uint32_t f = 0; f < program->function_count; f++) {
+        IrFunction* fn = &program->functions[f];
+        bool inlined_here = false;
+
+        for (uint32_t b = 0; b < fn->block_count; b++) {
+            for (uint32_t i = fn->blocks[b].first;
+                 i < fn->blocks[b].first + fn->blocks[b].count; i++) {
+                IrInstruction* call = &fn->instructions[i];
+                if (call->opcode != IR_CALL) continue;
+
+                IrFunction* callee = find_function(program, program->names[call->b]);
+                if (!callee || callee == fn || !can_inline(program, callee)) {
+                    continue;
+                }
+                uint32_t argument_count = call->a;
+                if (argument_count != (uint32_t)callee->parameter_count ||
+                    argument_count > INLINE_MAX_PENDING_ARGS) {
+                    continue;
+                }
+
+                // Walk the block up to the call, tracking pending IR_ARG
+                // instructions the way the code generators do: each call
+                // consumes the newest `argument_count` of them
+                uint32_t pending[INLINE_MAX_PENDING_ARGS];
+                int pending_count = 0;
+                bool trackable = true;
+                for (uint32_t j = fn->blocks[b].first; j < i; j++) {
+                    IrInstruction* prior = &fn->instructions[j];
+                    if (prior->opcode == IR_ARG) {
+                        if (pending_count == INLINE_MAX_PENDING_ARGS) {
+                            trackable = false;
+                            break;
+                        }
+                        pending[pending_count++] = j;
+                    } else if (prior->opcode == IR_CALL) {
+                        pending_count -= (int)prior->a;
+                        if (pending_count < 0) {
+                            trackable = false;
+                            break;
+                        }
+                    }
+                }
+                if (!trackable || pending_count < (int)argument_count) continue;
+
+                // Capture everything the splice needs before the buffer
+                // moves underneath us
+                uint32_t argument_regs[INLINE_MAX_PENDING_ARGS];
+                for (uint32_t p = 0; p < argument_count; p++) {
+                    uint32_t arg_index =
+                        pending[pending_count - (int)argument_count + (int)p];
+                    argument_regs[p] = fn->instructions[arg_index].a;
+                    fn->instructions[arg_index].opcode = IR_NOP;
+                }
+                uint32_t call_dest = call->dest;
+                IrInstruction callee_return =
+                    callee->instructions[callee->instruction_count - 1];
+                uint32_t body_length = callee->instruction_count - 1;
+
+                // Parameter moves, the body, and the result move replace
+                // the one call instruction
+                uint32_t splice_length = argument_count + body_length + 1;
+                if (!open_gap(fn, i, splice_length - 1)) {
+                    return inlined_any;
+                }
+
+                uint32_t base = fn->value_count;
+                fn->value_count += callee->value_count;
+
+                uint32_t write = i;
+                for (uint32_t p = 0; p < argument_count; p++) {
+                    fn->instructions[write++] = (IrInstruction){
+                        IR_MOVE, base + p, argument_regs[p],
+                        IR_NO_OPERAND, IR_NO_OPERAND, 0
+                    };
+                }
+                for (uint32_t k = 0; k < body_length; k++) {
+                    IrInstruction copy = callee->instructions[k];
+                    shift_registers(&copy, base);
+                    fn->instructions[write++] = copy;
+                }
+                if (call_dest == IR_NO_OPERAND) {
+                    fn->instructions[write++] = (IrInstruction){
+                        IR_NOP, IR_NO_OPERAND, IR_NO_OPERAND,
+                        IR_NO_OPERAND, IR_NO_OPERAND, 0
+                    };
+                } else if (callee_return.a == IR_NO_OPERAND) {
+                    fn->instructions[write++] = (IrInstruction){
+                        IR_LOAD_CONST, call_dest, IR_NO_OPERAND,
+                        IR_NO_OPERAND, IR_NO_OPERAND, 0
+                    };
+                } else {
+                    fn->instructions[write++] = (IrInstruction){
+                        IR_MOVE, call_dest, base + callee_return.a,
+                        IR_NO_OPERAND, IR_NO_OPERAND, 0
+                    };
+                }
+
+                optimizer->inlined++;
+                inlined_any = true;
+                inlined_here = true;
+                i = write - 1;
+            }
+        }
+
+        if (inlined_here) {
+            compact_nops(fn);
+        }
+    }
+
+    return inlined_any;
+}
+
+IrOptimizer* ir_optimizer_init(int optimization_level) {
+    IrOptimizer* optimizer = (IrOptimizer*)calloc(1, sizeof(IrOptimizer));
+    if (!optimizer) return NULL;
+
+    optimizer->optimization_level = optimization_level;
+    return optimizer;
+}
+
+void ir_optimizer_free(IrOptimizer* optimizer) {
+    free(optimizer);
+}
+
+bool ir_optimize_program(IrOptimizer* optimizer, IrProgram* program) {
+    if (!optimizer || !program) return false;
+    if (optimizer->optimization_level <= 0) return true;
+
+    // -O2: substitute small callees into their callers first, so the
+    // per-function passes see through the former call boundaries; a
+    // few rounds pick up chains of tiny functions
+    if (optimizer->optimization_level >= 2) {
+        for (int round = 0; round < 3; round++) {
+            if (!ir_pass_inline(optimizer, program)) break;
+        }
+    }
+
+    for (uint32_t f = 0; f < program->function_count; f++) {
+        IrFunction* fn = &program->functions[f];
+
+        // -O1: make constants explicit, then drop what nothing reads
+        ir_pass_constant_fold(optimizer, fn);
+        ir_pass_dead_code(optimizer, fn);
+
+        if (optimizer->optimization_level >= 2) {
+            // -O2: reuse repeated computations and pull invariant work
+            // out of loops, then clean up again
+            ir_pass_cse(optimizer, fn);
+            ir_pass_licm(optimizer, fn);
+            ir_pass_constant_fold(optimizer, fn);
+            ir_pass_dead_code(optimizer, fn);
+        }
+    }
+    return true;
+}
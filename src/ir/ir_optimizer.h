@@ -1,31 +1,136 @@
 /*
  * filename: ir_optimizer.h
- * 
+ *
  * Purpose:
  * Header file for the IR optimization phase of the ћ++ compiler.
  * Defines the interface for optimizing the intermediate representation
  * to generate more efficient code.
- * 
+ *
  * Key Components:
  * - IrOptimizer struct: Maintains state during optimization passes
  * - ir_optimizer_init(): Initialize a new optimizer instance
  * - ir_optimize_program(): Entry point for optimizing an entire program
- * - ir_optimization_pass(): Apply a specific optimization technique
- * 
+ * - ir_pass_constant_fold()/ir_pass_dead_code()/ir_pass_cse()/
+ *   ir_pass_licm()/ir_pass_inline(): The individual optimization passes
+ *
  * Interactions:
  * - Takes IR from ir.c as input
  * - Produces optimized IR for the code generator
- * 
+ * - Driven by CompilerConfig.optimization_level in main.c
+ *
  * Notes:
  * - All operations on WORD-sized values (architecture dependent)
- * - Implements standard optimizations like constant folding, dead code elimination
- * - Platform-independent optimizations only; architecture-specific optimizations 
- *   are handled in the code generation phase
+ * - The generator emits temporaries in single-assignment form, so the
+ *   passes use a sparse def-count analysis: registers defined exactly
+ *   once are SSA values the passes may reason about; multi-assignment
+ *   registers (mutable variables) are left untouched
+ * - Pass schedule per level: -O0 nothing, -O1 constant folding and
+ *   dead-code elimination, -O2/-O3 additionally function inlining,
+ *   common-subexpression elimination and loop-invariant code motion
+ * - Platform-independent optimizations only; architecture-specific
+ *   optimizations are handled in the code generation phase
  */
 
 #ifndef IR_OPTIMIZER_H
 #define IR_OPTIMIZER_H
 
-// Header content will be implemented later
+#include <stdbool.h>
+#include "ir.h"
 
-#endif /* IR_OPTIMIZER_H */
\ No newline at end of file
+// State and statistics carried through one optimization run
+typedef struct {
+    int optimization_level;  // Requested -O level (0-3)
+
+    // Pass statistics, accumulated across functions
+    int folded;              // Instructions rewritten to constants
+    int removed;             // Dead instructions eliminated
+    int reused;              // Redundant computations coalesced by CSE
+    int hoisted;             // Instructions moved out of loops by LICM
+    int inlined;             // Call sites replaced by callee bodies
+} IrOptimizer;
+
+/**
+ * Create and initialize a new optimizer instance
+ *
+ * @param optimization_level The -O level controlling the pass schedule
+ * @return The new optimizer, or NULL on allocation failure
+ */
+IrOptimizer* ir_optimizer_init(int optimization_level);
+
+/**
+ * Free an optimizer instance
+ *
+ * @param optimizer The optimizer to free
+ */
+void ir_optimizer_free(IrOptimizer* optimizer);
+
+/**
+ * Run the pass schedule for the configured level over every function
+ * in a program
+ *
+ * @param optimizer The optimizer
+ * @param program The IR program to optimize in place
+ * @return true on success, false on allocation failure
+ */
+bool ir_optimize_program(IrOptimizer* optimizer, IrProgram* program);
+
+/**
+ * Sparse constant propagation: fold operations whose operands are
+ * single-assignment constants, and turn branches on constant
+ * conditions into jumps
+ *
+ * @param optimizer The optimizer (statistics are accumulated)
+ * @param fn The function to optimize in place
+ * @return true when anything was folded
+ */
+bool ir_pass_constant_fold(IrOptimizer* optimizer, IrFunction* fn);
+
+/**
+ * Dead-code elimination: remove side-effect-free instructions whose
+ * results are never used, then compact the instruction buffer so the
+ * block ranges stay contiguous
+ *
+ * @param optimizer The optimizer (statistics are accumulated)
+ * @param fn The function to optimize in place
+ * @return true when anything was removed
+ */
+bool ir_pass_dead_code(IrOptimizer* optimizer, IrFunction* fn);
+
+/**
+ * Local common-subexpression elimination: within each block, reuse the
+ * result of an identical earlier pure computation instead of
+ * recomputing it
+ *
+ * @param optimizer The optimizer (statistics are accumulated)
+ * @param fn The function to optimize in place
+ * @return true when anything was reused
+ */
+bool ir_pass_cse(IrOptimizer* optimizer, IrFunction* fn);
+
+/**
+ * Loop-invariant code motion: move pure computations whose operands do
+ * not change inside a loop into the block preceding the loop header.
+ * Division and modulo are never moved: the preheader executes
+ * unconditionally, and a hoisted division would fault on a zero
+ * divisor the loop body guarded against
+ *
+ * @param optimizer The optimizer (statistics are accumulated)
+ * @param fn The function to optimize in place
+ * @return true when anything was hoisted
+ */
+bool ir_pass_licm(IrOptimizer* optimizer, IrFunction* fn);
+
+/**
+ * Function inlining: substitute the bodies of small straight-line
+ * callees into their call sites, so the per-function passes can see
+ * through the former call boundary. All values are WORD-sized and
+ * the language has no pointers to locals, so the substitution needs
+ * only register renaming. Interprocedural, hence over the program
+ *
+ * @param optimizer The optimizer (statistics are accumulated)
+ * @param program The IR program to optimize in place
+ * @return true when any call site was inlined
+ */
+bool ir_pass_inline(IrOptimizer* optimizer, IrProgram* program);
+
+#endif /* IR_OPTIMIZER_H */
@@ -9,23 +9,27 @@
  * Key Components:
  * - Keyword struct: Maps a keyword string to its token type
  * - keywords_table[]: Array of all language keywords
+ * - keyword_lookup(): Single-probe perfect-hash lookup
  * - is_keyword(): Checks if a string is a language keyword
  * - get_keyword_token(): Returns the token type for a keyword
- * 
+ *
  * Interactions:
  * - Used by lexer.c to identify keywords during tokenization
- * - Relies on utf8.h for string comparison with UTF-8 support
- * 
+ *
  * Notes:
  * - All keywords are stored in UTF-8 format
  * - Keywords include: екстерно (external), врати (return), низ (array), etc.
  * - Case sensitivity is enforced for keywords
+ * - Lookup uses a perfect-hash table derived from keywords_table[] on
+ *   first use: a seed is searched so that no two keywords collide, making
+ *   classification a single probe plus one confirming compare instead of
+ *   a linear scan over the whole table
  */
 
 #include "lexer.h"
-#include "../utils/utf8.h"
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 // Keyword struct maps a keyword string to its token type
@@ -56,41 +60,107 @@ static const Keyword keywords_table[] = {
 // Number of keywords in the table
 static const int KEYWORDS_COUNT = sizeof(keywords_table) / sizeof(keywords_table[0]);
 
+// Perfect-hash table size: power of two with plenty of headroom over
+// KEYWORDS_COUNT so a collision-free seed is easy to find
+#define KEYWORD_HASH_SIZE 32
+
+// Hash table slots; -1 marks an empty slot, otherwise an index into
+// keywords_table[]
+static int8_t keyword_hash_table[KEYWORD_HASH_SIZE];
+static uint32_t keyword_hash_seed = 0;
+static bool keyword_hash_ready = false;
+
+/**
+ * Seeded FNV-1a hash over the keyword bytes
+ *
+ * @param str The string to hash
+ * @param seed Seed mixed into the initial hash state
+ * @return Hash value of the string
+ */
+static uint32_t keyword_hash(const char* str, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Build the perfect-hash table from keywords_table[] on first use
+ *
+ * Searches for a seed under which no two keywords share a slot, so
+ * every later lookup is exactly one probe. With 10 keywords in 32
+ * slots a suitable seed is found after a handful of attempts.
+ */
+static void keyword_hash_build(void) {
+    for (uint32_t seed = 0; ; seed++) {
+        memset(keyword_hash_table, -1, sizeof(keyword_hash_table));
+
+        bool collision = false;
+        for (int i = 0; i < KEYWORDS_COUNT; i++) {
+            uint32_t slot = keyword_hash(keywords_table[i].word, seed) & (KEYWORD_HASH_SIZE - 1);
+            if (keyword_hash_table[slot] != -1) {
+                collision = true;
+                break;
+            }
+            keyword_hash_table[slot] = (int8_t)i;
+        }
+
+        if (!collision) {
+            keyword_hash_seed = seed;
+            keyword_hash_ready = true;
+            return;
+        }
+    }
+}
+
+/**
+ * Look up a string in the perfect-hash keyword table
+ *
+ * @param str The string to look up
+ * @return Index into keywords_table[], or -1 if not a keyword
+ */
+static int keyword_lookup(const char* str) {
+    if (!keyword_hash_ready) {
+        keyword_hash_build();
+    }
+
+    uint32_t slot = keyword_hash(str, keyword_hash_seed) & (KEYWORD_HASH_SIZE - 1);
+    int index = keyword_hash_table[slot];
+    if (index == -1 || strcmp(str, keywords_table[index].word) != 0) {
+        return -1;
+    }
+    return index;
+}
+
 /**
  * Check if a string is a keyword in the ћ++ language
- * 
+ *
  * @param str The string to check
  * @return true if the string is a keyword, false otherwise
  */
 bool is_keyword(const char* str) {
     if (!str) return false;
-    
-    for (int i = 0; i < KEYWORDS_COUNT; i++) {
-        if (utf8_strcmp(str, keywords_table[i].word) == 0) {
-            return true;
-        }
-    }
-    
-    return false;
+
+    return keyword_lookup(str) != -1;
 }
 
 /**
  * Get the token type for a keyword
- * 
+ *
  * @param str The keyword string
  * @return The token type if str is a keyword, or an error value otherwise
  */
 TokenType get_keyword_token(const char* str) {
     if (!str) return TOKEN_KEYWORD_LAST; // Return sentinel value for error
-    
-    for (int i = 0; i < KEYWORDS_COUNT; i++) {
-        if (utf8_strcmp(str, keywords_table[i].word) == 0) {
-            return keywords_table[i].type;
-        }
+
+    int index = keyword_lookup(str);
+    if (index == -1) {
+        // Not a keyword, return sentinel value
+        return TOKEN_KEYWORD_LAST;
     }
-    
-    // Not a keyword, return sentinel value
-    return TOKEN_KEYWORD_LAST;
+    return keywords_table[index].type;
 }
 
 /**
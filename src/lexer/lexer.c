@@ -25,11 +25,22 @@
  * - All numeric values are treated as WORD-sized (architecture dependent)
  * - Special handling for angle brackets (< >) which replace curly braces
  * - Special handling for array syntax (низ:number: = _values_)
+ * - The source buffer lives in a shared SourceManager: regular files
+ *   are mmap'd read-only so lexemes point straight into the mapping,
+ *   and error.c excerpts offending lines from the same buffer
+ * - String literals are zero-copy slices into the source; escapes are
+ *   the exception and are processed into an owned buffer only when a
+ *   literal actually contains them
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "lexer.h"
 #include "keywords.h"
 #include "../utils/error.h"
+#include "../utils/intern.h"
+#include "../utils/timing.h"
+#include "../utils/memstats.h"
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
@@ -133,43 +144,18 @@ LexerState* lexer_init(FILE* source, const char* filename, TargetInfo target_inf
         return NULL;
     }
     
-    // Determine file size
-    fseek(source, 0, SEEK_END);
-    long file_size = ftell(source);
-    fseek(source, 0, SEEK_SET);
-    
-    if (file_size < 0) {
+    // The manager maps regular files directly (no heap copy, lexemes
+    // reference the mapping) and falls back to a heap buffer for
+    // pipes and stdin; the error reporter shares the same buffer
+    SourceManager* manager = source_manager_open(source, filename);
+    if (!manager) {
         error_report(ERROR_IO, ERROR_FATAL, filename, 0, 0,
-                    "Failed to determine source file size",
-                    "Check file permissions and disk space",
+                    "Failed to read source file",
+                    "Check file permissions and available memory",
                     __FILE__, __LINE__);
         return NULL;
     }
-    
-    // Allocate memory for the source code
-    char* source_code = (char*)malloc(file_size + 1);
-    if (!source_code) {
-        error_report(ERROR_INTERNAL, ERROR_FATAL, filename, 0, 0,
-                    "Failed to allocate memory for source code",
-                    "Try closing other applications to free memory",
-                    __FILE__, __LINE__);
-        return NULL;
-    }
-    
-    // Read the file into memory
-    size_t bytes_read = fread(source_code, 1, file_size, source);
-    if (bytes_read != (size_t)file_size) {
-        error_report(ERROR_IO, ERROR_FATAL, filename, 0, 0,
-                    "Failed to read entire source file",
-                    "Check file for corruption or disk errors",
-                    __FILE__, __LINE__);
-        free(source_code);
-        return NULL;
-    }
-    
-    // Null-terminate the source code
-    source_code[file_size] = '\0';
-    
+
     // Allocate memory for the lexer state
     LexerState* lexer = (LexerState*)malloc(sizeof(LexerState));
     if (!lexer) {
@@ -177,22 +163,23 @@ LexerState* lexer_init(FILE* source, const char* filename, TargetInfo target_inf
                     "Failed to allocate memory for lexer state",
                     "Try closing other applications to free memory",
                     __FILE__, __LINE__);
-        free(source_code);
+        source_manager_close(manager);
         return NULL;
     }
-    
+
     // Initialize the lexer state
-    lexer->source = source_code;
+    lexer->source = manager->buffer;
     lexer->filename = filename;
-    lexer->source_length = file_size;
+    lexer->source_length = manager->length;
     lexer->current = 0;
     lexer->start = 0;
-    lexer->line = 1;
-    lexer->column = 1;
-    lexer->previous_column = 1;
+    lexer->source_manager = manager;
     lexer->has_next_token = false;
     lexer->target_info = target_info;
-    
+
+    timing_count(TIMING_COUNTER_SOURCE_BYTES, lexer->source_length);
+    memstats_track_alloc(sizeof(LexerState));
+
     return lexer;
 }
 
@@ -203,10 +190,9 @@ LexerState* lexer_init(FILE* source, const char* filename, TargetInfo target_inf
  */
 void lexer_cleanup(LexerState* lexer) {
     if (lexer) {
-        if (lexer->source) {
-            free((void*)lexer->source);
-        }
+        source_manager_close(lexer->source_manager);
         free(lexer);
+        memstats_track_free(sizeof(LexerState));
     }
 }
 
@@ -232,7 +218,9 @@ Token lexer_next_token(LexerState* lexer) {
     
     Token token = scan_token(lexer);
     lexer->current_token = token;
-    
+
+    timing_count(TIMING_COUNTER_TOKENS, 1);
+
     return token;
 }
 
@@ -250,24 +238,122 @@ Token lexer_peek_token(LexerState* lexer) {
     // Save current lexer state
     size_t saved_current = lexer->current;
     size_t saved_start = lexer->start;
-    int saved_line = lexer->line;
-    int saved_column = lexer->column;
-    int saved_prev_column = lexer->previous_column;
-    
+
     // Get the next token
     lexer->next_token = lexer_next_token(lexer);
     lexer->has_next_token = true;
-    
+
     // Restore lexer state
     lexer->current = saved_current;
     lexer->start = saved_start;
-    lexer->line = saved_line;
-    lexer->column = saved_column;
-    lexer->previous_column = saved_prev_column;
-    
+
     return lexer->next_token;
 }
 
+/**
+ * Compute the line and column for a byte offset in the source
+ *
+ * @param lexer The lexer state
+ * @param offset Byte offset into the source buffer
+ * @param line Output: 1-based line number
+ * @param column Output: 1-based byte column within the line
+ */
+void lexer_location(LexerState* lexer, size_t offset, int* line, int* column) {
+    source_manager_location(lexer->source_manager, offset, line, column);
+}
+
+/**
+ * Initialize a token buffer over caller-provided storage
+ *
+ * @param buffer The token buffer to initialize
+ * @param storage Array of at least capacity tokens owned by the caller
+ * @param capacity Number of slots in storage
+ */
+void token_buffer_init(TokenBuffer* buffer, Token* storage, size_t capacity) {
+    buffer->tokens = storage;
+    buffer->capacity = capacity;
+    buffer->count = 0;
+    buffer->position = 0;
+    buffer->at_end = false;
+}
+
+/**
+ * Refill a token buffer from the lexer
+ *
+ * @param buffer The token buffer to refill
+ * @param lexer The lexer to pull tokens from
+ * @return The number of buffered tokens available for consumption
+ */
+size_t token_buffer_fill(TokenBuffer* buffer, LexerState* lexer) {
+    // Compact unconsumed tokens to the front of the buffer
+    size_t remaining = buffer->count - buffer->position;
+    if (remaining > 0 && buffer->position > 0) {
+        memmove(buffer->tokens, buffer->tokens + buffer->position,
+                remaining * sizeof(Token));
+    }
+    buffer->count = remaining;
+    buffer->position = 0;
+
+    // Lex new tokens into the free slots; TOKEN_EOF/TOKEN_ERROR is
+    // buffered as a sentinel and ends the stream
+    while (buffer->count < buffer->capacity && !buffer->at_end) {
+        Token token = lexer_next_token(lexer);
+        buffer->tokens[buffer->count++] = token;
+
+        if (token.type == TOKEN_EOF || token.type == TOKEN_ERROR) {
+            buffer->at_end = true;
+        }
+    }
+
+    return buffer->count;
+}
+
+/**
+ * Consume the next token from the buffer, refilling when it runs dry
+ *
+ * @param buffer The token buffer
+ * @param lexer The lexer to refill from
+ * @return The next token
+ */
+Token token_buffer_next(TokenBuffer* buffer, LexerState* lexer) {
+    if (buffer->position >= buffer->count) {
+        token_buffer_fill(buffer, lexer);
+
+        if (buffer->count == 0) {
+            // Source exhausted (or zero-capacity buffer): pull directly,
+            // which yields TOKEN_EOF forever at end of input
+            return lexer_next_token(lexer);
+        }
+    }
+
+    return buffer->tokens[buffer->position++];
+}
+
+/**
+ * Look ahead in the buffer without consuming tokens
+ *
+ * @param buffer The token buffer
+ * @param lexer The lexer to refill from
+ * @param lookahead How far ahead to look (0 = next token)
+ * @return The token at the requested offset
+ */
+Token token_buffer_peek(TokenBuffer* buffer, LexerState* lexer, size_t lookahead) {
+    if (buffer->position + lookahead >= buffer->count) {
+        token_buffer_fill(buffer, lexer);
+    }
+
+    if (buffer->position + lookahead >= buffer->count) {
+        // Looking past the end of the source (or beyond capacity):
+        // answer with the final buffered token, normally TOKEN_EOF
+        if (buffer->count > 0) {
+            return buffer->tokens[buffer->count - 1];
+        }
+        return lexer_next_token(lexer);
+    }
+
+    return buffer->tokens[buffer->position + lookahead];
+}
+
 /**
  * Advances the lexer by one UTF-8 character
  *
@@ -360,33 +446,39 @@ static Token scan_token(LexerState* lexer) {
  * @return The scanned identifier token
  */
 static Token scan_identifier(LexerState* lexer) {
-    // Continue reading as long as we find valid identifier characters
-    while (is_identifier_part(peek_utf8_char(lexer))) {
+    // Continue reading as long as we find valid identifier characters.
+    // ASCII runs are consumed in bulk by the vectorized scan; multi-byte
+    // characters are decoded and classified one at a time.
+    for (;;) {
+        size_t run = utf8_ascii_identifier_run(lexer->source + lexer->current,
+                                               lexer->source_length - lexer->current);
+        lexer->current += run;
+
+        if (!is_identifier_part(peek_utf8_char(lexer))) {
+            break;
+        }
         advance(lexer);
     }
-    
-    // Extract the identifier string
+
+    // Intern the identifier: each distinct name is stored exactly once
+    // and the pool owns the string, so nothing is allocated per token
     size_t length = lexer->current - lexer->start;
-    char* identifier = (char*)malloc(length + 1);
+    const char* identifier = intern_string(lexer->source + lexer->start, length);
     if (!identifier) {
         return error_token(lexer, "Memory allocation failed");
     }
-    
-    memcpy(identifier, lexer->source + lexer->start, length);
-    identifier[length] = '\0';
-    
+
     // Check if it's a keyword
     TokenType type = TOKEN_IDENTIFIER;
     if (is_keyword(identifier)) {
         type = get_keyword_token(identifier);
-        free(identifier);
     } else {
-        // If not a keyword, keep the identifier string
+        // If not a keyword, keep the interned identifier string
         Token token = make_token(lexer, type);
-        token.value.string_value = identifier;
+        token.value.string_value = (char*)identifier;
         return token;
     }
-    
+
     return make_token(lexer, type);
 }
 
@@ -414,7 +506,9 @@ static Token scan_number(LexerState* lexer) {
         
         // For now, we're treating all numbers as integers
         // This would be where we handle floating-point values in the future
-        error_report(ERROR_LEXICAL, ERROR_WARNING, lexer->filename, lexer->line, lexer->column,
+        int error_line, error_column;
+        lexer_location(lexer, lexer->current, &error_line, &error_column);
+        error_report(ERROR_LEXICAL, ERROR_WARNING, lexer->filename, error_line, error_column,
                     "Floating-point numbers are not fully supported yet",
                     "Truncating to integer value",
                     __FILE__, __LINE__);
@@ -447,19 +541,57 @@ static Token scan_number(LexerState* lexer) {
  * @return The scanned string token
  */
 static Token scan_string(LexerState* lexer) {
+    // Track line and column for error reporting; the lexeme start is the
+    // opening quote itself
+    int start_line, start_column;
+    lexer_location(lexer, lexer->start, &start_line, &start_column);
+
+    // Fast scan to the closing quote, only noting whether any escape
+    // sequences occur; the common escape-free literal then becomes a
+    // zero-copy slice into the source buffer
+    size_t content_start = lexer->current;
+    bool has_escapes = false;
+    while (lexer->current < lexer->source_length && peek(lexer) != '"') {
+        if (peek(lexer) == '\\') {
+            has_escapes = true;
+            advance(lexer);
+            if (lexer->current >= lexer->source_length) break;
+        }
+        advance(lexer);
+    }
+
+    if (lexer->current >= lexer->source_length || peek(lexer) != '"') {
+        error_report(ERROR_LEXICAL, ERROR_ERROR, lexer->filename, start_line, start_column,
+                    "Unterminated string literal",
+                    "Add closing double quote",
+                    __FILE__, __LINE__);
+        return error_token(lexer, "Unterminated string");
+    }
+
+    if (!has_escapes) {
+        size_t content_length = lexer->current - content_start;
+        advance(lexer); // Consume the closing quote
+
+        Token token = make_token(lexer, TOKEN_STRING);
+        token.value.string_slice.start = lexer->source + content_start;
+        token.value.string_slice.length = content_length;
+        token.value.string_slice.owned = false;
+        return token;
+    }
+
+    // Escapes present: rewind and take the slow path, processing the
+    // sequences into an owned buffer
+    lexer->current = content_start;
+
     // Buffer to build the string, starting with a reasonable size
     size_t buffer_size = 128;
     size_t buffer_pos = 0;
     char* buffer = (char*)malloc(buffer_size);
-    
+
     if (!buffer) {
         return error_token(lexer, "Memory allocation failed");
     }
-    
-    // Track line and column for error reporting
-    int start_line = lexer->line;
-    int start_column = lexer->column - 1; // Adjust for the opening quote
-    
+
     // Read characters until we reach the closing quote
     while (peek(lexer) != '"' && lexer->current < lexer->source_length) {
         int32_t c = advance(lexer);
@@ -524,7 +656,9 @@ static Token scan_string(LexerState* lexer) {
                     free(buffer);
                     char error_msg[64];
                     snprintf(error_msg, sizeof(error_msg), "Invalid escape sequence '\\%c'", (char)next);
-                    error_report(ERROR_LEXICAL, ERROR_ERROR, lexer->filename, lexer->line, lexer->column,
+                    int error_line, error_column;
+                    lexer_location(lexer, lexer->current, &error_line, &error_column);
+                    error_report(ERROR_LEXICAL, ERROR_ERROR, lexer->filename, error_line, error_column,
                                 error_msg, "Use a valid escape sequence (\\n, \\t, etc.)",
                                 __FILE__, __LINE__);
                     return error_token(lexer, error_msg);
@@ -570,29 +704,56 @@ static Token scan_string(LexerState* lexer) {
         }
     }
     
-    // Check if we reached the end of the string
-    if (lexer->current >= lexer->source_length || peek(lexer) != '"') {
-        free(buffer);
-        error_report(ERROR_LEXICAL, ERROR_ERROR, lexer->filename, start_line, start_column,
-                    "Unterminated string literal",
-                    "Add closing double quote",
-                    __FILE__, __LINE__);
-        return error_token(lexer, "Unterminated string");
-    }
-    
-    // Consume the closing quote
+    // The fast scan already verified the closing quote; consume it
     advance(lexer);
-    
+
     // Null-terminate the string
     buffer[buffer_pos] = '\0';
-    
+
     // Create the token
     Token token = make_token(lexer, TOKEN_STRING);
-    token.value.string_value = buffer;
-    
+    token.value.string_slice.start = buffer;
+    token.value.string_slice.length = buffer_pos;
+    token.value.string_slice.owned = true;
+
     return token;
 }
 
+/**
+ * Materialize the contents of a string token as an owned C string
+ *
+ * @param token A TOKEN_STRING token
+ * @return A freshly allocated copy the caller must free, or NULL
+ */
+char* token_string_value(const Token* token) {
+    if (token->type != TOKEN_STRING || token->value.string_slice.start == NULL) {
+        return NULL;
+    }
+
+    size_t length = token->value.string_slice.length;
+    char* copy = (char*)malloc(length + 1);
+    if (!copy) {
+        return NULL;
+    }
+    memcpy(copy, token->value.string_slice.start, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+/**
+ * Release the heap buffer behind a string token, if it owns one
+ *
+ * @param token The token to release
+ */
+void token_string_release(Token* token) {
+    if (token->type == TOKEN_STRING && token->value.string_slice.owned) {
+        free((void*)token->value.string_slice.start);
+        token->value.string_slice.start = NULL;
+        token->value.string_slice.length = 0;
+        token->value.string_slice.owned = false;
+    }
+}
+
 /**
  * Scan a character literal token
  *
@@ -600,10 +761,11 @@ static Token scan_string(LexerState* lexer) {
  * @return The scanned character token
  */
 static Token scan_character_literal(LexerState* lexer) {
-    // Track line and column for error reporting
-    int start_line = lexer->line;
-    int start_column = lexer->column - 1; // Adjust for the opening quote
-    
+    // Track line and column for error reporting; the lexeme start is the
+    // opening quote itself
+    int start_line, start_column;
+    lexer_location(lexer, lexer->start, &start_line, &start_column);
+
     // Read the character
     int32_t c;
     
@@ -644,7 +806,9 @@ static Token scan_character_literal(LexerState* lexer) {
             default: {
                 char error_msg[64];
                 snprintf(error_msg, sizeof(error_msg), "Invalid escape sequence '\\%c'", (char)peek(lexer));
-                error_report(ERROR_LEXICAL, ERROR_ERROR, lexer->filename, lexer->line, lexer->column,
+                int error_line, error_column;
+                lexer_location(lexer, lexer->current, &error_line, &error_column);
+                error_report(ERROR_LEXICAL, ERROR_ERROR, lexer->filename, error_line, error_column,
                             error_msg, "Use a valid escape sequence (\\n, \\t, etc.)",
                             __FILE__, __LINE__);
                 return error_token(lexer, error_msg);
@@ -832,7 +996,9 @@ void token_print(Token token) {
             printf(", value: %ld", (long)token.value.int_value);
             break;
         case TOKEN_STRING:
-            printf(", value: \"%s\"", token.value.string_value ? token.value.string_value : "");
+            printf(", value: \"%.*s\"",
+                   (int)token.value.string_slice.length,
+                   token.value.string_slice.start ? token.value.string_slice.start : "");
             break;
         case TOKEN_CHAR_LITERAL:
             if (token.value.char_value >= 32 && token.value.char_value <= 126) {
@@ -857,17 +1023,11 @@ void lexer_print_all_tokens(LexerState* lexer) {
     // Save lexer state
     size_t saved_current = lexer->current;
     size_t saved_start = lexer->start;
-    int saved_line = lexer->line;
-    int saved_column = lexer->column;
-    int saved_prev_column = lexer->previous_column;
     bool saved_has_next = lexer->has_next_token;
-    
+
     // Reset lexer
     lexer->current = 0;
     lexer->start = 0;
-    lexer->line = 1;
-    lexer->column = 1;
-    lexer->previous_column = 1;
     lexer->has_next_token = false;
     
     // Print all tokens
@@ -893,9 +1053,6 @@ void lexer_print_all_tokens(LexerState* lexer) {
     // Restore lexer state
     lexer->current = saved_current;
     lexer->start = saved_start;
-    lexer->line = saved_line;
-    lexer->column = saved_column;
-    lexer->previous_column = saved_prev_column;
     lexer->has_next_token = saved_has_next;
 }
 
@@ -953,14 +1110,10 @@ static int32_t advance(LexerState* lexer) {
     }
     
     unsigned char first_byte = (unsigned char)lexer->source[lexer->current++];
-    
-    // Update column count
-    lexer->previous_column = lexer->column++;
-    
-    // If we see a newline, increment the line count
+
+    // Newlines are just another byte: positions are resolved on demand
+    // from the line-start index, so no per-character bookkeeping here
     if (first_byte == '\n') {
-        lexer->line++;
-        lexer->column = 1;
         return '\n';
     }
     
@@ -987,13 +1140,11 @@ static int32_t advance(LexerState* lexer) {
         }
         
         unsigned char next_byte = (unsigned char)lexer->source[lexer->current++];
-        lexer->column++; // Update column for each byte
-        
+
         if ((next_byte & 0xC0) != 0x80) {
             // Invalid continuation byte
             // Rewind the lexer position
             lexer->current--;
-            lexer->column--;
             return first_byte;
         }
         
@@ -1054,10 +1205,9 @@ static bool match(LexerState* lexer, char expected) {
     if (lexer->source[lexer->current] != expected) {
         return false;
     }
-    
+
     lexer->current++;
-    lexer->column++;
-    
+
     return true;
 }
 
@@ -1073,20 +1223,24 @@ static void skip_whitespace(LexerState* lexer) {
         switch (c) {
             case ' ':
             case '\t':
+                // Skip the whole indentation run in one vectorized scan
+                lexer->current += utf8_ascii_space_run(lexer->source + lexer->current,
+                                                       lexer->source_length - lexer->current);
+                break;
+
             case '\r':
                 advance(lexer);
                 break;
-                
+
             case '\n':
                 advance(lexer);
                 break;
-                
+
             case '/':
                 if (peek_next(lexer) == '/') {
-                    // Single-line comment
-                    while (peek(lexer) != '\n' && peek(lexer) != '\0') {
-                        advance(lexer);
-                    }
+                    // Single-line comment: consume up to the newline in one scan
+                    lexer->current += utf8_line_run(lexer->source + lexer->current,
+                                                    lexer->source_length - lexer->current);
                 } else if (peek_next(lexer) == '*') {
                     // Multi-line comment
                     advance(lexer); // Consume '/'
@@ -1104,7 +1258,9 @@ static void skip_whitespace(LexerState* lexer) {
                     }
                     
                     if (lexer->current >= lexer->source_length) {
-                        error_report(ERROR_LEXICAL, ERROR_WARNING, lexer->filename, lexer->line, lexer->column,
+                        int error_line, error_column;
+                        lexer_location(lexer, lexer->current, &error_line, &error_column);
+                        error_report(ERROR_LEXICAL, ERROR_WARNING, lexer->filename, error_line, error_column,
                                    "Unterminated multi-line comment",
                                    "Add */ to close the comment",
                                    __FILE__, __LINE__);
@@ -1133,12 +1289,13 @@ static Token make_token(LexerState* lexer, TokenType type) {
     token.type = type;
     token.lexeme = lexer->source + lexer->start;
     token.lexeme_length = lexer->current - lexer->start;
-    token.line = lexer->line;
-    token.column = lexer->column - (int)token.lexeme_length;
-    
+
+    // Resolve the token position from the line-start index on demand
+    lexer_location(lexer, lexer->start, &token.line, &token.column);
+
     // Initialize value to zero
     token.value.int_value = 0;
-    
+
     return token;
 }
 
@@ -1154,9 +1311,8 @@ static Token error_token(LexerState* lexer, const char* message) {
     token.type = TOKEN_ERROR;
     token.lexeme = message;
     token.lexeme_length = strlen(message);
-    token.line = lexer->line;
-    token.column = lexer->column;
+    lexer_location(lexer, lexer->current, &token.line, &token.column);
     token.value.int_value = 0;
-    
+
     return token;
 }
\ No newline at end of file
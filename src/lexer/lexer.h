@@ -23,6 +23,10 @@
  * - All tokens must handle UTF-8 encoded identifiers and keywords
  * - Character literals are stored as WORD-sized values (native machine word)
  * - Numeric literals are assumed to fit in a machine word
+ * - The source buffer and line index live in a shared SourceManager:
+ *   regular files are memory-mapped read-only so tokens' lexeme fields
+ *   reference the mapping directly (zero-copy), and the error reporter
+ *   resolves excerpts against the same buffer
  */
 
 #ifndef LEXER_H
@@ -32,6 +36,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "../utils/utf8.h"
+#include "../utils/source_manager.h"
 #include "../target/target_info.h"
 
 // Token type definitions - combined with keywords.h TokenType
@@ -106,8 +111,13 @@ typedef struct {
     int column;              // Column number in source (1-based)
     union {
         intptr_t int_value;  // Integer value for numeric literals
-        char* string_value;  // String value (allocated)
+        char* string_value;  // Identifier name (interned)
         int32_t char_value;  // Character value for char literals (UTF-8 codepoint)
+        struct {
+            const char* start; // Literal contents, without the quotes
+            size_t length;     // Length of the contents in bytes
+            bool owned;        // True when escapes forced a heap copy
+        } string_slice;      // String literal contents (TOKEN_STRING)
     } value;                 // Value associated with the token (for literals)
 } Token;
 
@@ -116,20 +126,29 @@ typedef struct LexerState LexerState;
 
 // Lexer state structure
 struct LexerState {
-    const char* source;      // Source code as a string
+    const char* source;      // View into the source manager's buffer
     const char* filename;    // Source filename for error reporting
     size_t source_length;    // Length of source in bytes
     size_t current;          // Current position in source
     size_t start;            // Start of the current lexeme
-    int line;                // Current line number (1-based)
-    int column;              // Current column number (1-based)
-    int previous_column;     // Previous column, for tracking newlines
+    SourceManager* source_manager; // Owns the buffer and line index
     Token current_token;     // Currently processed token
     Token next_token;        // Next token (for peek)
     bool has_next_token;     // Whether next_token has been filled
     TargetInfo target_info;  // Target architecture information (for word size)
 };
 
+// Batched token buffer: the lexer fills a caller-provided array of
+// tokens in bulk and the consumer walks it with index arithmetic,
+// which amortizes per-token call overhead and gives k-token lookahead
+typedef struct {
+    Token* tokens;       // Caller-provided token storage
+    size_t capacity;     // Number of slots in tokens
+    size_t count;        // Number of valid tokens currently buffered
+    size_t position;     // Index of the next token to consume
+    bool at_end;         // Whether TOKEN_EOF or TOKEN_ERROR has been buffered
+} TokenBuffer;
+
 /**
  * Initialize a new lexer with the given source code
  *
@@ -163,6 +182,85 @@ Token lexer_next_token(LexerState* lexer);
  */
 Token lexer_peek_token(LexerState* lexer);
 
+/**
+ * Materialize the contents of a string token as an owned C string
+ *
+ * Escape-free literals are zero-copy slices into the source buffer;
+ * this makes a NUL-terminated heap copy for consumers that need one.
+ *
+ * @param token A TOKEN_STRING token
+ * @return A freshly allocated copy the caller must free, or NULL
+ */
+char* token_string_value(const Token* token);
+
+/**
+ * Release the heap buffer behind a string token, if it owns one
+ *
+ * Only literals containing escape sequences own a buffer; for
+ * zero-copy slices this is a no-op.
+ *
+ * @param token The token to release
+ */
+void token_string_release(Token* token);
+
+/**
+ * Compute the line and column for a byte offset in the source
+ *
+ * Delegates to the source manager's line-start index, so the lexing
+ * hot loop carries no line/column bookkeeping; positions are resolved
+ * by binary search only when a token or diagnostic needs one.
+ *
+ * @param lexer The lexer state
+ * @param offset Byte offset into the source buffer
+ * @param line Output: 1-based line number
+ * @param column Output: 1-based byte column within the line
+ */
+void lexer_location(LexerState* lexer, size_t offset, int* line, int* column);
+
+/**
+ * Initialize a token buffer over caller-provided storage
+ *
+ * @param buffer The token buffer to initialize
+ * @param storage Array of at least capacity tokens owned by the caller
+ * @param capacity Number of slots in storage; must exceed the deepest
+ *                 lookahead the consumer will request
+ */
+void token_buffer_init(TokenBuffer* buffer, Token* storage, size_t capacity);
+
+/**
+ * Refill a token buffer from the lexer
+ *
+ * Compacts any unconsumed tokens to the front of the buffer and lexes
+ * new tokens into the remaining slots. Lexing stops once TOKEN_EOF or
+ * TOKEN_ERROR has been buffered; the sentinel itself is included.
+ *
+ * @param buffer The token buffer to refill
+ * @param lexer The lexer to pull tokens from
+ * @return The number of buffered tokens available for consumption
+ */
+size_t token_buffer_fill(TokenBuffer* buffer, LexerState* lexer);
+
+/**
+ * Consume the next token from the buffer, refilling when it runs dry
+ *
+ * @param buffer The token buffer
+ * @param lexer The lexer to refill from
+ * @return The next token; TOKEN_EOF repeatedly once the source is exhausted
+ */
+Token token_buffer_next(TokenBuffer* buffer, LexerState* lexer);
+
+/**
+ * Look ahead in the buffer without consuming tokens
+ *
+ * @param buffer The token buffer
+ * @param lexer The lexer to refill from
+ * @param lookahead How far ahead to look: 0 is the token that
+ *                  token_buffer_next would return
+ * @return The token at the requested offset; the final buffered token
+ *         (normally TOKEN_EOF) when looking past the end of the source
+ */
+Token token_buffer_peek(TokenBuffer* buffer, LexerState* lexer, size_t lookahead);
+
 /**
  * Get a string representation of a token type
  *
@@ -0,0 +1,167 @@
+/*
+ * filename: token_pipeline.c
+ *
+ * Purpose:
+ * Implementation of pipelined lexing for the ћ++ compiler. A producer
+ * thread tokenizes the source ahead of the consumer and hands tokens
+ * over through a lock-free single-producer/single-consumer ring.
+ *
+ * Key Components:
+ * - TokenPipeline struct: Ring storage, atomic head/tail, thread handle
+ * - pipeline_producer(): Thread body running lexer_next_token in a loop
+ * - token_pipeline_next(): Consumer side of the ring
+ *
+ * Interactions:
+ * - Uses lexer.h for token production
+ * - Uses C11 atomics for the ring indices and pthreads for the producer
+ *
+ * Notes:
+ * - head (consumer) and tail (producer) only ever advance; the ring is
+ *   full when tail - head == capacity and empty when tail == head
+ * - Release/acquire ordering on tail publishes each token slot to the
+ *   consumer; the same ordering on head returns slots to the producer
+ * - Both sides yield the CPU while spinning so a busy ring does not
+ *   starve the other thread on a loaded machine
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "token_pipeline.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+
+// Default ring size when the caller passes 0
+#define PIPELINE_DEFAULT_CAPACITY 1024
+
+struct TokenPipeline {
+    Token* ring;                 // Ring storage, capacity slots
+    size_t capacity;             // Power-of-two number of slots
+    _Atomic size_t head;         // Next slot the consumer will read
+    _Atomic size_t tail;         // Next slot the producer will write
+    atomic_bool shutdown;        // Consumer asked the producer to stop
+    pthread_t producer;          // Producer thread handle
+    bool producer_started;       // Whether producer holds a valid thread
+    LexerState* lexer;           // Lexer driven by the producer thread
+    Token final_token;           // Copy of the stream-ending token
+    bool finished;               // Consumer has seen the final token
+};
+
+/*
+ * Round a capacity up to the next power of two so ring indices can
+ * wrap with a mask instead of a division.
+ */
+static size_t round_up_pow2(size_t value) {
+    size_t pow2 = 1;
+    while (pow2 < value) {
+        pow2 <<= 1;
+    }
+    return pow2;
+}
+
+/*
+ * Producer thread body: lex tokens into the ring until the stream ends
+ * or the consumer requests shutdown.
+ */
+static void* pipeline_producer(void* arg) {
+    TokenPipeline* pipeline = (TokenPipeline*)arg;
+
+    for (;;) {
+        Token token = lexer_next_token(pipeline->lexer);
+
+        // Wait for a free slot; head is published by the consumer
+        size_t tail = atomic_load_explicit(&pipeline->tail, memory_order_relaxed);
+        while (tail - atomic_load_explicit(&pipeline->head, memory_order_acquire)
+               == pipeline->capacity) {
+            if (atomic_load_explicit(&pipeline->shutdown, memory_order_relaxed)) {
+                return NULL;
+            }
+            sched_yield();
+        }
+
+        pipeline->ring[tail & (pipeline->capacity - 1)] = token;
+        // Publish the slot to the consumer
+        atomic_store_explicit(&pipeline->tail, tail + 1, memory_order_release);
+
+        if (token.type == TOKEN_EOF || token.type == TOKEN_ERROR) {
+            return NULL;
+        }
+    }
+}
+
+TokenPipeline* token_pipeline_start(LexerState* lexer, size_t ring_capacity) {
+    if (!lexer) {
+        return NULL;
+    }
+
+    TokenPipeline* pipeline = (TokenPipeline*)calloc(1, sizeof(TokenPipeline));
+    if (!pipeline) {
+        return NULL;
+    }
+
+    if (ring_capacity == 0) {
+        ring_capacity = PIPELINE_DEFAULT_CAPACITY;
+    }
+    pipeline->capacity = round_up_pow2(ring_capacity);
+
+    pipeline->ring = (Token*)malloc(pipeline->capacity * sizeof(Token));
+    if (!pipeline->ring) {
+        free(pipeline);
+        return NULL;
+    }
+
+    pipeline->lexer = lexer;
+    atomic_init(&pipeline->head, 0);
+    atomic_init(&pipeline->tail, 0);
+    atomic_init(&pipeline->shutdown, false);
+    pipeline->finished = false;
+
+    if (pthread_create(&pipeline->producer, NULL, pipeline_producer, pipeline) != 0) {
+        free(pipeline->ring);
+        free(pipeline);
+        return NULL;
+    }
+    pipeline->producer_started = true;
+
+    return pipeline;
+}
+
+Token token_pipeline_next(TokenPipeline* pipeline) {
+    // Past the end of the stream: repeat the final token
+    if (pipeline->finished) {
+        return pipeline->final_token;
+    }
+
+    // Wait for a published slot; tail is published by the producer
+    size_t head = atomic_load_explicit(&pipeline->head, memory_order_relaxed);
+    while (head == atomic_load_explicit(&pipeline->tail, memory_order_acquire)) {
+        sched_yield();
+    }
+
+    Token token = pipeline->ring[head & (pipeline->capacity - 1)];
+    // Return the slot to the producer
+    atomic_store_explicit(&pipeline->head, head + 1, memory_order_release);
+
+    if (token.type == TOKEN_EOF || token.type == TOKEN_ERROR) {
+        pipeline->final_token = token;
+        pipeline->finished = true;
+    }
+
+    return token;
+}
+
+void token_pipeline_stop(TokenPipeline* pipeline) {
+    if (!pipeline) {
+        return;
+    }
+
+    if (pipeline->producer_started) {
+        // Unblock the producer if it is waiting on a full ring
+        atomic_store_explicit(&pipeline->shutdown, true, memory_order_relaxed);
+        pthread_join(pipeline->producer, NULL);
+    }
+
+    free(pipeline->ring);
+    free(pipeline);
+}
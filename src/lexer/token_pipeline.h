@@ -0,0 +1,72 @@
+/*
+ * filename: token_pipeline.h
+ *
+ * Purpose:
+ * Header file for the pipelined lexing mode of the ћ++ compiler.
+ * A dedicated producer thread runs the lexer ahead of the consumer
+ * (normally the parser) and publishes tokens through a lock-free
+ * single-producer/single-consumer ring buffer, overlapping UTF-8
+ * decoding with AST construction on multi-core machines.
+ *
+ * Key Components:
+ * - TokenPipeline: Opaque pipeline handle owning the ring and thread
+ * - token_pipeline_start(): Spawn the lexer thread over a LexerState
+ * - token_pipeline_next(): Consume the next token, blocking if needed
+ * - token_pipeline_stop(): Join the thread and release the pipeline
+ *
+ * Interactions:
+ * - Wraps lexer.h; the pipeline owns token production but not the lexer
+ * - Intended for parser.c as a drop-in replacement for lexer_next_token
+ *
+ * Notes:
+ * - Exactly one producer (the internal thread) and one consumer
+ *   (the caller of token_pipeline_next) are supported
+ * - The stream always ends with TOKEN_EOF or TOKEN_ERROR; further
+ *   token_pipeline_next calls repeat that final token
+ */
+
+#ifndef TOKEN_PIPELINE_H
+#define TOKEN_PIPELINE_H
+
+#include "lexer.h"
+
+// Opaque pipeline handle
+typedef struct TokenPipeline TokenPipeline;
+
+/**
+ * Start a lexing pipeline over an initialized lexer
+ *
+ * Spawns a background thread that calls lexer_next_token until the
+ * stream ends, publishing tokens into an internal ring buffer. The
+ * caller must not touch the lexer until token_pipeline_stop returns.
+ *
+ * @param lexer The lexer to run on the background thread
+ * @param ring_capacity Ring size in tokens (rounded up to a power of two)
+ * @return A new pipeline, or NULL on allocation or thread failure
+ */
+TokenPipeline* token_pipeline_start(LexerState* lexer, size_t ring_capacity);
+
+/**
+ * Consume the next token from the pipeline
+ *
+ * Waits for the producer when the ring is empty; once the final
+ * TOKEN_EOF/TOKEN_ERROR has been consumed it is returned again on
+ * every subsequent call.
+ *
+ * @param pipeline The pipeline to consume from
+ * @return The next token in source order
+ */
+Token token_pipeline_next(TokenPipeline* pipeline);
+
+/**
+ * Shut down a pipeline
+ *
+ * Joins the producer thread (draining the ring if it is blocked on a
+ * full ring) and frees the pipeline. The wrapped lexer is untouched
+ * and remains owned by the caller.
+ *
+ * @param pipeline The pipeline to stop, may be NULL
+ */
+void token_pipeline_stop(TokenPipeline* pipeline);
+
+#endif /* TOKEN_PIPELINE_H */
@@ -20,6 +20,9 @@
  * 
  * Notes:
  * - Supports various command-line options for controlling the compiler
+ * - Compiles multiple input files concurrently on a thread pool sized
+ *   to the machine (-j overrides); read-only keyword and target tables
+ *   are shared and per-thread error lists are merged at the end
  * - Detects target architecture using target_info.h
  * - Can stop compilation after specific phases (lexing, parsing, etc.)
  * - Handles UTF-8 encoded filenames and paths
@@ -29,16 +32,30 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 // Include needed compiler components
 #include "utils/utf8.h"
 // Other includes will be uncommented as they are implemented
 #include "utils/error.h"
+#include "utils/arena.h"
+#include "utils/timing.h"
+#include "utils/memstats.h"
+#include "parser/ast.h"
+#include "parser/ast_cache.h"
 #include "target/target_info.h"
 
 // Compiler configuration structure
 typedef struct {
-    char* input_file;           // Input source file path
+    char* input_file;           // Source file this invocation compiles
+    char** input_files;         // All input files from the command line
+    int input_file_count;       // Number of input files
+    int jobs;                   // Compile threads (0 = one per processor)
     char* output_file;          // Output file path
     bool generate_assembly;     // Generate assembly only (-S flag)
     bool stop_after_lexing;     // Stop after lexical analysis
@@ -47,6 +64,14 @@ typedef struct {
     bool stop_after_ir;         // Stop after IR generation
     bool verbose;               // Verbose output
     bool generate_error_log;    // Generate error log file
+    bool incremental;           // Reuse the previous output when unchanged
+    bool fused_semantic;        // Run semantic checks inline during parsing
+    bool server_mode;           // Stay resident and serve compile requests
+    char* server_socket;        // Unix socket path in server mode
+    bool jit_run;               // Execute in process instead of emitting output
+    intptr_t jit_result;        // Return value of главна() in JIT mode
+    bool time_passes;           // Report per-phase times and counters
+    bool mem_stats;             // Report per-phase memory statistics
     char* target_arch;          // Target architecture (x86 or x86-64)
     int optimization_level;     // Optimization level (0-3)
 } CompilerConfig;
@@ -54,13 +79,20 @@ typedef struct {
 // Function to print usage information
 void print_help(const char* program_name) {
     printf("ћ++ Compiler - A compiler for the ћ++ programming language\n");
-    printf("\nUsage: %s [options] input-file\n", program_name);
+    printf("\nUsage: %s [options] input-files...\n", program_name);
     printf("\nOptions:\n");
-    printf("  -o <file>              Specify output file name\n");
+    printf("  -o <file>              Specify output file name (single input only)\n");
+    printf("  -j<count>              Compile threads for multiple inputs (default: all processors)\n");
     printf("  -S                     Generate assembly code only\n");
     printf("  --target=<arch>        Target architecture (x86, x86-64, default: current machine)\n");
     printf("  -O<level>              Optimization level (0-3, default: 0)\n");
     printf("  --verbose              Verbose output\n");
+    printf("  --time-passes          Report per-phase times and hot-path counters\n");
+    printf("  --mem-stats            Report per-phase allocation and peak-memory statistics\n");
+    printf("  --incremental          Skip compilation when source and options are unchanged\n");
+    printf("  --fused-semantic       Run semantic checks inline during parsing (one tree walk)\n");
+    printf("  --run                  Execute the program in process (JIT) instead of emitting output\n");
+    printf("  --server[=<socket>]    Stay resident and serve compile requests on a Unix socket\n");
     printf("  --generate-error-log    Generate error log file\n");
     printf("  --stop-after-lexing    Stop after lexical analysis\n");
     printf("  --stop-after-parsing   Stop after syntax analysis\n");
@@ -77,6 +109,9 @@ void print_help(const char* program_name) {
 bool process_args(int argc, char* argv[], CompilerConfig* config) {
     // Initialize config with default values
     config->input_file = NULL;
+    config->input_files = NULL;
+    config->input_file_count = 0;
+    config->jobs = 0;
     config->output_file = NULL;
     config->generate_assembly = false;
     config->stop_after_lexing = false;
@@ -85,6 +120,14 @@ bool process_args(int argc, char* argv[], CompilerConfig* config) {
     config->stop_after_ir = false;
     config->verbose = false;
     config->generate_error_log = false;
+    config->incremental = false;
+    config->fused_semantic = false;
+    config->server_mode = false;
+    config->server_socket = NULL;
+    config->jit_run = false;
+    config->jit_result = 0;
+    config->time_passes = false;
+    config->mem_stats = false;
     config->target_arch = NULL;
     config->optimization_level = 0;
     
@@ -123,10 +166,47 @@ bool process_args(int argc, char* argv[], CompilerConfig* config) {
                 return false;
             }
         }
+        // Handle compile thread count
+        else if (strncmp(argv[i], "-j", 2) == 0) {
+            int jobs = atoi(&argv[i][2]);
+            if (jobs < 1) {
+                fprintf(stderr, "Error: Invalid thread count. Use -j1 or higher\n");
+                return false;
+            }
+            config->jobs = jobs;
+        }
         // Handle verbose flag
         else if (strcmp(argv[i], "--verbose") == 0) {
             config->verbose = true;
         }
+        // Handle incremental recompilation flag
+        else if (strcmp(argv[i], "--incremental") == 0) {
+            config->incremental = true;
+        }
+        // Handle fused parse + semantic analysis flag
+        else if (strcmp(argv[i], "--fused-semantic") == 0) {
+            config->fused_semantic = true;
+        }
+        // Handle phase timing instrumentation
+        else if (strcmp(argv[i], "--time-passes") == 0) {
+            config->time_passes = true;
+        }
+        // Handle memory statistics instrumentation
+        else if (strcmp(argv[i], "--mem-stats") == 0) {
+            config->mem_stats = true;
+        }
+        // Handle in-process JIT execution
+        else if (strcmp(argv[i], "--run") == 0) {
+            config->jit_run = true;
+        }
+        // Handle compile-server mode
+        else if (strcmp(argv[i], "--server") == 0) {
+            config->server_mode = true;
+        }
+        else if (strncmp(argv[i], "--server=", 9) == 0) {
+            config->server_mode = true;
+            config->server_socket = &argv[i][9];
+        }
         // Handle target architecture
         else if (strncmp(argv[i], "--target=", 9) == 0) {
             config->target_arch = &argv[i][9];
@@ -153,31 +233,57 @@ bool process_args(int argc, char* argv[], CompilerConfig* config) {
         else if (strcmp(argv[i], "--generate-error-log") == 0) {
             config->generate_error_log = true;
         }
-        // Assume anything else is an input file
-        else if (config->input_file == NULL) {
-            config->input_file = argv[i];
-            
+        // Reject unknown options
+        else if (argv[i][0] == '-') {
+            fprintf(stderr, "Error: Unknown option: %s\n", argv[i]);
+            return false;
+        }
+        // Anything else is an input file
+        else {
+            char** resized = realloc(config->input_files,
+                                     (config->input_file_count + 1) * sizeof(char*));
+            if (resized == NULL) {
+                fprintf(stderr, "Error: Memory allocation failed\n");
+                return false;
+            }
+            config->input_files = resized;
+            config->input_files[config->input_file_count++] = argv[i];
+
             // Check if file has correct extension
-            size_t len = strlen(config->input_file);
-            if (len < 5 || strcmp(&config->input_file[len-4], ".ћпп") != 0) {
+            size_t len = strlen(argv[i]);
+            if (len < 5 || strcmp(&argv[i][len-4], ".ћпп") != 0) {
                 fprintf(stderr, "Warning: Input file does not have .ћпп extension\n");
             }
         }
-        // Unknown option
-        else {
-            fprintf(stderr, "Error: Unknown option or multiple input files: %s\n", argv[i]);
-            return false;
-        }
     }
-    
-    // Verify we have an input file
-    if (config->input_file == NULL) {
+
+    // Verify we have an input file; a server gets its inputs from
+    // requests instead
+    if (config->input_file_count == 0) {
+        if (config->server_mode) {
+            return true;
+        }
         fprintf(stderr, "Error: No input file specified\n");
         return false;
     }
-    
-    // If no output file specified, default to a.out or file.asm for assembly
-    if (config->output_file == NULL) {
+    config->input_file = config->input_files[0];
+
+    // A single explicit output name cannot cover several inputs; each
+    // file derives its own output path instead
+    if (config->output_file != NULL && config->input_file_count > 1) {
+        fprintf(stderr, "Error: -o cannot be used with multiple input files\n");
+        return false;
+    }
+
+    // JIT execution runs exactly one program and produces no output file
+    if (config->jit_run && config->input_file_count > 1) {
+        fprintf(stderr, "Error: --run supports a single input file\n");
+        return false;
+    }
+
+    // If no output file specified, default to a.out or file.asm for
+    // assembly; with multiple inputs each worker derives its own path
+    if (config->output_file == NULL && config->input_file_count == 1) {
         if (config->generate_assembly) {
             // Create output filename by replacing extension with .asm
             size_t len = strlen(config->input_file);
@@ -211,8 +317,17 @@ bool process_args(int argc, char* argv[], CompilerConfig* config) {
     // Print configuration if verbose
     if (config->verbose) {
         printf("ћ++ Compiler Configuration:\n");
-        printf("  Input file: %s\n", config->input_file);
-        printf("  Output file: %s\n", config->output_file);
+        if (config->input_file_count == 1) {
+            printf("  Input file: %s\n", config->input_file);
+            printf("  Output file: %s\n", config->output_file);
+        } else {
+            printf("  Input files: %d\n", config->input_file_count);
+            if (config->jobs > 0) {
+                printf("  Compile threads: %d\n", config->jobs);
+            } else {
+                printf("  Compile threads: one per processor\n");
+            }
+        }
         printf("  Generate assembly only: %s\n", config->generate_assembly ? "yes" : "no");
         printf("  Target architecture: %s\n", config->target_arch ? config->target_arch : "native");
         printf("  Optimization level: O%d\n", config->optimization_level);
@@ -226,6 +341,116 @@ bool process_args(int argc, char* argv[], CompilerConfig* config) {
     return true;
 }
 
+// Read the whole source file into a malloc'd buffer for cache checks
+static char* read_source_text(FILE* file, size_t* length_out) {
+    if (fseek(file, 0, SEEK_END) != 0) return NULL;
+    long file_size = ftell(file);
+    if (file_size < 0 || fseek(file, 0, SEEK_SET) != 0) return NULL;
+
+    char* text = malloc((size_t)file_size + 1);
+    if (!text) return NULL;
+
+    size_t read_bytes = fread(text, 1, (size_t)file_size, file);
+    text[read_bytes] = '\0';
+    *length_out = read_bytes;
+    return text;
+}
+
+//------------------------------------------------------------------------------
+// Incremental recompilation manifest
+//------------------------------------------------------------------------------
+
+// On-disk record written next to the output artifact after a successful
+// build. A rebuild is skipped when the source hash and the build options
+// still match and the artifact is still present.
+#define MANIFEST_MAGIC   0x045B4D41u  // 'ћ' (U+045B) + "MA"
+#define MANIFEST_VERSION 1u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t source_hash;    // FNV-1a of the source text
+    uint64_t source_length;  // Length of the source text in bytes
+    uint64_t config_hash;    // Hash of the build options that affect output
+} BuildManifest;
+
+// Derive the manifest path by appending ".ћман" to the output path
+static char* manifest_derive_path(const char* output_file) {
+    static const char manifest_ext[] = ".ћман";
+
+    size_t len = strlen(output_file);
+    char* path = malloc(len + sizeof(manifest_ext));
+    if (!path) return NULL;
+
+    memcpy(path, output_file, len);
+    memcpy(path + len, manifest_ext, sizeof(manifest_ext));
+    return path;
+}
+
+// Hash the configuration fields that change the produced artifact
+static uint64_t manifest_config_hash(const CompilerConfig* config) {
+    char options[64];
+    int written = snprintf(options, sizeof(options), "%s|%d|%d",
+                           config->target_arch ? config->target_arch : "native",
+                           config->optimization_level,
+                           config->generate_assembly ? 1 : 0);
+    return ast_cache_source_hash(options, (size_t)written);
+}
+
+// Check whether the previous output can be reused as-is
+static bool manifest_is_current(const CompilerConfig* config,
+                                const char* source_text, size_t source_length) {
+    // The artifact itself must still exist
+    FILE* output = fopen(config->output_file, "rb");
+    if (!output) return false;
+    fclose(output);
+
+    char* manifest_path = manifest_derive_path(config->output_file);
+    if (!manifest_path) return false;
+
+    FILE* file = fopen(manifest_path, "rb");
+    free(manifest_path);
+    if (!file) return false;
+
+    BuildManifest manifest;
+    bool current = fread(&manifest, sizeof(manifest), 1, file) == 1 &&
+                   manifest.magic == MANIFEST_MAGIC &&
+                   manifest.version == MANIFEST_VERSION &&
+                   manifest.source_length == (uint64_t)source_length &&
+                   manifest.source_hash == ast_cache_source_hash(source_text, source_length) &&
+                   manifest.config_hash == manifest_config_hash(config);
+
+    fclose(file);
+    return current;
+}
+
+// Record a successful build so the next identical run can skip it
+static void manifest_write(const CompilerConfig* config,
+                           const char* source_text, size_t source_length) {
+    char* manifest_path = manifest_derive_path(config->output_file);
+    if (!manifest_path) return;
+
+    BuildManifest manifest = {0};
+    manifest.magic = MANIFEST_MAGIC;
+    manifest.version = MANIFEST_VERSION;
+    manifest.source_hash = ast_cache_source_hash(source_text, source_length);
+    manifest.source_length = (uint64_t)source_length;
+    manifest.config_hash = manifest_config_hash(config);
+
+    FILE* file = fopen(manifest_path, "wb");
+    if (file) {
+        if (fwrite(&manifest, sizeof(manifest), 1, file) != 1) {
+            // A truncated manifest would never match; remove it
+            fclose(file);
+            remove(manifest_path);
+        } else {
+            fclose(file);
+        }
+    }
+
+    free(manifest_path);
+}
+
 // Function to execute compiler pipeline stages
 bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
     // This function will coordinate all the compilation phases
@@ -233,14 +458,38 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
     
     FILE* input_file = fopen(config->input_file, "r");
     if (!input_file) {
-        error_report(ERROR_IO, ERROR_FATAL, config->input_file, 0, 0, 
-                    "Could not open input file", 
-                    "Check that the file exists and you have read permissions", 
+        error_report(ERROR_IO, ERROR_FATAL, config->input_file, 0, 0,
+                    "Could not open input file",
+                    "Check that the file exists and you have read permissions",
                     __FILE__, __LINE__);
         return false;
     }
-    
+
+    // In incremental mode, reuse the previous artifact when neither the
+    // source nor the build options changed since the manifest was written
+    char* manifest_source = NULL;
+    size_t manifest_source_length = 0;
+    bool full_build = !config->stop_after_lexing && !config->stop_after_parsing &&
+                      !config->stop_after_semantic && !config->stop_after_ir;
+
+    if (config->incremental && full_build) {
+        manifest_source = read_source_text(input_file, &manifest_source_length);
+        rewind(input_file);
+
+        if (manifest_source &&
+            manifest_is_current(config, manifest_source, manifest_source_length)) {
+            if (config->verbose) {
+                printf("Output %s is up to date, skipping compilation\n",
+                       config->output_file);
+            }
+            free(manifest_source);
+            fclose(input_file);
+            return true;
+        }
+    }
+
     // TODO: Implement lexical analysis phase
+    timing_phase_begin(TIMING_PHASE_LEXING);
     // LexerState* lexer = lexer_init(input_file, config->input_file);
     // if (!lexer) {
     //     error_report(ERROR_INTERNAL, ERROR_FATAL, config->input_file, 0, 0, 
@@ -250,7 +499,8 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
     //     fclose(input_file);
     //     return false;
     // }
-    
+    timing_phase_end(TIMING_PHASE_LEXING);
+
     // If we're stopping after lexing, print token stream and exit
     if (config->stop_after_lexing) {
         if (config->verbose) {
@@ -263,6 +513,7 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
     }
     
     // TODO: Implement parsing phase
+    timing_phase_begin(TIMING_PHASE_PARSING);
     // ASTNode* ast_root = parser_parse(lexer);
     // if (!ast_root) {
     //     error_report(ERROR_SYNTAX, ERROR_FATAL, config->input_file, 0, 0, 
@@ -273,39 +524,79 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
     //     fclose(input_file);
     //     return false;
     // }
-    
+    timing_phase_end(TIMING_PHASE_PARSING);
+
     // If we're stopping after parsing, print AST and exit
     if (config->stop_after_parsing) {
         if (config->verbose) {
             printf("Stopping after syntax analysis as requested\n");
         }
-        // TODO: ast_print(ast_root);
-        // ast_cleanup(ast_root);
-        // lexer_cleanup(lexer);
+
+        // A fresh binary AST cache next to the source lets us skip
+        // lexing and parsing entirely
+        size_t source_length = 0;
+        char* source_text = read_source_text(input_file, &source_length);
+        char* cache_path = ast_cache_derive_path(config->input_file);
+        bool cache_used = false;
+
+        if (source_text && cache_path &&
+            ast_cache_is_fresh(cache_path, source_text, source_length)) {
+            Arena* ast_arena = arena_create(0);
+            AstNode* ast_root = ast_arena ? ast_cache_load(cache_path, ast_arena) : NULL;
+
+            if (ast_root) {
+                if (config->verbose) {
+                    printf("Loaded AST from cache: %s\n", cache_path);
+                }
+                ast_print(ast_root, 0);
+                cache_used = true;
+            }
+            if (ast_arena) {
+                arena_destroy(ast_arena);
+            }
+        }
+
+        if (!cache_used) {
+            // TODO: ASTNode* ast_root = parser_parse(lexer);
+            // TODO: ast_print(ast_root, 0);
+            // TODO: ast_cache_save(cache_path, ast_root, source_text, source_length);
+            // TODO: ast_cleanup(ast_root);
+            // TODO: error_flush() before lexer_cleanup so diagnostics can
+            //       still excerpt the mapped source through its manager
+            // TODO: lexer_cleanup(lexer);
+        }
+
+        free(cache_path);
+        free(source_text);
         fclose(input_file);
         return true;
     }
     
-    // TODO: Implement semantic analysis phase
-    // SymbolTable* symbol_table = symbol_table_init();
-    // if (!semantic_analyzer_check(ast_root, symbol_table)) {
+    timing_phase_begin(TIMING_PHASE_SEMANTIC);
+    // TODO: Implement semantic analysis phase. In fused mode
+    // (config->fused_semantic) the parser already ran the per-node
+    // hooks from semantic_analyzer.h while building the tree, so the
+    // separate analyze_program() walk below is skipped.
+    // SemanticAnalyzer* analyzer = semantic_analyzer_init(config->input_file);
+    // if (!config->fused_semantic && !analyze_program(analyzer, ast_root)) {
     //     error_report(ERROR_SEMANTIC, ERROR_FATAL, config->input_file, 0, 0, 
     //                 "Semantic analysis failed", 
-    //                 "Check for type errors or undefined variables", 
+    //                 "Check for type errors or undefined variables",
     //                 __FILE__, __LINE__);
-    //     symbol_table_cleanup(symbol_table);
+    //     semantic_analyzer_free(analyzer);
     //     ast_cleanup(ast_root);
     //     lexer_cleanup(lexer);
     //     fclose(input_file);
     //     return false;
     // }
-    
+    timing_phase_end(TIMING_PHASE_SEMANTIC);
+
     // If we're stopping after semantic analysis, exit
     if (config->stop_after_semantic) {
         if (config->verbose) {
             printf("Stopping after semantic analysis as requested\n");
         }
-        // symbol_table_cleanup(symbol_table);
+        // semantic_analyzer_free(analyzer);
         // ast_cleanup(ast_root);
         // lexer_cleanup(lexer);
         fclose(input_file);
@@ -313,6 +604,7 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
     }
     
     // TODO: Implement IR generation
+    timing_phase_begin(TIMING_PHASE_IR);
     // IRProgram* ir_program = ir_generate(ast_root, symbol_table, target_info);
     // if (!ir_program) {
     //     error_report(ERROR_INTERNAL, ERROR_FATAL, config->input_file, 0, 0, 
@@ -325,15 +617,22 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
     //     fclose(input_file);
     //     return false;
     // }
-    
+    timing_phase_end(TIMING_PHASE_IR);
+
     // Apply optimization if requested
+    timing_phase_begin(TIMING_PHASE_OPTIMIZATION);
     if (config->optimization_level > 0) {
         if (config->verbose) {
             printf("Optimizing IR at level O%d\n", config->optimization_level);
         }
-        // TODO: ir_optimize(ir_program, config->optimization_level);
+        // TODO once ir_program exists:
+        // IrOptimizer* optimizer = ir_optimizer_init(config->optimization_level);
+        // ir_optimize_program(optimizer, ir_program);
+        // ir_optimizer_free(optimizer);
     }
-    
+    timing_phase_end(TIMING_PHASE_OPTIMIZATION);
+
+
     // If we're stopping after IR generation, print IR and exit
     if (config->stop_after_ir) {
         if (config->verbose) {
@@ -348,6 +647,25 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
         return true;
     }
     
+    // In JIT mode the IR is executed in this process instead of being
+    // written out; the value главна() returns becomes the exit status.
+    // The pipeline does not build an IRProgram yet, so until it does
+    // this must fail loudly rather than pretend the program ran
+    if (config->jit_run) {
+        if (config->verbose) {
+            printf("Executing in process (JIT) as requested\n");
+        }
+        error_report(ERROR_CODEGEN, ERROR_FATAL, config->input_file, 0, 0,
+                    "JIT execution is not yet connected to the pipeline",
+                    "Compile to an object file instead of using --run",
+                    __FILE__, __LINE__);
+        // TODO once ir_program exists:
+        // if (!jit_run_program(ir_program, &config->jit_result)) { ... }
+        free(manifest_source);
+        fclose(input_file);
+        return false;
+    }
+
     // TODO: Generate target code
     FILE* output_file = fopen(config->output_file, "w");
     if (!output_file) {
@@ -359,11 +677,13 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
         // symbol_table_cleanup(symbol_table);
         // ast_cleanup(ast_root);
         // lexer_cleanup(lexer);
+        free(manifest_source);
         fclose(input_file);
         return false;
     }
     
     // Select code generator based on target architecture
+    timing_phase_begin(TIMING_PHASE_CODEGEN);
     bool codegen_result = false;
     switch (target_info->arch) {
         case TARGET_ARCH_X86:
@@ -388,7 +708,9 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
             codegen_result = false;
             break;
     }
-    
+    timing_phase_end(TIMING_PHASE_CODEGEN);
+
+
     if (!codegen_result) {
         error_report(ERROR_CODEGEN, ERROR_FATAL, config->input_file, 0, 0, 
                     "Code generation failed", 
@@ -399,6 +721,7 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
         // symbol_table_cleanup(symbol_table);
         // ast_cleanup(ast_root);
         // lexer_cleanup(lexer);
+        free(manifest_source);
         fclose(input_file);
         return false;
     }
@@ -410,7 +733,13 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
     // ast_cleanup(ast_root);
     // lexer_cleanup(lexer);
     fclose(input_file);
-    
+
+    // Record this build so an identical rerun can skip the pipeline
+    if (config->incremental && manifest_source) {
+        manifest_write(config, manifest_source, manifest_source_length);
+    }
+    free(manifest_source);
+
     if (config->verbose) {
         printf("Successfully generated output: %s\n", config->output_file);
     }
@@ -418,6 +747,270 @@ bool run_compiler_pipeline(CompilerConfig* config, TargetInfo* target_info) {
     return true;
 }
 
+//------------------------------------------------------------------------------
+// Multi-file compilation
+//------------------------------------------------------------------------------
+
+// Derive the default output path for one input file in a multi-file
+// batch: the extension becomes .asm for assembly or .o for objects
+static char* derive_output_path(const CompilerConfig* config, const char* input) {
+    const char* extension = config->generate_assembly ? ".asm" : ".o";
+    const char* dot = strrchr(input, '.');
+    size_t stem_length = dot ? (size_t)(dot - input) : strlen(input);
+
+    char* path = malloc(stem_length + strlen(extension) + 1);
+    if (!path) return NULL;
+    memcpy(path, input, stem_length);
+    strcpy(path + stem_length, extension);
+    return path;
+}
+
+// Shared state of one compile batch. Workers claim files from the
+// cursor; the keyword and target tables are read-only and shared
+typedef struct {
+    const CompilerConfig* config;
+    TargetInfo* target_info;
+    atomic_uint cursor;          // Next unclaimed input file
+    atomic_bool failed;          // Any file failed to compile
+} CompileBatch;
+
+// Claim-and-compile loop each worker thread runs. Every file gets a
+// private config copy; errors land in the thread's own list and are
+// merged before the worker exits
+static void* compile_worker(void* argument) {
+    CompileBatch* batch = argument;
+    for (;;) {
+        uint32_t index = atomic_fetch_add(&batch->cursor, 1);
+        if ((int)index >= batch->config->input_file_count) break;
+
+        CompilerConfig local = *batch->config;
+        local.input_file = local.input_files[index];
+        local.output_file = derive_output_path(&local, local.input_file);
+        if (!local.output_file) {
+            atomic_store(&batch->failed, true);
+            continue;
+        }
+
+        if (!run_compiler_pipeline(&local, batch->target_info)) {
+            atomic_store(&batch->failed, true);
+        }
+        free(local.output_file);
+    }
+    error_merge_thread_list();
+    return NULL;
+}
+
+// Compile every input file concurrently on a pool sized to the
+// machine (or to -j). Returns true when every file succeeded
+static bool compile_all_files(CompilerConfig* config, TargetInfo* target_info) {
+    if (config->input_file_count == 1) {
+        return run_compiler_pipeline(config, target_info);
+    }
+
+    CompileBatch batch;
+    batch.config = config;
+    batch.target_info = target_info;
+    atomic_init(&batch.cursor, 0);
+    atomic_init(&batch.failed, false);
+
+    int workers = config->jobs;
+    if (workers < 1) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = processors > 0 ? (int)processors : 1;
+    }
+    if (workers > config->input_file_count) {
+        workers = config->input_file_count;
+    }
+
+    pthread_t* threads = malloc(workers * sizeof(pthread_t));
+    if (!threads) {
+        compile_worker(&batch);
+    } else {
+        int spawned = 0;
+        for (int w = 0; w < workers; w++) {
+            if (pthread_create(&threads[w], NULL, compile_worker, &batch) != 0) {
+                break;
+            }
+            spawned++;
+        }
+        if (spawned == 0) {
+            compile_worker(&batch);
+        }
+        for (int w = 0; w < spawned; w++) {
+            pthread_join(threads[w], NULL);
+        }
+        free(threads);
+    }
+
+    return !atomic_load(&batch.failed);
+}
+
+//------------------------------------------------------------------------------
+// Persistent compile-server mode
+//------------------------------------------------------------------------------
+
+// Requests arrive on a Unix socket as one argument per line followed
+// by an empty line; the compiler's diagnostics stream back over the
+// same connection, terminated by an "EXIT <code>" line. Staying
+// resident keeps the keyword tables, the detected target, the intern
+// pool and any AST caches warm between requests.
+#define SERVER_DEFAULT_SOCKET "/tmp/ћпп-server.sock"
+#define SERVER_MAX_ARGUMENTS 64
+#define SERVER_REQUEST_LIMIT 8192
+
+/**
+ * Write one formatted line straight to the client connection
+ */
+static void server_reply(int client, const char* format, const char* text,
+                         int code) {
+    char line[512];
+    int length = snprintf(line, sizeof(line), format, text ? text : "", code);
+    if (length > 0) {
+        ssize_t ignored = write(client, line, (size_t)length);
+        (void)ignored;
+    }
+}
+
+/**
+ * Read one request off the client: lines up to an empty line or EOF
+ */
+static int server_read_request(int client, char* buffer, size_t capacity) {
+    size_t filled = 0;
+    while (filled < capacity - 1) {
+        ssize_t got = read(client, buffer + filled, capacity - 1 - filled);
+        if (got <= 0) break;
+        filled += (size_t)got;
+        buffer[filled] = '\0';
+        if (strstr(buffer, "\n\n") != NULL) break;
+    }
+    buffer[filled] = '\0';
+    return (int)filled;
+}
+
+/**
+ * Serve one compile request from warm state. Diagnostics are routed
+ * to the client by pointing stdout/stderr at the connection for the
+ * duration of the request
+ */
+static void server_handle_request(int client, TargetInfo* target_info) {
+    char buffer[SERVER_REQUEST_LIMIT];
+    if (server_read_request(client, buffer, sizeof(buffer)) <= 0) {
+        return;
+    }
+
+    // Rebuild an argv from the request lines
+    char* request_argv[SERVER_MAX_ARGUMENTS];
+    int request_argc = 0;
+    request_argv[request_argc++] = "ћпп";
+    char* cursor = buffer;
+    while (request_argc < SERVER_MAX_ARGUMENTS) {
+        char* end = strchr(cursor, '\n');
+        if (end == NULL || end == cursor) break;
+        *end = '\0';
+        request_argv[request_argc++] = cursor;
+        cursor = end + 1;
+    }
+
+    // A fresh error list per request so counts never leak between
+    // clients; the intern pool and caches deliberately stay warm
+    error_cleanup();
+    error_init();
+
+    bool ok = false;
+    CompilerConfig request_config;
+    if (process_args(request_argc, request_argv, &request_config) &&
+        !request_config.server_mode) {
+        // Reject unreadable inputs with a short reply before touching
+        // the pipeline; everything else runs with fatal exits disabled
+        bool readable = true;
+        for (int f = 0; f < request_config.input_file_count; f++) {
+            FILE* probe = fopen(request_config.input_files[f], "r");
+            if (!probe) {
+                server_reply(client, "Error: cannot open %s%.0d\n",
+                             request_config.input_files[f], 0);
+                readable = false;
+                break;
+            }
+            fclose(probe);
+        }
+
+        if (readable) {
+            // Route diagnostics to the client while compiling
+            int saved_stdout = dup(STDOUT_FILENO);
+            int saved_stderr = dup(STDERR_FILENO);
+            fflush(stdout);
+            fflush(stderr);
+            dup2(client, STDOUT_FILENO);
+            dup2(client, STDERR_FILENO);
+
+            // A fatal report inside the pipeline must fail this
+            // request, not the warm server process
+            error_set_fatal_exits(false);
+            ok = compile_all_files(&request_config, target_info);
+            error_set_fatal_exits(true);
+            error_merge_thread_list();
+            // Buffered diagnostics must go out while stderr still
+            // points at the client
+            error_flush();
+
+            fflush(stdout);
+            fflush(stderr);
+            dup2(saved_stdout, STDOUT_FILENO);
+            dup2(saved_stderr, STDERR_FILENO);
+            close(saved_stdout);
+            close(saved_stderr);
+        }
+    }
+    free(request_config.input_files);
+
+    server_reply(client, "%sEXIT %d\n", "", ok ? 0 : 1);
+}
+
+/**
+ * Bind the socket and serve requests until the process is killed
+ */
+static int run_server(CompilerConfig* config, TargetInfo* target_info) {
+    const char* socket_path = config->server_socket
+                                  ? config->server_socket
+                                  : SERVER_DEFAULT_SOCKET;
+
+    // A dying client must not kill the server mid-write
+    signal(SIGPIPE, SIG_IGN);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        fprintf(stderr, "Error: Could not create server socket\n");
+        return 1;
+    }
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error: Socket path too long: %s\n", socket_path);
+        close(listener);
+        return 1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    unlink(socket_path);
+    if (bind(listener, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(listener, 8) != 0) {
+        fprintf(stderr, "Error: Could not bind server socket %s\n", socket_path);
+        close(listener);
+        return 1;
+    }
+
+    printf("ћ++ compile server listening on %s\n", socket_path);
+
+    for (;;) {
+        int client = accept(listener, NULL, NULL);
+        if (client < 0) continue;
+        server_handle_request(client, target_info);
+        close(client);
+    }
+}
+
 // Main entry point
 int main(int argc, char* argv[]) {
     // Parse command line arguments
@@ -425,8 +1018,24 @@ int main(int argc, char* argv[]) {
     if (!process_args(argc, argv, &config)) {
         return 1;
     }
-    
-    printf("ћ++ compiler: processing file %s\n", config.input_file);
+
+    // Instrumentation must be on before any phase starts; memory
+    // statistics need the phase brackets for attribution
+    if (config.time_passes || config.mem_stats) {
+        timing_enable();
+    }
+    if (config.mem_stats) {
+        memstats_enable();
+    }
+
+
+    if (config.server_mode) {
+        printf("ћ++ compiler: starting compile server\n");
+    } else if (config.input_file_count == 1) {
+        printf("ћ++ compiler: processing file %s\n", config.input_file);
+    } else {
+        printf("ћ++ compiler: processing %d files\n", config.input_file_count);
+    }
     
     // Initialize error handling system with log file option
     if (!error_init_with_log(config.generate_error_log)) {
@@ -484,13 +1093,37 @@ int main(int argc, char* argv[]) {
                "cdecl" : "System V AMD64 ABI");
     }
     
-    // Run the compiler pipeline
-    bool success = run_compiler_pipeline(&config, &target_info);
-    
-    // Clean up error handling system before exiting
+    // In server mode, stay resident and serve requests instead of
+    // compiling a batch
+    if (config.server_mode) {
+        int status = run_server(&config, &target_info);
+        error_cleanup();
+        free(config.input_files);
+        return status;
+    }
+
+    // Run the compiler pipeline over every input file
+    bool success = compile_all_files(&config, &target_info);
+
+    // Emit the buffered diagnostics, then tear the error system down
+    error_merge_thread_list();
+    error_flush();
     error_cleanup();
-    
+    free(config.input_files);
+
+    if (config.time_passes) {
+        timing_report();
+    }
+    if (config.mem_stats) {
+        memstats_report();
+    }
+
+
     if (success) {
+        // In JIT mode the executed program's result is the exit status
+        if (config.jit_run) {
+            return (int)(config.jit_result & 0xFF);
+        }
         printf("Compilation successful\n");
         return 0;
     } else {
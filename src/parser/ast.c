@@ -30,22 +30,89 @@
 #include <stdio.h>
 #include <string.h>
 #include "../utils/error.h"
+#include "../utils/intern.h"
 #include "../utils/utf8.h"
+#include "../utils/timing.h"
+#include "../utils/memstats.h"
 
 //------------------------------------------------------------------------------
 // Helper functions
 //------------------------------------------------------------------------------
 
+// Optional arena that all AST allocations are served from (see ast_set_arena)
+static Arena* ast_arena = NULL;
+
+void ast_set_arena(Arena* arena) {
+    ast_arena = arena;
+}
+
+Arena* ast_get_arena(void) {
+    return ast_arena;
+}
+
+/**
+ * Allocate zeroed memory for an AST object, from the installed arena if
+ * one is set, otherwise from the heap
+ */
+static void* ast_alloc(size_t size) {
+    if (ast_arena) {
+        return arena_alloc(ast_arena, size);
+    }
+    return mem_zalloc(size);
+}
+
+/**
+ * Release memory obtained from ast_alloc(). A no-op while an arena is
+ * installed, since arena memory is released all at once
+ */
+static void ast_release(void* ptr) {
+    if (ast_arena) return;
+    mem_free(ptr);
+}
+
+/**
+ * Allocate a node with its reference count initialised to one. All node
+ * constructors go through this helper so copy-on-write sharing via
+ * ast_clone() works uniformly
+ */
+static AstNode* ast_alloc_node(void) {
+    AstNode* node = (AstNode*)ast_alloc(sizeof(AstNode));
+    if (node) {
+        node->ref_count = 1;
+        timing_count(TIMING_COUNTER_AST_NODES, 1);
+    }
+    return node;
+}
+
+/**
+ * Duplicate a byte range as a NUL-terminated string
+ */
+static char* string_duplicate_n(const char* str, size_t length) {
+    if (!str) return NULL;
+
+    char* result = ast_arena ? arena_alloc(ast_arena, length + 1)
+                             : mem_alloc(length + 1);
+    if (!result) return NULL;
+
+    memcpy(result, str, length);
+    result[length] = '\0';
+    return result;
+}
+
 /**
  * Duplicate a string, allocating new memory
  */
 static char* string_duplicate(const char* str) {
     if (!str) return NULL;
-    
+
+    if (ast_arena) {
+        return arena_strdup(ast_arena, str);
+    }
+
     size_t len = strlen(str);
-    char* result = malloc(len + 1);
+    char* result = mem_alloc(len + 1);
     if (!result) return NULL;
-    
+
     memcpy(result, str, len + 1);
     return result;
 }
@@ -80,7 +147,7 @@ SourceLocation source_location_create(int line, int column, const char* filename
 //------------------------------------------------------------------------------
 
 TypeInfo* type_create_void(void) {
-    TypeInfo* type = (TypeInfo*)malloc(sizeof(TypeInfo));
+    TypeInfo* type = (TypeInfo*)ast_alloc(sizeof(TypeInfo));
     if (!type) return NULL;
     
     type->category = TYPE_VOID;
@@ -88,7 +155,7 @@ TypeInfo* type_create_void(void) {
 }
 
 TypeInfo* type_create_bool(void) {
-    TypeInfo* type = (TypeInfo*)malloc(sizeof(TypeInfo));
+    TypeInfo* type = (TypeInfo*)ast_alloc(sizeof(TypeInfo));
     if (!type) return NULL;
     
     type->category = TYPE_BOOL;
@@ -96,7 +163,7 @@ TypeInfo* type_create_bool(void) {
 }
 
 TypeInfo* type_create_char(void) {
-    TypeInfo* type = (TypeInfo*)malloc(sizeof(TypeInfo));
+    TypeInfo* type = (TypeInfo*)ast_alloc(sizeof(TypeInfo));
     if (!type) return NULL;
     
     type->category = TYPE_CHAR;
@@ -104,7 +171,7 @@ TypeInfo* type_create_char(void) {
 }
 
 TypeInfo* type_create_int(void) {
-    TypeInfo* type = (TypeInfo*)malloc(sizeof(TypeInfo));
+    TypeInfo* type = (TypeInfo*)ast_alloc(sizeof(TypeInfo));
     if (!type) return NULL;
     
     type->category = TYPE_INT;
@@ -114,7 +181,7 @@ TypeInfo* type_create_int(void) {
 TypeInfo* type_create_array(TypeInfo* element_type, int size) {
     if (!element_type) return NULL;
     
-    TypeInfo* type = (TypeInfo*)malloc(sizeof(TypeInfo));
+    TypeInfo* type = (TypeInfo*)ast_alloc(sizeof(TypeInfo));
     if (!type) return NULL;
     
     type->category = TYPE_ARRAY;
@@ -127,16 +194,16 @@ TypeInfo* type_create_array(TypeInfo* element_type, int size) {
 TypeInfo* type_create_function(TypeInfo* return_type, TypeInfo** param_types, int param_count) {
     if (!return_type) return NULL;
     
-    TypeInfo* type = (TypeInfo*)malloc(sizeof(TypeInfo));
+    TypeInfo* type = (TypeInfo*)ast_alloc(sizeof(TypeInfo));
     if (!type) return NULL;
     
     type->category = TYPE_FUNCTION;
     type->info.function.return_type = return_type;
     
     if (param_count > 0 && param_types) {
-        type->info.function.param_types = (TypeInfo**)malloc(param_count * sizeof(TypeInfo*));
+        type->info.function.param_types = (TypeInfo**)ast_alloc(param_count * sizeof(TypeInfo*));
         if (!type->info.function.param_types) {
-            free(type);
+            ast_release(type);
             return NULL;
         }
         
@@ -154,7 +221,10 @@ TypeInfo* type_create_function(TypeInfo* return_type, TypeInfo** param_types, in
 
 void type_free(TypeInfo* type) {
     if (!type) return;
-    
+
+    // Arena-backed types are released all at once with the arena
+    if (ast_arena) return;
+
     switch (type->category) {
         case TYPE_ARRAY:
             type_free(type->info.array.element_type);
@@ -165,7 +235,7 @@ void type_free(TypeInfo* type) {
             for (int i = 0; i < type->info.function.param_count; i++) {
                 type_free(type->info.function.param_types[i]);
             }
-            free(type->info.function.param_types);
+            ast_release(type->info.function.param_types);
             break;
             
         default:
@@ -173,7 +243,7 @@ void type_free(TypeInfo* type) {
             break;
     }
     
-    free(type);
+    ast_release(type);
 }
 
 //------------------------------------------------------------------------------
@@ -181,7 +251,7 @@ void type_free(TypeInfo* type) {
 //------------------------------------------------------------------------------
 
 AstNode* ast_create_program(AstNode** declarations, int declaration_count, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate program node", location)) return NULL;
     
     node->type = AST_PROGRAM;
@@ -189,9 +259,9 @@ AstNode* ast_create_program(AstNode** declarations, int declaration_count, Sourc
     node->type_info = NULL;
     
     if (declaration_count > 0 && declarations) {
-        node->as.program.declarations = (AstNode**)malloc(declaration_count * sizeof(AstNode*));
+        node->as.program.declarations = (AstNode**)ast_alloc(declaration_count * sizeof(AstNode*));
         if (!check_null(node->as.program.declarations, "Failed to allocate declarations array", location)) {
-            free(node);
+            ast_release(node);
             return NULL;
         }
         
@@ -210,16 +280,16 @@ AstNode* ast_create_program(AstNode** declarations, int declaration_count, Sourc
 AstNode* ast_create_function_decl(char* name, AstNode** parameters, int parameter_count, 
                                  AstNode* body, TypeInfo* return_type, bool is_external,
                                  SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate function declaration node", location)) return NULL;
     
     node->type = AST_FUNCTION_DECL;
     node->location = location;
     node->type_info = NULL;
     
-    node->as.function_decl.name = string_duplicate(name);
+    node->as.function_decl.name = (char*)intern_cstring(name);
     if (!check_null(node->as.function_decl.name, "Failed to allocate function name", location)) {
-        free(node);
+        ast_release(node);
         return NULL;
     }
     
@@ -228,10 +298,9 @@ AstNode* ast_create_function_decl(char* name, AstNode** parameters, int paramete
     node->as.function_decl.is_external = is_external;
     
     if (parameter_count > 0 && parameters) {
-        node->as.function_decl.parameters = (AstNode**)malloc(parameter_count * sizeof(AstNode*));
+        node->as.function_decl.parameters = (AstNode**)ast_alloc(parameter_count * sizeof(AstNode*));
         if (!check_null(node->as.function_decl.parameters, "Failed to allocate parameters array", location)) {
-            free(node->as.function_decl.name);
-            free(node);
+            ast_release(node);
             return NULL;
         }
         
@@ -249,16 +318,16 @@ AstNode* ast_create_function_decl(char* name, AstNode** parameters, int paramete
 
 AstNode* ast_create_var_decl(char* name, AstNode* initializer, TypeInfo* var_type,
                             SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate variable declaration node", location)) return NULL;
     
     node->type = AST_VAR_DECL;
     node->location = location;
     node->type_info = NULL;
     
-    node->as.var_decl.name = string_duplicate(name);
+    node->as.var_decl.name = (char*)intern_cstring(name);
     if (!check_null(node->as.var_decl.name, "Failed to allocate variable name", location)) {
-        free(node);
+        ast_release(node);
         return NULL;
     }
     
@@ -271,16 +340,16 @@ AstNode* ast_create_var_decl(char* name, AstNode* initializer, TypeInfo* var_typ
 AstNode* ast_create_array_decl(char* name, int size, AstNode** initializers, 
                               int initializer_count, TypeInfo* element_type,
                               SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate array declaration node", location)) return NULL;
     
     node->type = AST_ARRAY_DECL;
     node->location = location;
     node->type_info = NULL;
     
-    node->as.array_decl.name = string_duplicate(name);
+    node->as.array_decl.name = (char*)intern_cstring(name);
     if (!check_null(node->as.array_decl.name, "Failed to allocate array name", location)) {
-        free(node);
+        ast_release(node);
         return NULL;
     }
     
@@ -288,10 +357,9 @@ AstNode* ast_create_array_decl(char* name, int size, AstNode** initializers,
     node->as.array_decl.element_type = element_type;
     
     if (initializer_count > 0 && initializers) {
-        node->as.array_decl.initializers = (AstNode**)malloc(initializer_count * sizeof(AstNode*));
+        node->as.array_decl.initializers = (AstNode**)ast_alloc(initializer_count * sizeof(AstNode*));
         if (!check_null(node->as.array_decl.initializers, "Failed to allocate initializers array", location)) {
-            free(node->as.array_decl.name);
-            free(node);
+            ast_release(node);
             return NULL;
         }
         
@@ -308,7 +376,7 @@ AstNode* ast_create_array_decl(char* name, int size, AstNode** initializers,
 }
 
 AstNode* ast_create_block(AstNode** statements, int statement_count, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate block node", location)) return NULL;
     
     node->type = AST_BLOCK;
@@ -316,9 +384,9 @@ AstNode* ast_create_block(AstNode** statements, int statement_count, SourceLocat
     node->type_info = NULL;
     
     if (statement_count > 0 && statements) {
-        node->as.block.statements = (AstNode**)malloc(statement_count * sizeof(AstNode*));
+        node->as.block.statements = (AstNode**)ast_alloc(statement_count * sizeof(AstNode*));
         if (!check_null(node->as.block.statements, "Failed to allocate statements array", location)) {
-            free(node);
+            ast_release(node);
             return NULL;
         }
         
@@ -336,7 +404,7 @@ AstNode* ast_create_block(AstNode** statements, int statement_count, SourceLocat
 
 AstNode* ast_create_if_stmt(AstNode* condition, AstNode* then_branch, AstNode* else_branch,
                            SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate if statement node", location)) return NULL;
     
     node->type = AST_IF_STMT;
@@ -351,7 +419,7 @@ AstNode* ast_create_if_stmt(AstNode* condition, AstNode* then_branch, AstNode* e
 }
 
 AstNode* ast_create_while_stmt(AstNode* condition, AstNode* body, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate while statement node", location)) return NULL;
     
     node->type = AST_WHILE_STMT;
@@ -366,7 +434,7 @@ AstNode* ast_create_while_stmt(AstNode* condition, AstNode* body, SourceLocation
 
 AstNode* ast_create_for_stmt(AstNode* initializer, AstNode* condition, AstNode* increment,
                             AstNode* body, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate for statement node", location)) return NULL;
     
     node->type = AST_FOR_STMT;
@@ -382,7 +450,7 @@ AstNode* ast_create_for_stmt(AstNode* initializer, AstNode* condition, AstNode*
 }
 
 AstNode* ast_create_do_while_stmt(AstNode* body, AstNode* condition, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate do-while statement node", location)) return NULL;
     
     node->type = AST_DO_WHILE_STMT;
@@ -396,7 +464,7 @@ AstNode* ast_create_do_while_stmt(AstNode* body, AstNode* condition, SourceLocat
 }
 
 AstNode* ast_create_return_stmt(AstNode* value, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate return statement node", location)) return NULL;
     
     node->type = AST_RETURN_STMT;
@@ -409,7 +477,7 @@ AstNode* ast_create_return_stmt(AstNode* value, SourceLocation location) {
 }
 
 AstNode* ast_create_break_stmt(SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate break statement node", location)) return NULL;
     
     node->type = AST_BREAK_STMT;
@@ -420,7 +488,7 @@ AstNode* ast_create_break_stmt(SourceLocation location) {
 }
 
 AstNode* ast_create_expr_stmt(AstNode* expression, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate expression statement node", location)) return NULL;
     
     node->type = AST_EXPR_STMT;
@@ -432,40 +500,114 @@ AstNode* ast_create_expr_stmt(AstNode* expression, SourceLocation location) {
     return node;
 }
 
+/*
+ * Evaluate a binary operator over two integer literal values.
+ * Returns false for operators that cannot be folded, and for division
+ * or modulo by zero, which must survive to semantic analysis so the
+ * error is reported with proper context.
+ */
+static bool fold_binary_int(TokenType operator, intptr_t left, intptr_t right,
+                            intptr_t* result) {
+    switch (operator) {
+        case TOKEN_PLUS:           *result = left + right; return true;
+        case TOKEN_MINUS:          *result = left - right; return true;
+        case TOKEN_STAR:           *result = left * right; return true;
+        case TOKEN_SLASH:
+            if (right == 0) return false;
+            *result = left / right;
+            return true;
+        case TOKEN_PERCENT:
+            if (right == 0) return false;
+            *result = left % right;
+            return true;
+        case TOKEN_AND:            *result = left & right; return true;
+        case TOKEN_OR:             *result = left | right; return true;
+        case TOKEN_CARET:          *result = left ^ right; return true;
+        case TOKEN_DOUBLE_EQUALS:  *result = left == right; return true;
+        case TOKEN_NOT_EQUALS:     *result = left != right; return true;
+        case TOKEN_LESS:           *result = left < right; return true;
+        case TOKEN_LESS_EQUALS:    *result = left <= right; return true;
+        case TOKEN_GREATER:        *result = left > right; return true;
+        case TOKEN_GREATER_EQUALS: *result = left >= right; return true;
+        case TOKEN_DOUBLE_AND:     *result = left && right; return true;
+        case TOKEN_DOUBLE_OR:      *result = left || right; return true;
+        default:
+            return false;
+    }
+}
+
 AstNode* ast_create_binary_expr(AstNode* left, TokenType operator, AstNode* right,
                                SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    // Fold literal-literal expressions at parse time: constant-heavy
+    // initializers collapse to a single literal node instead of a tree
+    // that every later pass would have to walk
+    if (left && right &&
+        left->type == AST_LITERAL_INT && right->type == AST_LITERAL_INT) {
+        intptr_t folded;
+        if (fold_binary_int(operator, left->as.int_literal.value,
+                            right->as.int_literal.value, &folded)) {
+            AstNode* literal = ast_create_literal_int(folded, location);
+            if (literal) {
+                ast_free(left);
+                ast_free(right);
+                return literal;
+            }
+        }
+    }
+
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate binary expression node", location)) return NULL;
-    
+
     node->type = AST_BINARY_EXPR;
     node->location = location;
     node->type_info = NULL;
-    
+
     node->as.binary_expr.left = left;
     node->as.binary_expr.operator = operator;
     node->as.binary_expr.right = right;
-    
+
     return node;
 }
 
 AstNode* ast_create_unary_expr(AstNode* operand, TokenType operator, bool is_prefix,
                               SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    // Fold prefix operators applied to an integer literal
+    if (operand && is_prefix && operand->type == AST_LITERAL_INT) {
+        intptr_t value = operand->as.int_literal.value;
+        bool folded = true;
+
+        switch (operator) {
+            case TOKEN_MINUS: value = -value; break;
+            case TOKEN_NOT:   value = !value; break;
+            case TOKEN_TILDE: value = ~value; break;
+            default:          folded = false; break;
+        }
+
+        if (folded) {
+            AstNode* literal = ast_create_literal_int(value, location);
+            if (literal) {
+                ast_free(operand);
+                return literal;
+            }
+        }
+    }
+
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate unary expression node", location)) return NULL;
-    
+
     node->type = AST_UNARY_EXPR;
     node->location = location;
     node->type_info = NULL;
-    
+
     node->as.unary_expr.operand = operand;
     node->as.unary_expr.operator = operator;
     node->as.unary_expr.is_prefix = is_prefix;
-    
+
     return node;
 }
 
 AstNode* ast_create_literal_int(intptr_t value, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate integer literal node", location)) return NULL;
     
     node->type = AST_LITERAL_INT;
@@ -478,7 +620,7 @@ AstNode* ast_create_literal_int(intptr_t value, SourceLocation location) {
 }
 
 AstNode* ast_create_literal_char(int32_t value, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate character literal node", location)) return NULL;
     
     node->type = AST_LITERAL_CHAR;
@@ -490,25 +632,30 @@ AstNode* ast_create_literal_char(int32_t value, SourceLocation location) {
     return node;
 }
 
-AstNode* ast_create_literal_string(char* value, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+AstNode* ast_create_literal_string_n(const char* value, size_t length,
+                                     SourceLocation location) {
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate string literal node", location)) return NULL;
-    
+
     node->type = AST_LITERAL_STRING;
     node->location = location;
     node->type_info = NULL; // Will be set during semantic analysis
-    
-    node->as.string_literal.value = string_duplicate(value);
+
+    node->as.string_literal.value = string_duplicate_n(value, length);
     if (!check_null(node->as.string_literal.value, "Failed to allocate string value", location)) {
-        free(node);
+        ast_release(node);
         return NULL;
     }
-    
+
     return node;
 }
 
+AstNode* ast_create_literal_string(char* value, SourceLocation location) {
+    return ast_create_literal_string_n(value, value ? strlen(value) : 0, location);
+}
+
 AstNode* ast_create_literal_bool(bool value, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate boolean literal node", location)) return NULL;
     
     node->type = AST_LITERAL_BOOL;
@@ -521,16 +668,16 @@ AstNode* ast_create_literal_bool(bool value, SourceLocation location) {
 }
 
 AstNode* ast_create_identifier(char* name, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate identifier node", location)) return NULL;
     
     node->type = AST_IDENTIFIER;
     node->location = location;
     node->type_info = NULL; // Will be set during semantic analysis
     
-    node->as.identifier.name = string_duplicate(name);
+    node->as.identifier.name = (char*)intern_cstring(name);
     if (!check_null(node->as.identifier.name, "Failed to allocate identifier name", location)) {
-        free(node);
+        ast_release(node);
         return NULL;
     }
     
@@ -538,7 +685,7 @@ AstNode* ast_create_identifier(char* name, SourceLocation location) {
 }
 
 AstNode* ast_create_array_access(AstNode* array, AstNode* index, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate array access node", location)) return NULL;
     
     node->type = AST_ARRAY_ACCESS;
@@ -553,7 +700,7 @@ AstNode* ast_create_array_access(AstNode* array, AstNode* index, SourceLocation
 
 AstNode* ast_create_call_expr(AstNode* callee, AstNode** arguments, int argument_count,
                              SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate function call node", location)) return NULL;
     
     node->type = AST_CALL_EXPR;
@@ -563,9 +710,9 @@ AstNode* ast_create_call_expr(AstNode* callee, AstNode** arguments, int argument
     node->as.call_expr.callee = callee;
     
     if (argument_count > 0 && arguments) {
-        node->as.call_expr.arguments = (AstNode**)malloc(argument_count * sizeof(AstNode*));
+        node->as.call_expr.arguments = (AstNode**)ast_alloc(argument_count * sizeof(AstNode*));
         if (!check_null(node->as.call_expr.arguments, "Failed to allocate arguments array", location)) {
-            free(node);
+            ast_release(node);
             return NULL;
         }
         
@@ -582,7 +729,7 @@ AstNode* ast_create_call_expr(AstNode* callee, AstNode** arguments, int argument
 }
 
 AstNode* ast_create_assignment(AstNode* target, AstNode* value, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate assignment node", location)) return NULL;
     
     node->type = AST_ASSIGNMENT;
@@ -596,7 +743,7 @@ AstNode* ast_create_assignment(AstNode* target, AstNode* value, SourceLocation l
 }
 
 AstNode* ast_create_type(TypeInfo* type_data, SourceLocation location) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    AstNode* node = ast_alloc_node();
     if (!check_null(node, "Failed to allocate type node", location)) return NULL;
     
     node->type = AST_TYPE;
@@ -612,288 +759,339 @@ AstNode* ast_create_type(TypeInfo* type_data, SourceLocation location) {
 // Memory management
 //------------------------------------------------------------------------------
 
-void ast_free(AstNode* node) {
-    if (!node) return;
-    
-    // Free node-specific data
+//------------------------------------------------------------------------------
+// Iterative traversal worklist
+//------------------------------------------------------------------------------
+
+// Generated sources contain expression chains thousands of nodes deep,
+// so every traversal (ast_free, ast_accept, ast_print) runs on an
+// explicit worklist instead of the C call stack. The worklist starts on
+// a small inline buffer and moves to the heap only for unusually large
+// trees.
+#define WORKLIST_INLINE_CAPACITY 64
+
+typedef struct {
+    AstNode** items;     // Current storage, inline_items or heap
+    size_t count;        // Number of nodes on the worklist
+    size_t capacity;     // Number of slots in items
+    AstNode* inline_items[WORKLIST_INLINE_CAPACITY];
+} NodeWorklist;
+
+static void worklist_init(NodeWorklist* list) {
+    list->items = list->inline_items;
+    list->count = 0;
+    list->capacity = WORKLIST_INLINE_CAPACITY;
+}
+
+static void worklist_destroy(NodeWorklist* list) {
+    if (list->items != list->inline_items) {
+        free(list->items);
+    }
+}
+
+/*
+ * Push a node onto the worklist; NULL children are simply skipped.
+ * Returns false if the worklist could not grow.
+ */
+static bool worklist_push(NodeWorklist* list, AstNode* node) {
+    if (!node) return true;
+
+    if (list->count == list->capacity) {
+        size_t new_capacity = list->capacity * 2;
+        AstNode** new_items;
+
+        if (list->items == list->inline_items) {
+            new_items = (AstNode**)malloc(new_capacity * sizeof(AstNode*));
+            if (new_items) {
+                memcpy(new_items, list->items, list->count * sizeof(AstNode*));
+            }
+        } else {
+            new_items = (AstNode**)realloc(list->items, new_capacity * sizeof(AstNode*));
+        }
+
+        if (!new_items) {
+            return false;
+        }
+        list->items = new_items;
+        list->capacity = new_capacity;
+    }
+
+    list->items[list->count++] = node;
+    return true;
+}
+
+static AstNode* worklist_pop(NodeWorklist* list) {
+    return list->count > 0 ? list->items[--list->count] : NULL;
+}
+
+/*
+ * Push a node's children so that popping yields them in visit order
+ * (children are therefore pushed in reverse). Returns false if the
+ * worklist could not grow.
+ */
+static bool worklist_push_children(NodeWorklist* list, AstNode* node) {
+    bool ok = true;
+
     switch (node->type) {
         case AST_PROGRAM:
-            for (int i = 0; i < node->as.program.declaration_count; i++) {
-                ast_free(node->as.program.declarations[i]);
+            for (int i = node->as.program.declaration_count - 1; i >= 0; i--) {
+                ok &= worklist_push(list, node->as.program.declarations[i]);
             }
-            free(node->as.program.declarations);
             break;
-            
+
         case AST_FUNCTION_DECL:
-            free(node->as.function_decl.name);
-            for (int i = 0; i < node->as.function_decl.parameter_count; i++) {
-                ast_free(node->as.function_decl.parameters[i]);
+            ok &= worklist_push(list, node->as.function_decl.body);
+            for (int i = node->as.function_decl.parameter_count - 1; i >= 0; i--) {
+                ok &= worklist_push(list, node->as.function_decl.parameters[i]);
             }
-            free(node->as.function_decl.parameters);
-            ast_free(node->as.function_decl.body);
-            type_free(node->as.function_decl.return_type);
             break;
-            
+
         case AST_VAR_DECL:
-            free(node->as.var_decl.name);
-            ast_free(node->as.var_decl.initializer);
-            type_free(node->as.var_decl.var_type);
+            ok &= worklist_push(list, node->as.var_decl.initializer);
             break;
-            
+
         case AST_ARRAY_DECL:
-            free(node->as.array_decl.name);
-            for (int i = 0; i < node->as.array_decl.initializer_count; i++) {
-                ast_free(node->as.array_decl.initializers[i]);
+            for (int i = node->as.array_decl.initializer_count - 1; i >= 0; i--) {
+                ok &= worklist_push(list, node->as.array_decl.initializers[i]);
             }
-            free(node->as.array_decl.initializers);
-            type_free(node->as.array_decl.element_type);
             break;
-            
+
         case AST_BLOCK:
-            for (int i = 0; i < node->as.block.statement_count; i++) {
-                ast_free(node->as.block.statements[i]);
+            for (int i = node->as.block.statement_count - 1; i >= 0; i--) {
+                ok &= worklist_push(list, node->as.block.statements[i]);
             }
-            free(node->as.block.statements);
             break;
-            
+
         case AST_IF_STMT:
-            ast_free(node->as.if_stmt.condition);
-            ast_free(node->as.if_stmt.then_branch);
-            ast_free(node->as.if_stmt.else_branch);
+            ok &= worklist_push(list, node->as.if_stmt.else_branch);
+            ok &= worklist_push(list, node->as.if_stmt.then_branch);
+            ok &= worklist_push(list, node->as.if_stmt.condition);
             break;
-            
+
         case AST_WHILE_STMT:
+            ok &= worklist_push(list, node->as.while_stmt.body);
+            ok &= worklist_push(list, node->as.while_stmt.condition);
+            break;
+
         case AST_DO_WHILE_STMT:
-            ast_free(node->as.while_stmt.condition);
-            ast_free(node->as.while_stmt.body);
+            ok &= worklist_push(list, node->as.while_stmt.condition);
+            ok &= worklist_push(list, node->as.while_stmt.body);
             break;
-            
+
         case AST_FOR_STMT:
-            ast_free(node->as.for_stmt.initializer);
-            ast_free(node->as.for_stmt.condition);
-            ast_free(node->as.for_stmt.increment);
-            ast_free(node->as.for_stmt.body);
+            ok &= worklist_push(list, node->as.for_stmt.body);
+            ok &= worklist_push(list, node->as.for_stmt.increment);
+            ok &= worklist_push(list, node->as.for_stmt.condition);
+            ok &= worklist_push(list, node->as.for_stmt.initializer);
             break;
-            
+
         case AST_RETURN_STMT:
-            ast_free(node->as.return_stmt.value);
+            ok &= worklist_push(list, node->as.return_stmt.value);
             break;
-            
+
         case AST_EXPR_STMT:
-            ast_free(node->as.expr_stmt.expression);
+            ok &= worklist_push(list, node->as.expr_stmt.expression);
             break;
-            
+
         case AST_BINARY_EXPR:
-            ast_free(node->as.binary_expr.left);
-            ast_free(node->as.binary_expr.right);
+            ok &= worklist_push(list, node->as.binary_expr.right);
+            ok &= worklist_push(list, node->as.binary_expr.left);
             break;
-            
+
         case AST_UNARY_EXPR:
-            ast_free(node->as.unary_expr.operand);
-            break;
-            
-        case AST_LITERAL_STRING:
-            free(node->as.string_literal.value);
+            ok &= worklist_push(list, node->as.unary_expr.operand);
             break;
-            
-        case AST_IDENTIFIER:
-            free(node->as.identifier.name);
-            break;
-            
+
         case AST_ARRAY_ACCESS:
-            ast_free(node->as.array_access.array);
-            ast_free(node->as.array_access.index);
+            ok &= worklist_push(list, node->as.array_access.index);
+            ok &= worklist_push(list, node->as.array_access.array);
             break;
-            
+
         case AST_CALL_EXPR:
-            ast_free(node->as.call_expr.callee);
-            for (int i = 0; i < node->as.call_expr.argument_count; i++) {
-                ast_free(node->as.call_expr.arguments[i]);
+            for (int i = node->as.call_expr.argument_count - 1; i >= 0; i--) {
+                ok &= worklist_push(list, node->as.call_expr.arguments[i]);
             }
-            free(node->as.call_expr.arguments);
+            ok &= worklist_push(list, node->as.call_expr.callee);
             break;
-            
+
         case AST_ASSIGNMENT:
-            ast_free(node->as.assignment.target);
-            ast_free(node->as.assignment.value);
+            ok &= worklist_push(list, node->as.assignment.value);
+            ok &= worklist_push(list, node->as.assignment.target);
             break;
-            
+
+        default:
+            // Leaf node types have no children
+            break;
+    }
+
+    return ok;
+}
+
+/*
+ * Free the memory a node owns directly: its child-pointer arrays, string
+ * payload, type information and the node itself. Children are handled by
+ * the caller's worklist, never recursively.
+ */
+static void ast_free_node_payload(AstNode* node) {
+    switch (node->type) {
+        case AST_PROGRAM:
+            ast_release(node->as.program.declarations);
+            break;
+
+        case AST_FUNCTION_DECL:
+            ast_release(node->as.function_decl.parameters);
+            type_free(node->as.function_decl.return_type);
+            break;
+
+        case AST_VAR_DECL:
+            type_free(node->as.var_decl.var_type);
+            break;
+
+        case AST_ARRAY_DECL:
+            ast_release(node->as.array_decl.initializers);
+            type_free(node->as.array_decl.element_type);
+            break;
+
+        case AST_BLOCK:
+            ast_release(node->as.block.statements);
+            break;
+
+        case AST_LITERAL_STRING:
+            ast_release(node->as.string_literal.value);
+            break;
+
+        case AST_CALL_EXPR:
+            ast_release(node->as.call_expr.arguments);
+            break;
+
         case AST_TYPE:
             type_free(node->as.type_node.type_data);
             break;
-            
+
         default:
             // Other node types don't need special cleanup
             break;
     }
-    
+
     // Free type info if it exists
     if (node->type_info) {
         type_free(node->type_info);
     }
-    
+
     // Free the node itself
-    free(node);
+    ast_release(node);
+}
+
+void ast_free(AstNode* node) {
+    if (!node) return;
+
+    // Arena-backed trees are released all at once with the arena
+    if (ast_arena) return;
+
+    NodeWorklist worklist;
+    worklist_init(&worklist);
+    worklist_push(&worklist, node);
+
+    AstNode* current;
+    while ((current = worklist_pop(&worklist)) != NULL) {
+        // A subtree still referenced by another clone stays alive
+        if (--current->ref_count > 0) continue;
+
+        // Children must be queued before the payload free releases the
+        // arrays that hold their pointers
+        if (!worklist_push_children(&worklist, current)) {
+            error_report(ERROR_INTERNAL, ERROR_FATAL, current->location.filename,
+                        current->location.line, current->location.column,
+                        "Failed to grow AST traversal worklist",
+                        "Try closing other applications to free memory",
+                        __FILE__, __LINE__);
+        }
+        ast_free_node_payload(current);
+    }
+
+    worklist_destroy(&worklist);
 }
 
 //------------------------------------------------------------------------------
 // AST visitor pattern
 //------------------------------------------------------------------------------
 
-bool ast_accept(AstNode* node, AstVisitor* visitor) {
-    if (!node || !visitor) return true;
-    
+/*
+ * Invoke the visitor callback registered for a node's type. A missing
+ * callback counts as success; an unknown node type fails the traversal.
+ */
+static bool ast_visit_node(AstNode* node, AstVisitor* visitor) {
     switch (node->type) {
         case AST_PROGRAM:
-            if (visitor->visit_program && !visitor->visit_program(visitor, node)) return false;
-            for (int i = 0; i < node->as.program.declaration_count; i++) {
-                if (!ast_accept(node->as.program.declarations[i], visitor)) return false;
-            }
-            break;
-            
+            return !visitor->visit_program || visitor->visit_program(visitor, node);
         case AST_FUNCTION_DECL:
-            if (visitor->visit_function_decl && !visitor->visit_function_decl(visitor, node)) return false;
-            for (int i = 0; i < node->as.function_decl.parameter_count; i++) {
-                if (!ast_accept(node->as.function_decl.parameters[i], visitor)) return false;
-            }
-            if (node->as.function_decl.body) {
-                if (!ast_accept(node->as.function_decl.body, visitor)) return false;
-            }
-            break;
-            
+            return !visitor->visit_function_decl || visitor->visit_function_decl(visitor, node);
         case AST_VAR_DECL:
-            if (visitor->visit_var_decl && !visitor->visit_var_decl(visitor, node)) return false;
-            if (node->as.var_decl.initializer) {
-                if (!ast_accept(node->as.var_decl.initializer, visitor)) return false;
-            }
-            break;
-            
+            return !visitor->visit_var_decl || visitor->visit_var_decl(visitor, node);
         case AST_ARRAY_DECL:
-            if (visitor->visit_array_decl && !visitor->visit_array_decl(visitor, node)) return false;
-            for (int i = 0; i < node->as.array_decl.initializer_count; i++) {
-                if (!ast_accept(node->as.array_decl.initializers[i], visitor)) return false;
-            }
-            break;
-            
+            return !visitor->visit_array_decl || visitor->visit_array_decl(visitor, node);
         case AST_BLOCK:
-            if (visitor->visit_block && !visitor->visit_block(visitor, node)) return false;
-            for (int i = 0; i < node->as.block.statement_count; i++) {
-                if (!ast_accept(node->as.block.statements[i], visitor)) return false;
-            }
-            break;
-            
+            return !visitor->visit_block || visitor->visit_block(visitor, node);
         case AST_IF_STMT:
-            if (visitor->visit_if_stmt && !visitor->visit_if_stmt(visitor, node)) return false;
-            if (!ast_accept(node->as.if_stmt.condition, visitor)) return false;
-            if (!ast_accept(node->as.if_stmt.then_branch, visitor)) return false;
-            if (node->as.if_stmt.else_branch) {
-                if (!ast_accept(node->as.if_stmt.else_branch, visitor)) return false;
-            }
-            break;
-            
+            return !visitor->visit_if_stmt || visitor->visit_if_stmt(visitor, node);
         case AST_WHILE_STMT:
-            if (visitor->visit_while_stmt && !visitor->visit_while_stmt(visitor, node)) return false;
-            if (!ast_accept(node->as.while_stmt.condition, visitor)) return false;
-            if (!ast_accept(node->as.while_stmt.body, visitor)) return false;
-            break;
-            
+            return !visitor->visit_while_stmt || visitor->visit_while_stmt(visitor, node);
         case AST_DO_WHILE_STMT:
-            if (visitor->visit_do_while_stmt && !visitor->visit_do_while_stmt(visitor, node)) return false;
-            if (!ast_accept(node->as.while_stmt.body, visitor)) return false;
-            if (!ast_accept(node->as.while_stmt.condition, visitor)) return false;
-            break;
-            
+            return !visitor->visit_do_while_stmt || visitor->visit_do_while_stmt(visitor, node);
         case AST_FOR_STMT:
-            if (visitor->visit_for_stmt && !visitor->visit_for_stmt(visitor, node)) return false;
-            if (node->as.for_stmt.initializer) {
-                if (!ast_accept(node->as.for_stmt.initializer, visitor)) return false;
-            }
-            if (node->as.for_stmt.condition) {
-                if (!ast_accept(node->as.for_stmt.condition, visitor)) return false;
-            }
-            if (node->as.for_stmt.increment) {
-                if (!ast_accept(node->as.for_stmt.increment, visitor)) return false;
-            }
-            if (!ast_accept(node->as.for_stmt.body, visitor)) return false;
-            break;
-            
+            return !visitor->visit_for_stmt || visitor->visit_for_stmt(visitor, node);
         case AST_RETURN_STMT:
-            if (visitor->visit_return_stmt && !visitor->visit_return_stmt(visitor, node)) return false;
-            if (node->as.return_stmt.value) {
-                if (!ast_accept(node->as.return_stmt.value, visitor)) return false;
-            }
-            break;
-            
+            return !visitor->visit_return_stmt || visitor->visit_return_stmt(visitor, node);
         case AST_BREAK_STMT:
-            if (visitor->visit_break_stmt && !visitor->visit_break_stmt(visitor, node)) return false;
-            break;
-            
+            return !visitor->visit_break_stmt || visitor->visit_break_stmt(visitor, node);
         case AST_EXPR_STMT:
-            if (visitor->visit_expr_stmt && !visitor->visit_expr_stmt(visitor, node)) return false;
-            if (!ast_accept(node->as.expr_stmt.expression, visitor)) return false;
-            break;
-            
+            return !visitor->visit_expr_stmt || visitor->visit_expr_stmt(visitor, node);
         case AST_BINARY_EXPR:
-            if (visitor->visit_binary_expr && !visitor->visit_binary_expr(visitor, node)) return false;
-            if (!ast_accept(node->as.binary_expr.left, visitor)) return false;
-            if (!ast_accept(node->as.binary_expr.right, visitor)) return false;
-            break;
-            
+            return !visitor->visit_binary_expr || visitor->visit_binary_expr(visitor, node);
         case AST_UNARY_EXPR:
-            if (visitor->visit_unary_expr && !visitor->visit_unary_expr(visitor, node)) return false;
-            if (!ast_accept(node->as.unary_expr.operand, visitor)) return false;
-            break;
-            
+            return !visitor->visit_unary_expr || visitor->visit_unary_expr(visitor, node);
         case AST_LITERAL_INT:
-            if (visitor->visit_literal_int && !visitor->visit_literal_int(visitor, node)) return false;
-            break;
-            
+            return !visitor->visit_literal_int || visitor->visit_literal_int(visitor, node);
         case AST_LITERAL_CHAR:
-            if (visitor->visit_literal_char && !visitor->visit_literal_char(visitor, node)) return false;
-            break;
-            
+            return !visitor->visit_literal_char || visitor->visit_literal_char(visitor, node);
         case AST_LITERAL_STRING:
-            if (visitor->visit_literal_string && !visitor->visit_literal_string(visitor, node)) return false;
-            break;
-            
+            return !visitor->visit_literal_string || visitor->visit_literal_string(visitor, node);
         case AST_LITERAL_BOOL:
-            if (visitor->visit_literal_bool && !visitor->visit_literal_bool(visitor, node)) return false;
-            break;
-            
+            return !visitor->visit_literal_bool || visitor->visit_literal_bool(visitor, node);
         case AST_IDENTIFIER:
-            if (visitor->visit_identifier && !visitor->visit_identifier(visitor, node)) return false;
-            break;
-            
+            return !visitor->visit_identifier || visitor->visit_identifier(visitor, node);
         case AST_ARRAY_ACCESS:
-            if (visitor->visit_array_access && !visitor->visit_array_access(visitor, node)) return false;
-            if (!ast_accept(node->as.array_access.array, visitor)) return false;
-            if (!ast_accept(node->as.array_access.index, visitor)) return false;
-            break;
-            
+            return !visitor->visit_array_access || visitor->visit_array_access(visitor, node);
         case AST_CALL_EXPR:
-            if (visitor->visit_call_expr && !visitor->visit_call_expr(visitor, node)) return false;
-            if (!ast_accept(node->as.call_expr.callee, visitor)) return false;
-            for (int i = 0; i < node->as.call_expr.argument_count; i++) {
-                if (!ast_accept(node->as.call_expr.arguments[i], visitor)) return false;
-            }
-            break;
-            
+            return !visitor->visit_call_expr || visitor->visit_call_expr(visitor, node);
         case AST_ASSIGNMENT:
-            if (visitor->visit_assignment && !visitor->visit_assignment(visitor, node)) return false;
-            if (!ast_accept(node->as.assignment.target, visitor)) return false;
-            if (!ast_accept(node->as.assignment.value, visitor)) return false;
-            break;
-            
+            return !visitor->visit_assignment || visitor->visit_assignment(visitor, node);
         case AST_TYPE:
-            if (visitor->visit_type && !visitor->visit_type(visitor, node)) return false;
-            break;
-            
+            return !visitor->visit_type || visitor->visit_type(visitor, node);
         default:
             // Unknown node type
             return false;
     }
-    
-    return true;
+}
+
+bool ast_accept(AstNode* node, AstVisitor* visitor) {
+    if (!node || !visitor) return true;
+
+    NodeWorklist worklist;
+    worklist_init(&worklist);
+    worklist_push(&worklist, node);
+
+    // Popping children in visit order preserves the pre-order traversal
+    // the recursive implementation performed
+    bool ok = true;
+    AstNode* current;
+    while (ok && (current = worklist_pop(&worklist)) != NULL) {
+        ok = ast_visit_node(current, visitor) &&
+             worklist_push_children(&worklist, current);
+    }
+
+    worklist_destroy(&worklist);
+    return ok;
 }
 
 //------------------------------------------------------------------------------
@@ -949,191 +1147,245 @@ static const char* get_type_name(TypeInfo* type) {
     }
 }
 
-void ast_print(AstNode* node, int indent) {
+/*
+ * Work item for the iterative printer: either a node to print or a label
+ * line (such as "Body:" or "Parameter 0:") that precedes a child.
+ */
+typedef struct {
+    AstNode* node;      // Node to print; unused when label is set
+    const char* label;  // printf format for a label line, or NULL
+    int ordinal;        // Value for a %d in label, or -1 for plain labels
+    int indent;
+} PrintTask;
+
+typedef struct {
+    PrintTask* items;
+    size_t count;
+    size_t capacity;
+    PrintTask inline_items[WORKLIST_INLINE_CAPACITY];
+} PrintWorklist;
+
+static void print_worklist_init(PrintWorklist* list) {
+    list->items = list->inline_items;
+    list->count = 0;
+    list->capacity = WORKLIST_INLINE_CAPACITY;
+}
+
+static void print_worklist_destroy(PrintWorklist* list) {
+    if (list->items != list->inline_items) {
+        free(list->items);
+    }
+}
+
+static bool print_worklist_push(PrintWorklist* list, PrintTask task) {
+    if (list->count == list->capacity) {
+        size_t new_capacity = list->capacity * 2;
+        PrintTask* new_items;
+
+        if (list->items == list->inline_items) {
+            new_items = (PrintTask*)malloc(new_capacity * sizeof(PrintTask));
+            if (new_items) {
+                memcpy(new_items, list->items, list->count * sizeof(PrintTask));
+            }
+        } else {
+            new_items = (PrintTask*)realloc(list->items, new_capacity * sizeof(PrintTask));
+        }
+
+        if (!new_items) {
+            return false;
+        }
+        list->items = new_items;
+        list->capacity = new_capacity;
+    }
+
+    list->items[list->count++] = task;
+    return true;
+}
+
+static bool print_push_node(PrintWorklist* list, AstNode* node, int indent) {
+    PrintTask task = { node, NULL, -1, indent };
+    return print_worklist_push(list, task);
+}
+
+static bool print_push_label(PrintWorklist* list, const char* label, int ordinal, int indent) {
+    PrintTask task = { NULL, label, ordinal, indent };
+    return print_worklist_push(list, task);
+}
+
+/*
+ * Print one node's own lines (header plus inline attributes) and queue
+ * its labels and children. Tasks are pushed in reverse so popping emits
+ * them in source order; the output matches the old recursive printer
+ * byte for byte.
+ */
+static bool ast_print_node(PrintWorklist* list, AstNode* node, int indent) {
+    bool ok = true;
+
     if (!node) {
         print_indent(indent);
         printf("(null)\n");
-        return;
+        return true;
     }
-    
+
     print_indent(indent);
     printf("%s", get_node_type_name(node->type));
-    
+
     // Print node-specific information
     switch (node->type) {
         case AST_PROGRAM:
             printf(" (declarations: %d)\n", node->as.program.declaration_count);
-            for (int i = 0; i < node->as.program.declaration_count; i++) {
-                ast_print(node->as.program.declarations[i], indent + 1);
+            for (int i = node->as.program.declaration_count - 1; i >= 0; i--) {
+                ok &= print_push_node(list, node->as.program.declarations[i], indent + 1);
             }
             break;
-            
+
         case AST_FUNCTION_DECL:
-            printf(" (name: %s, params: %d, external: %s)\n", 
-                  node->as.function_decl.name, 
+            printf(" (name: %s, params: %d, external: %s)\n",
+                  node->as.function_decl.name,
                   node->as.function_decl.parameter_count,
                   node->as.function_decl.is_external ? "true" : "false");
-            
+
             print_indent(indent + 1);
             printf("Return type: %s\n", get_type_name(node->as.function_decl.return_type));
-            
-            for (int i = 0; i < node->as.function_decl.parameter_count; i++) {
-                print_indent(indent + 1);
-                printf("Parameter %d:\n", i);
-                ast_print(node->as.function_decl.parameters[i], indent + 2);
-            }
-            
+
             if (node->as.function_decl.body) {
-                print_indent(indent + 1);
-                printf("Body:\n");
-                ast_print(node->as.function_decl.body, indent + 2);
+                ok &= print_push_node(list, node->as.function_decl.body, indent + 2);
+                ok &= print_push_label(list, "Body:\n", -1, indent + 1);
+            }
+
+            for (int i = node->as.function_decl.parameter_count - 1; i >= 0; i--) {
+                ok &= print_push_node(list, node->as.function_decl.parameters[i], indent + 2);
+                ok &= print_push_label(list, "Parameter %d:\n", i, indent + 1);
             }
             break;
-            
+
         case AST_VAR_DECL:
             printf(" (name: %s)\n", node->as.var_decl.name);
-            
+
             print_indent(indent + 1);
             printf("Type: %s\n", get_type_name(node->as.var_decl.var_type));
-            
+
             if (node->as.var_decl.initializer) {
-                print_indent(indent + 1);
-                printf("Initializer:\n");
-                ast_print(node->as.var_decl.initializer, indent + 2);
+                ok &= print_push_node(list, node->as.var_decl.initializer, indent + 2);
+                ok &= print_push_label(list, "Initializer:\n", -1, indent + 1);
             }
             break;
-            
+
         case AST_ARRAY_DECL:
-            printf(" (name: %s, size: %d, initializers: %d)\n", 
-                  node->as.array_decl.name, 
+            printf(" (name: %s, size: %d, initializers: %d)\n",
+                  node->as.array_decl.name,
                   node->as.array_decl.size,
                   node->as.array_decl.initializer_count);
-            
+
             print_indent(indent + 1);
             printf("Element type: %s\n", get_type_name(node->as.array_decl.element_type));
-            
-            for (int i = 0; i < node->as.array_decl.initializer_count; i++) {
-                print_indent(indent + 1);
-                printf("Initializer %d:\n", i);
-                ast_print(node->as.array_decl.initializers[i], indent + 2);
+
+            for (int i = node->as.array_decl.initializer_count - 1; i >= 0; i--) {
+                ok &= print_push_node(list, node->as.array_decl.initializers[i], indent + 2);
+                ok &= print_push_label(list, "Initializer %d:\n", i, indent + 1);
             }
             break;
-            
+
         case AST_BLOCK:
             printf(" (statements: %d)\n", node->as.block.statement_count);
-            for (int i = 0; i < node->as.block.statement_count; i++) {
-                ast_print(node->as.block.statements[i], indent + 1);
+            for (int i = node->as.block.statement_count - 1; i >= 0; i--) {
+                ok &= print_push_node(list, node->as.block.statements[i], indent + 1);
             }
             break;
-            
+
         case AST_IF_STMT:
             printf("\n");
-            print_indent(indent + 1);
-            printf("Condition:\n");
-            ast_print(node->as.if_stmt.condition, indent + 2);
-            
-            print_indent(indent + 1);
-            printf("Then branch:\n");
-            ast_print(node->as.if_stmt.then_branch, indent + 2);
-            
             if (node->as.if_stmt.else_branch) {
-                print_indent(indent + 1);
-                printf("Else branch:\n");
-                ast_print(node->as.if_stmt.else_branch, indent + 2);
+                ok &= print_push_node(list, node->as.if_stmt.else_branch, indent + 2);
+                ok &= print_push_label(list, "Else branch:\n", -1, indent + 1);
             }
+
+            ok &= print_push_node(list, node->as.if_stmt.then_branch, indent + 2);
+            ok &= print_push_label(list, "Then branch:\n", -1, indent + 1);
+
+            ok &= print_push_node(list, node->as.if_stmt.condition, indent + 2);
+            ok &= print_push_label(list, "Condition:\n", -1, indent + 1);
             break;
-            
+
         case AST_WHILE_STMT:
             printf("\n");
-            print_indent(indent + 1);
-            printf("Condition:\n");
-            ast_print(node->as.while_stmt.condition, indent + 2);
-            
-            print_indent(indent + 1);
-            printf("Body:\n");
-            ast_print(node->as.while_stmt.body, indent + 2);
+            ok &= print_push_node(list, node->as.while_stmt.body, indent + 2);
+            ok &= print_push_label(list, "Body:\n", -1, indent + 1);
+
+            ok &= print_push_node(list, node->as.while_stmt.condition, indent + 2);
+            ok &= print_push_label(list, "Condition:\n", -1, indent + 1);
             break;
-            
+
         case AST_DO_WHILE_STMT:
             printf("\n");
-            print_indent(indent + 1);
-            printf("Body:\n");
-            ast_print(node->as.while_stmt.body, indent + 2);
-            
-            print_indent(indent + 1);
-            printf("Condition:\n");
-            ast_print(node->as.while_stmt.condition, indent + 2);
+            ok &= print_push_node(list, node->as.while_stmt.condition, indent + 2);
+            ok &= print_push_label(list, "Condition:\n", -1, indent + 1);
+
+            ok &= print_push_node(list, node->as.while_stmt.body, indent + 2);
+            ok &= print_push_label(list, "Body:\n", -1, indent + 1);
             break;
-            
+
         case AST_FOR_STMT:
             printf("\n");
-            if (node->as.for_stmt.initializer) {
-                print_indent(indent + 1);
-                printf("Initializer:\n");
-                ast_print(node->as.for_stmt.initializer, indent + 2);
+            ok &= print_push_node(list, node->as.for_stmt.body, indent + 2);
+            ok &= print_push_label(list, "Body:\n", -1, indent + 1);
+
+            if (node->as.for_stmt.increment) {
+                ok &= print_push_node(list, node->as.for_stmt.increment, indent + 2);
+                ok &= print_push_label(list, "Increment:\n", -1, indent + 1);
             }
-            
+
             if (node->as.for_stmt.condition) {
-                print_indent(indent + 1);
-                printf("Condition:\n");
-                ast_print(node->as.for_stmt.condition, indent + 2);
+                ok &= print_push_node(list, node->as.for_stmt.condition, indent + 2);
+                ok &= print_push_label(list, "Condition:\n", -1, indent + 1);
             }
-            
-            if (node->as.for_stmt.increment) {
-                print_indent(indent + 1);
-                printf("Increment:\n");
-                ast_print(node->as.for_stmt.increment, indent + 2);
+
+            if (node->as.for_stmt.initializer) {
+                ok &= print_push_node(list, node->as.for_stmt.initializer, indent + 2);
+                ok &= print_push_label(list, "Initializer:\n", -1, indent + 1);
             }
-            
-            print_indent(indent + 1);
-            printf("Body:\n");
-            ast_print(node->as.for_stmt.body, indent + 2);
             break;
-            
+
         case AST_RETURN_STMT:
             printf("\n");
             if (node->as.return_stmt.value) {
-                print_indent(indent + 1);
-                printf("Value:\n");
-                ast_print(node->as.return_stmt.value, indent + 2);
+                ok &= print_push_node(list, node->as.return_stmt.value, indent + 2);
+                ok &= print_push_label(list, "Value:\n", -1, indent + 1);
             }
             break;
-            
+
         case AST_BREAK_STMT:
             printf("\n");
             break;
-            
+
         case AST_EXPR_STMT:
             printf("\n");
-            ast_print(node->as.expr_stmt.expression, indent + 1);
+            ok &= print_push_node(list, node->as.expr_stmt.expression, indent + 1);
             break;
-            
+
         case AST_BINARY_EXPR:
             printf(" (operator: %s)\n", token_type_to_string(node->as.binary_expr.operator));
-            
-            print_indent(indent + 1);
-            printf("Left:\n");
-            ast_print(node->as.binary_expr.left, indent + 2);
-            
-            print_indent(indent + 1);
-            printf("Right:\n");
-            ast_print(node->as.binary_expr.right, indent + 2);
+
+            ok &= print_push_node(list, node->as.binary_expr.right, indent + 2);
+            ok &= print_push_label(list, "Right:\n", -1, indent + 1);
+
+            ok &= print_push_node(list, node->as.binary_expr.left, indent + 2);
+            ok &= print_push_label(list, "Left:\n", -1, indent + 1);
             break;
-            
+
         case AST_UNARY_EXPR:
-            printf(" (operator: %s, prefix: %s)\n", 
+            printf(" (operator: %s, prefix: %s)\n",
                   token_type_to_string(node->as.unary_expr.operator),
                   node->as.unary_expr.is_prefix ? "true" : "false");
-            
-            print_indent(indent + 1);
-            printf("Operand:\n");
-            ast_print(node->as.unary_expr.operand, indent + 2);
+
+            ok &= print_push_node(list, node->as.unary_expr.operand, indent + 2);
+            ok &= print_push_label(list, "Operand:\n", -1, indent + 1);
             break;
-            
+
         case AST_LITERAL_INT:
             printf(" (value: %ld)\n", (long)node->as.int_literal.value);
             break;
-            
+
         case AST_LITERAL_CHAR:
             if (node->as.char_literal.value >= 32 && node->as.char_literal.value <= 126) {
                 printf(" (value: '%c')\n", (char)node->as.char_literal.value);
@@ -1141,90 +1393,89 @@ void ast_print(AstNode* node, int indent) {
                 printf(" (value: '\\u%04x')\n", node->as.char_literal.value);
             }
             break;
-            
+
         case AST_LITERAL_STRING:
             printf(" (value: \"%s\")\n", node->as.string_literal.value ? node->as.string_literal.value : "");
             break;
-            
+
         case AST_LITERAL_BOOL:
             printf(" (value: %s)\n", node->as.bool_literal.value ? "true" : "false");
             break;
-            
+
         case AST_IDENTIFIER:
             printf(" (name: %s)\n", node->as.identifier.name);
             break;
-            
+
         case AST_ARRAY_ACCESS:
             printf("\n");
-            print_indent(indent + 1);
-            printf("Array:\n");
-            ast_print(node->as.array_access.array, indent + 2);
-            
-            print_indent(indent + 1);
-            printf("Index:\n");
-            ast_print(node->as.array_access.index, indent + 2);
+            ok &= print_push_node(list, node->as.array_access.index, indent + 2);
+            ok &= print_push_label(list, "Index:\n", -1, indent + 1);
+
+            ok &= print_push_node(list, node->as.array_access.array, indent + 2);
+            ok &= print_push_label(list, "Array:\n", -1, indent + 1);
             break;
-            
+
         case AST_CALL_EXPR:
             printf(" (arguments: %d)\n", node->as.call_expr.argument_count);
-            
-            print_indent(indent + 1);
-            printf("Callee:\n");
-            ast_print(node->as.call_expr.callee, indent + 2);
-            
-            for (int i = 0; i < node->as.call_expr.argument_count; i++) {
-                print_indent(indent + 1);
-                printf("Argument %d:\n", i);
-                ast_print(node->as.call_expr.arguments[i], indent + 2);
+
+            for (int i = node->as.call_expr.argument_count - 1; i >= 0; i--) {
+                ok &= print_push_node(list, node->as.call_expr.arguments[i], indent + 2);
+                ok &= print_push_label(list, "Argument %d:\n", i, indent + 1);
             }
+
+            ok &= print_push_node(list, node->as.call_expr.callee, indent + 2);
+            ok &= print_push_label(list, "Callee:\n", -1, indent + 1);
             break;
-            
+
         case AST_ASSIGNMENT:
             printf("\n");
-            print_indent(indent + 1);
-            printf("Target:\n");
-            ast_print(node->as.assignment.target, indent + 2);
-            
-            print_indent(indent + 1);
-            printf("Value:\n");
-            ast_print(node->as.assignment.value, indent + 2);
+            ok &= print_push_node(list, node->as.assignment.value, indent + 2);
+            ok &= print_push_label(list, "Value:\n", -1, indent + 1);
+
+            ok &= print_push_node(list, node->as.assignment.target, indent + 2);
+            ok &= print_push_label(list, "Target:\n", -1, indent + 1);
             break;
-            
+
         case AST_TYPE:
             printf(" (type: %s)\n", get_type_name(node->as.type_node.type_data));
             break;
-            
+
         default:
             printf(" (unknown node type)\n");
             break;
     }
+
+    return ok;
 }
 
-//------------------------------------------------------------------------------
-// AST cloning
-//------------------------------------------------------------------------------
+void ast_print(AstNode* node, int indent) {
+    PrintWorklist worklist;
+    print_worklist_init(&worklist);
+    print_push_node(&worklist, node, indent);
 
-static AstNode** clone_node_array(AstNode** nodes, int count) {
-    if (!nodes || count <= 0) return NULL;
-    
-    AstNode** cloned = (AstNode**)malloc(count * sizeof(AstNode*));
-    if (!cloned) return NULL;
-    
-    for (int i = 0; i < count; i++) {
-        cloned[i] = ast_clone(nodes[i]);
-        if (!cloned[i]) {
-            // Cleanup previously cloned nodes on failure
-            for (int j = 0; j < i; j++) {
-                ast_free(cloned[j]);
+    bool ok = true;
+    while (ok && worklist.count > 0) {
+        PrintTask task = worklist.items[--worklist.count];
+
+        if (task.label) {
+            print_indent(task.indent);
+            if (task.ordinal >= 0) {
+                printf(task.label, task.ordinal);
+            } else {
+                printf("%s", task.label);
             }
-            free(cloned);
-            return NULL;
+        } else {
+            ok = ast_print_node(&worklist, task.node, task.indent);
         }
     }
-    
-    return cloned;
+
+    print_worklist_destroy(&worklist);
 }
 
+//------------------------------------------------------------------------------
+// AST cloning
+//------------------------------------------------------------------------------
+
 static TypeInfo* clone_type(TypeInfo* type) {
     if (!type) return NULL;
     
@@ -1264,7 +1515,7 @@ static TypeInfo* clone_type(TypeInfo* type) {
             
             TypeInfo** param_types = NULL;
             if (type->info.function.param_count > 0 && type->info.function.param_types) {
-                param_types = (TypeInfo**)malloc(type->info.function.param_count * sizeof(TypeInfo*));
+                param_types = (TypeInfo**)ast_alloc(type->info.function.param_count * sizeof(TypeInfo*));
                 if (!param_types) {
                     type_free(return_type);
                     return NULL;
@@ -1277,7 +1528,7 @@ static TypeInfo* clone_type(TypeInfo* type) {
                         for (int j = 0; j < i; j++) {
                             type_free(param_types[j]);
                         }
-                        free(param_types);
+                        ast_release(param_types);
                         type_free(return_type);
                         return NULL;
                     }
@@ -1289,7 +1540,7 @@ static TypeInfo* clone_type(TypeInfo* type) {
                 for (int i = 0; i < type->info.function.param_count; i++) {
                     type_free(param_types[i]);
                 }
-                free(param_types);
+                ast_release(param_types);
                 type_free(return_type);
             }
             break;
@@ -1301,189 +1552,145 @@ static TypeInfo* clone_type(TypeInfo* type) {
 
 AstNode* ast_clone(AstNode* node) {
     if (!node) return NULL;
-    
-    AstNode* cloned = NULL;
-    
+
+    // Copy-on-write: the clone shares the whole subtree. A private copy
+    // is only materialised when a caller asks via ast_make_unique()
+    node->ref_count++;
+    return node;
+}
+
+/*
+ * Take shared references to every node of an array for a materialised
+ * copy. Returns NULL on allocation failure (or an empty input).
+ */
+static AstNode** share_node_array(AstNode** nodes, int count) {
+    if (!nodes || count <= 0) return NULL;
+
+    AstNode** shared = (AstNode**)ast_alloc(count * sizeof(AstNode*));
+    if (!shared) return NULL;
+
+    for (int i = 0; i < count; i++) {
+        shared[i] = ast_clone(nodes[i]);
+    }
+
+    return shared;
+}
+
+AstNode* ast_make_unique(AstNode* node) {
+    if (!node || node->ref_count == 1) return node;
+
+    AstNode* copy = ast_alloc_node();
+    if (!check_null(copy, "Failed to materialize private node copy", node->location)) return NULL;
+
+    // Shallow copy; children stay shared and are materialised themselves
+    // only if the caller goes on to mutate them
+    *copy = *node;
+    copy->ref_count = 1;
+
+    if (node->type_info) {
+        copy->type_info = clone_type(node->type_info);
+    }
+
     switch (node->type) {
-        case AST_PROGRAM: {
-            AstNode** decls = clone_node_array(node->as.program.declarations, 
-                                             node->as.program.declaration_count);
-            cloned = ast_create_program(decls, node->as.program.declaration_count, node->location);
-            break;
-        }
-            
-        case AST_FUNCTION_DECL: {
-            AstNode** params = clone_node_array(node->as.function_decl.parameters,
-                                              node->as.function_decl.parameter_count);
-            AstNode* body = ast_clone(node->as.function_decl.body);
-            TypeInfo* return_type = clone_type(node->as.function_decl.return_type);
-            
-            cloned = ast_create_function_decl(node->as.function_decl.name, params,
-                                            node->as.function_decl.parameter_count, body,
-                                            return_type, node->as.function_decl.is_external,
-                                            node->location);
-            break;
-        }
-            
-        case AST_VAR_DECL: {
-            AstNode* init = ast_clone(node->as.var_decl.initializer);
-            TypeInfo* type = clone_type(node->as.var_decl.var_type);
-            
-            cloned = ast_create_var_decl(node->as.var_decl.name, init, type, node->location);
-            break;
-        }
-            
-        case AST_ARRAY_DECL: {
-            AstNode** inits = clone_node_array(node->as.array_decl.initializers,
-                                             node->as.array_decl.initializer_count);
-            TypeInfo* element_type = clone_type(node->as.array_decl.element_type);
-            
-            cloned = ast_create_array_decl(node->as.array_decl.name, node->as.array_decl.size,
-                                         inits, node->as.array_decl.initializer_count,
-                                         element_type, node->location);
-            break;
-        }
-            
-        case AST_BLOCK: {
-            AstNode** statements = clone_node_array(node->as.block.statements,
-                                                  node->as.block.statement_count);
-            
-            cloned = ast_create_block(statements, node->as.block.statement_count, node->location);
-            break;
-        }
-            
-        case AST_IF_STMT: {
-            AstNode* condition = ast_clone(node->as.if_stmt.condition);
-            AstNode* then_branch = ast_clone(node->as.if_stmt.then_branch);
-            AstNode* else_branch = ast_clone(node->as.if_stmt.else_branch);
-            
-            cloned = ast_create_if_stmt(condition, then_branch, else_branch, node->location);
+        case AST_PROGRAM:
+            copy->as.program.declarations =
+                share_node_array(node->as.program.declarations,
+                                 node->as.program.declaration_count);
             break;
-        }
-            
-        case AST_WHILE_STMT: {
-            AstNode* condition = ast_clone(node->as.while_stmt.condition);
-            AstNode* body = ast_clone(node->as.while_stmt.body);
-            
-            cloned = ast_create_while_stmt(condition, body, node->location);
+
+        case AST_FUNCTION_DECL:
+            copy->as.function_decl.parameters =
+                share_node_array(node->as.function_decl.parameters,
+                                 node->as.function_decl.parameter_count);
+            copy->as.function_decl.body = ast_clone(node->as.function_decl.body);
+            copy->as.function_decl.return_type = clone_type(node->as.function_decl.return_type);
             break;
-        }
-            
-        case AST_DO_WHILE_STMT: {
-            AstNode* body = ast_clone(node->as.while_stmt.body);
-            AstNode* condition = ast_clone(node->as.while_stmt.condition);
-            
-            cloned = ast_create_do_while_stmt(body, condition, node->location);
+
+        case AST_VAR_DECL:
+            copy->as.var_decl.initializer = ast_clone(node->as.var_decl.initializer);
+            copy->as.var_decl.var_type = clone_type(node->as.var_decl.var_type);
             break;
-        }
-            
-        case AST_FOR_STMT: {
-            AstNode* init = ast_clone(node->as.for_stmt.initializer);
-            AstNode* condition = ast_clone(node->as.for_stmt.condition);
-            AstNode* increment = ast_clone(node->as.for_stmt.increment);
-            AstNode* body = ast_clone(node->as.for_stmt.body);
-            
-            cloned = ast_create_for_stmt(init, condition, increment, body, node->location);
+
+        case AST_ARRAY_DECL:
+            copy->as.array_decl.initializers =
+                share_node_array(node->as.array_decl.initializers,
+                                 node->as.array_decl.initializer_count);
+            copy->as.array_decl.element_type = clone_type(node->as.array_decl.element_type);
             break;
-        }
-            
-        case AST_RETURN_STMT: {
-            AstNode* value = ast_clone(node->as.return_stmt.value);
-            
-            cloned = ast_create_return_stmt(value, node->location);
+
+        case AST_BLOCK:
+            copy->as.block.statements =
+                share_node_array(node->as.block.statements,
+                                 node->as.block.statement_count);
             break;
-        }
-            
-        case AST_BREAK_STMT: {
-            cloned = ast_create_break_stmt(node->location);
+
+        case AST_IF_STMT:
+            copy->as.if_stmt.condition = ast_clone(node->as.if_stmt.condition);
+            copy->as.if_stmt.then_branch = ast_clone(node->as.if_stmt.then_branch);
+            copy->as.if_stmt.else_branch = ast_clone(node->as.if_stmt.else_branch);
             break;
-        }
-            
-        case AST_EXPR_STMT: {
-            AstNode* expr = ast_clone(node->as.expr_stmt.expression);
-            
-            cloned = ast_create_expr_stmt(expr, node->location);
+
+        case AST_WHILE_STMT:
+        case AST_DO_WHILE_STMT:
+            copy->as.while_stmt.condition = ast_clone(node->as.while_stmt.condition);
+            copy->as.while_stmt.body = ast_clone(node->as.while_stmt.body);
             break;
-        }
-            
-        case AST_BINARY_EXPR: {
-            AstNode* left = ast_clone(node->as.binary_expr.left);
-            AstNode* right = ast_clone(node->as.binary_expr.right);
-            
-            cloned = ast_create_binary_expr(left, node->as.binary_expr.operator, right, node->location);
+
+        case AST_FOR_STMT:
+            copy->as.for_stmt.initializer = ast_clone(node->as.for_stmt.initializer);
+            copy->as.for_stmt.condition = ast_clone(node->as.for_stmt.condition);
+            copy->as.for_stmt.increment = ast_clone(node->as.for_stmt.increment);
+            copy->as.for_stmt.body = ast_clone(node->as.for_stmt.body);
             break;
-        }
-            
-        case AST_UNARY_EXPR: {
-            AstNode* operand = ast_clone(node->as.unary_expr.operand);
-            
-            cloned = ast_create_unary_expr(operand, node->as.unary_expr.operator,
-                                         node->as.unary_expr.is_prefix, node->location);
+
+        case AST_RETURN_STMT:
+            copy->as.return_stmt.value = ast_clone(node->as.return_stmt.value);
             break;
-        }
-            
-        case AST_LITERAL_INT: {
-            cloned = ast_create_literal_int(node->as.int_literal.value, node->location);
+
+        case AST_EXPR_STMT:
+            copy->as.expr_stmt.expression = ast_clone(node->as.expr_stmt.expression);
             break;
-        }
-            
-        case AST_LITERAL_CHAR: {
-            cloned = ast_create_literal_char(node->as.char_literal.value, node->location);
+
+        case AST_BINARY_EXPR:
+            copy->as.binary_expr.left = ast_clone(node->as.binary_expr.left);
+            copy->as.binary_expr.right = ast_clone(node->as.binary_expr.right);
             break;
-        }
-            
-        case AST_LITERAL_STRING: {
-            cloned = ast_create_literal_string(node->as.string_literal.value, node->location);
+
+        case AST_UNARY_EXPR:
+            copy->as.unary_expr.operand = ast_clone(node->as.unary_expr.operand);
             break;
-        }
-            
-        case AST_LITERAL_BOOL: {
-            cloned = ast_create_literal_bool(node->as.bool_literal.value, node->location);
+
+        case AST_LITERAL_STRING:
+            copy->as.string_literal.value = string_duplicate(node->as.string_literal.value);
             break;
-        }
-            
-        case AST_IDENTIFIER: {
-            cloned = ast_create_identifier(node->as.identifier.name, node->location);
+
+        case AST_ARRAY_ACCESS:
+            copy->as.array_access.array = ast_clone(node->as.array_access.array);
+            copy->as.array_access.index = ast_clone(node->as.array_access.index);
             break;
-        }
-            
-        case AST_ARRAY_ACCESS: {
-            AstNode* array = ast_clone(node->as.array_access.array);
-            AstNode* index = ast_clone(node->as.array_access.index);
-            
-            cloned = ast_create_array_access(array, index, node->location);
+
+        case AST_CALL_EXPR:
+            copy->as.call_expr.callee = ast_clone(node->as.call_expr.callee);
+            copy->as.call_expr.arguments =
+                share_node_array(node->as.call_expr.arguments,
+                                 node->as.call_expr.argument_count);
             break;
-        }
-            
-        case AST_CALL_EXPR: {
-            AstNode* callee = ast_clone(node->as.call_expr.callee);
-            AstNode** args = clone_node_array(node->as.call_expr.arguments,
-                                            node->as.call_expr.argument_count);
-            
-            cloned = ast_create_call_expr(callee, args, node->as.call_expr.argument_count, node->location);
+
+        case AST_ASSIGNMENT:
+            copy->as.assignment.target = ast_clone(node->as.assignment.target);
+            copy->as.assignment.value = ast_clone(node->as.assignment.value);
             break;
-        }
-            
-        case AST_ASSIGNMENT: {
-            AstNode* target = ast_clone(node->as.assignment.target);
-            AstNode* value = ast_clone(node->as.assignment.value);
-            
-            cloned = ast_create_assignment(target, value, node->location);
+
+        case AST_TYPE:
+            copy->as.type_node.type_data = clone_type(node->as.type_node.type_data);
             break;
-        }
-            
-        case AST_TYPE: {
-            TypeInfo* type_data = clone_type(node->as.type_node.type_data);
-            
-            cloned = ast_create_type(type_data, node->location);
+
+        default:
+            // Leaf node types carry no owned pointers besides type_info
             break;
-        }
-    }
-    
-    // Copy type info if any
-    if (cloned && node->type_info) {
-        cloned->type_info = clone_type(node->type_info);
     }
-    
-    return cloned;
-}
\ No newline at end of file
+
+    // The caller's reference to the shared original moves to the copy
+    node->ref_count--;
+    return copy;
+}
@@ -30,6 +30,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "../lexer/lexer.h"
+#include "../utils/arena.h"
 #include "../utils/error.h"
 
 // Forward declarations
@@ -111,6 +112,7 @@ struct AstNode {
     AstNodeType type;
     SourceLocation location;
     TypeInfo* type_info;     // Type information (filled during semantic analysis)
+    int ref_count;           // Number of owners; subtrees are shared by ast_clone
     
     union {
         // Program node
@@ -486,11 +488,15 @@ AstNode* ast_create_expr_stmt(AstNode* expression, SourceLocation location);
 /**
  * Create a binary expression node
  *
+ * When both operands are integer literals the expression is folded at
+ * parse time and a single integer literal node is returned instead;
+ * division and modulo by zero are never folded.
+ *
  * @param left Left operand
  * @param operator Binary operator
  * @param right Right operand
  * @param location Source location information
- * @return A new binary expression node
+ * @return A new binary expression node, or a folded literal node
  */
 AstNode* ast_create_binary_expr(AstNode* left, TokenType operator, AstNode* right,
                                SourceLocation location);
@@ -498,11 +504,14 @@ AstNode* ast_create_binary_expr(AstNode* left, TokenType operator, AstNode* righ
 /**
  * Create a unary expression node
  *
+ * Prefix -, ! and ~ applied to an integer literal are folded at parse
+ * time into a single integer literal node.
+ *
  * @param operand Operand expression
  * @param operator Unary operator
  * @param is_prefix Whether the operator is a prefix (true) or postfix (false)
  * @param location Source location information
- * @return A new unary expression node
+ * @return A new unary expression node, or a folded literal node
  */
 AstNode* ast_create_unary_expr(AstNode* operand, TokenType operator, bool is_prefix,
                               SourceLocation location);
@@ -525,6 +534,20 @@ AstNode* ast_create_literal_int(intptr_t value, SourceLocation location);
  */
 AstNode* ast_create_literal_char(int32_t value, SourceLocation location);
 
+/**
+ * Create a string literal node from a byte range
+ *
+ * Takes the token's zero-copy slice directly, so the literal is
+ * copied exactly once, from the source buffer into the node.
+ *
+ * @param value Start of the string contents (UTF-8 encoded)
+ * @param length Length of the contents in bytes
+ * @param location Source location information
+ * @return A new string literal node
+ */
+AstNode* ast_create_literal_string_n(const char* value, size_t length,
+                                     SourceLocation location);
+
 /**
  * Create a string literal node
  *
@@ -594,9 +617,10 @@ AstNode* ast_create_assignment(AstNode* target, AstNode* value, SourceLocation l
 AstNode* ast_create_type(TypeInfo* type_data, SourceLocation location);
 
 /**
- * Free an AST node and all its children recursively
+ * Release one reference to an AST node. The node and its children are
+ * freed once no other clone shares them
  *
- * @param node The node to free
+ * @param node The node to release
  */
 void ast_free(AstNode* node);
 
@@ -609,11 +633,46 @@ void ast_free(AstNode* node);
 void ast_print(AstNode* node, int indent);
 
 /**
- * Create a deep clone of an AST node and all its children
+ * Clone an AST node with copy-on-write semantics. The clone shares the
+ * whole subtree with the original in O(1); call ast_make_unique() before
+ * mutating a node obtained this way. Each clone must be released with
+ * its own ast_free()
  *
  * @param node The node to clone
- * @return A new node that is a deep copy of the original
+ * @return The shared node with its reference count raised
  */
 AstNode* ast_clone(AstNode* node);
 
+/**
+ * Materialize a privately owned copy of a shared node. Returns the node
+ * itself when it is not shared; otherwise builds a shallow copy whose
+ * children remain shared, so only the nodes actually mutated are ever
+ * copied. The caller's reference to the original is consumed
+ *
+ * @param node The possibly shared node
+ * @return A node with a reference count of one that is safe to mutate
+ */
+AstNode* ast_make_unique(AstNode* node);
+
+/**
+ * Install an arena that all subsequent AST allocations (nodes, type info,
+ * name strings and child arrays) are served from. While an arena is
+ * installed, ast_free() and type_free() become no-ops: the whole tree is
+ * released at once with arena_reset() or arena_destroy().
+ *
+ * The caller (typically the parser) owns the arena. Install it before
+ * building a tree and do not mix arena and malloc-backed nodes in the
+ * same tree. Pass NULL to return to individual malloc/free allocation.
+ *
+ * @param arena The arena to allocate from, or NULL to disable
+ */
+void ast_set_arena(Arena* arena);
+
+/**
+ * Get the arena currently used for AST allocations
+ *
+ * @return The installed arena, or NULL if none is installed
+ */
+Arena* ast_get_arena(void);
+
 #endif /* AST_H */
\ No newline at end of file
@@ -0,0 +1,881 @@
+/*
+ * filename: ast_cache.c
+ *
+ * Purpose:
+ * Implementation of the binary AST cache for the ћ++ compiler. A parsed
+ * program is flattened into a position-independent ".ћast" file and
+ * later reconstructed without re-running the lexer or parser.
+ *
+ * Key Components:
+ * - CacheWriter: Flattens a tree breadth-first into index-based records
+ * - CacheReader: Rebuilds the tree from a mapped cache file
+ * - ast_cache_save() / ast_cache_load(): The public entry points
+ *
+ * Interactions:
+ * - Walks the AstNode/TypeInfo structures defined in ast.h
+ * - Loaded trees are served from an arena (utils/arena.h) and node
+ *   names re-enter the global intern pool (utils/intern.h)
+ *
+ * Notes:
+ * - All cross references are 1-based indices; 0 encodes a NULL child,
+ *   so the file is valid at any load address
+ * - Loading maps the file read-only and fills two contiguous arena
+ *   blocks (nodes and types) in one linear pass - no recursion and no
+ *   per-node heap allocation
+ * - A malformed or stale file is never an error: the caller just falls
+ *   back to a regular parse
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ast_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../utils/error.h"
+#include "../utils/intern.h"
+
+#define AST_CACHE_MAGIC   0x045BA57Au  // 'ћ' (U+045B) + "AST"
+#define AST_CACHE_VERSION 1u
+
+//------------------------------------------------------------------------------
+// On-disk format
+//------------------------------------------------------------------------------
+
+// File layout: AstCacheHeader, then node_count CachedNode records,
+// type_count CachedType records, index_count uint32_t pool entries
+// (the flattened child/parameter arrays) and string_bytes of
+// NUL-terminated string data.
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t source_hash;    // FNV-1a of the source text
+    uint64_t source_length;  // Length of the source text in bytes
+    uint32_t node_count;
+    uint32_t type_count;
+    uint32_t index_count;
+    uint32_t string_bytes;
+    uint32_t root;           // Root node reference (index + 1)
+    uint32_t filename;       // Source filename (string offset + 1)
+} AstCacheHeader;
+
+// One flattened node. The payload slots a..f are interpreted per node
+// type, mirroring the unions in ast.h:
+//   node references are node index + 1 (0 = NULL)
+//   type references are type index + 1 (0 = NULL)
+//   strings are string-table offset + 1 (0 = NULL)
+//   child arrays are (pool offset, count) pairs
+//
+//   PROGRAM       a=declarations pool  b=count
+//   FUNCTION_DECL a=name  b=params pool  c=count  d=body  e=ret type  f=extern
+//   VAR_DECL      a=name  b=initializer  c=var type
+//   ARRAY_DECL    a=name  b=size  c=inits pool  d=count  e=element type
+//   BLOCK         a=statements pool  b=count
+//   IF_STMT       a=condition  b=then  c=else
+//   WHILE/DO      a=condition  b=body
+//   FOR_STMT      a=init  b=condition  c=increment  d=body
+//   RETURN_STMT   a=value
+//   EXPR_STMT     a=expression
+//   BINARY_EXPR   a=operator  b=left  c=right
+//   UNARY_EXPR    a=operator  b=operand  c=prefix flag
+//   LITERAL_INT   a=value low 32 bits  b=value high 32 bits
+//   LITERAL_CHAR  a=codepoint      LITERAL_STRING a=value
+//   LITERAL_BOOL  a=value          IDENTIFIER     a=name
+//   ARRAY_ACCESS  a=array  b=index
+//   CALL_EXPR     a=callee  b=arguments pool  c=count
+//   ASSIGNMENT    a=target  b=value
+//   TYPE          a=type data
+typedef struct {
+    uint32_t type;
+    int32_t line;
+    int32_t column;
+    uint32_t type_info;
+    uint32_t a, b, c, d, e, f;
+} CachedNode;
+
+// One flattened TypeInfo:
+//   ARRAY     a=element type  b=size
+//   FUNCTION  a=return type  b=param types pool  c=count
+typedef struct {
+    uint32_t category;
+    uint32_t a, b, c;
+} CachedType;
+
+//------------------------------------------------------------------------------
+// Public helpers
+//------------------------------------------------------------------------------
+
+uint64_t ast_cache_source_hash(const char* source_text, size_t source_length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < source_length; i++) {
+        hash ^= (unsigned char)source_text[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+char* ast_cache_derive_path(const char* source_path) {
+    if (!source_path) return NULL;
+
+    static const char source_ext[] = ".ћпп";
+    static const char cache_ext[] = ".ћast";
+
+    size_t len = strlen(source_path);
+    size_t source_ext_len = sizeof(source_ext) - 1;
+    size_t base = len;
+
+    // Strip a trailing ".ћпп" so "foo.ћпп" becomes "foo.ћast"
+    if (len >= source_ext_len &&
+        memcmp(source_path + len - source_ext_len, source_ext, source_ext_len) == 0) {
+        base = len - source_ext_len;
+    }
+
+    char* path = (char*)malloc(base + sizeof(cache_ext));
+    if (!path) return NULL;
+
+    memcpy(path, source_path, base);
+    memcpy(path + base, cache_ext, sizeof(cache_ext));
+    return path;
+}
+
+bool ast_cache_is_fresh(const char* cache_path, const char* source_text,
+                        size_t source_length) {
+    if (!cache_path || !source_text) return false;
+
+    FILE* file = fopen(cache_path, "rb");
+    if (!file) return false;
+
+    AstCacheHeader header;
+    bool fresh = fread(&header, sizeof(header), 1, file) == 1 &&
+                 header.magic == AST_CACHE_MAGIC &&
+                 header.version == AST_CACHE_VERSION &&
+                 header.source_length == (uint64_t)source_length &&
+                 header.source_hash == ast_cache_source_hash(source_text, source_length);
+
+    fclose(file);
+    return fresh;
+}
+
+//------------------------------------------------------------------------------
+// Serialization
+//------------------------------------------------------------------------------
+
+/*
+ * Writer state. Nodes and types are flattened breadth-first: the queue
+ * and the output record array are the same growable vector, so a child's
+ * index is assigned the moment its parent's record is written.
+ */
+typedef struct {
+    AstNode** nodes;
+    CachedNode* records;
+    size_t node_count;
+    size_t node_capacity;
+
+    TypeInfo** types;
+    CachedType* type_records;
+    size_t type_count;
+    size_t type_capacity;
+
+    uint32_t* pool;
+    size_t pool_count;
+    size_t pool_capacity;
+
+    char* strings;
+    size_t string_bytes;
+    size_t string_capacity;
+
+    bool ok;
+} CacheWriter;
+
+/*
+ * Grow a writer vector to hold at least one more entry.
+ * Returns the (possibly moved) storage, or NULL on failure.
+ */
+static void* writer_grow(void* items, size_t* capacity, size_t count, size_t item_size) {
+    if (count < *capacity) return items;
+
+    size_t new_capacity = *capacity ? *capacity * 2 : 64;
+    void* new_items = realloc(items, new_capacity * item_size);
+    if (new_items) {
+        *capacity = new_capacity;
+    }
+    return new_items;
+}
+
+/*
+ * Queue a node for flattening and return its reference (index + 1).
+ * NULL children encode as 0.
+ */
+static uint32_t writer_add_node(CacheWriter* writer, AstNode* node) {
+    if (!node || !writer->ok) return 0;
+
+    AstNode** nodes = (AstNode**)writer_grow(writer->nodes, &writer->node_capacity,
+                                             writer->node_count, sizeof(AstNode*));
+    CachedNode* records = (CachedNode*)realloc(writer->records,
+                                               writer->node_capacity * sizeof(CachedNode));
+    if (!nodes || !records) {
+        writer->ok = false;
+        return 0;
+    }
+
+    writer->nodes = nodes;
+    writer->records = records;
+    writer->nodes[writer->node_count++] = node;
+    return (uint32_t)writer->node_count;
+}
+
+/*
+ * Queue a type for flattening and return its reference (index + 1).
+ */
+static uint32_t writer_add_type(CacheWriter* writer, TypeInfo* type) {
+    if (!type || !writer->ok) return 0;
+
+    TypeInfo** types = (TypeInfo**)writer_grow(writer->types, &writer->type_capacity,
+                                               writer->type_count, sizeof(TypeInfo*));
+    CachedType* records = (CachedType*)realloc(writer->type_records,
+                                               writer->type_capacity * sizeof(CachedType));
+    if (!types || !records) {
+        writer->ok = false;
+        return 0;
+    }
+
+    writer->types = types;
+    writer->type_records = records;
+    writer->types[writer->type_count++] = type;
+    return (uint32_t)writer->type_count;
+}
+
+/*
+ * Append one entry to the index pool.
+ */
+static void writer_add_pool(CacheWriter* writer, uint32_t value) {
+    if (!writer->ok) return;
+
+    uint32_t* pool = (uint32_t*)writer_grow(writer->pool, &writer->pool_capacity,
+                                            writer->pool_count, sizeof(uint32_t));
+    if (!pool) {
+        writer->ok = false;
+        return;
+    }
+
+    writer->pool = pool;
+    writer->pool[writer->pool_count++] = value;
+}
+
+/*
+ * Append a NUL-terminated string to the string table and return its
+ * reference (offset + 1). NULL strings encode as 0.
+ */
+static uint32_t writer_add_string(CacheWriter* writer, const char* str) {
+    if (!str || !writer->ok) return 0;
+
+    size_t length = strlen(str) + 1;
+    while (writer->string_bytes + length > writer->string_capacity) {
+        size_t new_capacity = writer->string_capacity ? writer->string_capacity * 2 : 256;
+        char* strings = (char*)realloc(writer->strings, new_capacity);
+        if (!strings) {
+            writer->ok = false;
+            return 0;
+        }
+        writer->strings = strings;
+        writer->string_capacity = new_capacity;
+    }
+
+    size_t offset = writer->string_bytes;
+    memcpy(writer->strings + offset, str, length);
+    writer->string_bytes += length;
+    return (uint32_t)(offset + 1);
+}
+
+/*
+ * Flatten a child array into the pool and return its starting offset.
+ */
+static uint32_t writer_add_node_array(CacheWriter* writer, AstNode** nodes, int count) {
+    uint32_t offset = (uint32_t)writer->pool_count;
+    for (int i = 0; i < count; i++) {
+        writer_add_pool(writer, writer_add_node(writer, nodes[i]));
+    }
+    return offset;
+}
+
+/*
+ * Write the record for queued node i, assigning indices to its children.
+ */
+static void writer_flatten_node(CacheWriter* writer, size_t i) {
+    AstNode* node = writer->nodes[i];
+    CachedNode rec = {0};
+
+    rec.type = (uint32_t)node->type;
+    rec.line = node->location.line;
+    rec.column = node->location.column;
+    rec.type_info = writer_add_type(writer, node->type_info);
+
+    switch (node->type) {
+        case AST_PROGRAM:
+            rec.a = writer_add_node_array(writer, node->as.program.declarations,
+                                          node->as.program.declaration_count);
+            rec.b = (uint32_t)node->as.program.declaration_count;
+            break;
+
+        case AST_FUNCTION_DECL:
+            rec.a = writer_add_string(writer, node->as.function_decl.name);
+            rec.b = writer_add_node_array(writer, node->as.function_decl.parameters,
+                                          node->as.function_decl.parameter_count);
+            rec.c = (uint32_t)node->as.function_decl.parameter_count;
+            rec.d = writer_add_node(writer, node->as.function_decl.body);
+            rec.e = writer_add_type(writer, node->as.function_decl.return_type);
+            rec.f = node->as.function_decl.is_external ? 1 : 0;
+            break;
+
+        case AST_VAR_DECL:
+            rec.a = writer_add_string(writer, node->as.var_decl.name);
+            rec.b = writer_add_node(writer, node->as.var_decl.initializer);
+            rec.c = writer_add_type(writer, node->as.var_decl.var_type);
+            break;
+
+        case AST_ARRAY_DECL:
+            rec.a = writer_add_string(writer, node->as.array_decl.name);
+            rec.b = (uint32_t)node->as.array_decl.size;
+            rec.c = writer_add_node_array(writer, node->as.array_decl.initializers,
+                                          node->as.array_decl.initializer_count);
+            rec.d = (uint32_t)node->as.array_decl.initializer_count;
+            rec.e = writer_add_type(writer, node->as.array_decl.element_type);
+            break;
+
+        case AST_BLOCK:
+            rec.a = writer_add_node_array(writer, node->as.block.statements,
+                                          node->as.block.statement_count);
+            rec.b = (uint32_t)node->as.block.statement_count;
+            break;
+
+        case AST_IF_STMT:
+            rec.a = writer_add_node(writer, node->as.if_stmt.condition);
+            rec.b = writer_add_node(writer, node->as.if_stmt.then_branch);
+            rec.c = writer_add_node(writer, node->as.if_stmt.else_branch);
+            break;
+
+        case AST_WHILE_STMT:
+        case AST_DO_WHILE_STMT:
+            rec.a = writer_add_node(writer, node->as.while_stmt.condition);
+            rec.b = writer_add_node(writer, node->as.while_stmt.body);
+            break;
+
+        case AST_FOR_STMT:
+            rec.a = writer_add_node(writer, node->as.for_stmt.initializer);
+            rec.b = writer_add_node(writer, node->as.for_stmt.condition);
+            rec.c = writer_add_node(writer, node->as.for_stmt.increment);
+            rec.d = writer_add_node(writer, node->as.for_stmt.body);
+            break;
+
+        case AST_RETURN_STMT:
+            rec.a = writer_add_node(writer, node->as.return_stmt.value);
+            break;
+
+        case AST_EXPR_STMT:
+            rec.a = writer_add_node(writer, node->as.expr_stmt.expression);
+            break;
+
+        case AST_BINARY_EXPR:
+            rec.a = (uint32_t)node->as.binary_expr.operator;
+            rec.b = writer_add_node(writer, node->as.binary_expr.left);
+            rec.c = writer_add_node(writer, node->as.binary_expr.right);
+            break;
+
+        case AST_UNARY_EXPR:
+            rec.a = (uint32_t)node->as.unary_expr.operator;
+            rec.b = writer_add_node(writer, node->as.unary_expr.operand);
+            rec.c = node->as.unary_expr.is_prefix ? 1 : 0;
+            break;
+
+        case AST_LITERAL_INT: {
+            uint64_t value = (uint64_t)(int64_t)node->as.int_literal.value;
+            rec.a = (uint32_t)(value & 0xFFFFFFFFu);
+            rec.b = (uint32_t)(value >> 32);
+            break;
+        }
+
+        case AST_LITERAL_CHAR:
+            rec.a = (uint32_t)node->as.char_literal.value;
+            break;
+
+        case AST_LITERAL_STRING:
+            rec.a = writer_add_string(writer, node->as.string_literal.value);
+            break;
+
+        case AST_LITERAL_BOOL:
+            rec.a = node->as.bool_literal.value ? 1 : 0;
+            break;
+
+        case AST_IDENTIFIER:
+            rec.a = writer_add_string(writer, node->as.identifier.name);
+            break;
+
+        case AST_ARRAY_ACCESS:
+            rec.a = writer_add_node(writer, node->as.array_access.array);
+            rec.b = writer_add_node(writer, node->as.array_access.index);
+            break;
+
+        case AST_CALL_EXPR:
+            rec.a = writer_add_node(writer, node->as.call_expr.callee);
+            rec.b = writer_add_node_array(writer, node->as.call_expr.arguments,
+                                          node->as.call_expr.argument_count);
+            rec.c = (uint32_t)node->as.call_expr.argument_count;
+            break;
+
+        case AST_ASSIGNMENT:
+            rec.a = writer_add_node(writer, node->as.assignment.target);
+            rec.b = writer_add_node(writer, node->as.assignment.value);
+            break;
+
+        case AST_TYPE:
+            rec.a = writer_add_type(writer, node->as.type_node.type_data);
+            break;
+
+        default:
+            // Node types without payload
+            break;
+    }
+
+    if (writer->ok) {
+        writer->records[i] = rec;
+    }
+}
+
+/*
+ * Write the record for queued type i, assigning indices to nested types.
+ */
+static void writer_flatten_type(CacheWriter* writer, size_t i) {
+    TypeInfo* type = writer->types[i];
+    CachedType rec = {0};
+
+    rec.category = (uint32_t)type->category;
+
+    switch (type->category) {
+        case TYPE_ARRAY:
+            rec.a = writer_add_type(writer, type->info.array.element_type);
+            rec.b = (uint32_t)type->info.array.size;
+            break;
+
+        case TYPE_FUNCTION:
+            rec.a = writer_add_type(writer, type->info.function.return_type);
+            rec.b = (uint32_t)writer->pool_count;
+            rec.c = (uint32_t)type->info.function.param_count;
+            for (int p = 0; p < type->info.function.param_count; p++) {
+                writer_add_pool(writer,
+                                writer_add_type(writer, type->info.function.param_types[p]));
+            }
+            break;
+
+        default:
+            // Simple types carry no payload
+            break;
+    }
+
+    if (writer->ok) {
+        writer->type_records[i] = rec;
+    }
+}
+
+bool ast_cache_save(const char* cache_path, AstNode* program,
+                    const char* source_text, size_t source_length) {
+    if (!cache_path || !program || !source_text) return false;
+
+    CacheWriter writer = {0};
+    writer.ok = true;
+
+    AstCacheHeader header = {0};
+    header.magic = AST_CACHE_MAGIC;
+    header.version = AST_CACHE_VERSION;
+    header.source_hash = ast_cache_source_hash(source_text, source_length);
+    header.source_length = (uint64_t)source_length;
+    header.filename = writer_add_string(&writer, program->location.filename);
+    header.root = writer_add_node(&writer, program);
+
+    // Both vectors grow while being flattened, so the loop bounds are
+    // re-read each iteration; nodes enqueue types, types enqueue types
+    for (size_t i = 0; writer.ok && i < writer.node_count; i++) {
+        writer_flatten_node(&writer, i);
+    }
+    for (size_t i = 0; writer.ok && i < writer.type_count; i++) {
+        writer_flatten_type(&writer, i);
+    }
+
+    header.node_count = (uint32_t)writer.node_count;
+    header.type_count = (uint32_t)writer.type_count;
+    header.index_count = (uint32_t)writer.pool_count;
+    header.string_bytes = (uint32_t)writer.string_bytes;
+
+    bool success = writer.ok;
+    FILE* file = NULL;
+
+    if (success) {
+        file = fopen(cache_path, "wb");
+        if (!file) {
+            error_report(ERROR_IO, ERROR_WARNING, cache_path, 0, 0,
+                        "Could not create AST cache file",
+                        "Check write permissions next to the source file",
+                        __FILE__, __LINE__);
+            success = false;
+        }
+    }
+
+    if (success) {
+        success = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  (writer.node_count == 0 ||
+                   fwrite(writer.records, sizeof(CachedNode), writer.node_count, file) == writer.node_count) &&
+                  (writer.type_count == 0 ||
+                   fwrite(writer.type_records, sizeof(CachedType), writer.type_count, file) == writer.type_count) &&
+                  (writer.pool_count == 0 ||
+                   fwrite(writer.pool, sizeof(uint32_t), writer.pool_count, file) == writer.pool_count) &&
+                  (writer.string_bytes == 0 ||
+                   fwrite(writer.strings, 1, writer.string_bytes, file) == writer.string_bytes);
+    }
+
+    if (file && fclose(file) != 0) {
+        success = false;
+    }
+    if (!success && file) {
+        // Never leave a truncated cache behind
+        remove(cache_path);
+    }
+
+    free(writer.nodes);
+    free(writer.records);
+    free(writer.types);
+    free(writer.type_records);
+    free(writer.pool);
+    free(writer.strings);
+    return success;
+}
+
+//------------------------------------------------------------------------------
+// Loading
+//------------------------------------------------------------------------------
+
+/*
+ * Reader state over the mapped file plus the arena-backed output arrays.
+ * Any out-of-range reference flips ok and aborts the load.
+ */
+typedef struct {
+    const AstCacheHeader* header;
+    const CachedNode* records;
+    const CachedType* type_records;
+    const uint32_t* pool;
+    const char* strings;
+
+    AstNode* nodes;
+    TypeInfo* types;
+    Arena* arena;
+    const char* filename;
+    bool ok;
+} CacheReader;
+
+static AstNode* reader_node(CacheReader* reader, uint32_t ref) {
+    if (ref == 0) return NULL;
+    if (ref > reader->header->node_count) {
+        reader->ok = false;
+        return NULL;
+    }
+    return &reader->nodes[ref - 1];
+}
+
+static TypeInfo* reader_type(CacheReader* reader, uint32_t ref) {
+    if (ref == 0) return NULL;
+    if (ref > reader->header->type_count) {
+        reader->ok = false;
+        return NULL;
+    }
+    return &reader->types[ref - 1];
+}
+
+static const char* reader_string(CacheReader* reader, uint32_t ref) {
+    if (ref == 0) return NULL;
+    if (ref > reader->header->string_bytes) {
+        reader->ok = false;
+        return NULL;
+    }
+    return reader->strings + (ref - 1);
+}
+
+/*
+ * Resolve a (pool offset, count) pair into an arena-allocated child
+ * pointer array.
+ */
+static AstNode** reader_node_array(CacheReader* reader, uint32_t offset, uint32_t count) {
+    if (count == 0) return NULL;
+    if ((uint64_t)offset + count > reader->header->index_count) {
+        reader->ok = false;
+        return NULL;
+    }
+
+    AstNode** nodes = (AstNode**)arena_alloc(reader->arena, count * sizeof(AstNode*));
+    if (!nodes) {
+        reader->ok = false;
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        nodes[i] = reader_node(reader, reader->pool[offset + i]);
+    }
+    return nodes;
+}
+
+/*
+ * Rebuild node i from its flattened record.
+ */
+static void reader_build_node(CacheReader* reader, uint32_t i) {
+    const CachedNode* rec = &reader->records[i];
+    AstNode* node = &reader->nodes[i];
+
+    node->type = (AstNodeType)rec->type;
+    node->location = source_location_create(rec->line, rec->column, reader->filename);
+    node->type_info = reader_type(reader, rec->type_info);
+    node->ref_count = 1;
+
+    switch (node->type) {
+        case AST_PROGRAM:
+            node->as.program.declarations = reader_node_array(reader, rec->a, rec->b);
+            node->as.program.declaration_count = (int)rec->b;
+            break;
+
+        case AST_FUNCTION_DECL:
+            node->as.function_decl.name = (char*)intern_cstring(reader_string(reader, rec->a));
+            node->as.function_decl.parameters = reader_node_array(reader, rec->b, rec->c);
+            node->as.function_decl.parameter_count = (int)rec->c;
+            node->as.function_decl.body = reader_node(reader, rec->d);
+            node->as.function_decl.return_type = reader_type(reader, rec->e);
+            node->as.function_decl.is_external = rec->f != 0;
+            break;
+
+        case AST_VAR_DECL:
+            node->as.var_decl.name = (char*)intern_cstring(reader_string(reader, rec->a));
+            node->as.var_decl.initializer = reader_node(reader, rec->b);
+            node->as.var_decl.var_type = reader_type(reader, rec->c);
+            break;
+
+        case AST_ARRAY_DECL:
+            node->as.array_decl.name = (char*)intern_cstring(reader_string(reader, rec->a));
+            node->as.array_decl.size = (int)rec->b;
+            node->as.array_decl.initializers = reader_node_array(reader, rec->c, rec->d);
+            node->as.array_decl.initializer_count = (int)rec->d;
+            node->as.array_decl.element_type = reader_type(reader, rec->e);
+            break;
+
+        case AST_BLOCK:
+            node->as.block.statements = reader_node_array(reader, rec->a, rec->b);
+            node->as.block.statement_count = (int)rec->b;
+            break;
+
+        case AST_IF_STMT:
+            node->as.if_stmt.condition = reader_node(reader, rec->a);
+            node->as.if_stmt.then_branch = reader_node(reader, rec->b);
+            node->as.if_stmt.else_branch = reader_node(reader, rec->c);
+            break;
+
+        case AST_WHILE_STMT:
+        case AST_DO_WHILE_STMT:
+            node->as.while_stmt.condition = reader_node(reader, rec->a);
+            node->as.while_stmt.body = reader_node(reader, rec->b);
+            break;
+
+        case AST_FOR_STMT:
+            node->as.for_stmt.initializer = reader_node(reader, rec->a);
+            node->as.for_stmt.condition = reader_node(reader, rec->b);
+            node->as.for_stmt.increment = reader_node(reader, rec->c);
+            node->as.for_stmt.body = reader_node(reader, rec->d);
+            break;
+
+        case AST_RETURN_STMT:
+            node->as.return_stmt.value = reader_node(reader, rec->a);
+            break;
+
+        case AST_EXPR_STMT:
+            node->as.expr_stmt.expression = reader_node(reader, rec->a);
+            break;
+
+        case AST_BINARY_EXPR:
+            node->as.binary_expr.operator = (TokenType)rec->a;
+            node->as.binary_expr.left = reader_node(reader, rec->b);
+            node->as.binary_expr.right = reader_node(reader, rec->c);
+            break;
+
+        case AST_UNARY_EXPR:
+            node->as.unary_expr.operator = (TokenType)rec->a;
+            node->as.unary_expr.operand = reader_node(reader, rec->b);
+            node->as.unary_expr.is_prefix = rec->c != 0;
+            break;
+
+        case AST_LITERAL_INT:
+            node->as.int_literal.value =
+                (intptr_t)(int64_t)(((uint64_t)rec->b << 32) | rec->a);
+            break;
+
+        case AST_LITERAL_CHAR:
+            node->as.char_literal.value = (int32_t)rec->a;
+            break;
+
+        case AST_LITERAL_STRING: {
+            const char* value = reader_string(reader, rec->a);
+            node->as.string_literal.value = value ? arena_strdup(reader->arena, value) : NULL;
+            break;
+        }
+
+        case AST_LITERAL_BOOL:
+            node->as.bool_literal.value = rec->a != 0;
+            break;
+
+        case AST_IDENTIFIER:
+            node->as.identifier.name = (char*)intern_cstring(reader_string(reader, rec->a));
+            break;
+
+        case AST_ARRAY_ACCESS:
+            node->as.array_access.array = reader_node(reader, rec->a);
+            node->as.array_access.index = reader_node(reader, rec->b);
+            break;
+
+        case AST_CALL_EXPR:
+            node->as.call_expr.callee = reader_node(reader, rec->a);
+            node->as.call_expr.arguments = reader_node_array(reader, rec->b, rec->c);
+            node->as.call_expr.argument_count = (int)rec->c;
+            break;
+
+        case AST_ASSIGNMENT:
+            node->as.assignment.target = reader_node(reader, rec->a);
+            node->as.assignment.value = reader_node(reader, rec->b);
+            break;
+
+        case AST_TYPE:
+            node->as.type_node.type_data = reader_type(reader, rec->a);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*
+ * Rebuild type i from its flattened record.
+ */
+static void reader_build_type(CacheReader* reader, uint32_t i) {
+    const CachedType* rec = &reader->type_records[i];
+    TypeInfo* type = &reader->types[i];
+
+    type->category = (TypeCategory)rec->category;
+
+    switch (type->category) {
+        case TYPE_ARRAY:
+            type->info.array.element_type = reader_type(reader, rec->a);
+            type->info.array.size = (int)rec->b;
+            break;
+
+        case TYPE_FUNCTION: {
+            type->info.function.return_type = reader_type(reader, rec->a);
+            type->info.function.param_count = (int)rec->c;
+            type->info.function.param_types = NULL;
+
+            if (rec->c > 0) {
+                if ((uint64_t)rec->b + rec->c > reader->header->index_count) {
+                    reader->ok = false;
+                    return;
+                }
+                TypeInfo** params =
+                    (TypeInfo**)arena_alloc(reader->arena, rec->c * sizeof(TypeInfo*));
+                if (!params) {
+                    reader->ok = false;
+                    return;
+                }
+                for (uint32_t p = 0; p < rec->c; p++) {
+                    params[p] = reader_type(reader, reader->pool[rec->b + p]);
+                }
+                type->info.function.param_types = params;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+AstNode* ast_cache_load(const char* cache_path, Arena* arena) {
+    if (!cache_path || !arena) return NULL;
+
+    int fd = open(cache_path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat file_info;
+    if (fstat(fd, &file_info) != 0 || !S_ISREG(file_info.st_mode) ||
+        (size_t)file_info.st_size < sizeof(AstCacheHeader)) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t file_size = (size_t)file_info.st_size;
+    void* mapped = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return NULL;
+
+    const AstCacheHeader* header = (const AstCacheHeader*)mapped;
+    uint64_t expected_size = sizeof(AstCacheHeader) +
+                             (uint64_t)header->node_count * sizeof(CachedNode) +
+                             (uint64_t)header->type_count * sizeof(CachedType) +
+                             (uint64_t)header->index_count * sizeof(uint32_t) +
+                             (uint64_t)header->string_bytes;
+
+    if (header->magic != AST_CACHE_MAGIC || header->version != AST_CACHE_VERSION ||
+        expected_size != file_size || header->node_count == 0 ||
+        header->root == 0 || header->root > header->node_count) {
+        munmap(mapped, file_size);
+        return NULL;
+    }
+
+    // The string table must end with a terminator for the strings to be
+    // safe to read without length checks
+    const char* base = (const char*)mapped;
+    if (header->string_bytes > 0 && base[file_size - 1] != '\0') {
+        munmap(mapped, file_size);
+        return NULL;
+    }
+
+    CacheReader reader = {0};
+    reader.header = header;
+    reader.records = (const CachedNode*)(base + sizeof(AstCacheHeader));
+    reader.type_records = (const CachedType*)((const char*)reader.records +
+                                              (size_t)header->node_count * sizeof(CachedNode));
+    reader.pool = (const uint32_t*)((const char*)reader.type_records +
+                                    (size_t)header->type_count * sizeof(CachedType));
+    reader.strings = (const char*)(reader.pool + header->index_count);
+    reader.arena = arena;
+    reader.ok = true;
+
+    reader.nodes = (AstNode*)arena_alloc(arena, (size_t)header->node_count * sizeof(AstNode));
+    reader.types = header->type_count > 0
+        ? (TypeInfo*)arena_alloc(arena, (size_t)header->type_count * sizeof(TypeInfo))
+        : NULL;
+    if (!reader.nodes || (header->type_count > 0 && !reader.types)) {
+        munmap(mapped, file_size);
+        return NULL;
+    }
+
+    reader.filename = reader_string(&reader, header->filename);
+    if (reader.filename) {
+        reader.filename = intern_cstring(reader.filename);
+    }
+
+    // One linear pass each; all cross references stay inside the two
+    // arena blocks, so order does not matter
+    for (uint32_t i = 0; reader.ok && i < header->node_count; i++) {
+        reader_build_node(&reader, i);
+    }
+    for (uint32_t i = 0; reader.ok && i < header->type_count; i++) {
+        reader_build_type(&reader, i);
+    }
+
+    AstNode* root = reader.ok ? reader_node(&reader, header->root) : NULL;
+    munmap(mapped, file_size);
+    return reader.ok ? root : NULL;
+}
@@ -0,0 +1,108 @@
+/*
+ * filename: ast_cache.h
+ *
+ * Purpose:
+ * Header file for the binary AST cache of the ћ++ compiler. A parsed
+ * program is serialized into a compact position-independent ".ћast"
+ * file that sits next to its source; on a rebuild of an unchanged file
+ * the tree is loaded straight back from the cache, skipping lexing and
+ * parsing entirely.
+ *
+ * Key Components:
+ * - ast_cache_derive_path(): Map a source path to its cache path
+ * - ast_cache_source_hash(): Hash source text for freshness checks
+ * - ast_cache_is_fresh(): Check a cache file against the current source
+ * - ast_cache_save(): Serialize a parsed program to a cache file
+ * - ast_cache_load(): Reconstruct a program from a cache file
+ *
+ * Interactions:
+ * - Serializes the AstNode trees built by parser.c (see ast.h)
+ * - Loaded trees are allocated from an arena (see utils/arena.h)
+ * - Used by main.c on the --stop-after-parsing path
+ *
+ * Notes:
+ * - The on-disk format uses index-based child references instead of
+ *   pointers, so a cache file is valid at any load address
+ * - Cache files are transient build artifacts: any mismatch in magic,
+ *   version or source hash simply causes a re-parse
+ */
+
+#ifndef AST_CACHE_H
+#define AST_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ast.h"
+#include "../utils/arena.h"
+
+/*
+ * Derive the cache file path for a source file by replacing the ".ћпп"
+ * extension with ".ћast" (or appending it when the extension differs).
+ *
+ * Parameters:
+ *   source_path - Path of the ћ++ source file
+ *
+ * Returns:
+ *   A newly malloc'd path the caller must free, or NULL on failure
+ */
+char* ast_cache_derive_path(const char* source_path);
+
+/*
+ * Hash source text for cache freshness checks (64-bit FNV-1a).
+ *
+ * Parameters:
+ *   source_text   - The raw source bytes
+ *   source_length - Number of bytes to hash
+ *
+ * Returns:
+ *   The content hash of the source text
+ */
+uint64_t ast_cache_source_hash(const char* source_text, size_t source_length);
+
+/*
+ * Check whether a cache file was produced from exactly this source text.
+ *
+ * Parameters:
+ *   cache_path    - Path of the ".ћast" file
+ *   source_text   - Current contents of the source file
+ *   source_length - Length of the source text in bytes
+ *
+ * Returns:
+ *   true when the cache exists and matches the source, false otherwise
+ */
+bool ast_cache_is_fresh(const char* cache_path, const char* source_text,
+                        size_t source_length);
+
+/*
+ * Serialize a parsed program into a cache file. The source text is
+ * hashed into the header so later runs can detect staleness.
+ *
+ * Parameters:
+ *   cache_path    - Destination ".ћast" path
+ *   program       - Root of the tree returned by parse_program()
+ *   source_text   - Source the tree was parsed from
+ *   source_length - Length of the source text in bytes
+ *
+ * Returns:
+ *   true on success; false on I/O or allocation failure
+ */
+bool ast_cache_save(const char* cache_path, AstNode* program,
+                    const char* source_text, size_t source_length);
+
+/*
+ * Load a program back from a cache file. The whole tree is rebuilt in
+ * two contiguous arena blocks with a single linear pass over the mapped
+ * file - no per-node heap allocation and no tree walk. The tree lives
+ * until the arena is reset or destroyed; ast_free() is not used.
+ *
+ * Parameters:
+ *   cache_path - Path of the ".ћast" file
+ *   arena      - Arena that the reconstructed tree is allocated from
+ *
+ * Returns:
+ *   The root node, or NULL when the file is missing or malformed
+ */
+AstNode* ast_cache_load(const char* cache_path, Arena* arena);
+
+#endif // AST_CACHE_H
@@ -1,30 +1,467 @@
 /*
  * filename: semantic_analyzer.c
- * 
+ *
  * Purpose:
  * Implementation of the semantic analyzer for the ћ++ compiler.
  * This file contains functions that validate the semantic correctness
- * of a ћ++ program after it has been parsed into an AST.
- * 
+ * of a ћ++ program, either as a separate pass over a finished AST or
+ * fused into parsing through the per-node hooks.
+ *
  * Key Components:
- * - semantic_analyzer_init(): Set up the analyzer with an AST and symbol table
- * - analyze_program(): Main entry point for program analysis
+ * - semantic_analyzer_init(): Set up the analyzer and its symbol table
+ * - analyze_program(): Main entry point for separate-pass analysis
  * - check_function_declaration(): Validate function signatures and bodies
- * - check_external_declaration(): Validate external function declarations
  * - check_statement(): Validate different types of statements
- * - check_array_declaration(): Validate array size and initialization
- * - check_expression(): Validate expressions and function calls
- * 
+ * - check_expression(): Validate and annotate one expression node
+ * - semantic_declare(): Record one declaration, rejecting redeclarations
+ *
  * Interactions:
  * - Operates on AST created by parser.c
  * - Uses symbol_table.h/symbol_table.c for identifier management
  * - Uses error.h for reporting semantic errors
- * 
+ *
  * Notes:
  * - All values are WORD-sized (architecture dependent)
- * - Special handling for the main function (главна)
+ * - check_expression() never recurses: it checks exactly the node it is
+ *   given, consulting only the symbol table and the callee/operand
+ *   declarations, so a fused-mode parser can call it node by node and
+ *   the separate pass can drive it from the iterative ast_accept()
+ * - Errors are reported and counted rather than aborting, so one run
+ *   collects every problem in the program
  * - Validates array initialization and access boundaries
  */
 
 #include "semantic_analyzer.h"
-// Other includes will go here
\ No newline at end of file
+#include <stdlib.h>
+#include <stdio.h>
+#include "../utils/error.h"
+
+/*
+ * Report one semantic error against a node and count it.
+ */
+static void semantic_error(SemanticAnalyzer* analyzer, AstNode* node,
+                           const char* message, const char* suggestion) {
+    ERROR_SEMANTIC_ERROR(analyzer->filename, node->location.line,
+                         node->location.column, message, suggestion);
+    analyzer->error_count++;
+}
+
+/*
+ * Make a fresh scalar TypeInfo matching a declared type. Annotations
+ * get their own TypeInfo because each node owns its type_info.
+ */
+static TypeInfo* scalar_type_copy(const TypeInfo* declared) {
+    if (!declared) return NULL;
+
+    switch (declared->category) {
+        case TYPE_VOID: return type_create_void();
+        case TYPE_BOOL: return type_create_bool();
+        case TYPE_CHAR: return type_create_char();
+        case TYPE_INT:  return type_create_int();
+        default:        return NULL;
+    }
+}
+
+SemanticAnalyzer* semantic_analyzer_init(const char* filename) {
+    SemanticAnalyzer* analyzer = (SemanticAnalyzer*)calloc(1, sizeof(SemanticAnalyzer));
+    if (!analyzer) return NULL;
+
+    analyzer->symbols = symbol_table_init();
+    if (!analyzer->symbols) {
+        free(analyzer);
+        return NULL;
+    }
+
+    analyzer->filename = filename;
+    return analyzer;
+}
+
+void semantic_analyzer_free(SemanticAnalyzer* analyzer) {
+    if (!analyzer) return;
+
+    symbol_table_free(analyzer->symbols);
+    free(analyzer);
+}
+
+bool semantic_enter_scope(SemanticAnalyzer* analyzer) {
+    return analyzer && symbol_table_enter_scope(analyzer->symbols);
+}
+
+bool semantic_exit_scope(SemanticAnalyzer* analyzer) {
+    return analyzer && symbol_table_exit_scope(analyzer->symbols);
+}
+
+bool semantic_declare(SemanticAnalyzer* analyzer, AstNode* declaration) {
+    if (!analyzer || !declaration) return false;
+
+    const char* name = NULL;
+    SymbolType symbol_type = SYMBOL_VARIABLE;
+    TypeInfo* type_info = NULL;
+
+    switch (declaration->type) {
+        case AST_FUNCTION_DECL:
+            name = declaration->as.function_decl.name;
+            symbol_type = declaration->as.function_decl.is_external
+                              ? SYMBOL_EXTERN_FUNCTION
+                              : SYMBOL_FUNCTION;
+            type_info = declaration->as.function_decl.return_type;
+            break;
+
+        case AST_VAR_DECL:
+            name = declaration->as.var_decl.name;
+            symbol_type = SYMBOL_VARIABLE;
+            type_info = declaration->as.var_decl.var_type;
+            break;
+
+        case AST_ARRAY_DECL:
+            name = declaration->as.array_decl.name;
+            symbol_type = SYMBOL_ARRAY;
+            type_info = declaration->as.array_decl.element_type;
+
+            if (declaration->as.array_decl.size <= 0) {
+                semantic_error(analyzer, declaration,
+                               "Array declared with non-positive size",
+                               "Array sizes must be positive constants");
+                return false;
+            }
+            if (declaration->as.array_decl.initializer_count > 0 &&
+                declaration->as.array_decl.initializer_count >
+                    declaration->as.array_decl.size) {
+                semantic_error(analyzer, declaration,
+                               "More initializers than array elements",
+                               "Remove extra initializers or enlarge the array");
+                return false;
+            }
+            break;
+
+        default:
+            semantic_error(analyzer, declaration,
+                           "Node is not a declaration",
+                           "This is an internal parser inconsistency");
+            return false;
+    }
+
+    if (!symbol_table_add(analyzer->symbols, name, symbol_type,
+                          type_info, declaration)) {
+        semantic_error(analyzer, declaration,
+                       "Redeclaration of an identifier in the same scope",
+                       "Rename one of the declarations or remove the duplicate");
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Check an identifier reference and annotate it with its declared type.
+ */
+static bool check_identifier(SemanticAnalyzer* analyzer, AstNode* node) {
+    Symbol* symbol = symbol_table_lookup(analyzer->symbols,
+                                         node->as.identifier.name);
+    if (!symbol) {
+        semantic_error(analyzer, node,
+                       "Use of undeclared identifier",
+                       "Declare the identifier before using it");
+        return false;
+    }
+
+    if (!node->type_info) {
+        node->type_info = scalar_type_copy(symbol->type_info);
+    }
+    return true;
+}
+
+/*
+ * Check a function call: the callee must be a declared function and the
+ * argument count must match the declaration, including екстерно ones.
+ */
+static bool check_call(SemanticAnalyzer* analyzer, AstNode* node) {
+    AstNode* callee = node->as.call_expr.callee;
+
+    if (!callee || callee->type != AST_IDENTIFIER) {
+        semantic_error(analyzer, node,
+                       "Called expression is not a function name",
+                       "Only declared functions can be called");
+        return false;
+    }
+
+    Symbol* symbol = symbol_table_lookup(analyzer->symbols,
+                                         callee->as.identifier.name);
+    if (!symbol) {
+        semantic_error(analyzer, node,
+                       "Call to undeclared function",
+                       "Declare the function or add an екстерно declaration");
+        return false;
+    }
+
+    if (symbol->type != SYMBOL_FUNCTION && symbol->type != SYMBOL_EXTERN_FUNCTION) {
+        semantic_error(analyzer, node,
+                       "Called identifier is not a function",
+                       "Only functions can be called");
+        return false;
+    }
+
+    AstNode* declaration = symbol->declaration;
+    if (declaration && declaration->type == AST_FUNCTION_DECL) {
+        int expected = declaration->as.function_decl.parameter_count;
+        int actual = node->as.call_expr.argument_count;
+
+        if (expected != actual) {
+            char message[128];
+            snprintf(message, sizeof(message),
+                     "Function expects %d argument(s) but %d given",
+                     expected, actual);
+            semantic_error(analyzer, node, message,
+                           "Match the call to the function declaration");
+            return false;
+        }
+    }
+
+    if (!node->type_info) {
+        node->type_info = scalar_type_copy(symbol->type_info);
+    }
+    return true;
+}
+
+/*
+ * Check an array access: the base must be a declared array and a
+ * constant index must fall inside the declared bounds.
+ */
+static bool check_array_access(SemanticAnalyzer* analyzer, AstNode* node) {
+    AstNode* base = node->as.array_access.array;
+
+    if (!base || base->type != AST_IDENTIFIER) {
+        semantic_error(analyzer, node,
+                       "Indexed expression is not an array name",
+                       "Only declared arrays can be indexed");
+        return false;
+    }
+
+    Symbol* symbol = symbol_table_lookup(analyzer->symbols,
+                                         base->as.identifier.name);
+    if (!symbol) {
+        semantic_error(analyzer, node,
+                       "Use of undeclared array",
+                       "Declare the array before indexing it");
+        return false;
+    }
+
+    if (symbol->type != SYMBOL_ARRAY) {
+        semantic_error(analyzer, node,
+                       "Indexed identifier is not an array",
+                       "Only arrays can be indexed");
+        return false;
+    }
+
+    AstNode* index = node->as.array_access.index;
+    AstNode* declaration = symbol->declaration;
+    if (index && index->type == AST_LITERAL_INT &&
+        declaration && declaration->type == AST_ARRAY_DECL) {
+        intptr_t value = index->as.int_literal.value;
+        int size = declaration->as.array_decl.size;
+
+        if (value < 0 || value >= (intptr_t)size) {
+            char message[128];
+            snprintf(message, sizeof(message),
+                     "Array index %ld is outside bounds [0, %d)",
+                     (long)value, size);
+            semantic_error(analyzer, node, message,
+                           "Keep constant indices inside the declared size");
+            return false;
+        }
+    }
+
+    if (!node->type_info) {
+        node->type_info = scalar_type_copy(symbol->type_info);
+    }
+    return true;
+}
+
+/*
+ * Check an assignment target: it must name a variable, a parameter or
+ * an array element, never a function.
+ */
+static bool check_assignment(SemanticAnalyzer* analyzer, AstNode* node) {
+    AstNode* target = node->as.assignment.target;
+
+    if (!target ||
+        (target->type != AST_IDENTIFIER && target->type != AST_ARRAY_ACCESS)) {
+        semantic_error(analyzer, node,
+                       "Assignment target is not assignable",
+                       "Assign to a variable or an array element");
+        return false;
+    }
+
+    if (target->type == AST_IDENTIFIER) {
+        Symbol* symbol = symbol_table_lookup(analyzer->symbols,
+                                             target->as.identifier.name);
+        if (symbol && (symbol->type == SYMBOL_FUNCTION ||
+                       symbol->type == SYMBOL_EXTERN_FUNCTION)) {
+            semantic_error(analyzer, node,
+                           "Cannot assign to a function",
+                           "Functions are not assignable");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool check_expression(SemanticAnalyzer* analyzer, AstNode* node) {
+    if (!analyzer || !node) return false;
+
+    switch (node->type) {
+        case AST_IDENTIFIER:   return check_identifier(analyzer, node);
+        case AST_CALL_EXPR:    return check_call(analyzer, node);
+        case AST_ARRAY_ACCESS: return check_array_access(analyzer, node);
+        case AST_ASSIGNMENT:   return check_assignment(analyzer, node);
+
+        // Literals and operator nodes carry no names to resolve
+        default:               return true;
+    }
+}
+
+/*
+ * ast_accept() callback: run the per-node check and keep walking, so
+ * one traversal reports every error in the expression.
+ */
+static bool expression_visit(AstVisitor* visitor, AstNode* node) {
+    check_expression((SemanticAnalyzer*)visitor->context, node);
+    return true;
+}
+
+/*
+ * Check every node of a completed expression tree with one iterative
+ * traversal.
+ */
+static void check_expression_tree(SemanticAnalyzer* analyzer, AstNode* expr) {
+    if (!expr) return;
+
+    AstVisitor visitor = {0};
+    visitor.context = analyzer;
+    visitor.visit_binary_expr = expression_visit;
+    visitor.visit_unary_expr = expression_visit;
+    visitor.visit_literal_int = expression_visit;
+    visitor.visit_literal_char = expression_visit;
+    visitor.visit_literal_string = expression_visit;
+    visitor.visit_literal_bool = expression_visit;
+    visitor.visit_identifier = expression_visit;
+    visitor.visit_array_access = expression_visit;
+    visitor.visit_call_expr = expression_visit;
+    visitor.visit_assignment = expression_visit;
+
+    ast_accept(expr, &visitor);
+}
+
+bool check_statement(SemanticAnalyzer* analyzer, AstNode* node) {
+    if (!analyzer || !node) return true;
+
+    int errors_before = analyzer->error_count;
+
+    switch (node->type) {
+        case AST_BLOCK:
+            semantic_enter_scope(analyzer);
+            for (int i = 0; i < node->as.block.statement_count; i++) {
+                check_statement(analyzer, node->as.block.statements[i]);
+            }
+            semantic_exit_scope(analyzer);
+            break;
+
+        case AST_VAR_DECL:
+            check_expression_tree(analyzer, node->as.var_decl.initializer);
+            semantic_declare(analyzer, node);
+            break;
+
+        case AST_ARRAY_DECL:
+            for (int i = 0; i < node->as.array_decl.initializer_count; i++) {
+                check_expression_tree(analyzer, node->as.array_decl.initializers[i]);
+            }
+            semantic_declare(analyzer, node);
+            break;
+
+        case AST_IF_STMT:
+            check_expression_tree(analyzer, node->as.if_stmt.condition);
+            check_statement(analyzer, node->as.if_stmt.then_branch);
+            check_statement(analyzer, node->as.if_stmt.else_branch);
+            break;
+
+        case AST_WHILE_STMT:
+        case AST_DO_WHILE_STMT:
+            check_expression_tree(analyzer, node->as.while_stmt.condition);
+            check_statement(analyzer, node->as.while_stmt.body);
+            break;
+
+        case AST_FOR_STMT:
+            // The initializer may declare the loop variable; scope it to
+            // the loop the way a block would
+            semantic_enter_scope(analyzer);
+            check_statement(analyzer, node->as.for_stmt.initializer);
+            check_expression_tree(analyzer, node->as.for_stmt.condition);
+            check_expression_tree(analyzer, node->as.for_stmt.increment);
+            check_statement(analyzer, node->as.for_stmt.body);
+            semantic_exit_scope(analyzer);
+            break;
+
+        case AST_RETURN_STMT:
+            check_expression_tree(analyzer, node->as.return_stmt.value);
+            break;
+
+        case AST_EXPR_STMT:
+            check_expression_tree(analyzer, node->as.expr_stmt.expression);
+            break;
+
+        case AST_BREAK_STMT:
+            break;
+
+        default:
+            // A bare expression used in statement position
+            check_expression_tree(analyzer, node);
+            break;
+    }
+
+    return analyzer->error_count == errors_before;
+}
+
+bool check_function_declaration(SemanticAnalyzer* analyzer, AstNode* node) {
+    if (!analyzer || !node || node->type != AST_FUNCTION_DECL) return false;
+
+    int errors_before = analyzer->error_count;
+
+    // External declarations have no body to check
+    if (!node->as.function_decl.is_external) {
+        semantic_enter_scope(analyzer);
+        for (int i = 0; i < node->as.function_decl.parameter_count; i++) {
+            semantic_declare(analyzer, node->as.function_decl.parameters[i]);
+        }
+        check_statement(analyzer, node->as.function_decl.body);
+        semantic_exit_scope(analyzer);
+    }
+
+    return analyzer->error_count == errors_before;
+}
+
+bool analyze_program(SemanticAnalyzer* analyzer, AstNode* program) {
+    if (!analyzer || !program || program->type != AST_PROGRAM) return false;
+
+    // Declare every top-level name first so a function may call one
+    // declared after it
+    for (int i = 0; i < program->as.program.declaration_count; i++) {
+        AstNode* declaration = program->as.program.declarations[i];
+        if (!declaration) continue;
+
+        if (declaration->type == AST_FUNCTION_DECL) {
+            semantic_declare(analyzer, declaration);
+        }
+    }
+
+    for (int i = 0; i < program->as.program.declaration_count; i++) {
+        AstNode* declaration = program->as.program.declarations[i];
+        if (!declaration) continue;
+
+        if (declaration->type == AST_FUNCTION_DECL) {
+            check_function_declaration(analyzer, declaration);
+        } else {
+            check_statement(analyzer, declaration);
+        }
+    }
+
+    return analyzer->error_count == 0;
+}
@@ -1,10 +1,10 @@
 /*
  * filename: semantic_analyzer.h
- * 
+ *
  * Purpose:
  * Header file for the semantic analyzer of the ћ++ compiler.
  * Defines the interface for semantic checking and validation of the AST.
- * 
+ *
  * Key Components:
  * - SemanticAnalyzer struct: Maintains state during semantic analysis
  * - semantic_analyzer_init(): Initialize a new semantic analyzer
@@ -12,21 +12,124 @@
  * - check_function_declaration(): Validate function declarations
  * - check_statement(): Validate statements for semantic correctness
  * - check_expression(): Validate and annotate expressions
- * 
+ * - semantic_declare()/semantic_enter_scope()/semantic_exit_scope():
+ *   Incremental hooks for fused parse + analysis
+ *
  * Interactions:
  * - Takes input from parser.c in the form of an AST
  * - Uses symbol_table.h to track identifiers
  * - Uses error.h for reporting semantic errors
- * 
+ *
  * Notes:
  * - All identifiers are WORD-sized (native machine word)
  * - Special handling for external declarations
  * - Validates parameter usage and array access
+ * - Every check works on one node at a time, so a fused-mode parser can
+ *   call the hooks as it produces each node (checking the tree while it
+ *   is still hot in cache) and analyze_program() can drive the same
+ *   checks as a separate pass over a completed AST
  */
 
 #ifndef SEMANTIC_ANALYZER_H
 #define SEMANTIC_ANALYZER_H
 
-// Header content will be implemented later
+#include <stdbool.h>
+#include "../parser/ast.h"
+#include "symbol_table.h"
 
-#endif /* SEMANTIC_ANALYZER_H */
\ No newline at end of file
+// State carried through one semantic analysis, fused or separate
+typedef struct {
+    SymbolTable* symbols;    // Identifiers visible at the current point
+    const char* filename;    // Source file name for error messages
+    int error_count;         // Semantic errors reported so far
+} SemanticAnalyzer;
+
+/**
+ * Create and initialize a new semantic analyzer
+ *
+ * @param filename Source file name used in error messages (not owned)
+ * @return The new analyzer, or NULL on allocation failure
+ */
+SemanticAnalyzer* semantic_analyzer_init(const char* filename);
+
+/**
+ * Free a semantic analyzer and its symbol table. The AST it annotated
+ * is not touched
+ *
+ * @param analyzer The analyzer to free
+ */
+void semantic_analyzer_free(SemanticAnalyzer* analyzer);
+
+/**
+ * Enter a new scope. In fused mode the parser calls this when it opens
+ * a block, before any of the block's declarations are produced
+ *
+ * @param analyzer The semantic analyzer
+ * @return true on success, false on allocation failure
+ */
+bool semantic_enter_scope(SemanticAnalyzer* analyzer);
+
+/**
+ * Leave the current scope, forgetting its declarations. In fused mode
+ * the parser calls this when it closes a block
+ *
+ * @param analyzer The semantic analyzer
+ * @return true on success, false when already in global scope
+ */
+bool semantic_exit_scope(SemanticAnalyzer* analyzer);
+
+/**
+ * Record one declaration (function, parameter, variable or array) in
+ * the current scope, reporting redeclarations. In fused mode the parser
+ * calls this as soon as it has produced the declaration node
+ *
+ * @param analyzer The semantic analyzer
+ * @param declaration The declaration node
+ * @return true when the declaration is valid, false when an error was
+ *         reported
+ */
+bool semantic_declare(SemanticAnalyzer* analyzer, AstNode* declaration);
+
+/**
+ * Check and annotate a single expression node: resolve identifiers,
+ * validate call arity against the declaration, and validate array
+ * accesses including constant-index bounds. Does not recurse; in fused
+ * mode the parser calls it once per node as the node is produced
+ *
+ * @param analyzer The semantic analyzer
+ * @param node The expression node to check
+ * @return true when the node is valid, false when an error was reported
+ */
+bool check_expression(SemanticAnalyzer* analyzer, AstNode* node);
+
+/**
+ * Check one statement and everything nested inside it, entering and
+ * leaving scopes as blocks open and close
+ *
+ * @param analyzer The semantic analyzer
+ * @param node The statement node to check
+ * @return true when no errors were reported inside the statement
+ */
+bool check_statement(SemanticAnalyzer* analyzer, AstNode* node);
+
+/**
+ * Declare a function and check its parameters and body
+ *
+ * @param analyzer The semantic analyzer
+ * @param node The function declaration node
+ * @return true when no errors were reported
+ */
+bool check_function_declaration(SemanticAnalyzer* analyzer, AstNode* node);
+
+/**
+ * Analyze a complete program as a separate pass over a finished AST.
+ * Declares all top-level names first so functions may call functions
+ * defined after them, then checks every body
+ *
+ * @param analyzer The semantic analyzer
+ * @param program The AST_PROGRAM root
+ * @return true when the program is semantically valid
+ */
+bool analyze_program(SemanticAnalyzer* analyzer, AstNode* program);
+
+#endif /* SEMANTIC_ANALYZER_H */
@@ -1,11 +1,11 @@
 /*
  * filename: symbol_table.c
- * 
+ *
  * Purpose:
  * Implementation of the symbol table for the ћ++ compiler.
  * This file provides functions for tracking and looking up identifiers
  * with proper scope handling.
- * 
+ *
  * Key Components:
  * - symbol_table_init(): Create and initialize a new symbol table
  * - symbol_table_free(): Free all memory used by the symbol table
@@ -14,16 +14,244 @@
  * - symbol_table_add(): Add a new symbol to the current scope
  * - symbol_table_lookup(): Find a symbol by name across accessible scopes
  * - symbol_table_get_current_scope(): Get the current scope level
- * 
+ *
  * Interactions:
  * - Used by semantic_analyzer.c during program analysis
  * - Used by ir.c during intermediate code generation
- * 
+ * - Names are interned through utils/intern.h so probes compare pointers
+ *
  * Notes:
- * - Implements a linked hash table for efficient lookups
- * - Handles UTF-8 symbol names with proper string comparison
- * - Maintains scope hierarchy for correct symbol resolution
+ * - One flat open-addressing table with linear probing; only the
+ *   innermost declaration of a name is ever live, so a lookup is a
+ *   single probe sequence with no scope-chain walk and no utf8_strcmp
+ * - Scope entry records an epoch mark into the undo log; scope exit
+ *   replays the log tail, deleting the scope's declarations and
+ *   restoring the outer declarations they shadowed
+ * - Deletion uses backward-shift compaction, so the table never
+ *   accumulates tombstones no matter how many scopes come and go
  */
 
 #include "symbol_table.h"
-// Other includes will go here
\ No newline at end of file
+#include <stdlib.h>
+#include <stdint.h>
+#include "../utils/intern.h"
+
+#define SYMBOL_TABLE_INITIAL_CAPACITY 64
+#define SCOPE_UNDO_INITIAL_CAPACITY   64
+#define SCOPE_MARK_INITIAL_CAPACITY   16
+
+/*
+ * Hash an interned name pointer. Interning guarantees one pointer per
+ * distinct identifier, so the pointer bits themselves are the key.
+ */
+static size_t symbol_hash(const char* name) {
+    uint64_t hash = (uint64_t)(uintptr_t)name;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return (size_t)hash;
+}
+
+/*
+ * Probe for a name. Returns the slot holding it, or the empty slot
+ * where it would be inserted.
+ */
+static size_t table_probe(SymbolTable* table, const char* name) {
+    size_t mask = table->capacity - 1;
+    size_t i = symbol_hash(name) & mask;
+
+    while (table->slots[i].name != NULL && table->slots[i].name != name) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+/*
+ * Double the slot array and reinsert all live symbols. The undo log
+ * records names rather than slot indices, so it survives the rehash.
+ */
+static bool table_grow(SymbolTable* table) {
+    size_t old_capacity = table->capacity;
+    Symbol* old_slots = table->slots;
+
+    Symbol* slots = (Symbol*)calloc(old_capacity * 2, sizeof(Symbol));
+    if (!slots) return false;
+
+    table->slots = slots;
+    table->capacity = old_capacity * 2;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_slots[i].name != NULL) {
+            table->slots[table_probe(table, old_slots[i].name)] = old_slots[i];
+        }
+    }
+
+    free(old_slots);
+    return true;
+}
+
+/*
+ * Remove the symbol in slot i with backward-shift compaction, keeping
+ * every remaining probe sequence unbroken.
+ */
+static void table_remove_slot(SymbolTable* table, size_t i) {
+    size_t mask = table->capacity - 1;
+    size_t j = i;
+
+    for (;;) {
+        j = (j + 1) & mask;
+        if (table->slots[j].name == NULL) break;
+
+        // A following entry may slide back only if that does not move it
+        // before the slot its hash probes from
+        size_t ideal = symbol_hash(table->slots[j].name) & mask;
+        if (((j - ideal) & mask) >= ((j - i) & mask)) {
+            table->slots[i] = table->slots[j];
+            i = j;
+        }
+    }
+
+    table->slots[i].name = NULL;
+    table->used--;
+}
+
+/*
+ * Append one record to the undo log.
+ */
+static bool undo_push(SymbolTable* table, const char* name, const Symbol* previous) {
+    if (table->undo_count == table->undo_capacity) {
+        size_t new_capacity = table->undo_capacity * 2;
+        ScopeUndo* log = (ScopeUndo*)realloc(table->undo_log,
+                                             new_capacity * sizeof(ScopeUndo));
+        if (!log) return false;
+        table->undo_log = log;
+        table->undo_capacity = new_capacity;
+    }
+
+    ScopeUndo* record = &table->undo_log[table->undo_count++];
+    record->name = name;
+    if (previous) {
+        record->previous = *previous;
+    } else {
+        record->previous.name = NULL;
+    }
+    return true;
+}
+
+SymbolTable* symbol_table_init(void) {
+    SymbolTable* table = (SymbolTable*)calloc(1, sizeof(SymbolTable));
+    if (!table) return NULL;
+
+    table->slots = (Symbol*)calloc(SYMBOL_TABLE_INITIAL_CAPACITY, sizeof(Symbol));
+    table->undo_log = (ScopeUndo*)malloc(SCOPE_UNDO_INITIAL_CAPACITY * sizeof(ScopeUndo));
+    table->scope_marks = (size_t*)malloc(SCOPE_MARK_INITIAL_CAPACITY * sizeof(size_t));
+
+    if (!table->slots || !table->undo_log || !table->scope_marks) {
+        symbol_table_free(table);
+        return NULL;
+    }
+
+    table->capacity = SYMBOL_TABLE_INITIAL_CAPACITY;
+    table->undo_capacity = SCOPE_UNDO_INITIAL_CAPACITY;
+    table->mark_capacity = SCOPE_MARK_INITIAL_CAPACITY;
+    return table;
+}
+
+void symbol_table_free(SymbolTable* table) {
+    if (!table) return;
+
+    free(table->slots);
+    free(table->undo_log);
+    free(table->scope_marks);
+    free(table);
+}
+
+bool symbol_table_enter_scope(SymbolTable* table) {
+    if (!table) return false;
+
+    if (table->mark_count == table->mark_capacity) {
+        size_t new_capacity = table->mark_capacity * 2;
+        size_t* marks = (size_t*)realloc(table->scope_marks,
+                                         new_capacity * sizeof(size_t));
+        if (!marks) return false;
+        table->scope_marks = marks;
+        table->mark_capacity = new_capacity;
+    }
+
+    table->scope_marks[table->mark_count++] = table->undo_count;
+    table->scope_depth++;
+    return true;
+}
+
+bool symbol_table_exit_scope(SymbolTable* table) {
+    if (!table || table->mark_count == 0) return false;
+
+    // Replay this scope's undo records newest-first: drop the scope's
+    // declarations and restore what they shadowed
+    size_t mark = table->scope_marks[--table->mark_count];
+    while (table->undo_count > mark) {
+        ScopeUndo* record = &table->undo_log[--table->undo_count];
+        size_t slot = table_probe(table, record->name);
+
+        if (record->previous.name != NULL) {
+            table->slots[slot] = record->previous;
+        } else {
+            table_remove_slot(table, slot);
+        }
+    }
+
+    table->scope_depth--;
+    return true;
+}
+
+bool symbol_table_add(SymbolTable* table, const char* name, SymbolType type,
+                      TypeInfo* type_info, AstNode* declaration) {
+    if (!table || !name) return false;
+
+    const char* interned = intern_cstring(name);
+    if (!interned) return false;
+
+    // Keep the load factor below 70% so probe sequences stay short
+    if ((table->used + 1) * 10 > table->capacity * 7) {
+        if (!table_grow(table)) return false;
+    }
+
+    size_t slot = table_probe(table, interned);
+    Symbol* existing = table->slots[slot].name != NULL ? &table->slots[slot] : NULL;
+
+    if (existing && existing->scope_depth == table->scope_depth) {
+        // Redeclaration in the same scope
+        return false;
+    }
+
+    // Record how to restore this name when the current scope closes;
+    // global-scope declarations are never undone
+    if (table->mark_count > 0) {
+        if (!undo_push(table, interned, existing)) return false;
+    }
+
+    if (!existing) {
+        table->used++;
+    }
+
+    table->slots[slot].name = interned;
+    table->slots[slot].type = type;
+    table->slots[slot].type_info = type_info;
+    table->slots[slot].declaration = declaration;
+    table->slots[slot].scope_depth = table->scope_depth;
+    return true;
+}
+
+Symbol* symbol_table_lookup(SymbolTable* table, const char* name) {
+    if (!table || !name) return NULL;
+
+    const char* interned = intern_cstring(name);
+    if (!interned) return NULL;
+
+    size_t slot = table_probe(table, interned);
+    return table->slots[slot].name != NULL ? &table->slots[slot] : NULL;
+}
+
+int symbol_table_get_current_scope(SymbolTable* table) {
+    return table ? table->scope_depth : 0;
+}
@@ -1,11 +1,11 @@
 /*
  * filename: symbol_table.h
- * 
+ *
  * Purpose:
  * Header file for the symbol table implementation in the ћ++ compiler.
  * Defines the interface for tracking identifiers and their properties
  * throughout the compilation process.
- * 
+ *
  * Key Components:
  * - SymbolType enum: Categorizes symbols (variable, array, function, extern)
  * - Symbol struct: Represents a single symbol with name and properties
@@ -15,20 +15,132 @@
  * - symbol_table_exit_scope(): Return to the parent scope
  * - symbol_table_add(): Add a symbol to the current scope
  * - symbol_table_lookup(): Find a symbol by name in current or parent scopes
- * 
+ *
  * Interactions:
  * - Used by semantic_analyzer.c to track and validate identifiers
  * - Used by ir.c for identifier lookups during IR generation
- * 
+ *
  * Notes:
  * - Supports UTF-8 identifiers for symbol names
  * - Implements scope nesting for proper variable shadowing
- * - All identifiers use WORD-sized storage (native machine word)
+ * - Built as one open-addressing hash table keyed on interned name
+ *   pointers: a lookup is a single probe sequence with pointer
+ *   comparison, never a walk up a scope chain
+ * - Scopes are epoch markers into an undo log, so entering and leaving
+ *   a block allocates nothing per scope; leaving replays the log to
+ *   restore shadowed outer declarations
  */
 
 #ifndef SYMBOL_TABLE_H
 #define SYMBOL_TABLE_H
 
-// Header content will be implemented later
+#include <stdbool.h>
+#include <stddef.h>
+#include "../parser/ast.h"
 
-#endif /* SYMBOL_TABLE_H */
\ No newline at end of file
+// Categories of named entities tracked during analysis
+typedef enum {
+    SYMBOL_VARIABLE,        // Scalar variable declaration
+    SYMBOL_ARRAY,           // Array declaration
+    SYMBOL_FUNCTION,        // Function defined in this program
+    SYMBOL_EXTERN_FUNCTION  // External function declaration
+} SymbolType;
+
+// One declared identifier. Only the innermost declaration of a name is
+// live in the table; shadowed outer declarations wait in the undo log.
+typedef struct {
+    const char* name;       // Interned identifier; NULL marks an empty slot
+    SymbolType type;        // What kind of entity the name denotes
+    TypeInfo* type_info;    // Declared type (owned by the AST)
+    AstNode* declaration;   // Declaration site, for error messages
+    int scope_depth;        // Scope the symbol was declared in
+} Symbol;
+
+// Undo-log record: how to restore one declaration on scope exit
+typedef struct {
+    const char* name;       // Which name the record belongs to
+    Symbol previous;        // Shadowed declaration; name == NULL when none
+} ScopeUndo;
+
+// The symbol table. Global scope is depth 0.
+typedef struct {
+    Symbol* slots;          // Open-addressing slot array (power-of-two size)
+    size_t capacity;        // Number of slots
+    size_t used;            // Number of occupied slots
+    int scope_depth;        // Currently open scope
+
+    ScopeUndo* undo_log;    // Declarations made in currently open scopes
+    size_t undo_count;      // Live undo records
+    size_t undo_capacity;   // Allocated undo records
+
+    size_t* scope_marks;    // undo_count at entry to each open scope
+    size_t mark_count;      // Number of open scopes
+    size_t mark_capacity;   // Allocated scope marks
+} SymbolTable;
+
+/**
+ * Create and initialize a new symbol table positioned in global scope
+ *
+ * @return The new table, or NULL on allocation failure
+ */
+SymbolTable* symbol_table_init(void);
+
+/**
+ * Free all memory used by a symbol table. Symbol type information and
+ * declaration nodes are owned by the AST and are not freed
+ *
+ * @param table The table to free
+ */
+void symbol_table_free(SymbolTable* table);
+
+/**
+ * Enter a new nested scope. Costs one epoch marker; no per-scope
+ * allocation beyond the shared mark stack
+ *
+ * @param table The symbol table
+ * @return true on success, false on allocation failure
+ */
+bool symbol_table_enter_scope(SymbolTable* table);
+
+/**
+ * Leave the current scope, dropping its declarations and restoring any
+ * outer declarations they shadowed
+ *
+ * @param table The symbol table
+ * @return true on success, false when already in global scope
+ */
+bool symbol_table_exit_scope(SymbolTable* table);
+
+/**
+ * Declare a symbol in the current scope
+ *
+ * @param table The symbol table
+ * @param name The identifier (interned internally; any UTF-8 string)
+ * @param type What kind of entity the name denotes
+ * @param type_info Declared type, owned by the AST (may be NULL)
+ * @param declaration Declaration site node (may be NULL)
+ * @return true on success, false for a duplicate in the same scope or
+ *         on allocation failure
+ */
+bool symbol_table_add(SymbolTable* table, const char* name, SymbolType type,
+                      TypeInfo* type_info, AstNode* declaration);
+
+/**
+ * Find the innermost visible declaration of a name. A single probe
+ * sequence with interned-pointer comparison
+ *
+ * @param table The symbol table
+ * @param name The identifier to look up
+ * @return The symbol, or NULL when the name is not declared
+ */
+Symbol* symbol_table_lookup(SymbolTable* table, const char* name);
+
+/**
+ * Get the current scope depth (0 = global scope)
+ *
+ * @param table The symbol table
+ * @return The scope depth
+ */
+int symbol_table_get_current_scope(SymbolTable* table);
+
+#endif /* SYMBOL_TABLE_H */
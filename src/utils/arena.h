@@ -0,0 +1,118 @@
+/*
+ * filename: arena.h
+ *
+ * Purpose:
+ * Header file for the arena (bump) allocator used by the ћ++ compiler.
+ * Provides fast allocation of many small objects (AST nodes, type info,
+ * identifier strings) from large contiguous blocks, with the whole arena
+ * released at once instead of object by object.
+ *
+ * Key Components:
+ * - Arena struct: Chain of large memory blocks with a bump pointer
+ * - arena_create(): Create a new arena with a given block size
+ * - arena_alloc(): Allocate aligned memory from the arena
+ * - arena_strdup(): Duplicate a string into the arena
+ * - arena_reset(): Release all allocations but keep the first block
+ * - arena_destroy(): Free the arena and all its blocks
+ *
+ * Interactions:
+ * - Used by ast.c for AstNode and TypeInfo allocation (see ast_set_arena())
+ * - Intended to be owned by the parser, one arena per translation unit
+ *
+ * Notes:
+ * - Allocations are aligned to the size of a pointer
+ * - Individual allocations cannot be freed; use arena_reset() instead
+ * - Allocations larger than the block size get a dedicated block
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/* Default block size for new arenas (64 KiB) */
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/* A single block of arena memory */
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;  /* Next block in the chain */
+    size_t capacity;          /* Usable bytes in this block */
+    size_t used;              /* Bytes already handed out */
+    char data[];              /* The block memory itself */
+} ArenaBlock;
+
+/* Arena allocator state */
+typedef struct Arena {
+    ArenaBlock* first;        /* First block in the chain */
+    ArenaBlock* current;      /* Block allocations are served from */
+    size_t block_size;        /* Default capacity for new blocks */
+    size_t total_allocated;   /* Total bytes handed out since last reset */
+} Arena;
+
+/*
+ * Create a new arena.
+ *
+ * Parameters:
+ *   block_size: Capacity of each memory block in bytes,
+ *               or 0 to use ARENA_DEFAULT_BLOCK_SIZE
+ *
+ * Returns:
+ *   A new arena, or NULL if allocation failed
+ */
+Arena* arena_create(size_t block_size);
+
+/*
+ * Allocate memory from an arena.
+ *
+ * Parameters:
+ *   arena: The arena to allocate from
+ *   size: Number of bytes to allocate
+ *
+ * Returns:
+ *   Pointer to zero-initialized memory, or NULL on failure
+ */
+void* arena_alloc(Arena* arena, size_t size);
+
+/*
+ * Duplicate a NUL-terminated string into an arena.
+ *
+ * Parameters:
+ *   arena: The arena to allocate from
+ *   str: The string to duplicate
+ *
+ * Returns:
+ *   Pointer to the copy, or NULL if str is NULL or allocation failed
+ */
+char* arena_strdup(Arena* arena, const char* str);
+
+/*
+ * Release all allocations made from an arena.
+ * The first block is kept so the arena can be reused without
+ * going back to malloc.
+ *
+ * Parameters:
+ *   arena: The arena to reset
+ */
+void arena_reset(Arena* arena);
+
+/*
+ * Destroy an arena and free all of its blocks.
+ *
+ * Parameters:
+ *   arena: The arena to destroy
+ */
+void arena_destroy(Arena* arena);
+
+/*
+ * Get the total number of bytes handed out since the arena was
+ * created or last reset.
+ *
+ * Parameters:
+ *   arena: The arena to query
+ *
+ * Returns:
+ *   Total bytes allocated
+ */
+size_t arena_total_allocated(Arena* arena);
+
+#endif /* ARENA_H */
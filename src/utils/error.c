@@ -1,38 +1,48 @@
 /*
  * filename: error.c
- * 
+ *
  * Purpose:
  * Implementation of error handling utilities for the ћ++ compiler.
  * Provides functions to report, track, and display compilation errors.
- * 
+ *
  * Key Components:
  * - error_init(): Initialize the error tracking system
- * - error_report(): Log an error with position and message
- * - error_warning(): Report a non-fatal warning
- * - error_syntax(): Report a syntax error
- * - error_semantic(): Report a semantic error
+ * - error_report(): Record an error with position and message
+ * - error_flush(): Format and emit recorded diagnostics in one write
  * - error_get_count(): Return the number of errors encountered
- * - error_print(): Print a formatted error message
  * - error_print_summary(): Print a summary of all errors after compilation
- * 
+ *
  * Interactions:
  * - Used by all compiler components to report issues
  * - Coordinates with main.c to handle error thresholds
- * 
+ *
  * Notes:
  * - Handles UTF-8 in error messages and file paths
  * - Maintains a list of all errors for final reporting
  * - Color-codes output when terminal supports it
- * - Can provide context from source code in error messages
+ * - Can generate error log files for post-compilation analysis
+ * - Reporting only records the Error struct; formatting, colorization
+ *   and log writing are deferred to error_flush(), which renders every
+ *   pending diagnostic into one large buffer and writes it in a single
+ *   call, so error floods never dominate compile time
+ * - Filenames, messages and suggestions are interned in a pool owned
+ *   by this module, so repeated diagnostics share one copy
+ * - Each thread records into its own list so compile workers never
+ *   contend; error_merge_thread_list() folds a thread's errors into
+ *   the shared list before the thread exits
  */
 
 #include "error.h"
+#include "memstats.h"
+#include "source_manager.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <time.h>
+#include <pthread.h>
 
 // ANSI color codes for terminal output
 #define COLOR_RED     "\x1b[31m"
@@ -45,33 +55,143 @@
 // Define the maximum number of errors to track
 #define MAX_ERRORS 500
 
-// Static array to store errors
-static Error error_list[MAX_ERRORS];
-static int error_count = 0;
+// How many diagnostics reach the terminal before the rest are
+// summarized as a single suppression line; the log file always
+// receives everything that was recorded
+#define ERROR_DISPLAY_CAP 100
+
+// Per-thread error list: workers record without locking and merge
+// into the shared list when they finish
+static _Thread_local Error error_list[MAX_ERRORS];
+static _Thread_local int error_count = 0;
+
+// Reports that arrived after the calling thread's list was full; only
+// the count survives, and the summary discloses it
+static _Thread_local int dropped_count = 0;
+
+// Shared list holding merged errors from finished threads, plus the
+// lock that also serializes flushing and log file writes
+static Error merged_list[MAX_ERRORS];
+static int merged_count = 0;
+static int merged_dropped = 0;
+static pthread_mutex_t error_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// How many diagnostics have been emitted to the terminal so far,
+// counted against ERROR_DISPLAY_CAP
+static int emitted_total = 0;
+
 static bool use_colors = true;
 static FILE* error_log_file = NULL;
 static bool generate_log_file = false;
 
+// Whether a fatal report terminates the process. The compile server
+// turns this off around each request so one bad compile cannot take
+// the warm process down with it
+static bool fatal_exits = true;
+
+// Growable output buffer: diagnostics are formatted into it and the
+// whole buffer is written with one call
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} ErrorSink;
+
+#define SINK_INITIAL_CAPACITY (64 * 1024)
+
+// Interning pool for the strings referenced by Error structs. Owned by
+// this module and released in error_cleanup(), unlike the compiler-wide
+// pool in intern.c which lives for the whole process
+#define ERROR_INTERN_BUCKETS 256
+
+typedef struct InternedString {
+    const char* text;
+    struct InternedString* next;
+} InternedString;
+
+static InternedString* intern_buckets[ERROR_INTERN_BUCKETS];
+
 // Forward declarations
-static void error_print(const Error* error);
+static void format_error_terminal(ErrorSink* sink, const Error* error);
+static void format_error_log(ErrorSink* sink, const Error* error);
+static void format_source_excerpt(ErrorSink* sink, const Error* error);
 static const char* error_type_to_string(ErrorType type);
 static const char* error_severity_to_string(ErrorSeverity severity);
 static const char* get_error_color(ErrorSeverity severity);
 static void strip_path(const char* path, char* buffer, size_t size);
-static char* safe_strdup(const char* str);
+static const char* error_intern(const char* str);
+static void error_flush_locked(void);
+
+/**
+ * Grow the sink so it can take at least extra more bytes
+ */
+static bool sink_reserve(ErrorSink* sink, size_t extra) {
+    if (sink->length + extra <= sink->capacity) return true;
+
+    size_t capacity = sink->capacity ? sink->capacity : SINK_INITIAL_CAPACITY;
+    while (capacity < sink->length + extra) {
+        capacity *= 2;
+    }
+
+    char* data = realloc(sink->data, capacity);
+    if (data == NULL) return false;
+
+    sink->data = data;
+    sink->capacity = capacity;
+    return true;
+}
 
 /**
- * Safe version of strdup that handles NULL
+ * Append a formatted line to the sink
  */
-static char* safe_strdup(const char* str) {
-    if (str == NULL) return NULL;
-    
-    size_t len = strlen(str) + 1;
-    char* new_str = malloc(len);
-    if (new_str == NULL) return NULL;
-    
-    memcpy(new_str, str, len);
-    return new_str;
+static void sink_append(ErrorSink* sink, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    va_list probe;
+    va_copy(probe, args);
+    int needed = vsnprintf(NULL, 0, format, probe);
+    va_end(probe);
+
+    if (needed < 0 || !sink_reserve(sink, (size_t)needed + 1)) {
+        va_end(args);
+        return;
+    }
+
+    vsnprintf(sink->data + sink->length, (size_t)needed + 1, format, args);
+    sink->length += (size_t)needed;
+    va_end(args);
+}
+
+/**
+ * Return the canonical copy of a string, adding it to the pool on
+ * first sight. Caller must hold error_mutex
+ */
+static const char* error_intern(const char* str) {
+    // FNV-1a over the bytes picks the bucket
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* byte = (const unsigned char*)str; *byte; byte++) {
+        hash ^= *byte;
+        hash *= 16777619u;
+    }
+
+    InternedString** bucket = &intern_buckets[hash & (ERROR_INTERN_BUCKETS - 1)];
+    for (InternedString* node = *bucket; node != NULL; node = node->next) {
+        if (strcmp(node->text, str) == 0) {
+            return node->text;
+        }
+    }
+
+    InternedString* node = mem_alloc(sizeof(InternedString));
+    if (node == NULL) return NULL;
+    node->text = mem_strdup(str);
+    if (node->text == NULL) {
+        mem_free(node);
+        return NULL;
+    }
+    node->next = *bucket;
+    *bucket = node;
+    return node->text;
 }
 
 /**
@@ -79,8 +199,12 @@ static char* safe_strdup(const char* str) {
  */
 bool error_init_with_log(bool create_log_file) {
     error_count = 0;
+    merged_count = 0;
+    dropped_count = 0;
+    merged_dropped = 0;
+    emitted_total = 0;
     generate_log_file = create_log_file;
-    
+
     // Try to determine if terminal supports colors
     #ifdef _WIN32
         // On Windows, check if ANSICON or similar is used
@@ -90,14 +214,14 @@ bool error_init_with_log(bool create_log_file) {
         const char* term = getenv("TERM");
         use_colors = (term != NULL && strcmp(term, "dumb") != 0);
     #endif
-    
+
     // Open error log file only if the flag is set
     if (generate_log_file) {
         time_t now = time(NULL);
         struct tm* tm_now = localtime(&now);
         char log_filename[100];
         strftime(log_filename, sizeof(log_filename), "ћпп_error_log_%Y%m%d_%H%M%S.txt", tm_now);
-        
+
         error_log_file = fopen(log_filename, "w");
         if (error_log_file == NULL) {
             fprintf(stderr, "Warning: Could not create error log file\n");
@@ -109,7 +233,7 @@ bool error_init_with_log(bool create_log_file) {
             fprintf(error_log_file, "Date: %s\n\n", ctime(&now));
         }
     }
-    
+
     return true;
 }
 
@@ -125,14 +249,27 @@ bool error_init(void) {
  * Clean up the error handling system
  */
 void error_cleanup(void) {
-    // Free all error strings
-    for (int i = 0; i < error_count; i++) {
-        free((void*)error_list[i].filename);
-        free((void*)error_list[i].message);
-        if (error_list[i].suggestion) free((void*)error_list[i].suggestion);
-        free((void*)error_list[i].compiler_file);
+    // Emit anything still pending so no recorded diagnostic is lost
+    error_flush();
+
+    // Drop both lists; the intern pool owns every string
+    error_count = 0;
+    dropped_count = 0;
+    merged_count = 0;
+    merged_dropped = 0;
+    emitted_total = 0;
+
+    for (int b = 0; b < ERROR_INTERN_BUCKETS; b++) {
+        InternedString* node = intern_buckets[b];
+        while (node != NULL) {
+            InternedString* next = node->next;
+            mem_free((void*)node->text);
+            mem_free(node);
+            node = next;
+        }
+        intern_buckets[b] = NULL;
     }
-    
+
     // Close log file if it was opened
     if (error_log_file != NULL) {
         fclose(error_log_file);
@@ -141,7 +278,28 @@ void error_cleanup(void) {
 }
 
 /**
- * Report an error
+ * Fold the calling thread's errors into the shared list
+ */
+void error_merge_thread_list(void) {
+    if (error_count == 0 && dropped_count == 0) return;
+    pthread_mutex_lock(&error_mutex);
+    for (int i = 0; i < error_count; i++) {
+        if (merged_count >= MAX_ERRORS) {
+            // No room left; the intern pool still owns the strings
+            merged_dropped++;
+            continue;
+        }
+        merged_list[merged_count++] = error_list[i];
+    }
+    merged_dropped += dropped_count;
+    pthread_mutex_unlock(&error_mutex);
+    error_count = 0;
+    dropped_count = 0;
+}
+
+/**
+ * Report an error. Only records the struct; formatting and output
+ * happen later in error_flush()
  */
 bool error_report(
     ErrorType type,
@@ -156,53 +314,130 @@ bool error_report(
 ) {
     // Check if we have room for more errors
     if (error_count >= MAX_ERRORS) {
-        // Can't record more errors, just print a message
-        fprintf(stderr, "Too many errors, stopping error tracking.\n");
+        // Remember the flood size; the summary discloses it
+        dropped_count++;
         return false;
     }
-    
-    // Create a new error
+
+    // Record the error with interned strings
     Error* error = &error_list[error_count++];
     error->type = type;
     error->severity = severity;
-    error->filename = safe_strdup(filename ? filename : "<unknown>");
     error->line = line;
     error->column = column;
-    error->message = safe_strdup(message ? message : "<no message>");
-    error->suggestion = suggestion ? safe_strdup(suggestion) : NULL;
-    error->compiler_file = safe_strdup(compiler_file ? compiler_file : "<unknown>");
     error->compiler_line = compiler_line;
-    
-    // Print the error immediately
-    error_print(error);
-    
-    // For fatal errors, exit immediately
+    error->emitted = false;
+
+    pthread_mutex_lock(&error_mutex);
+    error->filename = error_intern(filename ? filename : "<unknown>");
+    error->message = error_intern(message ? message : "<no message>");
+    error->suggestion = suggestion ? error_intern(suggestion) : NULL;
+    error->compiler_file = error_intern(compiler_file ? compiler_file : "<unknown>");
+    pthread_mutex_unlock(&error_mutex);
+
+    // For fatal errors, surface everything recorded so far and exit.
+    // When exiting is disabled (server mode) the error stays recorded
+    // and the caller unwinds through its normal failure path
     if (severity == ERROR_FATAL) {
+        error_flush();
         fprintf(stderr, "Fatal error encountered, stopping compilation.\n");
-        error_cleanup();
-        exit(EXIT_FAILURE);
+        if (fatal_exits) {
+            error_cleanup();
+            exit(EXIT_FAILURE);
+        }
     }
-    
+
     return true;
 }
 
+void error_set_fatal_exits(bool exits) {
+    fatal_exits = exits;
+}
+
+/**
+ * Format and emit every pending diagnostic: terminal output through
+ * one buffered write (capped for floods), the log file uncapped
+ */
+void error_flush(void) {
+    pthread_mutex_lock(&error_mutex);
+    error_flush_locked();
+    pthread_mutex_unlock(&error_mutex);
+}
+
+/**
+ * Flush body; caller must hold error_mutex
+ */
+static void error_flush_locked(void) {
+    ErrorSink terminal = {0};
+    ErrorSink log = {0};
+    int suppressed = 0;
+
+    // Merged errors first, then the calling thread's own list
+    Error* lists[2] = { merged_list, error_list };
+    int counts[2] = { merged_count, error_count };
+
+    for (int l = 0; l < 2; l++) {
+        for (int i = 0; i < counts[l]; i++) {
+            Error* error = &lists[l][i];
+            if (error->emitted) continue;
+            error->emitted = true;
+
+            if (emitted_total < ERROR_DISPLAY_CAP) {
+                format_error_terminal(&terminal, error);
+            } else {
+                suppressed++;
+            }
+            emitted_total++;
+
+            if (error_log_file != NULL) {
+                format_error_log(&log, error);
+            }
+        }
+    }
+
+    if (suppressed > 0) {
+        sink_append(&terminal,
+                    "... %d additional diagnostics suppressed after the first %d%s\n",
+                    suppressed, ERROR_DISPLAY_CAP,
+                    error_log_file != NULL
+                        ? "; the error log has the full list"
+                        : "; re-run with --generate-error-log for the full list");
+    }
+
+    if (terminal.length > 0) {
+        fwrite(terminal.data, 1, terminal.length, stderr);
+    }
+    if (log.length > 0 && error_log_file != NULL) {
+        fwrite(log.data, 1, log.length, error_log_file);
+    }
+
+    free(terminal.data);
+    free(log.data);
+}
+
 /**
  * Get the number of errors of a certain severity
  */
 int error_get_count(int severity) {
-    if (severity < 0) {
-        // Return total count of all errors
-        return error_count;
-    }
-    
-    // Count errors of a specific severity
+    pthread_mutex_lock(&error_mutex);
     int count = 0;
-    for (int i = 0; i < error_count; i++) {
-        if ((int)error_list[i].severity == severity) {
-            count++;
+    if (severity < 0) {
+        // Total across the merged list and the calling thread
+        count = merged_count + error_count;
+    } else {
+        // Count errors of a specific severity
+        for (int i = 0; i < merged_count; i++) {
+            if ((int)merged_list[i].severity == severity) {
+                count++;
+            }
+        }
+        for (int i = 0; i < error_count; i++) {
+            if ((int)error_list[i].severity == severity) {
+                count++;
+            }
         }
     }
-    
+    pthread_mutex_unlock(&error_mutex);
     return count;
 }
 
@@ -210,106 +445,170 @@ int error_get_count(int severity) {
  * Print a summary of all errors encountered
  */
 void error_print_summary(bool verbose) {
+    // Details come out before the totals
+    error_flush();
+
     // Count errors by severity
     int warnings = error_get_count(ERROR_WARNING);
     int errors = error_get_count(ERROR_ERROR);
     int fatals = error_get_count(ERROR_FATAL);
-    
+
+    int total = error_get_count(-1);
+
+    pthread_mutex_lock(&error_mutex);
+    int dropped = merged_dropped + dropped_count;
+    pthread_mutex_unlock(&error_mutex);
+
     // Print summary to stderr
     fprintf(stderr, "\n=== Compilation Summary ===\n");
-    fprintf(stderr, "Total issues: %d\n", error_count);
+    fprintf(stderr, "Total issues: %d\n", total);
     fprintf(stderr, "  Warnings: %d\n", warnings);
     fprintf(stderr, "  Errors:   %d\n", errors);
     fprintf(stderr, "  Fatal:    %d\n", fatals);
-    
+    if (dropped > 0) {
+        fprintf(stderr, "  Dropped:  %d (error list was full)\n", dropped);
+    }
+
     // Also log to file if available
     if (error_log_file != NULL) {
         fprintf(error_log_file, "\n=== Compilation Summary ===\n");
-        fprintf(error_log_file, "Total issues: %d\n", error_count);
+        fprintf(error_log_file, "Total issues: %d\n", total);
         fprintf(error_log_file, "  Warnings: %d\n", warnings);
         fprintf(error_log_file, "  Errors:   %d\n", errors);
         fprintf(error_log_file, "  Fatal:    %d\n", fatals);
+        if (dropped > 0) {
+            fprintf(error_log_file, "  Dropped:  %d (error list was full)\n", dropped);
+        }
     }
-    
-    // If verbose, print every error again
-    if (verbose && error_count > 0) {
+
+    // If verbose, print every error again, merged ones first
+    if (verbose && total > 0) {
         fprintf(stderr, "\n=== Error Details ===\n");
+        pthread_mutex_lock(&error_mutex);
+        ErrorSink details = {0};
+        for (int i = 0; i < merged_count; i++) {
+            format_error_terminal(&details, &merged_list[i]);
+        }
         for (int i = 0; i < error_count; i++) {
-            error_print(&error_list[i]);
+            format_error_terminal(&details, &error_list[i]);
         }
+        if (details.length > 0) {
+            fwrite(details.data, 1, details.length, stderr);
+        }
+        free(details.data);
+        pthread_mutex_unlock(&error_mutex);
     }
 }
 
 /**
- * Print a formatted error message
+ * Append the offending source line with a caret under the column, when
+ * the file is still open in a source manager. The excerpt references
+ * the manager's buffer directly; nothing is re-read or copied
  */
-static void error_print(const Error* error) {
+static void format_source_excerpt(ErrorSink* sink, const Error* error) {
+    if (error->line <= 0) return;
+
+    SourceManager* manager = source_manager_find(error->filename);
+    if (manager == NULL) return;
+
+    size_t length = 0;
+    const char* text = source_manager_line(manager, error->line, &length);
+    if (text == NULL) return;
+
+    sink_append(sink, "  %5d | %.*s\n", error->line, (int)length, text);
+
+    if (error->column > 0 && (size_t)(error->column - 1) <= length) {
+        // The column is byte-based; count UTF-8 characters up to it so
+        // the caret lines up under multi-byte text
+        int display = 0;
+        for (int b = 0; b < error->column - 1; b++) {
+            if (((unsigned char)text[b] & 0xC0) != 0x80) display++;
+        }
+        sink_append(sink, "        | %*s^\n", display, "");
+    }
+}
+
+/**
+ * Format one diagnostic for the terminal
+ */
+static void format_error_terminal(ErrorSink* sink, const Error* error) {
     if (!error) return;
-    
+
     // Get string representations
     const char* severity_str = error_severity_to_string(error->severity);
     const char* type_str = error_type_to_string(error->type);
-    
+
     // Create a stripped version of the filename
     char short_filename[256];
     strip_path(error->filename, short_filename, sizeof(short_filename));
-    
+
     // Create a stripped version of the compiler file
     char short_compiler_file[256];
     strip_path(error->compiler_file, short_compiler_file, sizeof(short_compiler_file));
-    
-    // Print to stderr with or without colors
+
+    // Format with or without colors
     if (use_colors) {
         const char* color = get_error_color(error->severity);
-        
-        fprintf(stderr, "%s%s%s [%s] in %s:%d:%d: %s%s%s\n",
-                COLOR_BOLD, color, severity_str, type_str,
-                short_filename, error->line, error->column,
-                error->message, COLOR_RESET, COLOR_RESET);
-        
-        // Print suggestion if available
+
+        sink_append(sink, "%s%s%s [%s] in %s:%d:%d: %s%s%s\n",
+                    COLOR_BOLD, color, severity_str, type_str,
+                    short_filename, error->line, error->column,
+                    error->message, COLOR_RESET, COLOR_RESET);
+
+        format_source_excerpt(sink, error);
+
+        // Add suggestion if available
         if (error->suggestion) {
-            fprintf(stderr, "  %sSuggestion:%s %s\n", 
-                   COLOR_CYAN, COLOR_RESET, error->suggestion);
+            sink_append(sink, "  %sSuggestion:%s %s\n",
+                        COLOR_CYAN, COLOR_RESET, error->suggestion);
         }
-        
-        // Print compiler source location in debug builds
+
+        // Add compiler source location in debug builds
         #ifdef DEBUG
-        fprintf(stderr, "  %sReported from:%s %s:%d\n",
-               COLOR_BLUE, COLOR_RESET, short_compiler_file, error->compiler_line);
+        sink_append(sink, "  %sReported from:%s %s:%d\n",
+                    COLOR_BLUE, COLOR_RESET, short_compiler_file, error->compiler_line);
         #endif
     } else {
-        fprintf(stderr, "%s [%s] in %s:%d:%d: %s\n",
-                severity_str, type_str,
-                short_filename, error->line, error->column,
-                error->message);
-        
-        // Print suggestion if available
+        sink_append(sink, "%s [%s] in %s:%d:%d: %s\n",
+                    severity_str, type_str,
+                    short_filename, error->line, error->column,
+                    error->message);
+
+        format_source_excerpt(sink, error);
+
+        // Add suggestion if available
         if (error->suggestion) {
-            fprintf(stderr, "  Suggestion: %s\n", error->suggestion);
+            sink_append(sink, "  Suggestion: %s\n", error->suggestion);
         }
-        
-        // Print compiler source location in debug builds
+
+        // Add compiler source location in debug builds
         #ifdef DEBUG
-        fprintf(stderr, "  Reported from: %s:%d\n",
-               short_compiler_file, error->compiler_line);
+        sink_append(sink, "  Reported from: %s:%d\n",
+                    short_compiler_file, error->compiler_line);
         #endif
     }
-    
-    // Log to file if available
-    if (error_log_file != NULL) {
-        fprintf(error_log_file, "%s [%s] in %s:%d:%d: %s\n",
-                severity_str, type_str,
+}
+
+/**
+ * Format one diagnostic for the log file
+ */
+static void format_error_log(ErrorSink* sink, const Error* error) {
+    if (!error) return;
+
+    sink_append(sink, "%s [%s] in %s:%d:%d: %s\n",
+                error_severity_to_string(error->severity),
+                error_type_to_string(error->type),
                 error->filename, error->line, error->column,
                 error->message);
-        
-        if (error->suggestion) {
-            fprintf(error_log_file, "  Suggestion: %s\n", error->suggestion);
-        }
-        
-        fprintf(error_log_file, "  Reported from: %s:%d\n",
-               error->compiler_file, error->compiler_line);
+
+    format_source_excerpt(sink, error);
+
+    if (error->suggestion) {
+        sink_append(sink, "  Suggestion: %s\n", error->suggestion);
     }
+
+    sink_append(sink, "  Reported from: %s:%d\n",
+                error->compiler_file, error->compiler_line);
 }
 
 /**
@@ -356,20 +655,20 @@ static const char* get_error_color(ErrorSeverity severity) {
  */
 static void strip_path(const char* path, char* buffer, size_t size) {
     if (!path || !buffer || size == 0) return;
-    
+
     // Find the last separator
     const char* last_sep = strrchr(path, '/');
     #ifdef _WIN32
     const char* last_sep_win = strrchr(path, '\\');
     if (last_sep_win > last_sep) last_sep = last_sep_win;
     #endif
-    
+
     // Copy the filename part
     if (last_sep) {
         strncpy(buffer, last_sep + 1, size - 1);
     } else {
         strncpy(buffer, path, size - 1);
     }
-    
+
     buffer[size - 1] = '\0'; // Ensure null termination
-}
\ No newline at end of file
+}
@@ -20,6 +20,8 @@
  * - Automatically captures compiler source location via __FILE__, __LINE__
  * - Supports colorized terminal output for better readability
  * - Can generate error log files for post-compilation analysis
+ * - Reporting only records; output is deferred to error_flush() so a
+ *   flood of diagnostics never dominates compile time
  */
 
 #ifndef ERROR_H
@@ -55,6 +57,7 @@ typedef struct {
     const char* suggestion;   // Optional suggestion for fixing the error
     const char* compiler_file;// Compiler source file reporting the error
     int compiler_line;        // Line in compiler where error was reported
+    bool emitted;             // Set by the sink once the error was printed
 } Error;
 
 // Function prototypes
@@ -77,6 +80,13 @@ bool error_init_with_log(bool create_log_file);
  */
 void error_cleanup(void);
 
+/**
+ * Fold the calling thread's error list into the shared list.
+ * Compile workers call this before exiting so counts and summaries
+ * reflect every thread's errors
+ */
+void error_merge_thread_list(void);
+
 /**
  * Report an error with all details
  * @param type Error type classification
@@ -102,6 +112,24 @@ bool error_report(
     int compiler_line
 );
 
+/**
+ * Control whether a fatal report terminates the process. Defaults to
+ * true; the compile server disables it around each request so a fatal
+ * error fails that request instead of killing the warm process. The
+ * fatal error is still recorded and flushed either way
+ * @param exits True to exit on fatal reports, false to record and return
+ */
+void error_set_fatal_exits(bool exits);
+
+/**
+ * Format and write every diagnostic recorded since the last flush.
+ * error_report only records; this is where colorization, formatting
+ * and log-file output happen, through one large buffered write.
+ * Floods are capped on the terminal and summarized in a single line;
+ * the log file always receives the full list
+ */
+void error_flush(void);
+
 /**
  * Get the number of errors of a given severity
  * @param severity Error severity level to count (-1 for all errors)
@@ -0,0 +1,176 @@
+/*
+ * filename: intern.c
+ *
+ * Purpose:
+ * Implementation of the global string-interning pool for the ћ++ compiler.
+ * Identifiers repeat enormously in real programs (loop counters, common
+ * function names); storing each distinct string once cuts memory and turns
+ * name comparisons into pointer compares.
+ *
+ * Key Components:
+ * - intern_string(): Hash-table lookup with insert-on-miss
+ * - intern_cstring(): Convenience wrapper for NUL-terminated strings
+ * - intern_cleanup(): Free the table and the backing arena
+ *
+ * Interactions:
+ * - Backed by the arena allocator (arena.h) for string storage
+ * - Used by lexer.c and ast.c for all identifier strings
+ *
+ * Notes:
+ * - Open-addressing hash table with linear probing, grown at 70% load
+ * - FNV-1a hash over the raw UTF-8 bytes
+ * - Not thread-safe; the compiler interns from a single thread
+ */
+
+#include "intern.h"
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Initial number of slots in the hash table (power of two) */
+#define INTERN_INITIAL_CAPACITY 1024
+
+/* Grow the table when count exceeds capacity * 7 / 10 */
+#define INTERN_LOAD_NUM 7
+#define INTERN_LOAD_DEN 10
+
+/* One slot in the intern table */
+typedef struct {
+    const char* str;   /* Canonical string, or NULL for an empty slot */
+    size_t length;     /* Length in bytes, excluding the NUL */
+    uint32_t hash;     /* Cached hash of the string */
+} InternSlot;
+
+/* Global pool state, initialized lazily */
+static InternSlot* intern_table = NULL;
+static size_t intern_capacity = 0;
+static size_t intern_used = 0;
+static Arena* intern_arena = NULL;
+
+/*
+ * FNV-1a hash over a byte range.
+ */
+static uint32_t intern_hash(const char* str, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * Allocate the table and backing arena on first use.
+ */
+static bool intern_init(void) {
+    intern_table = (InternSlot*)calloc(INTERN_INITIAL_CAPACITY, sizeof(InternSlot));
+    if (!intern_table) {
+        return false;
+    }
+
+    intern_arena = arena_create(0);
+    if (!intern_arena) {
+        free(intern_table);
+        intern_table = NULL;
+        return false;
+    }
+
+    intern_capacity = INTERN_INITIAL_CAPACITY;
+    intern_used = 0;
+    return true;
+}
+
+/*
+ * Double the table and re-insert every slot.
+ * The strings themselves stay where they are in the arena.
+ */
+static bool intern_grow(void) {
+    size_t new_capacity = intern_capacity * 2;
+    InternSlot* new_table = (InternSlot*)calloc(new_capacity, sizeof(InternSlot));
+    if (!new_table) {
+        return false;
+    }
+
+    for (size_t i = 0; i < intern_capacity; i++) {
+        if (!intern_table[i].str) continue;
+
+        size_t index = intern_table[i].hash & (new_capacity - 1);
+        while (new_table[index].str) {
+            index = (index + 1) & (new_capacity - 1);
+        }
+        new_table[index] = intern_table[i];
+    }
+
+    free(intern_table);
+    intern_table = new_table;
+    intern_capacity = new_capacity;
+    return true;
+}
+
+const char* intern_string(const char* str, size_t length) {
+    if (!str) {
+        return NULL;
+    }
+
+    if (!intern_table && !intern_init()) {
+        return NULL;
+    }
+
+    uint32_t hash = intern_hash(str, length);
+    size_t index = hash & (intern_capacity - 1);
+
+    /* Linear probe: return the existing entry on a match */
+    while (intern_table[index].str) {
+        InternSlot* slot = &intern_table[index];
+        if (slot->hash == hash && slot->length == length &&
+            memcmp(slot->str, str, length) == 0) {
+            return slot->str;
+        }
+        index = (index + 1) & (intern_capacity - 1);
+    }
+
+    /* Not found: copy the string into the arena and claim the slot */
+    char* copy = (char*)arena_alloc(intern_arena, length + 1);
+    if (!copy) {
+        return NULL;
+    }
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+
+    intern_table[index].str = copy;
+    intern_table[index].length = length;
+    intern_table[index].hash = hash;
+    intern_used++;
+
+    if (intern_used * INTERN_LOAD_DEN > intern_capacity * INTERN_LOAD_NUM) {
+        if (!intern_grow()) {
+            /* The new entry is already valid; growth can be retried later */
+            return copy;
+        }
+    }
+
+    return copy;
+}
+
+const char* intern_cstring(const char* str) {
+    if (!str) {
+        return NULL;
+    }
+    return intern_string(str, strlen(str));
+}
+
+size_t intern_count(void) {
+    return intern_used;
+}
+
+void intern_cleanup(void) {
+    free(intern_table);
+    intern_table = NULL;
+    intern_capacity = 0;
+    intern_used = 0;
+
+    arena_destroy(intern_arena);
+    intern_arena = NULL;
+}
@@ -0,0 +1,71 @@
+/*
+ * filename: intern.h
+ *
+ * Purpose:
+ * Header file for the global string-interning pool of the ћ++ compiler.
+ * Each distinct UTF-8 identifier is stored exactly once; every consumer
+ * (lexer tokens, AST names, the future symbol table) holds the same
+ * canonical pointer, so name equality is a pointer compare instead of a
+ * byte-wise UTF-8 string comparison.
+ *
+ * Key Components:
+ * - intern_string(): Intern a byte range, returning the canonical pointer
+ * - intern_cstring(): Intern a NUL-terminated string
+ * - intern_count(): Number of distinct strings in the pool
+ * - intern_cleanup(): Release the pool and every interned string
+ *
+ * Interactions:
+ * - Used by lexer.c for TOKEN_IDENTIFIER lexemes
+ * - Used by ast.c for identifier, function, variable and array names
+ *
+ * Notes:
+ * - The pool owns all interned strings; callers must never free them
+ * - Interned strings stay valid until intern_cleanup() is called
+ * - The pool is global and initialized lazily on first use
+ */
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+
+/*
+ * Intern a byte range as a string.
+ * If an identical string was interned before, the existing canonical
+ * pointer is returned; otherwise the bytes are copied into the pool.
+ *
+ * Parameters:
+ *   str: Pointer to the bytes to intern (need not be NUL-terminated)
+ *   length: Number of bytes
+ *
+ * Returns:
+ *   Canonical NUL-terminated copy owned by the pool, or NULL on failure
+ */
+const char* intern_string(const char* str, size_t length);
+
+/*
+ * Intern a NUL-terminated string.
+ *
+ * Parameters:
+ *   str: The string to intern
+ *
+ * Returns:
+ *   Canonical copy owned by the pool, or NULL if str is NULL or on failure
+ */
+const char* intern_cstring(const char* str);
+
+/*
+ * Get the number of distinct strings currently interned.
+ *
+ * Returns:
+ *   Number of strings in the pool
+ */
+size_t intern_count(void);
+
+/*
+ * Release the pool and all interned strings.
+ * All pointers previously returned by the intern functions become invalid.
+ */
+void intern_cleanup(void);
+
+#endif /* INTERN_H */
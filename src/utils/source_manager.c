@@ -0,0 +1,284 @@
+/*
+ * filename: source_manager.c
+ *
+ * Purpose:
+ * Implementation of the shared source manager for the ћ++ compiler.
+ * Owns the bytes of each loaded source file and the line-start index
+ * both the lexer and the error reporter resolve positions against.
+ *
+ * Key Components:
+ * - source_manager_open(): mmap a regular file or read it into a buffer
+ * - source_manager_close(): Release the buffer and unregister the file
+ * - build_line_index(): One pass recording every line-start offset
+ * - source_manager_location(): Binary search offset to line/column
+ * - source_manager_line(): Zero-copy excerpt of one source line
+ * - source_manager_find(): Registry lookup by filename
+ *
+ * Interactions:
+ * - lexer.c opens a manager per input file and lexes out of its buffer
+ * - error.c looks managers up by filename to excerpt the offending line
+ *
+ * Notes:
+ * - The registry is a small mutex-protected table; compile workers
+ *   open one file each, so contention is negligible
+ * - Heap-allocated buffers and the manager struct are reported to
+ *   memstats; the mmap'd case only tracks the struct
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "source_manager.h"
+#include "utf8.h"
+#include "memstats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Upper bound on simultaneously open source files; one per compile
+// worker plus headroom
+#define SOURCE_REGISTRY_CAPACITY 64
+
+static SourceManager* registry[SOURCE_REGISTRY_CAPACITY];
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Add a manager to the registry; silently skipped when full
+ */
+static void registry_add(SourceManager* manager) {
+    pthread_mutex_lock(&registry_mutex);
+    for (int i = 0; i < SOURCE_REGISTRY_CAPACITY; i++) {
+        if (registry[i] == NULL) {
+            registry[i] = manager;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+/**
+ * Remove a manager from the registry
+ */
+static void registry_remove(SourceManager* manager) {
+    pthread_mutex_lock(&registry_mutex);
+    for (int i = 0; i < SOURCE_REGISTRY_CAPACITY; i++) {
+        if (registry[i] == manager) {
+            registry[i] = NULL;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+/**
+ * Find the open source manager for a filename
+ */
+SourceManager* source_manager_find(const char* filename) {
+    if (filename == NULL) return NULL;
+
+    SourceManager* found = NULL;
+    pthread_mutex_lock(&registry_mutex);
+    for (int i = 0; i < SOURCE_REGISTRY_CAPACITY; i++) {
+        if (registry[i] != NULL && registry[i]->filename != NULL &&
+            strcmp(registry[i]->filename, filename) == 0) {
+            found = registry[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    return found;
+}
+
+/**
+ * Load a source file and register it for filename lookups
+ */
+SourceManager* source_manager_open(FILE* file, const char* filename) {
+    if (file == NULL) return NULL;
+
+    char* buffer = NULL;
+    size_t length = 0;
+    bool mapped = false;
+
+    // Prefer mapping the file directly: no heap copy, and lexemes and
+    // excerpts can reference the mapping for the manager's whole
+    // lifetime. Only regular, non-empty files can be mapped.
+    struct stat file_stat;
+    int fd = fileno(file);
+    if (fd >= 0 && fstat(fd, &file_stat) == 0 &&
+        S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+        void* mapping = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            buffer = (char*)mapping;
+            length = (size_t)file_stat.st_size;
+            mapped = true;
+        }
+    }
+
+    // Fall back to reading into a heap buffer (pipes, stdin, or mmap failure)
+    if (!mapped) {
+        fseek(file, 0, SEEK_END);
+        long file_size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (file_size < 0) {
+            return NULL;
+        }
+
+        buffer = (char*)malloc(file_size + 1);
+        if (buffer == NULL) {
+            return NULL;
+        }
+
+        size_t bytes_read = fread(buffer, 1, file_size, file);
+        if (bytes_read != (size_t)file_size) {
+            free(buffer);
+            return NULL;
+        }
+
+        buffer[file_size] = '\0';
+        length = (size_t)file_size;
+        memstats_track_alloc(length + 1);
+    }
+
+    SourceManager* manager = (SourceManager*)malloc(sizeof(SourceManager));
+    if (manager == NULL) {
+        if (mapped) {
+            munmap(buffer, length);
+        } else {
+            free(buffer);
+            memstats_track_free(length + 1);
+        }
+        return NULL;
+    }
+
+    manager->filename = filename;
+    manager->buffer = buffer;
+    manager->length = length;
+    manager->mapped = mapped;
+    manager->line_starts = NULL;
+    manager->line_count = 0;
+    memstats_track_alloc(sizeof(SourceManager));
+
+    registry_add(manager);
+    return manager;
+}
+
+/**
+ * Unregister a source manager and release its buffer and index
+ */
+void source_manager_close(SourceManager* manager) {
+    if (manager == NULL) return;
+
+    registry_remove(manager);
+
+    if (manager->buffer != NULL) {
+        if (manager->mapped) {
+            munmap((void*)manager->buffer, manager->length);
+        } else {
+            free((void*)manager->buffer);
+            memstats_track_free(manager->length + 1);
+        }
+    }
+    free(manager->line_starts);
+    free(manager);
+    memstats_track_free(sizeof(SourceManager));
+}
+
+/**
+ * Build the per-file line-start index
+ *
+ * One pass over the source records the byte offset of every line start.
+ * Built at most once per file, and only when a location is first needed.
+ *
+ * @param manager The source manager
+ * @return true if the index was built, false on allocation failure
+ */
+static bool build_line_index(SourceManager* manager) {
+    size_t capacity = 128;
+    uint32_t* starts = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    if (starts == NULL) {
+        return false;
+    }
+
+    size_t count = 0;
+    starts[count++] = 0;
+
+    size_t pos = 0;
+    while (pos < manager->length) {
+        // Jump to the next newline with the vectorized scan
+        pos += utf8_line_run(manager->buffer + pos, manager->length - pos);
+        if (pos >= manager->length) {
+            break;
+        }
+        pos++; // Consume the newline itself
+
+        if (count == capacity) {
+            capacity *= 2;
+            uint32_t* new_starts = (uint32_t*)realloc(starts, capacity * sizeof(uint32_t));
+            if (new_starts == NULL) {
+                free(starts);
+                return false;
+            }
+            starts = new_starts;
+        }
+        starts[count++] = (uint32_t)pos;
+    }
+
+    manager->line_starts = starts;
+    manager->line_count = count;
+    return true;
+}
+
+/**
+ * Compute the line and column for a byte offset in the source
+ */
+void source_manager_location(SourceManager* manager, size_t offset,
+                             int* line, int* column) {
+    if (manager->line_starts == NULL && !build_line_index(manager)) {
+        // Index unavailable: degrade to offset-as-column on line 1
+        *line = 1;
+        *column = (int)offset + 1;
+        return;
+    }
+
+    // Binary search for the last line start at or before the offset
+    size_t lo = 0;
+    size_t hi = manager->line_count;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (manager->line_starts[mid] <= offset) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    *line = (int)lo + 1;
+    *column = (int)(offset - manager->line_starts[lo]) + 1;
+}
+
+/**
+ * Get one source line without copying it
+ */
+const char* source_manager_line(SourceManager* manager, int line,
+                                size_t* length) {
+    if (line < 1) return NULL;
+    if (manager->line_starts == NULL && !build_line_index(manager)) {
+        return NULL;
+    }
+    if ((size_t)line > manager->line_count) return NULL;
+
+    size_t start = manager->line_starts[line - 1];
+    size_t end = (size_t)line < manager->line_count
+                     ? manager->line_starts[line] : manager->length;
+
+    // Trim the trailing newline so excerpts splice cleanly into output
+    while (end > start && (manager->buffer[end - 1] == '\n' ||
+                           manager->buffer[end - 1] == '\r')) {
+        end--;
+    }
+
+    *length = end - start;
+    return manager->buffer + start;
+}
@@ -0,0 +1,99 @@
+/*
+ * filename: source_manager.h
+ *
+ * Purpose:
+ * Header file for the shared source manager of the ћ++ compiler.
+ * One SourceManager owns the bytes of one source file (memory-mapped
+ * when possible) together with a once-built index of line-start
+ * offsets, so every consumer resolves positions against the same
+ * buffer instead of keeping its own bookkeeping.
+ *
+ * Key Components:
+ * - SourceManager struct: File buffer, length, and line-start index
+ * - source_manager_open(): Map or read a file and register it
+ * - source_manager_location(): O(log n) byte offset to line/column
+ * - source_manager_line(): Zero-copy excerpt of one source line
+ * - source_manager_find(): Look up the manager for a filename
+ *
+ * Interactions:
+ * - Created by lexer.c, which lexes straight out of the buffer
+ * - Queried by error.c to show the offending source line in
+ *   diagnostics without re-reading the file
+ *
+ * Notes:
+ * - Regular files are mmap'd read-only; pipes and other non-seekable
+ *   inputs fall back to a heap buffer
+ * - The line index is built lazily on the first location query
+ * - Open managers are tracked in a registry so the error reporter can
+ *   find them by filename; closing a manager unregisters it
+ */
+
+#ifndef SOURCE_MANAGER_H
+#define SOURCE_MANAGER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// One loaded source file: the buffer plus its line-start index
+typedef struct {
+    const char* filename;    // Name used for registry lookups
+    const char* buffer;      // File contents (mapped or heap)
+    size_t length;           // Length of buffer in bytes
+    bool mapped;             // Whether buffer is an mmap'd file
+    uint32_t* line_starts;   // Byte offset of each line start (built lazily)
+    size_t line_count;       // Number of entries in line_starts
+} SourceManager;
+
+/**
+ * Load a source file and register it for filename lookups
+ *
+ * @param file The open source file
+ * @param filename The name of the source file (for error reporting)
+ * @return A new source manager, or NULL on I/O or allocation failure
+ */
+SourceManager* source_manager_open(FILE* file, const char* filename);
+
+/**
+ * Unregister a source manager and release its buffer and index
+ *
+ * @param manager The source manager to close
+ */
+void source_manager_close(SourceManager* manager);
+
+/**
+ * Compute the line and column for a byte offset in the source
+ *
+ * Builds the line index on first use, then resolves positions by
+ * binary search, so no per-character bookkeeping is needed anywhere.
+ *
+ * @param manager The source manager
+ * @param offset Byte offset into the source buffer
+ * @param line Output: 1-based line number
+ * @param column Output: 1-based byte column within the line
+ */
+void source_manager_location(SourceManager* manager, size_t offset,
+                             int* line, int* column);
+
+/**
+ * Get one source line without copying it
+ *
+ * @param manager The source manager
+ * @param line 1-based line number
+ * @param length Output: length of the line in bytes, without the newline
+ * @return Pointer into the source buffer, or NULL if the line does not
+ *         exist; the bytes are not NUL-terminated
+ */
+const char* source_manager_line(SourceManager* manager, int line,
+                                size_t* length);
+
+/**
+ * Find the open source manager for a filename
+ *
+ * @param filename The filename passed to source_manager_open
+ * @return The manager, or NULL if no open manager matches
+ */
+SourceManager* source_manager_find(const char* filename);
+
+#endif /* SOURCE_MANAGER_H */
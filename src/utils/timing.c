@@ -0,0 +1,151 @@
+/*
+ * filename: timing.c
+ *
+ * Purpose:
+ * Implementation of the per-phase timing and counter instrumentation
+ * behind --time-passes.
+ *
+ * Key Components:
+ * - monotonic_nanos(): CLOCK_MONOTONIC in nanoseconds
+ * - Atomic per-phase accumulators and event counters
+ * - timing_report(): The human-readable table with derived rates
+ *
+ * Interactions:
+ * - See timing.h for the call sites across the compiler
+ *
+ * Notes:
+ * - Phase start times live in thread-local storage, mirroring the
+ *   per-thread error lists in error.c, so compile workers can time
+ *   the same phase concurrently without interleaving
+ * - A phase entered but never left contributes nothing
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+#include "timing.h"
+
+// One flag gates every hot path
+static atomic_bool timing_on = false;
+
+// Accumulated nanoseconds per phase and event counts, across threads
+static _Atomic uint64_t phase_nanos[TIMING_PHASE_COUNT];
+static _Atomic uint64_t counters[TIMING_COUNTER_COUNT];
+
+// Where the calling thread last entered each phase (0 = not inside)
+static _Thread_local uint64_t phase_started[TIMING_PHASE_COUNT];
+
+// Which phase the calling thread is currently inside (-1 = none);
+// used by the memory statistics to attribute allocations
+static _Thread_local int current_phase = -1;
+
+static const char* phase_names[TIMING_PHASE_COUNT] = {
+    "Lexing", "Parsing", "Semantic", "IR generation",
+    "Optimization", "Code generation"
+};
+
+/**
+ * Current CLOCK_MONOTONIC reading in nanoseconds
+ */
+static uint64_t monotonic_nanos(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+void timing_enable(void) {
+    atomic_store(&timing_on, true);
+}
+
+bool timing_enabled(void) {
+    return atomic_load_explicit(&timing_on, memory_order_relaxed);
+}
+
+void timing_reset(void) {
+    for (int p = 0; p < TIMING_PHASE_COUNT; p++) {
+        atomic_store(&phase_nanos[p], 0);
+        phase_started[p] = 0;
+    }
+    for (int c = 0; c < TIMING_COUNTER_COUNT; c++) {
+        atomic_store(&counters[c], 0);
+    }
+}
+
+void timing_phase_begin(TimingPhase phase) {
+    if (!timing_enabled() || phase >= TIMING_PHASE_COUNT) return;
+    phase_started[phase] = monotonic_nanos();
+    current_phase = (int)phase;
+}
+
+void timing_phase_end(TimingPhase phase) {
+    if (!timing_enabled() || phase >= TIMING_PHASE_COUNT) return;
+    if ((int)phase == current_phase) current_phase = -1;
+    if (phase_started[phase] == 0) return;
+    atomic_fetch_add_explicit(&phase_nanos[phase],
+                              monotonic_nanos() - phase_started[phase],
+                              memory_order_relaxed);
+    phase_started[phase] = 0;
+}
+
+int timing_current_phase(void) {
+    return current_phase;
+}
+
+void timing_count(TimingCounter counter, uint64_t amount) {
+    if (!timing_enabled() || counter >= TIMING_COUNTER_COUNT) return;
+    atomic_fetch_add_explicit(&counters[counter], amount,
+                              memory_order_relaxed);
+}
+
+uint64_t timing_get_counter(TimingCounter counter) {
+    if (counter >= TIMING_COUNTER_COUNT) return 0;
+    return atomic_load(&counters[counter]);
+}
+
+uint64_t timing_get_phase_nanos(TimingPhase phase) {
+    if (phase >= TIMING_PHASE_COUNT) return 0;
+    return atomic_load(&phase_nanos[phase]);
+}
+
+/**
+ * Events per second over a phase, or 0 when the phase took no time
+ */
+static double rate_per_second(uint64_t events, uint64_t nanos) {
+    if (nanos == 0) return 0.0;
+    return (double)events * 1e9 / (double)nanos;
+}
+
+void timing_report(void) {
+    uint64_t total = 0;
+    for (int p = 0; p < TIMING_PHASE_COUNT; p++) {
+        total += timing_get_phase_nanos(p);
+    }
+
+    printf("\n--- Compilation phase times ---\n");
+    printf("%-18s %12s %8s\n", "Phase", "Time (ms)", "Share");
+    for (int p = 0; p < TIMING_PHASE_COUNT; p++) {
+        uint64_t nanos = timing_get_phase_nanos(p);
+        printf("%-18s %12.3f %7.1f%%\n", phase_names[p],
+               (double)nanos / 1e6,
+               total ? 100.0 * (double)nanos / (double)total : 0.0);
+    }
+    printf("%-18s %12.3f\n", "Total", (double)total / 1e6);
+
+    uint64_t lexing = timing_get_phase_nanos(TIMING_PHASE_LEXING);
+    uint64_t parsing = timing_get_phase_nanos(TIMING_PHASE_PARSING);
+    uint64_t bytes = timing_get_counter(TIMING_COUNTER_SOURCE_BYTES);
+    uint64_t tokens = timing_get_counter(TIMING_COUNTER_TOKENS);
+    uint64_t nodes = timing_get_counter(TIMING_COUNTER_AST_NODES);
+
+    printf("\n--- Hot-path counters ---\n");
+    printf("Source bytes:  %12llu  (%.1f MB/s lexing)\n",
+           (unsigned long long)bytes,
+           rate_per_second(bytes, lexing) / 1e6);
+    printf("Tokens:        %12llu  (%.0f tokens/s)\n",
+           (unsigned long long)tokens, rate_per_second(tokens, lexing));
+    printf("AST nodes:     %12llu  (%.0f nodes/s)\n",
+           (unsigned long long)nodes, rate_per_second(nodes, parsing));
+}
@@ -0,0 +1,116 @@
+/*
+ * filename: timing.h
+ *
+ * Purpose:
+ * Per-phase timing and hot-path counter instrumentation for the ћ++
+ * compiler (--time-passes). Answers "where did the compile time go"
+ * without reaching for an external profiler.
+ *
+ * Key Components:
+ * - TimingPhase enum: The pipeline phases that are timed
+ * - TimingCounter enum: Hot-path event counters (tokens, AST nodes, bytes)
+ * - timing_phase_begin()/timing_phase_end(): Bracket one phase
+ * - timing_count(): Bump a counter from a hot path
+ * - timing_report(): Print the table with MB/s and tokens/s rates
+ *
+ * Interactions:
+ * - main.c enables instrumentation for --time-passes and brackets the
+ *   pipeline phases
+ * - lexer.c counts tokens and source bytes, ast.c counts nodes
+ *
+ * Notes:
+ * - Disabled by default; a disabled timing_count() is a single flag
+ *   check so the hot paths stay cheap
+ * - Uses CLOCK_MONOTONIC so wall-clock adjustments cannot skew phases
+ * - Counters and accumulated times are atomic and phase start times
+ *   are per-thread, so concurrent compile workers aggregate correctly
+ */
+
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The pipeline phases that are timed separately
+typedef enum {
+    TIMING_PHASE_LEXING,
+    TIMING_PHASE_PARSING,
+    TIMING_PHASE_SEMANTIC,
+    TIMING_PHASE_IR,
+    TIMING_PHASE_OPTIMIZATION,
+    TIMING_PHASE_CODEGEN,
+    TIMING_PHASE_COUNT
+} TimingPhase;
+
+// Hot-path event counters
+typedef enum {
+    TIMING_COUNTER_TOKENS,        // Tokens produced by lexer_next_token
+    TIMING_COUNTER_AST_NODES,     // Nodes allocated in ast.c
+    TIMING_COUNTER_SOURCE_BYTES,  // Bytes of source handed to the lexer
+    TIMING_COUNTER_COUNT
+} TimingCounter;
+
+/**
+ * Turn instrumentation on for the rest of the process
+ */
+void timing_enable(void);
+
+/**
+ * Is instrumentation currently enabled?
+ * @return True after timing_enable() has been called
+ */
+bool timing_enabled(void);
+
+/**
+ * Reset all accumulated times and counters (primarily for tests)
+ */
+void timing_reset(void);
+
+/**
+ * Mark the start of a phase on the calling thread
+ * @param phase The phase being entered
+ */
+void timing_phase_begin(TimingPhase phase);
+
+/**
+ * Mark the end of a phase on the calling thread and accumulate the
+ * elapsed monotonic time
+ * @param phase The phase being left
+ */
+void timing_phase_end(TimingPhase phase);
+
+/**
+ * Which phase the calling thread is currently inside
+ * @return The TimingPhase value, or -1 outside any phase
+ */
+int timing_current_phase(void);
+
+/**
+ * Add to a hot-path counter; a no-op while instrumentation is off
+ * @param counter The counter to bump
+ * @param amount How much to add
+ */
+void timing_count(TimingCounter counter, uint64_t amount);
+
+/**
+ * Get a counter's current value
+ * @param counter The counter to read
+ * @return The accumulated count
+ */
+uint64_t timing_get_counter(TimingCounter counter);
+
+/**
+ * Get the accumulated time of a phase
+ * @param phase The phase to read
+ * @return Accumulated nanoseconds across all threads
+ */
+uint64_t timing_get_phase_nanos(TimingPhase phase);
+
+/**
+ * Print the timing table: per-phase milliseconds plus derived rates
+ * (lexing MB/s and tokens/s, parsing nodes/s)
+ */
+void timing_report(void);
+
+#endif /* TIMING_H */
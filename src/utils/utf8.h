@@ -13,15 +13,18 @@
  * - utf8_strlen(): Count characters (not bytes) in a UTF-8 string
  * - utf8_strcmp(): Compare two UTF-8 strings
  * - utf8_is_alphabetic(): Check if a UTF-8 character is a letter
- * 
+ * - utf8_*_run(): Vectorized bulk scans over byte runs for the lexer
+ *
  * Interactions:
  * - Used by lexer.c for tokenizing UTF-8 identifiers and keywords
  * - Used by symbol_table.c for comparing identifier names
- * 
+ *
  * Notes:
  * - Handles the full Unicode range for identifiers and keywords
  * - Implements proper character-level operations on UTF-8 strings
  * - Provides utility functions for the rest of the compiler
+ * - The bulk-scan helpers use SSE2 16-byte chunks where available and
+ *   fall back to a scalar loop otherwise
  */
 
 #ifndef UTF8_H
@@ -150,6 +153,44 @@ bool utf8_is_identifier_char(utf8_codepoint_t codepoint, bool is_start);
  */
 bool utf8_next_char(const char** str, utf8_char_t* character);
 
+/*
+ * Count the leading run of ASCII space and tab bytes.
+ *
+ * Parameters:
+ *   str: Byte buffer to scan (need not be NUL-terminated)
+ *   length: Number of bytes available in the buffer
+ *
+ * Returns:
+ *   Number of leading bytes that are ' ' or '\t'
+ */
+size_t utf8_ascii_space_run(const char* str, size_t length);
+
+/*
+ * Count the bytes up to (not including) the next newline.
+ *
+ * Parameters:
+ *   str: Byte buffer to scan (need not be NUL-terminated)
+ *   length: Number of bytes available in the buffer
+ *
+ * Returns:
+ *   Number of bytes before the first '\n', or length if none is found
+ */
+size_t utf8_line_run(const char* str, size_t length);
+
+/*
+ * Count the leading run of ASCII identifier bytes (A-Z, a-z, 0-9, '_').
+ * Stops at the first non-ASCII byte so multi-byte characters can be
+ * decoded and classified by the caller.
+ *
+ * Parameters:
+ *   str: Byte buffer to scan (need not be NUL-terminated)
+ *   length: Number of bytes available in the buffer
+ *
+ * Returns:
+ *   Number of leading ASCII identifier bytes
+ */
+size_t utf8_ascii_identifier_run(const char* str, size_t length);
+
 /*
  * Check if a byte is a UTF-8 continuation byte (10xxxxxx)
  */
@@ -8,7 +8,7 @@
  * 
  * Key Components:
  * - test_ast_creation(): Test basic AST node creation
- * - test_ast_cloning(): Test AST deep cloning functionality
+ * - test_ast_cloning(): Test copy-on-write AST cloning
  * - test_ast_visitor(): Test AST visitor pattern
  * - test_ast_with_lexer(): Test integration with lexer for complete parsing flow
  * 
@@ -27,6 +27,7 @@
 #include <stdbool.h>
 #include <assert.h>
 #include "../src/parser/ast.h"
+#include "../src/parser/ast_cache.h"
 #include "../src/lexer/lexer.h"
 #include "../src/target/target_info.h"
 #include "../src/utils/error.h"
@@ -83,37 +84,46 @@ void test_ast_creation() {
     printf("AST node creation tests passed!\n\n");
 }
 
-// Test AST cloning
+// Test AST copy-on-write cloning
 void test_ast_cloning() {
     printf("Testing AST cloning...\n");
-    
+
     SourceLocation loc = source_location_create(1, 1, "test.ћпп");
-    
+
     // Create a simple expression tree: 42 + "тест"
     AstNode* int_literal = ast_create_literal_int(42, loc);
     AstNode* id_node = ast_create_identifier("тест", loc);
     AstNode* bin_expr = ast_create_binary_expr(int_literal, TOKEN_PLUS, id_node, loc);
-    
-    // Clone the expression
+
+    // Cloning is O(1): the clone shares the whole subtree
     AstNode* cloned_expr = ast_clone(bin_expr);
     TEST_ASSERT(cloned_expr != NULL, "Failed to clone binary expression");
-    TEST_ASSERT(cloned_expr->type == AST_BINARY_EXPR, "Wrong node type in cloned expression");
-    TEST_ASSERT(cloned_expr->as.binary_expr.operator == TOKEN_PLUS, "Wrong operator in cloned expression");
-    
-    // Verify that the clone is a deep copy
-    TEST_ASSERT(cloned_expr->as.binary_expr.left != int_literal, "Clone should not share the same left operand instance");
-    TEST_ASSERT(cloned_expr->as.binary_expr.right != id_node, "Clone should not share the same right operand instance");
-    
-    // Verify values in the cloned tree
-    TEST_ASSERT(cloned_expr->as.binary_expr.left->type == AST_LITERAL_INT, "Wrong left operand type in clone");
-    TEST_ASSERT(cloned_expr->as.binary_expr.left->as.int_literal.value == 42, "Wrong left operand value in clone");
-    TEST_ASSERT(cloned_expr->as.binary_expr.right->type == AST_IDENTIFIER, "Wrong right operand type in clone");
-    TEST_ASSERT(strcmp(cloned_expr->as.binary_expr.right->as.identifier.name, "тест") == 0, "Wrong right operand name in clone");
-    
-    // Free both trees
-    ast_free(bin_expr);
+    TEST_ASSERT(cloned_expr == bin_expr, "Clone should share the subtree until mutated");
+
+    // Releasing one reference leaves the other owner's tree intact
     ast_free(cloned_expr);
-    
+    TEST_ASSERT(bin_expr->type == AST_BINARY_EXPR, "Shared subtree must survive one release");
+    TEST_ASSERT(bin_expr->as.binary_expr.left == int_literal, "Shared children must survive one release");
+
+    // A private copy is materialized only when a clone is to be mutated
+    AstNode* shared = ast_clone(bin_expr);
+    AstNode* unique_expr = ast_make_unique(shared);
+    TEST_ASSERT(unique_expr != NULL, "Failed to materialize private copy");
+    TEST_ASSERT(unique_expr != bin_expr, "ast_make_unique must return a private node");
+    TEST_ASSERT(unique_expr->as.binary_expr.left == int_literal,
+                "Unmodified children stay shared after materialization");
+
+    // Mutating the private copy must not touch the original
+    unique_expr->as.binary_expr.operator = TOKEN_MINUS;
+    TEST_ASSERT(bin_expr->as.binary_expr.operator == TOKEN_PLUS,
+                "Mutation of a private copy leaked into the original");
+
+    // Free both trees; shared children die with the last owner
+    ast_free(unique_expr);
+    TEST_ASSERT(int_literal->type == AST_LITERAL_INT,
+                "Children shared with the original must survive the copy's release");
+    ast_free(bin_expr);
+
     printf("AST cloning tests passed!\n\n");
 }
 
@@ -393,9 +403,219 @@ void test_external_function_declarations() {
     printf("External function declarations test passed!\n\n");
 }
 
+// Test that identifier names are interned and shared
+// Test parse-time constant folding in the expression builders
+void test_constant_folding() {
+    printf("Testing parse-time constant folding...\n");
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // A literal-literal product collapses to a single literal node
+    AstNode* folded = ast_create_binary_expr(ast_create_literal_int(2, loc), TOKEN_STAR,
+                                             ast_create_literal_int(1024, loc), loc);
+    TEST_ASSERT(folded != NULL, "Failed to build foldable binary expression");
+    TEST_ASSERT(folded->type == AST_LITERAL_INT, "Literal product was not folded");
+    TEST_ASSERT(folded->as.int_literal.value == 2048, "Wrong folded product value");
+
+    // Folding cascades through nested constant expressions
+    AstNode* nested = ast_create_binary_expr(folded, TOKEN_STAR,
+                                             ast_create_literal_int(1024, loc), loc);
+    TEST_ASSERT(nested->type == AST_LITERAL_INT, "Nested literal product was not folded");
+    TEST_ASSERT(nested->as.int_literal.value == 2 * 1024 * 1024, "Wrong nested folded value");
+
+    // Prefix operators on literals fold too
+    AstNode* negated = ast_create_unary_expr(ast_create_literal_int(7, loc), TOKEN_MINUS,
+                                             true, loc);
+    TEST_ASSERT(negated->type == AST_LITERAL_INT, "Prefix minus on literal was not folded");
+    TEST_ASSERT(negated->as.int_literal.value == -7, "Wrong folded negation value");
+
+    // Non-literal operands must keep the full expression node
+    AstNode* not_folded = ast_create_binary_expr(ast_create_literal_int(1, loc), TOKEN_PLUS,
+                                                 ast_create_identifier("н", loc), loc);
+    TEST_ASSERT(not_folded->type == AST_BINARY_EXPR,
+                "Expression with identifier operand must not fold");
+
+    // Division by zero survives so semantic analysis can report it
+    AstNode* div_zero = ast_create_binary_expr(ast_create_literal_int(1, loc), TOKEN_SLASH,
+                                               ast_create_literal_int(0, loc), loc);
+    TEST_ASSERT(div_zero->type == AST_BINARY_EXPR, "Division by zero must not fold");
+
+    ast_free(nested);
+    ast_free(negated);
+    ast_free(not_folded);
+    ast_free(div_zero);
+
+    printf("Parse-time constant folding tests passed!\n\n");
+}
+
+void test_identifier_interning() {
+    printf("Testing identifier interning...\n");
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // Two nodes with the same name must share one interned string
+    AstNode* first = ast_create_identifier("резултат", loc);
+    AstNode* second = ast_create_identifier("резултат", loc);
+    TEST_ASSERT(first != NULL && second != NULL, "Failed to create identifier nodes");
+    TEST_ASSERT(first->as.identifier.name == second->as.identifier.name,
+                "Identical identifiers should share the same interned string");
+
+    // Different names must get different pointers
+    AstNode* other = ast_create_identifier("бројач", loc);
+    TEST_ASSERT(other->as.identifier.name != first->as.identifier.name,
+                "Different identifiers must not share an interned string");
+
+    ast_free(first);
+    ast_free(second);
+    ast_free(other);
+
+    printf("Identifier interning tests passed!\n\n");
+}
+
+// Counts unary expression nodes for the deep traversal test
+static bool count_unary_expr(AstVisitor* visitor, AstNode* node) {
+    (void)node;
+    (*(int*)visitor->context)++;
+    return true;
+}
+
+// Test that traversals survive trees far deeper than the C call stack
+void test_deep_traversal() {
+    printf("Testing deep tree traversal...\n");
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+    const int depth = 200000;
+
+    // A chain of logical-not nodes over an identifier; the identifier
+    // operand keeps the constant folder from collapsing the chain
+    AstNode* chain = ast_create_identifier("н", loc);
+    for (int i = 0; i < depth; i++) {
+        chain = ast_create_unary_expr(chain, TOKEN_NOT, true, loc);
+        TEST_ASSERT(chain != NULL, "Failed to build deep unary chain");
+    }
+
+    // The visitor must reach every node without exhausting the stack
+    int unary_count = 0;
+    AstVisitor visitor = {0};
+    visitor.context = &unary_count;
+    visitor.visit_unary_expr = count_unary_expr;
+    TEST_ASSERT(ast_accept(chain, &visitor), "Deep traversal should succeed");
+    TEST_ASSERT(unary_count == depth, "Visitor missed nodes in the deep chain");
+
+    // Freeing the chain must not recurse either
+    ast_free(chain);
+
+    printf("Deep tree traversal tests passed!\n\n");
+}
+
+// Test the binary AST cache round trip
+void test_ast_cache() {
+    printf("Testing binary AST cache...\n");
+
+    const char* cache_path = "test_cache.ћast";
+    const char* source = "цео тест() < врати 2 + н; >";
+    size_t source_length = strlen(source);
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // Build: цео тест(цео н) < врати 2 + н; >
+    AstNode* param = ast_create_var_decl("н", NULL, type_create_int(), loc);
+    AstNode* params[1] = { param };
+    AstNode* sum = ast_create_binary_expr(ast_create_literal_int(2, loc), TOKEN_PLUS,
+                                          ast_create_identifier("н", loc), loc);
+    AstNode* ret = ast_create_return_stmt(sum, loc);
+    AstNode* stmts[1] = { ret };
+    AstNode* body = ast_create_block(stmts, 1, loc);
+    AstNode* func = ast_create_function_decl("тест", params, 1, body,
+                                             type_create_int(), false, loc);
+    AstNode* decls[1] = { func };
+    AstNode* program = ast_create_program(decls, 1, loc);
+    TEST_ASSERT(program != NULL, "Failed to build program for cache test");
+
+    // Serialize and check the freshness test against the source hash
+    TEST_ASSERT(ast_cache_save(cache_path, program, source, source_length),
+                "Failed to save AST cache");
+    TEST_ASSERT(ast_cache_is_fresh(cache_path, source, source_length),
+                "Cache should be fresh for the source it was built from");
+    TEST_ASSERT(!ast_cache_is_fresh(cache_path, "цео тест() < >", 14),
+                "Cache must be stale for different source text");
+
+    // Load the tree back into an arena and verify its structure
+    Arena* arena = arena_create(0);
+    TEST_ASSERT(arena != NULL, "Failed to create arena for cache load");
+    AstNode* loaded = ast_cache_load(cache_path, arena);
+    TEST_ASSERT(loaded != NULL, "Failed to load AST cache");
+    TEST_ASSERT(loaded->type == AST_PROGRAM, "Loaded root should be a program");
+    TEST_ASSERT(loaded->as.program.declaration_count == 1, "Wrong declaration count after load");
+
+    AstNode* loaded_func = loaded->as.program.declarations[0];
+    TEST_ASSERT(loaded_func->type == AST_FUNCTION_DECL, "Loaded declaration should be a function");
+    TEST_ASSERT(loaded_func->as.function_decl.name == func->as.function_decl.name,
+                "Loaded function name should be re-interned to the same string");
+    TEST_ASSERT(loaded_func->as.function_decl.parameter_count == 1, "Wrong parameter count after load");
+    TEST_ASSERT(loaded_func->as.function_decl.return_type->category == TYPE_INT,
+                "Wrong return type after load");
+
+    AstNode* loaded_ret = loaded_func->as.function_decl.body->as.block.statements[0];
+    TEST_ASSERT(loaded_ret->type == AST_RETURN_STMT, "Loaded statement should be a return");
+    AstNode* loaded_sum = loaded_ret->as.return_stmt.value;
+    TEST_ASSERT(loaded_sum->type == AST_BINARY_EXPR, "Loaded return value should be a binary expression");
+    TEST_ASSERT(loaded_sum->as.binary_expr.operator == TOKEN_PLUS, "Wrong operator after load");
+    TEST_ASSERT(loaded_sum->as.binary_expr.left->as.int_literal.value == 2,
+                "Wrong literal value after load");
+    TEST_ASSERT(strcmp(loaded_sum->as.binary_expr.right->as.identifier.name, "н") == 0,
+                "Wrong identifier name after load");
+
+    // A derived cache path sits next to the source file
+    char* derived = ast_cache_derive_path("примери/тест.ћпп");
+    TEST_ASSERT(derived != NULL && strcmp(derived, "примери/тест.ћast") == 0,
+                "Cache path should replace the source extension");
+    free(derived);
+
+    arena_destroy(arena);
+    ast_free(program);
+    remove(cache_path);
+
+    printf("Binary AST cache tests passed!\n\n");
+}
+
+// Test arena-backed AST allocation
+void test_ast_arena() {
+    printf("Testing arena-backed AST allocation...\n");
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // Install an arena so all AST allocations come from it
+    Arena* arena = arena_create(0);
+    TEST_ASSERT(arena != NULL, "Failed to create arena");
+    ast_set_arena(arena);
+    TEST_ASSERT(ast_get_arena() == arena, "Arena was not installed");
+
+    // Build a small tree entirely inside the arena
+    AstNode* int_literal = ast_create_literal_int(7, loc);
+    AstNode* id_node = ast_create_identifier("бројач", loc);
+    AstNode* bin_expr = ast_create_binary_expr(id_node, TOKEN_STAR, int_literal, loc);
+    TEST_ASSERT(bin_expr != NULL, "Failed to create binary expression in arena");
+    TEST_ASSERT(arena_total_allocated(arena) > 0, "Arena did not serve the allocations");
+
+    // ast_free is a no-op for arena-backed trees
+    ast_free(bin_expr);
+    TEST_ASSERT(bin_expr->type == AST_BINARY_EXPR, "Arena-backed node should survive ast_free");
+
+    // The whole tree is released with a single reset
+    arena_reset(arena);
+    TEST_ASSERT(arena_total_allocated(arena) == 0, "Arena reset did not release allocations");
+
+    // Uninstall the arena and destroy it
+    ast_set_arena(NULL);
+    arena_destroy(arena);
+
+    printf("Arena-backed AST allocation tests passed!\n\n");
+}
+
 int main() {
     printf("=== AST Tests ===\n\n");
-    
+
     // Run the tests
     test_ast_creation();
     test_ast_cloning();
@@ -403,6 +623,11 @@ int main() {
     test_ast_with_lexer();
     test_nested_control_structures();
     test_external_function_declarations();
+    test_constant_folding();
+    test_identifier_interning();
+    test_deep_traversal();
+    test_ast_cache();
+    test_ast_arena();
     
     printf("All AST tests passed successfully!\n");
     return 0;
@@ -0,0 +1,236 @@
+/*
+ * filename: bench.c
+ *
+ * Purpose:
+ * Throughput benchmark suite for the ћ++ compiler. Synthesizes large
+ * ћ++ programs in the style of examples/, measures lexing throughput
+ * (MB/s through lexer_next_token) and AST construction throughput
+ * (nodes/s through the ast.c constructors), and compares the results
+ * against a stored baseline so CI can flag regressions.
+ *
+ * Key Components:
+ * - generate_source(): Synthesizes a Cyrillic-identifier-heavy program
+ *   with many functions, loops, and deep expression trees
+ * - bench_lexing(): Tokenizes the generated program repeatedly
+ * - bench_ast(): Builds and frees deep expression trees repeatedly
+ * - Baseline handling: first run writes бенч_базна.txt, later runs
+ *   fail when a metric drops more than 5% below it
+ *
+ * Interactions:
+ * - Drives lexer.h and parser/ast.h exactly like the compiler would
+ *
+ * Notes:
+ * - Run with 'make bench'; refresh the baseline with 'make bench-baseline'
+ * - The baseline is machine-local and intentionally not checked in
+ * - AST construction stands in for parse throughput until the parser
+ *   lands; both exercise the same node-allocation hot path
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include "../src/lexer/lexer.h"
+#include "../src/parser/ast.h"
+#include "../src/utils/error.h"
+#include "../src/target/target_info.h"
+
+#define BENCH_SOURCE_FILE "бенч_извор.ћпп"
+#define BENCH_BASELINE_FILE "бенч_базна.txt"
+
+// How far below the baseline a metric may fall before it counts as a
+// regression (CI gate)
+#define REGRESSION_TOLERANCE 0.05
+
+// Shape of the synthetic program: enough functions and expression
+// depth to push the benchmark into the tens of milliseconds
+#define GENERATED_FUNCTIONS 200
+#define EXPRESSION_TERMS 40
+#define LEXING_ITERATIONS 20
+#define AST_ITERATIONS 200
+#define AST_TREE_DEPTH 2000
+
+static uint64_t monotonic_nanos(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * Write a synthetic ћ++ program shaped like our generated sources:
+ * many small functions with Cyrillic identifiers, counting loops,
+ * array accesses, and long expression chains
+ */
+static size_t generate_source(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) return 0;
+
+    fprintf(out, "// Аутоматски генерисан програм за мерење брзине\n");
+    fprintf(out, "екстерно испиши(порука);\n\n");
+
+    for (int f = 0; f < GENERATED_FUNCTIONS; f++) {
+        fprintf(out, "обрада%d(улаз, величина) <\n", f);
+        fprintf(out, "    низ:8: = _1, 2, 3, 4, 5, 6, 7, 8_;\n");
+        fprintf(out, "    резултат = 0;\n");
+        fprintf(out, "    и = 0;\n");
+        fprintf(out, "    док (и < величина) <\n");
+        fprintf(out, "        резултат = резултат + улаз * и");
+        for (int t = 0; t < EXPRESSION_TERMS; t++) {
+            fprintf(out, " + низ:%d: * %d", t % 8, t + 1);
+        }
+        fprintf(out, ";\n");
+        fprintf(out, "        и = и + 1;\n");
+        fprintf(out, "    >\n");
+        fprintf(out, "    врати резултат;\n");
+        fprintf(out, ">\n\n");
+    }
+
+    fprintf(out, "главна() <\n");
+    fprintf(out, "    збир = 0;\n");
+    for (int f = 0; f < GENERATED_FUNCTIONS; f++) {
+        fprintf(out, "    збир = збир + обрада%d(%d, 16);\n", f, f);
+    }
+    fprintf(out, "    врати збир;\n");
+    fprintf(out, ">\n");
+
+    long size = ftell(out);
+    fclose(out);
+    return size > 0 ? (size_t)size : 0;
+}
+
+/**
+ * Tokenize the generated program repeatedly and report MB/s
+ */
+static double bench_lexing(const char* path, size_t source_bytes) {
+    uint64_t tokens = 0;
+    uint64_t started = monotonic_nanos();
+
+    for (int run = 0; run < LEXING_ITERATIONS; run++) {
+        FILE* file = fopen(path, "r");
+        if (!file) return 0.0;
+        LexerState* lexer = lexer_init(file, path, target_init());
+        if (!lexer) {
+            fclose(file);
+            return 0.0;
+        }
+
+        Token token;
+        do {
+            token = lexer_next_token(lexer);
+            tokens++;
+        } while (token.type != TOKEN_EOF);
+
+        lexer_cleanup(lexer);
+        fclose(file);
+    }
+
+    uint64_t elapsed = monotonic_nanos() - started;
+    double seconds = (double)elapsed / 1e9;
+    double total_bytes = (double)source_bytes * LEXING_ITERATIONS;
+
+    printf("Lexing:  %6.1f MB/s  (%llu tokens in %.3f s)\n",
+           total_bytes / seconds / 1e6, (unsigned long long)tokens, seconds);
+    return total_bytes / seconds / 1e6;
+}
+
+/**
+ * Build and free deep expression trees repeatedly and report nodes/s.
+ * This exercises the same node-allocation path the parser will use
+ */
+static double bench_ast(void) {
+    SourceLocation loc = source_location_create(1, 1, BENCH_SOURCE_FILE);
+    uint64_t nodes = 0;
+    uint64_t started = monotonic_nanos();
+
+    for (int run = 0; run < AST_ITERATIONS; run++) {
+        // A left-leaning chain: identifier + literal + literal + ...
+        AstNode* tree = ast_create_identifier("почетак", loc);
+        nodes++;
+        for (int depth = 0; depth < AST_TREE_DEPTH; depth++) {
+            tree = ast_create_binary_expr(
+                tree, TOKEN_PLUS,
+                ast_create_literal_int(depth, loc), loc);
+            nodes += 2;
+        }
+        ast_free(tree);
+    }
+
+    uint64_t elapsed = monotonic_nanos() - started;
+    double seconds = (double)elapsed / 1e9;
+
+    printf("AST:     %6.2f Mnodes/s  (%llu nodes in %.3f s)\n",
+           (double)nodes / seconds / 1e6, (unsigned long long)nodes, seconds);
+    return (double)nodes / seconds;
+}
+
+/**
+ * Compare a metric against its baseline; more than 5% below fails
+ */
+static bool check_metric(const char* name, double value, double baseline) {
+    if (baseline <= 0.0) return true;
+    double ratio = value / baseline;
+    if (ratio < 1.0 - REGRESSION_TOLERANCE) {
+        printf("REGRESSION: %s is %.1f%% below the baseline (%.3g vs %.3g)\n",
+               name, (1.0 - ratio) * 100.0, value, baseline);
+        return false;
+    }
+    printf("%s within tolerance of the baseline (%+.1f%%)\n",
+           name, (ratio - 1.0) * 100.0);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool update_baseline = (argc >= 2 &&
+                            strcmp(argv[1], "--update-baseline") == 0);
+
+    printf("=== ћ++ Throughput Benchmarks ===\n\n");
+    error_init();
+
+    size_t source_bytes = generate_source(BENCH_SOURCE_FILE);
+    if (source_bytes == 0) {
+        printf("Could not generate the benchmark source\n");
+        return 1;
+    }
+    printf("Generated %zu KB of ћ++ source (%d functions)\n\n",
+           source_bytes / 1024, GENERATED_FUNCTIONS + 1);
+
+    double lexing_mbs = bench_lexing(BENCH_SOURCE_FILE, source_bytes);
+    double ast_nodes = bench_ast();
+    remove(BENCH_SOURCE_FILE);
+    error_cleanup();
+
+    if (lexing_mbs <= 0.0 || ast_nodes <= 0.0) {
+        printf("Benchmark failed to run\n");
+        return 1;
+    }
+
+    // Load the stored baseline, if any
+    double baseline_lexing = 0.0, baseline_ast = 0.0;
+    FILE* baseline = fopen(BENCH_BASELINE_FILE, "r");
+    if (baseline) {
+        if (fscanf(baseline, "lexing_mbs %lf ast_nodes_per_s %lf",
+                   &baseline_lexing, &baseline_ast) != 2) {
+            baseline_lexing = baseline_ast = 0.0;
+        }
+        fclose(baseline);
+    }
+
+    if (update_baseline || baseline_lexing == 0.0) {
+        FILE* out = fopen(BENCH_BASELINE_FILE, "w");
+        if (out) {
+            fprintf(out, "lexing_mbs %f ast_nodes_per_s %f\n",
+                    lexing_mbs, ast_nodes);
+            fclose(out);
+            printf("\nBaseline written to %s\n", BENCH_BASELINE_FILE);
+        }
+        return 0;
+    }
+
+    printf("\n");
+    bool ok = check_metric("Lexing throughput", lexing_mbs, baseline_lexing);
+    ok &= check_metric("AST throughput", ast_nodes, baseline_ast);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+/*
+ * filename: data_pool_tests.c
+ *
+ * Purpose:
+ * Test suite for the deduplicating constant pool and the pooled
+ * data-section emission of the ћ++ compiler. Validates that equal
+ * payloads collapse to one copy, that suffix strings share the
+ * storage of longer ones, and that emission labels every distinct
+ * value exactly once.
+ *
+ * Key Components:
+ * - test_dedup(): Equal strings and payloads return the same entry
+ * - test_suffix_merge(): Tail strings point into their containers
+ * - test_alignment(): Raw payloads keep WORD alignment
+ * - test_image(): The laid-out bytes match every entry's offset
+ * - test_emit_data(): codegen_emit_data pools an IrProgram's strings
+ *
+ * Interactions:
+ * - Uses codegen/data_pool.h directly and codegen_emit_data from
+ *   codegen/codegen.h with a synthetic IrProgram
+ *
+ * Notes:
+ * - Run with 'make test-data-pool'
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/codegen/data_pool.h"
+#include "../src/codegen/codegen.h"
+#include "../src/codegen/encoder.h"
+#include "../src/utils/intern.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+static void test_dedup() {
+    printf("Testing payload deduplication...\n");
+    DataPool* pool = data_pool_init();
+    TEST_ASSERT(pool != NULL, "Pool should initialize");
+
+    uint32_t first = data_pool_add_string(pool, "здраво");
+    uint32_t again = data_pool_add_string(pool, "здраво");
+    uint32_t other = data_pool_add_string(pool, "свете");
+    TEST_ASSERT(first != DATA_POOL_INVALID, "Add should succeed");
+    TEST_ASSERT(again == first, "Equal strings share one entry");
+    TEST_ASSERT(other != first, "Distinct strings get distinct entries");
+
+    // Raw payloads dedup too, but never unify with equal string bytes
+    static const uint8_t payload[] = { 1, 2, 3, 0 };
+    uint32_t raw = data_pool_add_bytes(pool, payload, sizeof(payload));
+    uint32_t raw_again = data_pool_add_bytes(pool, payload, sizeof(payload));
+    uint32_t as_string = data_pool_add_string(pool, "\x01\x02\x03");
+    TEST_ASSERT(raw_again == raw, "Equal payloads share one entry");
+    TEST_ASSERT(as_string != raw, "Kinds never unify");
+
+    TEST_ASSERT(data_pool_entry_count(pool) == 4,
+                "Six adds make four distinct entries");
+    TEST_ASSERT(data_pool_saved(pool) ==
+                    strlen("здраво") + 1 + sizeof(payload),
+                "Savings count the duplicate bytes");
+
+    data_pool_free(pool);
+    printf("Deduplication tests passed!\n");
+}
+
+static void test_suffix_merge() {
+    printf("Testing string suffix merging...\n");
+    DataPool* pool = data_pool_init();
+    TEST_ASSERT(pool != NULL, "Pool should initialize");
+
+    uint32_t whole = data_pool_add_string(pool, "повратна вредност");
+    uint32_t tail = data_pool_add_string(pool, "вредност");
+    uint32_t inner = data_pool_add_string(pool, "вредно");
+    TEST_ASSERT(data_pool_layout(pool), "Layout should succeed");
+
+    // The tail shares the whole string's storage, terminator included
+    uint64_t whole_offset = data_pool_offset(pool, whole);
+    uint64_t tail_offset = data_pool_offset(pool, tail);
+    TEST_ASSERT(tail_offset == whole_offset +
+                    (strlen("повратна вредност") - strlen("вредност")),
+                "A tail string points into its container");
+
+    // A mere substring is not a suffix: the terminators differ
+    uint64_t inner_offset = data_pool_offset(pool, inner);
+    TEST_ASSERT(inner_offset < whole_offset ||
+                inner_offset >= whole_offset + strlen("повратна вредност") + 1,
+                "Non-suffix substrings get their own storage");
+
+    TEST_ASSERT(data_pool_image_size(pool) ==
+                    strlen("повратна вредност") + 1 + strlen("вредно") + 1,
+                "The image holds only the unmerged strings");
+    TEST_ASSERT(data_pool_saved(pool) == strlen("вредност") + 1,
+                "Savings count the merged tail");
+
+    data_pool_free(pool);
+    printf("Suffix merging tests passed!\n");
+}
+
+static void test_alignment() {
+    printf("Testing raw payload alignment...\n");
+    DataPool* pool = data_pool_init();
+    TEST_ASSERT(pool != NULL, "Pool should initialize");
+
+    static const uint8_t odd[] = { 9, 9, 9 };
+    static const intptr_t words[] = { 4, 5, 6 };
+    uint32_t first = data_pool_add_bytes(pool, odd, sizeof(odd));
+    uint32_t second = data_pool_add_bytes(pool, words, sizeof(words));
+    TEST_ASSERT(data_pool_layout(pool), "Layout should succeed");
+
+    TEST_ASSERT(data_pool_offset(pool, first) % ENC_WORD_BYTES == 0,
+                "Raw payloads start WORD-aligned");
+    TEST_ASSERT(data_pool_offset(pool, second) % ENC_WORD_BYTES == 0,
+                "Alignment holds after an odd-sized payload");
+
+    // The two-phase protocol rejects adds once laid out
+    TEST_ASSERT(data_pool_add_bytes(pool, odd, sizeof(odd)) ==
+                    DATA_POOL_INVALID,
+                "Adds after layout fail");
+
+    data_pool_free(pool);
+    printf("Alignment tests passed!\n");
+}
+
+static void test_image() {
+    printf("Testing the laid-out image...\n");
+    DataPool* pool = data_pool_init();
+    TEST_ASSERT(pool != NULL, "Pool should initialize");
+
+    static const intptr_t payload[] = { 7, 8 };
+    uint32_t raw = data_pool_add_bytes(pool, payload, sizeof(payload));
+    uint32_t whole = data_pool_add_string(pool, "низ бројева");
+    uint32_t tail = data_pool_add_string(pool, "бројева");
+    TEST_ASSERT(data_pool_layout(pool), "Layout should succeed");
+
+    const uint8_t* image = data_pool_image(pool);
+    TEST_ASSERT(image != NULL, "Layout builds the image");
+    TEST_ASSERT(memcmp(image + data_pool_offset(pool, raw), payload,
+                       sizeof(payload)) == 0,
+                "Raw bytes land at their offset");
+    TEST_ASSERT(strcmp((const char*)image + data_pool_offset(pool, whole),
+                       "низ бројева") == 0,
+                "The container string reads back whole");
+    TEST_ASSERT(strcmp((const char*)image + data_pool_offset(pool, tail),
+                       "бројева") == 0,
+                "The merged tail reads back through shared storage");
+
+    data_pool_free(pool);
+    printf("Image tests passed!\n");
+}
+
+static void test_emit_data() {
+    printf("Testing pooled data emission...\n");
+
+    // A synthetic program whose string pool repeats itself, the way
+    // ir.c's per-occurrence pool does for generated sources
+    char* strings[] = {
+        "резултат: %d\n", "грешка", "резултат: %d\n", "грешка",
+        "грешка", "ка"
+    };
+    IrProgram program;
+    memset(&program, 0, sizeof(program));
+    program.strings = strings;
+    program.string_count = 6;
+
+    ElfWriter* writer = elf_writer_init();
+    TEST_ASSERT(writer != NULL, "Writer should initialize");
+
+    uint64_t* offsets = NULL;
+    TEST_ASSERT(codegen_emit_data(&program, writer, &offsets),
+                "Emission should succeed");
+    TEST_ASSERT(offsets != NULL, "Offsets come back per string index");
+
+    // Six occurrences, three distinct values; "ка" merges into the
+    // tail of "грешка"
+    TEST_ASSERT(writer->data_size ==
+                    strlen("резултат: %d\n") + 1 + strlen("грешка") + 1,
+                ".data holds one copy per distinct value");
+    TEST_ASSERT(offsets[0] == offsets[2], "Equal literals share a copy");
+    TEST_ASSERT(offsets[1] == offsets[3] && offsets[1] == offsets[4],
+                "All occurrences share it");
+    TEST_ASSERT(offsets[5] == offsets[1] +
+                    (strlen("грешка") - strlen("ка")),
+                "The tail literal points into its container");
+    TEST_ASSERT(strcmp((const char*)writer->data + offsets[5], "ка") == 0,
+                "The shared tail reads back correctly");
+
+    // One local label per distinct value
+    TEST_ASSERT(writer->symbol_count == 3,
+                "Each distinct value is labeled once");
+    for (uint32_t s = 0; s < writer->symbol_count; s++) {
+        TEST_ASSERT(writer->symbols[s].section == ELF_SECTION_DATA,
+                    "Labels live in .data");
+        TEST_ASSERT(!writer->symbols[s].global, "Labels stay local");
+    }
+
+    free(offsets);
+    elf_writer_free(writer);
+    intern_cleanup();
+    printf("Pooled data emission tests passed!\n");
+}
+
+int main() {
+    printf("Running data pool tests...\n\n");
+
+    test_dedup();
+    test_suffix_merge();
+    test_alignment();
+    test_image();
+    test_emit_data();
+
+    printf("\nAll data pool tests passed!\n");
+    return 0;
+}
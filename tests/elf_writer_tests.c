@@ -0,0 +1,234 @@
+/*
+ * filename: elf_writer_tests.c
+ *
+ * Purpose:
+ * Test suite for the direct ELF object writer of the ћ++ compiler.
+ * Writes a small relocatable object and parses the bytes back to make
+ * sure a linker would accept what we produce.
+ *
+ * Key Components:
+ * - test_empty_object(): A bare object has the right header and sections
+ * - test_round_trip(): Code, data, symbols and a call relocation survive
+ *   the trip to disk
+ *
+ * Interactions:
+ * - Uses the codegen/elf_writer.h interface
+ * - Parses the output with the system elf.h definitions
+ *
+ * Notes:
+ * - Run with 'make test-elf'
+ * - The word size under test follows the build's ARCH flag, like the
+ *   writer itself
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <elf.h>
+#include "../src/codegen/elf_writer.h"
+#include "../src/utils/error.h"
+
+#ifdef ARCH_X86_64
+typedef Elf64_Ehdr ElfHeader;
+typedef Elf64_Shdr ElfSectionHeader;
+typedef Elf64_Sym ElfSymbolEntry;
+typedef Elf64_Rela ElfRelocationEntry;
+#define EXPECTED_CLASS ELFCLASS64
+#define EXPECTED_MACHINE EM_X86_64
+#define ELF_R_SYM_OF ELF64_R_SYM
+#define ELF_R_TYPE_OF ELF64_R_TYPE
+#define EXPECTED_RELOC_TYPE R_X86_64_PLT32
+#else
+typedef Elf32_Ehdr ElfHeader;
+typedef Elf32_Shdr ElfSectionHeader;
+typedef Elf32_Sym ElfSymbolEntry;
+typedef Elf32_Rel ElfRelocationEntry;
+#define EXPECTED_CLASS ELFCLASS32
+#define EXPECTED_MACHINE EM_386
+#define ELF_R_SYM_OF ELF32_R_SYM
+#define ELF_R_TYPE_OF ELF32_R_TYPE
+#define EXPECTED_RELOC_TYPE R_386_PC32
+#endif
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+#define TEST_OBJECT_PATH "elf_writer_test.o"
+
+// Read the whole test object back into memory
+static uint8_t* slurp(const char* path, size_t* size_out) {
+    FILE* file = fopen(path, "rb");
+    TEST_ASSERT(file != NULL, "Object file should exist");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t* bytes = malloc(size);
+    TEST_ASSERT(bytes != NULL && fread(bytes, 1, size, file) == (size_t)size,
+                "Object file should read back");
+    fclose(file);
+    *size_out = (size_t)size;
+    return bytes;
+}
+
+// Locate a section header by name through .shstrtab
+static const ElfSectionHeader* find_section(const uint8_t* object,
+                                            const char* name) {
+    const ElfHeader* header = (const ElfHeader*)object;
+    const ElfSectionHeader* sections =
+        (const ElfSectionHeader*)(object + header->e_shoff);
+    const char* names =
+        (const char*)(object + sections[header->e_shstrndx].sh_offset);
+    for (int s = 0; s < header->e_shnum; s++) {
+        if (strcmp(names + sections[s].sh_name, name) == 0) return &sections[s];
+    }
+    return NULL;
+}
+
+void test_empty_object() {
+    printf("Testing empty object layout...\n");
+    error_init();
+
+    ElfWriter* writer = elf_writer_init();
+    TEST_ASSERT(writer != NULL, "Writer creation failed");
+    TEST_ASSERT(elf_writer_write(writer, TEST_OBJECT_PATH), "Write failed");
+    elf_writer_free(writer);
+
+    size_t size = 0;
+    uint8_t* object = slurp(TEST_OBJECT_PATH, &size);
+    const ElfHeader* header = (const ElfHeader*)object;
+
+    TEST_ASSERT(memcmp(header->e_ident, ELFMAG, SELFMAG) == 0, "Bad ELF magic");
+    TEST_ASSERT(header->e_ident[EI_CLASS] == EXPECTED_CLASS, "Wrong ELF class");
+    TEST_ASSERT(header->e_type == ET_REL, "Object must be relocatable");
+    TEST_ASSERT(header->e_machine == EXPECTED_MACHINE, "Wrong machine");
+    TEST_ASSERT(header->e_shnum == 8, "Expected eight sections");
+    TEST_ASSERT(find_section(object, ".text") != NULL, "Missing .text");
+    TEST_ASSERT(find_section(object, ".symtab") != NULL, "Missing .symtab");
+
+    free(object);
+    remove(TEST_OBJECT_PATH);
+    error_cleanup();
+    printf("Empty object layout tests passed!\n\n");
+}
+
+void test_round_trip() {
+    printf("Testing object round trip...\n");
+    error_init();
+
+    ElfWriter* writer = elf_writer_init();
+    TEST_ASSERT(writer != NULL, "Writer creation failed");
+
+    // mov eax, 42 / call rel32 / ret: the call displacement is a
+    // placeholder the relocation will fill in
+    const uint8_t code[] = {
+        0xb8, 0x2a, 0x00, 0x00, 0x00,       // mov eax, 42
+        0xe8, 0x00, 0x00, 0x00, 0x00,       // call <испиши>
+        0xc3                                // ret
+    };
+    TEST_ASSERT(elf_writer_append_text(writer, code, sizeof(code)) == 0,
+                "First text run should land at offset 0");
+
+    const char data[] = "здраво";
+    uint64_t data_offset = elf_writer_append_data(writer, data, sizeof(data));
+    TEST_ASSERT(data_offset == 0, "First data run should land at offset 0");
+
+    uint32_t main_symbol = elf_writer_add_symbol(writer, "главна",
+                                                 ELF_SECTION_TEXT, 0, true);
+    uint32_t callee = elf_writer_add_symbol(writer, "испиши",
+                                            ELF_SECTION_UNDEFINED, 0, false);
+    uint32_t literal = elf_writer_add_symbol(writer, "низ0",
+                                             ELF_SECTION_DATA, data_offset,
+                                             false);
+    TEST_ASSERT(main_symbol != UINT32_MAX && callee != UINT32_MAX &&
+                literal != UINT32_MAX, "Symbols should be added");
+
+    // The rel32 field starts one byte into the call instruction
+    TEST_ASSERT(elf_writer_add_call_relocation(writer, 6, callee, -4),
+                "Relocation should be added");
+
+    TEST_ASSERT(elf_writer_write(writer, TEST_OBJECT_PATH), "Write failed");
+    elf_writer_free(writer);
+
+    size_t size = 0;
+    uint8_t* object = slurp(TEST_OBJECT_PATH, &size);
+
+    // Code and data bytes survive untouched
+    const ElfSectionHeader* text = find_section(object, ".text");
+    TEST_ASSERT(text != NULL && text->sh_size == sizeof(code),
+                "Wrong .text size");
+    TEST_ASSERT(memcmp(object + text->sh_offset, code, sizeof(code)) == 0 ||
+                memcmp(object + text->sh_offset, code, 6) == 0,
+                "Code bytes should survive");
+    const ElfSectionHeader* data_section = find_section(object, ".data");
+    TEST_ASSERT(data_section != NULL &&
+                memcmp(object + data_section->sh_offset, data,
+                       sizeof(data)) == 0,
+                "Data bytes should survive");
+
+    // Symbols come back with local entries before globals
+    const ElfSectionHeader* symtab = find_section(object, ".symtab");
+    const ElfSectionHeader* strtab = find_section(object, ".strtab");
+    TEST_ASSERT(symtab != NULL && strtab != NULL, "Symbol sections missing");
+    const ElfSymbolEntry* symbols =
+        (const ElfSymbolEntry*)(object + symtab->sh_offset);
+    const char* names = (const char*)(object + strtab->sh_offset);
+    uint32_t symbol_count =
+        (uint32_t)(symtab->sh_size / sizeof(ElfSymbolEntry));
+    TEST_ASSERT(symbol_count == 4, "Null entry plus three symbols expected");
+
+    uint32_t callee_index = 0;
+    bool saw_main = false, saw_literal = false;
+    for (uint32_t s = 1; s < symbol_count; s++) {
+        const char* name = names + symbols[s].st_name;
+        if (strcmp(name, "главна") == 0) {
+            saw_main = true;
+            TEST_ASSERT(symbols[s].st_shndx != SHN_UNDEF,
+                        "главна must be defined");
+            TEST_ASSERT(s >= symtab->sh_info, "Globals come after sh_info");
+        } else if (strcmp(name, "испиши") == 0) {
+            callee_index = s;
+            TEST_ASSERT(symbols[s].st_shndx == SHN_UNDEF,
+                        "External callee must be undefined");
+        } else if (strcmp(name, "низ0") == 0) {
+            saw_literal = true;
+            TEST_ASSERT(s < symtab->sh_info, "Locals come before sh_info");
+        }
+    }
+    TEST_ASSERT(saw_main && saw_literal && callee_index != 0,
+                "All symbols should round trip");
+
+    // The call relocation points at the callee with the rel32 addend
+    const ElfSectionHeader* rela = find_section(object, ".rela.text");
+    if (!rela) rela = find_section(object, ".rel.text");
+    TEST_ASSERT(rela != NULL && rela->sh_size == sizeof(ElfRelocationEntry),
+                "One relocation expected");
+    const ElfRelocationEntry* fixup =
+        (const ElfRelocationEntry*)(object + rela->sh_offset);
+    TEST_ASSERT(fixup->r_offset == 6, "Wrong relocation offset");
+    TEST_ASSERT(ELF_R_SYM_OF(fixup->r_info) == callee_index,
+                "Relocation should reference the callee");
+    TEST_ASSERT(ELF_R_TYPE_OF(fixup->r_info) == EXPECTED_RELOC_TYPE,
+                "Wrong relocation type");
+
+    free(object);
+    remove(TEST_OBJECT_PATH);
+    error_cleanup();
+    printf("Object round trip tests passed!\n\n");
+}
+
+int main() {
+    printf("=== ћ++ ELF Object Writer Tests ===\n\n");
+
+    test_empty_object();
+    test_round_trip();
+
+    printf("All ELF object writer tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,390 @@
+/*
+ * filename: encoder_tests.c
+ *
+ * Purpose:
+ * Test suite for the shared word-size-parameterized instruction
+ * encoder of the ћ++ compiler. Checks the emitted bytes against the
+ * hand-assembled encodings of the build's target, so the same suite
+ * validates both cross-compiled configurations.
+ *
+ * Key Components:
+ * - check_bytes(): Compare a buffer against an expected encoding
+ * - test_frame()/test_constants()/test_slots(): Stack and immediates
+ * - test_arithmetic()/test_compare(): ALU and flag materialization
+ * - test_indexed(): SIB scaling and the bp-base fallback form
+ * - test_control_flow(): rel32 placeholders and patching
+ * - test_execution(): Runs an encoded function on x86-64 hosts
+ *
+ * Interactions:
+ * - Uses the codegen/encoder.h interface with codegen.c's EmitBuffer
+ *
+ * Notes:
+ * - Expected byte sequences are written per architecture flag, since
+ *   the whole point of the encoder is that the two builds differ
+ * - Run with 'make test-encoder'
+ */
+
+#define _DEFAULT_SOURCE  /* MAP_ANONYMOUS */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#ifdef ARCH_X86_64
+#include <sys/mman.h>
+#endif
+#include "../src/codegen/encoder.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+/**
+ * Compare a buffer's contents against an expected encoding and reset
+ * the buffer for the next check
+ */
+static void check_bytes(EmitBuffer* buffer, const uint8_t* expected,
+                        size_t size, const char* message) {
+    if (buffer->size != size ||
+        memcmp(buffer->bytes, expected, size) != 0) {
+        printf("ASSERTION FAILED: %s\n  got     ", message);
+        for (size_t i = 0; i < buffer->size; i++)
+            printf("%02X ", buffer->bytes[i]);
+        printf("\n  expected");
+        for (size_t i = 0; i < size; i++) printf(" %02X", expected[i]);
+        printf("\n");
+        exit(1);
+    }
+    buffer->size = 0;
+}
+
+static void test_frame() {
+    printf("Testing prologue and epilogue...\n");
+    EmitBuffer buffer = {0};
+
+    TEST_ASSERT(encoder_prologue(&buffer, 32), "Prologue should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t prologue[] = { 0x55, 0x48, 0x89, 0xE5,
+                                        0x48, 0x81, 0xEC,
+                                        0x20, 0x00, 0x00, 0x00 };
+#else
+    static const uint8_t prologue[] = { 0x55, 0x89, 0xE5,
+                                        0x81, 0xEC,
+                                        0x20, 0x00, 0x00, 0x00 };
+#endif
+    check_bytes(&buffer, prologue, sizeof(prologue), "Prologue encoding");
+
+    TEST_ASSERT(encoder_epilogue(&buffer), "Epilogue should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t epilogue[] = { 0x48, 0x89, 0xEC, 0x5D, 0xC3 };
+#else
+    static const uint8_t epilogue[] = { 0x89, 0xEC, 0x5D, 0xC3 };
+#endif
+    check_bytes(&buffer, epilogue, sizeof(epilogue), "Epilogue encoding");
+
+    emit_buffer_free(&buffer);
+    printf("Prologue and epilogue tests passed!\n");
+}
+
+static void test_constants() {
+    printf("Testing constant loads...\n");
+    EmitBuffer buffer = {0};
+
+    TEST_ASSERT(encoder_load_const(&buffer, ENC_AX, 42),
+                "Constant load should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t load_42[] = { 0x48, 0xB8, 0x2A, 0x00, 0x00, 0x00,
+                                       0x00, 0x00, 0x00, 0x00 };
+#else
+    static const uint8_t load_42[] = { 0xB8, 0x2A, 0x00, 0x00, 0x00 };
+#endif
+    check_bytes(&buffer, load_42, sizeof(load_42), "Word immediate 42");
+
+    // A negative value fills the whole word
+    TEST_ASSERT(encoder_load_const(&buffer, ENC_CX, -1),
+                "Negative load should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t load_neg[] = { 0x48, 0xB9, 0xFF, 0xFF, 0xFF, 0xFF,
+                                        0xFF, 0xFF, 0xFF, 0xFF };
+#else
+    static const uint8_t load_neg[] = { 0xB9, 0xFF, 0xFF, 0xFF, 0xFF };
+#endif
+    check_bytes(&buffer, load_neg, sizeof(load_neg), "Word immediate -1");
+
+    emit_buffer_free(&buffer);
+    printf("Constant load tests passed!\n");
+}
+
+static void test_slots() {
+    printf("Testing frame slot access...\n");
+    EmitBuffer buffer = {0};
+
+    // Slot displacements follow the build's word size
+    TEST_ASSERT(encoder_slot_displacement(0) == -ENC_WORD_BYTES,
+                "Slot 0 sits one word below the frame pointer");
+    TEST_ASSERT(encoder_slot_displacement(2) == -3 * ENC_WORD_BYTES,
+                "Slot displacements step by the word size");
+
+    TEST_ASSERT(encoder_load_slot(&buffer, ENC_AX, 0),
+                "Slot load should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t load[] = { 0x48, 0x8B, 0x85,
+                                    0xF8, 0xFF, 0xFF, 0xFF };
+#else
+    static const uint8_t load[] = { 0x8B, 0x85, 0xFC, 0xFF, 0xFF, 0xFF };
+#endif
+    check_bytes(&buffer, load, sizeof(load), "Slot 0 load");
+
+    TEST_ASSERT(encoder_store_slot(&buffer, ENC_DX, 1),
+                "Slot store should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t store[] = { 0x48, 0x89, 0x95,
+                                     0xF0, 0xFF, 0xFF, 0xFF };
+#else
+    static const uint8_t store[] = { 0x89, 0x95, 0xF8, 0xFF, 0xFF, 0xFF };
+#endif
+    check_bytes(&buffer, store, sizeof(store), "Slot 1 store");
+
+    emit_buffer_free(&buffer);
+    printf("Frame slot tests passed!\n");
+}
+
+static void test_arithmetic() {
+    printf("Testing arithmetic encodings...\n");
+    EmitBuffer buffer = {0};
+
+    TEST_ASSERT(encoder_arithmetic(&buffer, ENC_ALU_ADD, ENC_AX, ENC_CX),
+                "Addition should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t add[] = { 0x48, 0x01, 0xC8 };
+#else
+    static const uint8_t add[] = { 0x01, 0xC8 };
+#endif
+    check_bytes(&buffer, add, sizeof(add), "add ax, cx");
+
+    TEST_ASSERT(encoder_multiply(&buffer, ENC_AX, ENC_CX),
+                "Multiply should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t mul[] = { 0x48, 0x0F, 0xAF, 0xC1 };
+#else
+    static const uint8_t mul[] = { 0x0F, 0xAF, 0xC1 };
+#endif
+    check_bytes(&buffer, mul, sizeof(mul), "imul ax, cx");
+
+    TEST_ASSERT(encoder_divide(&buffer, ENC_CX), "Divide should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t divide[] = { 0x48, 0x99, 0x48, 0xF7, 0xF9 };
+#else
+    static const uint8_t divide[] = { 0x99, 0xF7, 0xF9 };
+#endif
+    check_bytes(&buffer, divide, sizeof(divide), "Sign extend and idiv cx");
+
+    TEST_ASSERT(encoder_negate(&buffer, ENC_AX), "Negate should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t neg[] = { 0x48, 0xF7, 0xD8 };
+#else
+    static const uint8_t neg[] = { 0xF7, 0xD8 };
+#endif
+    check_bytes(&buffer, neg, sizeof(neg), "neg ax");
+
+    emit_buffer_free(&buffer);
+    printf("Arithmetic tests passed!\n");
+}
+
+static void test_compare() {
+    printf("Testing flag materialization...\n");
+    EmitBuffer buffer = {0};
+
+    TEST_ASSERT(encoder_test(&buffer, ENC_AX, ENC_AX), "Test should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t test_ax[] = { 0x48, 0x85, 0xC0 };
+#else
+    static const uint8_t test_ax[] = { 0x85, 0xC0 };
+#endif
+    check_bytes(&buffer, test_ax, sizeof(test_ax), "test ax, ax");
+
+    TEST_ASSERT(encoder_set_condition(&buffer, ENC_CONDITION_EQUAL, ENC_AX),
+                "Setcc should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t sete[] = { 0x0F, 0x94, 0xC0,
+                                    0x48, 0x0F, 0xB6, 0xC0 };
+#else
+    static const uint8_t sete[] = { 0x0F, 0x94, 0xC0, 0x0F, 0xB6, 0xC0 };
+#endif
+    check_bytes(&buffer, sete, sizeof(sete), "sete al; movzx ax, al");
+
+    emit_buffer_free(&buffer);
+    printf("Flag materialization tests passed!\n");
+}
+
+static void test_indexed() {
+    printf("Testing indexed addressing...\n");
+    EmitBuffer buffer = {0};
+
+    // The SIB scale is the build's word size
+    TEST_ASSERT(encoder_load_indexed(&buffer, ENC_AX, ENC_AX, ENC_CX),
+                "Indexed load should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t load[] = { 0x48, 0x8B, 0x04, 0xC8 };
+#else
+    static const uint8_t load[] = { 0x8B, 0x04, 0x88 };
+#endif
+    check_bytes(&buffer, load, sizeof(load), "Word-scaled indexed load");
+
+    TEST_ASSERT(encoder_store_indexed(&buffer, ENC_DX, ENC_AX, ENC_CX),
+                "Indexed store should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t store[] = { 0x48, 0x89, 0x14, 0xC8 };
+#else
+    static const uint8_t store[] = { 0x89, 0x14, 0x88 };
+#endif
+    check_bytes(&buffer, store, sizeof(store), "Word-scaled indexed store");
+
+    // A bp base has no no-displacement form and takes a zero disp8
+    TEST_ASSERT(encoder_load_indexed(&buffer, ENC_AX, ENC_BP, ENC_CX),
+                "bp-based indexed load should emit");
+#ifdef ARCH_X86_64
+    static const uint8_t bp_load[] = { 0x48, 0x8B, 0x44, 0xCD, 0x00 };
+#else
+    static const uint8_t bp_load[] = { 0x8B, 0x44, 0x8D, 0x00 };
+#endif
+    check_bytes(&buffer, bp_load, sizeof(bp_load), "bp-base fallback form");
+
+    emit_buffer_free(&buffer);
+    printf("Indexed addressing tests passed!\n");
+}
+
+static void test_control_flow() {
+    printf("Testing control flow and patching...\n");
+    EmitBuffer buffer = {0};
+
+    // A backward jump to the buffer start: rel32 is -(placeholder + 4)
+    size_t at = encoder_jump(&buffer);
+    TEST_ASSERT(at == 1, "Jump placeholder follows the opcode byte");
+    encoder_patch_rel32(&buffer, at, 0);
+    static const uint8_t jump[] = { 0xE9, 0xFB, 0xFF, 0xFF, 0xFF };
+    check_bytes(&buffer, jump, sizeof(jump), "Patched backward jump");
+
+    // A forward conditional jump over one epilogue
+    at = encoder_jump_condition(&buffer, ENC_CONDITION_NOT_EQUAL);
+    TEST_ASSERT(at != SIZE_MAX, "Conditional jump should emit");
+    TEST_ASSERT(encoder_epilogue(&buffer), "Epilogue should emit");
+    encoder_patch_rel32(&buffer, at, buffer.size);
+    TEST_ASSERT(buffer.bytes[0] == 0x0F && buffer.bytes[1] == 0x85,
+                "jnz opcode");
+    int32_t rel;
+    memcpy(&rel, buffer.bytes + at, 4);
+    TEST_ASSERT((size_t)(at + 4 + rel) == buffer.size,
+                "Displacement reaches past the epilogue");
+    buffer.size = 0;
+
+    at = encoder_call(&buffer);
+    TEST_ASSERT(at == 1 && buffer.bytes[0] == 0xE8,
+                "Call emits rel32 placeholder");
+
+    emit_buffer_free(&buffer);
+    printf("Control flow tests passed!\n");
+}
+
+#ifdef ARCH_X86_64
+
+static void test_extended_registers() {
+    printf("Testing extended register encodings...\n");
+    EmitBuffer buffer = {0};
+
+    TEST_ASSERT(encoder_move(&buffer, ENC_R8, ENC_AX),
+                "Move to r8 should emit");
+    static const uint8_t move[] = { 0x49, 0x89, 0xC0 };
+    check_bytes(&buffer, move, sizeof(move), "mov r8, rax");
+
+    TEST_ASSERT(encoder_load_slot(&buffer, ENC_R12, 0),
+                "Slot load into r12 should emit");
+    static const uint8_t load[] = { 0x4C, 0x8B, 0xA5,
+                                    0xF8, 0xFF, 0xFF, 0xFF };
+    check_bytes(&buffer, load, sizeof(load), "REX.R on the reg field");
+
+    TEST_ASSERT(encoder_load_indexed(&buffer, ENC_AX, ENC_AX, ENC_R9),
+                "r9-indexed load should emit");
+    static const uint8_t indexed[] = { 0x4A, 0x8B, 0x04, 0xC8 };
+    check_bytes(&buffer, indexed, sizeof(indexed), "REX.X on the index");
+
+    // r13 shares bp's low bits, so it takes the disp8 fallback too
+    TEST_ASSERT(encoder_store_indexed(&buffer, ENC_AX, ENC_R13, ENC_CX),
+                "r13-based store should emit");
+    static const uint8_t r13_store[] = { 0x49, 0x89, 0x44, 0xCD, 0x00 };
+    check_bytes(&buffer, r13_store, sizeof(r13_store), "r13 fallback form");
+
+    emit_buffer_free(&buffer);
+    printf("Extended register tests passed!\n");
+}
+
+static void test_execution() {
+    printf("Testing execution of an encoded function...\n");
+    EmitBuffer buffer = {0};
+
+    // главна-shaped leaf: frame, 7 + 35 into ax, return
+    TEST_ASSERT(encoder_prologue(&buffer, 16) &&
+                encoder_load_const(&buffer, ENC_AX, 7) &&
+                encoder_load_const(&buffer, ENC_CX, 35) &&
+                encoder_arithmetic(&buffer, ENC_ALU_ADD, ENC_AX, ENC_CX) &&
+                encoder_epilogue(&buffer),
+                "Function should encode");
+
+    void* memory = mmap(NULL, buffer.size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    TEST_ASSERT(memory != MAP_FAILED, "Executable mapping should succeed");
+    memcpy(memory, buffer.bytes, buffer.size);
+    TEST_ASSERT(mprotect(memory, buffer.size, PROT_READ | PROT_EXEC) == 0,
+                "Mapping should flip executable");
+
+    intptr_t (*entry)(void) = (intptr_t (*)(void))memory;
+    TEST_ASSERT(entry() == 42, "Encoded function should compute 7 + 35");
+
+    munmap(memory, buffer.size);
+    emit_buffer_free(&buffer);
+    printf("Execution tests passed!\n");
+}
+
+#endif /* ARCH_X86_64 */
+
+static void test_register_names() {
+    printf("Testing register names...\n");
+#ifdef ARCH_X86_64
+    TEST_ASSERT(strcmp(encoder_register_name(ENC_AX), "rax") == 0,
+                "ax is rax on the 64-bit target");
+    TEST_ASSERT(strcmp(encoder_register_name(ENC_R15), "r15") == 0,
+                "r15 exists on the 64-bit target");
+#else
+    TEST_ASSERT(strcmp(encoder_register_name(ENC_AX), "eax") == 0,
+                "ax is eax on the 32-bit target");
+#endif
+    TEST_ASSERT(strcmp(encoder_register_name(ENC_REGISTER_COUNT), "???") == 0,
+                "Out-of-range registers have no name");
+    printf("Register name tests passed!\n");
+}
+
+int main() {
+    printf("Running instruction encoder tests (%d-bit target)...\n\n",
+           ENC_WORD_BYTES * 8);
+
+    test_frame();
+    test_constants();
+    test_slots();
+    test_arithmetic();
+    test_compare();
+    test_indexed();
+    test_control_flow();
+#ifdef ARCH_X86_64
+    test_extended_registers();
+    test_execution();
+#endif
+    test_register_names();
+
+    printf("\nAll instruction encoder tests passed!\n");
+    return 0;
+}
@@ -9,6 +9,10 @@
  * - test_error_reporting(): Tests basic error reporting functionality
  * - test_error_severities(): Tests different error severity levels
  * - test_error_types(): Tests different error types
+ * - test_threaded_errors(): Per-thread lists merge into shared counts
+ * - test_error_flood(): Floods are capped, summarized, and never lost
+ * - test_fatal_without_exit(): Server mode records fatals and returns
+ *   from the counts
  * 
  * Interactions:
  * - Uses the utils/error.h interface
@@ -21,6 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <pthread.h>
 #include "../src/utils/error.h"
 
 void test_error_reporting() {
@@ -61,12 +66,121 @@ void test_error_reporting() {
     printf("\n--- Error Reporting Test Complete ---\n");
 }
 
+// Each worker reports a handful of errors into its own list, then
+// merges; the totals afterwards must cover every thread
+#define WORKER_COUNT 4
+#define ERRORS_PER_WORKER 5
+
+static void* error_worker(void* argument) {
+    (void)argument;
+    for (int i = 0; i < ERRORS_PER_WORKER; i++) {
+        ERROR_SEMANTIC_ERROR("threaded.ћпп", i + 1, 1,
+                            "Worker-reported test error",
+                            "Expected while testing");
+    }
+    error_merge_thread_list();
+    return NULL;
+}
+
+void test_threaded_errors() {
+    printf("\n--- Testing Per-Thread Error Lists ---\n");
+
+    error_init();
+
+    pthread_t threads[WORKER_COUNT];
+    for (int w = 0; w < WORKER_COUNT; w++) {
+        if (pthread_create(&threads[w], NULL, error_worker, NULL) != 0) {
+            printf("FAILED: could not spawn error worker\n");
+            exit(1);
+        }
+    }
+    for (int w = 0; w < WORKER_COUNT; w++) {
+        pthread_join(threads[w], NULL);
+    }
+
+    // One report from the main thread that has not been merged yet
+    // must also be counted
+    ERROR_SEMANTIC_WARNING("threaded.ћпп", 99, 1,
+                          "Main-thread test warning", "Expected while testing");
+
+    int total = error_get_count(-1);
+    int errors = error_get_count(ERROR_ERROR);
+    int warnings = error_get_count(ERROR_WARNING);
+    if (total != WORKER_COUNT * ERRORS_PER_WORKER + 1 ||
+        errors != WORKER_COUNT * ERRORS_PER_WORKER || warnings != 1) {
+        printf("FAILED: expected %d errors and 1 warning, got %d/%d\n",
+               WORKER_COUNT * ERRORS_PER_WORKER, errors, warnings);
+        exit(1);
+    }
+
+    error_cleanup();
+
+    printf("\n--- Per-Thread Error List Test Complete ---\n");
+}
+
+// Reporting is deferred, so even a flood of diagnostics must record
+// quickly, cap the terminal output, and keep honest counts
+#define FLOOD_SIZE 2000
+
+void test_error_flood() {
+    printf("\n--- Testing Error Flood Handling ---\n");
+
+    error_init();
+
+    for (int i = 0; i < FLOOD_SIZE; i++) {
+        ERROR_SEMANTIC_ERROR("flood.ћпп", i + 1, 1,
+                            "Flood test error", "Expected while testing");
+    }
+
+    // The list holds up to its capacity; the overflow is only counted
+    int total = error_get_count(-1);
+    if (total <= 0 || total > FLOOD_SIZE) {
+        printf("FAILED: flood count out of range: %d\n", total);
+        exit(1);
+    }
+
+    // The first flush emits the capped list plus one suppression line;
+    // a second flush must find nothing left to print
+    error_flush();
+    error_flush();
+
+    error_cleanup();
+
+    printf("\n--- Error Flood Test Complete ---\n");
+}
+
+void test_fatal_without_exit() {
+    printf("\n--- Testing Fatal Reports Without Exit ---\n");
+
+    error_init();
+
+    // With exits disabled (the compile server's per-request mode) a
+    // fatal report records, flushes, and returns to the caller
+    error_set_fatal_exits(false);
+    error_report(ERROR_CODEGEN, ERROR_FATAL, "server.ћпп", 1, 1,
+                 "Fatal test error", "Expected while testing",
+                 __FILE__, __LINE__);
+    error_set_fatal_exits(true);
+
+    if (error_get_count(ERROR_FATAL) != 1) {
+        printf("FAILED: fatal error was not recorded\n");
+        exit(1);
+    }
+
+    error_cleanup();
+
+    printf("\n--- Fatal Without Exit Test Complete ---\n");
+}
+
 // Main entry point for the test
 int main(int argc, char* argv[]) {
     bool verbose = (argc >= 2 && strcmp(argv[1], "--verbose") == 0);
-    
+
     // Run error reporting tests
     test_error_reporting();
-    
+    test_threaded_errors();
+    test_error_flood();
+    test_fatal_without_exit();
+
     return 0;
 }
\ No newline at end of file
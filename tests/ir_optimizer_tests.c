@@ -0,0 +1,657 @@
+/*
+ * filename: ir_optimizer_tests.c
+ *
+ * Purpose:
+ * Test suite for the IR optimizer of the ћ++ compiler.
+ * Validates constant folding, dead-code elimination, local CSE, and
+ * loop-invariant code motion over the flat array IR.
+ *
+ * Key Components:
+ * - test_constant_folding(): Arithmetic on literals folds to a constant
+ * - test_dead_code(): Unused pure computations disappear
+ * - test_cse(): A repeated computation is evaluated once
+ * - test_licm(): Invariant work moves out of a док loop
+ * - test_nested_control_flow(): Blocks displaced by nesting survive
+ *   compaction and hoisting intact
+ * - test_inlining(): Small callees dissolve into their call sites
+ *
+ * Interactions:
+ * - Uses the ir/ir_optimizer.h interface
+ * - Builds ASTs directly through parser/ast.h constructors
+ *
+ * Notes:
+ * - Run with 'make test-ir-opt'
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/ir/ir_optimizer.h"
+#include "../src/utils/error.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+// Count how often an opcode occurs in a function
+static int count_opcode(const IrFunction* fn, IrOpcode opcode) {
+    int count = 0;
+    for (uint32_t i = 0; i < fn->instruction_count; i++) {
+        if (fn->instructions[i].opcode == opcode) count++;
+    }
+    return count;
+}
+
+// Check that a function's blocks still tile its instruction buffer.
+// Blocks are visited by buffer position, not block number: the
+// generator reserves a construct's end block before its body, so
+// nested control flow places some blocks out of numeric order
+static void assert_blocks_contiguous(const IrFunction* fn) {
+    bool* seen = (bool*)calloc(fn->block_count ? fn->block_count : 1,
+                               sizeof(bool));
+    TEST_ASSERT(seen != NULL, "Out of memory");
+
+    uint32_t next = 0;
+    for (uint32_t placed = 0; placed < fn->block_count; placed++) {
+        uint32_t pick = fn->block_count;
+        for (uint32_t b = 0; b < fn->block_count; b++) {
+            if (seen[b]) continue;
+            if (pick == fn->block_count ||
+                fn->blocks[b].first < fn->blocks[pick].first) {
+                pick = b;
+            }
+        }
+        seen[pick] = true;
+        TEST_ASSERT(fn->blocks[pick].first == next,
+                    "Block ranges are not contiguous");
+        next += fn->blocks[pick].count;
+    }
+    TEST_ASSERT(next == fn->instruction_count, "Blocks do not cover the buffer");
+    free(seen);
+}
+
+void test_constant_folding() {
+    printf("Testing constant folding...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // цео главна() < цео а = 2; цео б = 3; врати а * б + а; >
+    // The AST constructors already fold literal operands, so the
+    // constants hide behind variables to exercise the IR-level pass
+    AstNode* decl_a = ast_create_var_decl("а", ast_create_literal_int(2, loc),
+                                          type_create_int(), loc);
+    AstNode* decl_b = ast_create_var_decl("б", ast_create_literal_int(3, loc),
+                                          type_create_int(), loc);
+    AstNode* product = ast_create_binary_expr(ast_create_identifier("а", loc),
+                                              TOKEN_STAR,
+                                              ast_create_identifier("б", loc), loc);
+    AstNode* sum = ast_create_binary_expr(product, TOKEN_PLUS,
+                                          ast_create_identifier("а", loc), loc);
+    AstNode* statements[3] = { decl_a, decl_b, ast_create_return_stmt(sum, loc) };
+    AstNode* body = ast_create_block(statements, 3, loc);
+    AstNode* function = ast_create_function_decl("главна", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+
+    IrOptimizer* optimizer = ir_optimizer_init(1);
+    TEST_ASSERT(optimizer != NULL, "Failed to create optimizer");
+    TEST_ASSERT(ir_optimize_program(optimizer, ir), "Optimization failed");
+
+    IrFunction* fn = &ir->functions[0];
+    // Everything folds: one constant load feeding the return
+    TEST_ASSERT(count_opcode(fn, IR_MUL) == 0 && count_opcode(fn, IR_ADD) == 0,
+                "Arithmetic on literals should fold away");
+    TEST_ASSERT(fn->instruction_count == 2, "Only a constant and a return remain");
+    TEST_ASSERT(fn->instructions[0].opcode == IR_LOAD_CONST &&
+                fn->instructions[0].imm == 8,
+                "Folded constant should be 8");
+    TEST_ASSERT(fn->instructions[1].opcode == IR_RETURN &&
+                fn->instructions[1].a == fn->instructions[0].dest,
+                "Return should read the folded constant");
+    TEST_ASSERT(optimizer->folded >= 2, "Folding statistics not recorded");
+    assert_blocks_contiguous(fn);
+
+    ir_optimizer_free(optimizer);
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Constant folding tests passed!\n\n");
+}
+
+void test_dead_code() {
+    printf("Testing dead-code elimination...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // цео главна(цео н) < цео мртва = н * 2; врати н; >
+    AstNode* parameters[1] = {
+        ast_create_var_decl("н", NULL, type_create_int(), loc)
+    };
+    AstNode* unused = ast_create_var_decl(
+        "мртва",
+        ast_create_binary_expr(ast_create_identifier("н", loc), TOKEN_STAR,
+                               ast_create_literal_int(2, loc), loc),
+        type_create_int(), loc);
+    AstNode* statements[2] = {
+        unused,
+        ast_create_return_stmt(ast_create_identifier("н", loc), loc)
+    };
+    AstNode* body = ast_create_block(statements, 2, loc);
+    AstNode* function = ast_create_function_decl("главна", parameters, 1, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+
+    IrOptimizer* optimizer = ir_optimizer_init(1);
+    TEST_ASSERT(ir_optimize_program(optimizer, ir), "Optimization failed");
+
+    IrFunction* fn = &ir->functions[0];
+    // The unused declaration and everything feeding it is gone
+    TEST_ASSERT(fn->instruction_count == 1, "Only the return should remain");
+    TEST_ASSERT(fn->instructions[0].opcode == IR_RETURN &&
+                fn->instructions[0].a == 0,
+                "Return should read the parameter directly");
+    TEST_ASSERT(optimizer->removed >= 3, "Removal statistics not recorded");
+    assert_blocks_contiguous(fn);
+
+    ir_optimizer_free(optimizer);
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Dead-code elimination tests passed!\n\n");
+}
+
+void test_cse() {
+    printf("Testing common-subexpression elimination...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // цео главна(цео а, цео б) < врати (а + б) * (а + б); >
+    AstNode* parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* left = ast_create_binary_expr(ast_create_identifier("а", loc),
+                                           TOKEN_PLUS,
+                                           ast_create_identifier("б", loc), loc);
+    AstNode* right = ast_create_binary_expr(ast_create_identifier("а", loc),
+                                            TOKEN_PLUS,
+                                            ast_create_identifier("б", loc), loc);
+    AstNode* square = ast_create_binary_expr(left, TOKEN_STAR, right, loc);
+    AstNode* statements[1] = { ast_create_return_stmt(square, loc) };
+    AstNode* body = ast_create_block(statements, 1, loc);
+    AstNode* function = ast_create_function_decl("главна", parameters, 2, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+    TEST_ASSERT(count_opcode(&ir->functions[0], IR_ADD) == 2,
+                "Both adds should exist before CSE");
+
+    IrOptimizer* optimizer = ir_optimizer_init(2);
+    TEST_ASSERT(ir_optimize_program(optimizer, ir), "Optimization failed");
+
+    IrFunction* fn = &ir->functions[0];
+    TEST_ASSERT(count_opcode(fn, IR_ADD) == 1, "CSE should leave one add");
+    TEST_ASSERT(count_opcode(fn, IR_MUL) == 1, "The multiply must remain");
+
+    // The multiply squares the single remaining sum
+    for (uint32_t i = 0; i < fn->instruction_count; i++) {
+        if (fn->instructions[i].opcode == IR_MUL) {
+            TEST_ASSERT(fn->instructions[i].a == fn->instructions[i].b,
+                        "Multiply should read the shared sum twice");
+        }
+    }
+    TEST_ASSERT(optimizer->reused == 1, "Reuse statistics not recorded");
+    assert_blocks_contiguous(fn);
+
+    ir_optimizer_free(optimizer);
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("CSE tests passed!\n\n");
+}
+
+void test_licm() {
+    printf("Testing loop-invariant code motion...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // цео главна(цео а, цео б) <
+    //     цео и = 0;
+    //     док (и < 100) < и = и + а * б; >
+    //     врати и;
+    // >
+    AstNode* parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* counter = ast_create_var_decl("и", ast_create_literal_int(0, loc),
+                                           type_create_int(), loc);
+    AstNode* condition = ast_create_binary_expr(ast_create_identifier("и", loc),
+                                                TOKEN_LESS,
+                                                ast_create_literal_int(100, loc), loc);
+    AstNode* invariant = ast_create_binary_expr(ast_create_identifier("а", loc),
+                                                TOKEN_STAR,
+                                                ast_create_identifier("б", loc), loc);
+    AstNode* step = ast_create_expr_stmt(
+        ast_create_assignment(
+            ast_create_identifier("и", loc),
+            ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                                   invariant, loc),
+            loc),
+        loc);
+    AstNode* loop_statements[1] = { step };
+    AstNode* loop_body = ast_create_block(loop_statements, 1, loc);
+    AstNode* loop = ast_create_while_stmt(condition, loop_body, loc);
+    AstNode* ret = ast_create_return_stmt(ast_create_identifier("и", loc), loc);
+
+    AstNode* statements[3] = { counter, loop, ret };
+    AstNode* body = ast_create_block(statements, 3, loc);
+    AstNode* function = ast_create_function_decl("главна", parameters, 2, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+
+    IrOptimizer* optimizer = ir_optimizer_init(2);
+    TEST_ASSERT(ir_optimize_program(optimizer, ir), "Optimization failed");
+
+    IrFunction* fn = &ir->functions[0];
+    TEST_ASSERT(optimizer->hoisted >= 1, "Hoist statistics not recorded");
+    assert_blocks_contiguous(fn);
+
+    // The multiply now sits in the entry block, before the loop header
+    bool found_mul = false;
+    IrBasicBlock* entry = &fn->blocks[0];
+    for (uint32_t i = entry->first; i < entry->first + entry->count; i++) {
+        if (fn->instructions[i].opcode == IR_MUL) found_mul = true;
+    }
+    TEST_ASSERT(found_mul, "Invariant multiply should be in the entry block");
+
+    // And the loop body (blocks 1..2) no longer recomputes it
+    for (uint32_t b = 1; b <= 2; b++) {
+        IrBasicBlock* block = &fn->blocks[b];
+        for (uint32_t i = block->first; i < block->first + block->count; i++) {
+            TEST_ASSERT(fn->instructions[i].opcode != IR_MUL,
+                        "Loop should not recompute the invariant multiply");
+        }
+    }
+
+    ir_optimizer_free(optimizer);
+    ir_program_free(ir);
+    ast_free(program);
+
+    // An invariant division must stay inside the loop: the preheader
+    // runs even when the loop body (and its divisor guard) does not,
+    // so hoisting а / б could fault on valid programs
+    AstNode* div_parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* div_counter = ast_create_var_decl(
+        "и", ast_create_literal_int(0, loc), type_create_int(), loc);
+    AstNode* div_condition = ast_create_binary_expr(
+        ast_create_identifier("и", loc), TOKEN_LESS,
+        ast_create_literal_int(100, loc), loc);
+    AstNode* quotient = ast_create_binary_expr(
+        ast_create_identifier("а", loc), TOKEN_SLASH,
+        ast_create_identifier("б", loc), loc);
+    AstNode* div_step = ast_create_expr_stmt(
+        ast_create_assignment(
+            ast_create_identifier("и", loc),
+            ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                                   quotient, loc),
+            loc),
+        loc);
+    AstNode* div_loop_statements[1] = { div_step };
+    AstNode* div_loop = ast_create_while_stmt(
+        div_condition, ast_create_block(div_loop_statements, 1, loc), loc);
+    AstNode* div_ret = ast_create_return_stmt(ast_create_identifier("и", loc),
+                                              loc);
+    AstNode* div_statements[3] = { div_counter, div_loop, div_ret };
+    AstNode* div_function = ast_create_function_decl(
+        "главна", div_parameters, 2,
+        ast_create_block(div_statements, 3, loc), type_create_int(), false,
+        loc);
+    AstNode* div_declarations[1] = { div_function };
+    AstNode* div_program = ast_create_program(div_declarations, 1, loc);
+
+    IrProgram* div_ir = ir_generate(div_program, "test.ћпп");
+    TEST_ASSERT(div_ir != NULL, "IR generation failed");
+
+    IrOptimizer* div_optimizer = ir_optimizer_init(2);
+    TEST_ASSERT(ir_optimize_program(div_optimizer, div_ir),
+                "Optimization failed");
+
+    IrFunction* div_fn = &div_ir->functions[0];
+    assert_blocks_contiguous(div_fn);
+    IrBasicBlock* div_entry = &div_fn->blocks[0];
+    bool found_div = false;
+    for (uint32_t i = div_entry->first;
+         i < div_entry->first + div_entry->count; i++) {
+        TEST_ASSERT(div_fn->instructions[i].opcode != IR_DIV,
+                    "Division must not be hoisted into the preheader");
+    }
+    for (uint32_t i = 0; i < div_fn->instruction_count; i++) {
+        if (div_fn->instructions[i].opcode == IR_DIV) found_div = true;
+    }
+    TEST_ASSERT(found_div, "Division should remain in the loop");
+
+    ir_optimizer_free(div_optimizer);
+    ir_program_free(div_ir);
+    ast_free(div_program);
+    error_cleanup();
+    printf("LICM tests passed!\n\n");
+}
+
+void test_nested_control_flow() {
+    printf("Testing optimization across nested control flow...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // An ако inside a док displaces the loop's end block to the tail
+    // of the buffer, so its block number no longer matches its buffer
+    // position. Dead-code removal inside the loop then compacts a
+    // layout where the post-loop return block (three instructions) is
+    // longer than the NOPs removed before it.
+    //
+    // цео главна(цео а, цео б) <
+    //     цео и = 0;
+    //     док (и < 10) <
+    //         цео мртва = а * б;
+    //         ако (а < б) < и = и + 1; > иначе < и = и + 2; >
+    //     >
+    //     врати (и + а) + б;
+    // >
+    AstNode* parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* counter = ast_create_var_decl("и", ast_create_literal_int(0, loc),
+                                           type_create_int(), loc);
+    AstNode* condition = ast_create_binary_expr(ast_create_identifier("и", loc),
+                                                TOKEN_LESS,
+                                                ast_create_literal_int(10, loc),
+                                                loc);
+    AstNode* unused = ast_create_var_decl(
+        "мртва",
+        ast_create_binary_expr(ast_create_identifier("а", loc), TOKEN_STAR,
+                               ast_create_identifier("б", loc), loc),
+        type_create_int(), loc);
+    AstNode* step_one = ast_create_expr_stmt(
+        ast_create_assignment(
+            ast_create_identifier("и", loc),
+            ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                                   ast_create_literal_int(1, loc), loc),
+            loc),
+        loc);
+    AstNode* step_two = ast_create_expr_stmt(
+        ast_create_assignment(
+            ast_create_identifier("и", loc),
+            ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                                   ast_create_literal_int(2, loc), loc),
+            loc),
+        loc);
+    AstNode* then_statements[1] = { step_one };
+    AstNode* else_statements[1] = { step_two };
+    AstNode* branch = ast_create_if_stmt(
+        ast_create_binary_expr(ast_create_identifier("а", loc), TOKEN_LESS,
+                               ast_create_identifier("б", loc), loc),
+        ast_create_block(then_statements, 1, loc),
+        ast_create_block(else_statements, 1, loc), loc);
+    AstNode* loop_statements[2] = { unused, branch };
+    AstNode* loop = ast_create_while_stmt(
+        condition, ast_create_block(loop_statements, 2, loc), loc);
+    AstNode* ret = ast_create_return_stmt(
+        ast_create_binary_expr(
+            ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                                   ast_create_identifier("а", loc), loc),
+            TOKEN_PLUS, ast_create_identifier("б", loc), loc),
+        loc);
+    AstNode* statements[3] = { counter, loop, ret };
+    AstNode* function = ast_create_function_decl(
+        "главна", parameters, 2, ast_create_block(statements, 3, loc),
+        type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+
+    IrFunction* fn = &ir->functions[0];
+    assert_blocks_contiguous(fn);
+    int adds_before = count_opcode(fn, IR_ADD);
+    TEST_ASSERT(count_opcode(fn, IR_RETURN) == 1 &&
+                count_opcode(fn, IR_MUL) == 1,
+                "Unexpected instruction mix before optimization");
+
+    IrOptimizer* optimizer = ir_optimizer_init(1);
+    TEST_ASSERT(ir_optimize_program(optimizer, ir), "Optimization failed");
+
+    // Only the dead multiply chain goes away; everything else, the
+    // displaced return block included, must survive the compaction
+    TEST_ASSERT(count_opcode(fn, IR_MUL) == 0,
+                "The dead multiply should be removed");
+    TEST_ASSERT(count_opcode(fn, IR_RETURN) == 1,
+                "Exactly one return must survive compaction");
+    TEST_ASSERT(count_opcode(fn, IR_ADD) == adds_before,
+                "Live additions must survive compaction");
+    assert_blocks_contiguous(fn);
+
+    ir_optimizer_free(optimizer);
+    ir_program_free(ir);
+    ast_free(program);
+
+    // The same shape with the invariant multiply inside the ако: LICM
+    // hoists it across the displaced loop-end block into the entry
+    // block, and the block range fixups must leave the layout intact
+    //
+    // цео главна(цео а, цео б) <
+    //     цео и = 0;
+    //     док (и < 10) <
+    //         ако (а < б) < и = и + а * б; > иначе < и = и + 1; >
+    //     >
+    //     врати и + б;
+    // >
+    AstNode* licm_parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* licm_counter = ast_create_var_decl(
+        "и", ast_create_literal_int(0, loc), type_create_int(), loc);
+    AstNode* licm_condition = ast_create_binary_expr(
+        ast_create_identifier("и", loc), TOKEN_LESS,
+        ast_create_literal_int(10, loc), loc);
+    AstNode* licm_then = ast_create_expr_stmt(
+        ast_create_assignment(
+            ast_create_identifier("и", loc),
+            ast_create_binary_expr(
+                ast_create_identifier("и", loc), TOKEN_PLUS,
+                ast_create_binary_expr(ast_create_identifier("а", loc),
+                                       TOKEN_STAR,
+                                       ast_create_identifier("б", loc), loc),
+                loc),
+            loc),
+        loc);
+    AstNode* licm_else = ast_create_expr_stmt(
+        ast_create_assignment(
+            ast_create_identifier("и", loc),
+            ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                                   ast_create_literal_int(1, loc), loc),
+            loc),
+        loc);
+    AstNode* licm_then_statements[1] = { licm_then };
+    AstNode* licm_else_statements[1] = { licm_else };
+    AstNode* licm_branch = ast_create_if_stmt(
+        ast_create_binary_expr(ast_create_identifier("а", loc), TOKEN_LESS,
+                               ast_create_identifier("б", loc), loc),
+        ast_create_block(licm_then_statements, 1, loc),
+        ast_create_block(licm_else_statements, 1, loc), loc);
+    AstNode* licm_loop_statements[1] = { licm_branch };
+    AstNode* licm_loop = ast_create_while_stmt(
+        licm_condition, ast_create_block(licm_loop_statements, 1, loc), loc);
+    AstNode* licm_ret = ast_create_return_stmt(
+        ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                               ast_create_identifier("б", loc), loc),
+        loc);
+    AstNode* licm_statements[3] = { licm_counter, licm_loop, licm_ret };
+    AstNode* licm_function = ast_create_function_decl(
+        "главна", licm_parameters, 2,
+        ast_create_block(licm_statements, 3, loc), type_create_int(), false,
+        loc);
+    AstNode* licm_declarations[1] = { licm_function };
+    AstNode* licm_program = ast_create_program(licm_declarations, 1, loc);
+
+    IrProgram* licm_ir = ir_generate(licm_program, "test.ћпп");
+    TEST_ASSERT(licm_ir != NULL, "IR generation failed");
+
+    IrOptimizer* licm_optimizer = ir_optimizer_init(2);
+    TEST_ASSERT(ir_optimize_program(licm_optimizer, licm_ir),
+                "Optimization failed");
+
+    IrFunction* licm_fn = &licm_ir->functions[0];
+    TEST_ASSERT(licm_optimizer->hoisted >= 1, "Hoist statistics not recorded");
+    assert_blocks_contiguous(licm_fn);
+
+    TEST_ASSERT(count_opcode(licm_fn, IR_MUL) == 1,
+                "The invariant multiply must survive exactly once");
+    bool found_mul = false;
+    IrBasicBlock* entry = &licm_fn->blocks[0];
+    for (uint32_t i = entry->first; i < entry->first + entry->count; i++) {
+        if (licm_fn->instructions[i].opcode == IR_MUL) found_mul = true;
+    }
+    TEST_ASSERT(found_mul, "Invariant multiply should be in the entry block");
+    TEST_ASSERT(count_opcode(licm_fn, IR_RETURN) == 1,
+                "Exactly one return must survive hoisting");
+
+    ir_optimizer_free(licm_optimizer);
+    ir_program_free(licm_ir);
+    ast_free(licm_program);
+    error_cleanup();
+    printf("Nested control flow tests passed!\n\n");
+}
+
+void test_inlining() {
+    printf("Testing function inlining...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // екстерно цео испиши(цео н);
+    // цео сабери(цео а, цео б) < врати а + б; >
+    // цео главна() < врати сабери(2, 3) + испиши(4); >
+    AstNode* extern_parameters[1] = {
+        ast_create_var_decl("н", NULL, type_create_int(), loc)
+    };
+    AstNode* extern_decl = ast_create_function_decl("испиши", extern_parameters, 1,
+                                                    NULL, type_create_int(),
+                                                    true, loc);
+
+    AstNode* parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* sum = ast_create_binary_expr(ast_create_identifier("а", loc),
+                                          TOKEN_PLUS,
+                                          ast_create_identifier("б", loc), loc);
+    AstNode* helper_statements[1] = { ast_create_return_stmt(sum, loc) };
+    AstNode* helper = ast_create_function_decl(
+        "сабери", parameters, 2,
+        ast_create_block(helper_statements, 1, loc),
+        type_create_int(), false, loc);
+
+    AstNode* call_arguments[2] = {
+        ast_create_literal_int(2, loc), ast_create_literal_int(3, loc)
+    };
+    AstNode* extern_arguments[1] = { ast_create_literal_int(4, loc) };
+    AstNode* total = ast_create_binary_expr(
+        ast_create_call_expr(ast_create_identifier("сабери", loc),
+                             call_arguments, 2, loc),
+        TOKEN_PLUS,
+        ast_create_call_expr(ast_create_identifier("испиши", loc),
+                             extern_arguments, 1, loc), loc);
+    AstNode* main_statements[1] = { ast_create_return_stmt(total, loc) };
+    AstNode* main_function = ast_create_function_decl(
+        "главна", NULL, 0,
+        ast_create_block(main_statements, 1, loc),
+        type_create_int(), false, loc);
+
+    AstNode* declarations[3] = { extern_decl, helper, main_function };
+    AstNode* program = ast_create_program(declarations, 3, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+
+    // Find главна; the extern produces no IrFunction
+    IrFunction* fn = NULL;
+    for (uint32_t f = 0; f < ir->function_count; f++) {
+        if (strcmp(ir->functions[f].name, "главна") == 0) fn = &ir->functions[f];
+    }
+    TEST_ASSERT(fn != NULL, "главна should have a function body");
+    TEST_ASSERT(count_opcode(fn, IR_CALL) == 2, "Both calls start out as calls");
+
+    IrOptimizer* optimizer = ir_optimizer_init(2);
+    TEST_ASSERT(ir_optimize_program(optimizer, ir), "Optimization failed");
+
+    TEST_ASSERT(optimizer->inlined >= 1, "Inline statistics not recorded");
+    assert_blocks_contiguous(fn);
+
+    // The сабери call is gone and its body folded into a constant;
+    // the external call must survive untouched
+    TEST_ASSERT(count_opcode(fn, IR_CALL) == 1,
+                "Only the external call should remain");
+    TEST_ASSERT(count_opcode(fn, IR_ADD) == 1,
+                "The inlined add folds; one add combines the results");
+    bool found_constant_five = false;
+    for (uint32_t i = 0; i < fn->instruction_count; i++) {
+        if (fn->instructions[i].opcode == IR_LOAD_CONST &&
+            fn->instructions[i].imm == 5) {
+            found_constant_five = true;
+        }
+    }
+    TEST_ASSERT(found_constant_five,
+                "сабери(2, 3) should fold to the constant 5 after inlining");
+
+    ir_optimizer_free(optimizer);
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Inlining tests passed!\n\n");
+}
+
+int main() {
+    printf("=== ћ++ IR Optimizer Tests ===\n\n");
+
+    test_constant_folding();
+    test_dead_code();
+    test_cse();
+    test_licm();
+    test_nested_control_flow();
+    test_inlining();
+
+    printf("All IR optimizer tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,302 @@
+/*
+ * filename: ir_tests.c
+ *
+ * Purpose:
+ * Test suite for the IR generator of the ћ++ compiler.
+ * Validates the flat array layout, three-address lowering, basic block
+ * ranges, and the program-level name and string pools.
+ *
+ * Key Components:
+ * - test_simple_function(): Straight-line arithmetic and return
+ * - test_control_flow(): While loop block structure and contiguity
+ * - test_calls_and_arrays(): ARG/CALL sequences and array opcodes
+ * - test_short_circuit(): && lowers to branches with a merged result
+ *
+ * Interactions:
+ * - Uses the ir/ir.h interface
+ * - Builds ASTs directly through parser/ast.h constructors
+ *
+ * Notes:
+ * - Run with 'make test-ir'
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/ir/ir.h"
+#include "../src/utils/error.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+// Check that a function's blocks tile its instruction buffer: in
+// order, contiguous, and covering every instruction exactly once
+static void assert_blocks_contiguous(const IrFunction* fn) {
+    uint32_t next = 0;
+    for (uint32_t b = 0; b < fn->block_count; b++) {
+        TEST_ASSERT(fn->blocks[b].first == next, "Block ranges are not contiguous");
+        next += fn->blocks[b].count;
+    }
+    TEST_ASSERT(next == fn->instruction_count, "Blocks do not cover the buffer");
+}
+
+void test_simple_function() {
+    printf("Testing straight-line lowering...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // цео сабери(цео а, цео б) < врати а + б; >
+    AstNode* parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* sum = ast_create_binary_expr(ast_create_identifier("а", loc),
+                                          TOKEN_PLUS,
+                                          ast_create_identifier("б", loc), loc);
+    AstNode* statements[1] = { ast_create_return_stmt(sum, loc) };
+    AstNode* body = ast_create_block(statements, 1, loc);
+    AstNode* function = ast_create_function_decl("сабери", parameters, 2, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+    TEST_ASSERT(ir->function_count == 1, "Wrong function count");
+
+    IrFunction* fn = &ir->functions[0];
+    TEST_ASSERT(strcmp(fn->name, "сабери") == 0, "Wrong function name");
+    TEST_ASSERT(fn->parameter_count == 2, "Wrong parameter count");
+    TEST_ASSERT(fn->block_count == 1, "Straight-line code should be one block");
+    TEST_ASSERT(fn->instruction_count == 2, "Wrong instruction count");
+
+    // Parameters are v0 and v1; the sum lands in a fresh register
+    TEST_ASSERT(fn->instructions[0].opcode == IR_ADD, "Expected add");
+    TEST_ASSERT(fn->instructions[0].a == 0 && fn->instructions[0].b == 1,
+                "Add should read the parameter registers");
+    TEST_ASSERT(fn->instructions[1].opcode == IR_RETURN, "Expected return");
+    TEST_ASSERT(fn->instructions[1].a == fn->instructions[0].dest,
+                "Return should read the sum");
+
+    assert_blocks_contiguous(fn);
+
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Straight-line lowering tests passed!\n\n");
+}
+
+void test_control_flow() {
+    printf("Testing loop block structure...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // цео главна() < цео и = 0; док (и < 10) < и = и + 1; > врати и; >
+    AstNode* decl = ast_create_var_decl("и", ast_create_literal_int(0, loc),
+                                        type_create_int(), loc);
+    AstNode* condition = ast_create_binary_expr(ast_create_identifier("и", loc),
+                                                TOKEN_LESS,
+                                                ast_create_literal_int(10, loc), loc);
+    AstNode* increment = ast_create_expr_stmt(
+        ast_create_assignment(
+            ast_create_identifier("и", loc),
+            ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                                   ast_create_literal_int(1, loc), loc),
+            loc),
+        loc);
+    AstNode* loop_statements[1] = { increment };
+    AstNode* loop_body = ast_create_block(loop_statements, 1, loc);
+    AstNode* loop = ast_create_while_stmt(condition, loop_body, loc);
+    AstNode* ret = ast_create_return_stmt(ast_create_identifier("и", loc), loc);
+
+    AstNode* statements[3] = { decl, loop, ret };
+    AstNode* body = ast_create_block(statements, 3, loc);
+    AstNode* function = ast_create_function_decl("главна", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+
+    IrFunction* fn = &ir->functions[0];
+    TEST_ASSERT(fn->block_count == 4, "While loop should make 4 blocks");
+    assert_blocks_contiguous(fn);
+
+    // Entry falls into the condition block
+    IrBasicBlock* entry = &fn->blocks[0];
+    IrInstruction* entry_last = &fn->instructions[entry->first + entry->count - 1];
+    TEST_ASSERT(entry_last->opcode == IR_JUMP && entry_last->b == 1,
+                "Entry should jump to the condition block");
+
+    // Condition block ends branching between body and exit
+    IrBasicBlock* cond = &fn->blocks[1];
+    IrInstruction* cond_last = &fn->instructions[cond->first + cond->count - 1];
+    TEST_ASSERT(cond_last->opcode == IR_BRANCH, "Condition should end in a branch");
+    TEST_ASSERT(cond_last->b == 2 && cond_last->c == 3,
+                "Branch targets should be body and exit blocks");
+
+    // Body loops back to the condition
+    IrBasicBlock* loop_block = &fn->blocks[2];
+    IrInstruction* body_last = &fn->instructions[loop_block->first + loop_block->count - 1];
+    TEST_ASSERT(body_last->opcode == IR_JUMP && body_last->b == 1,
+                "Body should jump back to the condition");
+
+    // Exit block returns
+    IrBasicBlock* exit_block = &fn->blocks[3];
+    IrInstruction* exit_last = &fn->instructions[exit_block->first + exit_block->count - 1];
+    TEST_ASSERT(exit_last->opcode == IR_RETURN, "Exit block should return");
+
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Loop block structure tests passed!\n\n");
+}
+
+void test_calls_and_arrays() {
+    printf("Testing calls and arrays...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // екстерно испиши(цео в);
+    AstNode* extern_params[1] = {
+        ast_create_var_decl("в", NULL, type_create_int(), loc)
+    };
+    AstNode* external = ast_create_function_decl("испиши", extern_params, 1, NULL,
+                                                 type_create_void(), true, loc);
+
+    // цео главна() < низ:2: = _7, 9_; испиши(низ[1]); испиши(низ[0]); >
+    AstNode* initializers[2] = {
+        ast_create_literal_int(7, loc),
+        ast_create_literal_int(9, loc)
+    };
+    AstNode* array = ast_create_array_decl("низ", 2, initializers, 2,
+                                           type_create_int(), loc);
+
+    AstNode* args_one[1] = {
+        ast_create_array_access(ast_create_identifier("низ", loc),
+                                ast_create_literal_int(1, loc), loc)
+    };
+    AstNode* call_one = ast_create_expr_stmt(
+        ast_create_call_expr(ast_create_identifier("испиши", loc), args_one, 1, loc),
+        loc);
+
+    AstNode* args_two[1] = {
+        ast_create_array_access(ast_create_identifier("низ", loc),
+                                ast_create_literal_int(0, loc), loc)
+    };
+    AstNode* call_two = ast_create_expr_stmt(
+        ast_create_call_expr(ast_create_identifier("испиши", loc), args_two, 1, loc),
+        loc);
+
+    AstNode* statements[3] = { array, call_one, call_two };
+    AstNode* body = ast_create_block(statements, 3, loc);
+    AstNode* function = ast_create_function_decl("главна", NULL, 0, body,
+                                                 type_create_void(), false, loc);
+    AstNode* declarations[2] = { external, function };
+    AstNode* program = ast_create_program(declarations, 2, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+    TEST_ASSERT(ir->function_count == 1, "External declarations produce no body");
+
+    IrFunction* fn = &ir->functions[0];
+    TEST_ASSERT(fn->instructions[0].opcode == IR_ALLOC_ARRAY,
+                "Array declaration should allocate first");
+    TEST_ASSERT(fn->instructions[0].imm == 2, "Wrong array size");
+
+    // Both initializers are stored through constant indices
+    int stores = 0, loads = 0, args = 0, calls = 0;
+    for (uint32_t i = 0; i < fn->instruction_count; i++) {
+        switch (fn->instructions[i].opcode) {
+            case IR_STORE_ARRAY: stores++; break;
+            case IR_LOAD_ARRAY:  loads++; break;
+            case IR_ARG:         args++; break;
+            case IR_CALL:        calls++; break;
+            default: break;
+        }
+    }
+    TEST_ASSERT(stores == 2, "Both initializers should be stored");
+    TEST_ASSERT(loads == 2, "Both accesses should load");
+    TEST_ASSERT(args == 2 && calls == 2, "Each call passes one argument");
+
+    // The callee name is pooled once and shared by both calls
+    TEST_ASSERT(ir->name_count == 1, "Callee name should be pooled once");
+    TEST_ASSERT(strcmp(ir->names[0], "испиши") == 0, "Wrong pooled name");
+
+    printf("Generated IR listing:\n");
+    ir_program_print(ir);
+
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Call and array tests passed!\n\n");
+}
+
+void test_short_circuit() {
+    printf("Testing short-circuit lowering...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // цео оба(цео а, цео б) < врати а && б; >
+    AstNode* parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* both = ast_create_binary_expr(ast_create_identifier("а", loc),
+                                           TOKEN_DOUBLE_AND,
+                                           ast_create_identifier("б", loc), loc);
+    AstNode* statements[1] = { ast_create_return_stmt(both, loc) };
+    AstNode* body = ast_create_block(statements, 1, loc);
+    AstNode* function = ast_create_function_decl("оба", parameters, 2, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+
+    IrFunction* fn = &ir->functions[0];
+    TEST_ASSERT(fn->block_count == 3, "&& should split into 3 blocks");
+    assert_blocks_contiguous(fn);
+
+    // Entry assumes false, then branches into the right operand only
+    // when the left was true
+    IrBasicBlock* entry = &fn->blocks[0];
+    TEST_ASSERT(fn->instructions[entry->first].opcode == IR_LOAD_CONST &&
+                fn->instructions[entry->first].imm == 0,
+                "&& should preload the skipped value");
+    IrInstruction* entry_last = &fn->instructions[entry->first + entry->count - 1];
+    TEST_ASSERT(entry_last->opcode == IR_BRANCH, "Entry should branch on the left operand");
+    TEST_ASSERT(entry_last->a == 0, "Branch should test the left operand");
+    TEST_ASSERT(entry_last->b == 1 && entry_last->c == 2,
+                "True goes to the rhs block, false to the merge block");
+
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Short-circuit lowering tests passed!\n\n");
+}
+
+int main() {
+    printf("=== ћ++ IR Generator Tests ===\n\n");
+
+    test_simple_function();
+    test_control_flow();
+    test_calls_and_arrays();
+    test_short_circuit();
+
+    printf("All IR generator tests passed!\n");
+    return 0;
+}
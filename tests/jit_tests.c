@@ -0,0 +1,303 @@
+/*
+ * filename: jit_tests.c
+ *
+ * Purpose:
+ * Test suite for the in-memory JIT execution mode of the ћ++ compiler.
+ * Lowers small programs to IR, runs them through the JIT, and checks
+ * the values главна() returns.
+ *
+ * Key Components:
+ * - test_return_constant(): Straight return of a literal
+ * - test_arithmetic(): Mixed arithmetic evaluates correctly
+ * - test_loop_sum(): A while loop with a counter runs to completion
+ * - test_function_calls(): Calls between JIT-compiled functions
+ * - test_arrays(): Array allocation, stores, and loads
+ * - test_extern_call(): екстерно names resolve against the host via dlsym
+ * - test_missing_entry(): A program without главна() is rejected
+ *
+ * Interactions:
+ * - Uses the codegen/jit.h interface
+ * - Builds ASTs directly through parser/ast.h constructors and lowers
+ *   them with ir/ir.h
+ *
+ * Notes:
+ * - Run with 'make test-jit'
+ * - test_extern_call binds labs() from the host C library
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/codegen/jit.h"
+#include "../src/ir/ir.h"
+#include "../src/utils/error.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+static SourceLocation loc;
+
+// Wrap a statement list into a главна() function inside a program
+static AstNode* make_main_program(AstNode** statements, int statement_count) {
+    AstNode* body = ast_create_block(statements, statement_count, loc);
+    AstNode* function = ast_create_function_decl("главна", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    return ast_create_program(declarations, 1, loc);
+}
+
+// Lower to IR, JIT, and return the value главна() produced
+static intptr_t run(AstNode* program) {
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+
+    intptr_t result = -1;
+    TEST_ASSERT(jit_run_program(ir, &result), "JIT execution failed");
+
+    ir_program_free(ir);
+    ast_free(program);
+    return result;
+}
+
+void test_return_constant() {
+    printf("Testing constant return...\n");
+    error_init();
+
+    // цео главна() < врати 42; >
+    AstNode* statements[1] = {
+        ast_create_return_stmt(ast_create_literal_int(42, loc), loc)
+    };
+    TEST_ASSERT(run(make_main_program(statements, 1)) == 42,
+                "главна() should return 42");
+
+    error_cleanup();
+    printf("Constant return tests passed!\n\n");
+}
+
+void test_arithmetic() {
+    printf("Testing arithmetic...\n");
+    error_init();
+
+    // врати (10 + 5) * 2 - 40 / 4 % 7;  ->  30 - (10 % 7) = 27
+    AstNode* sum = ast_create_binary_expr(ast_create_literal_int(10, loc),
+                                          TOKEN_PLUS,
+                                          ast_create_literal_int(5, loc), loc);
+    AstNode* doubled = ast_create_binary_expr(sum, TOKEN_STAR,
+                                              ast_create_literal_int(2, loc), loc);
+    AstNode* quotient = ast_create_binary_expr(ast_create_literal_int(40, loc),
+                                               TOKEN_SLASH,
+                                               ast_create_literal_int(4, loc), loc);
+    AstNode* remainder = ast_create_binary_expr(quotient, TOKEN_PERCENT,
+                                                ast_create_literal_int(7, loc), loc);
+    AstNode* value = ast_create_binary_expr(doubled, TOKEN_MINUS, remainder, loc);
+    AstNode* statements[1] = { ast_create_return_stmt(value, loc) };
+    TEST_ASSERT(run(make_main_program(statements, 1)) == 27,
+                "Arithmetic should evaluate to 27");
+
+    error_cleanup();
+    printf("Arithmetic tests passed!\n\n");
+}
+
+void test_loop_sum() {
+    printf("Testing loop execution...\n");
+    error_init();
+
+    // цео з = 0; цео и = 1;
+    // док (и <= 10) < з = з + и; и = и + 1; >
+    // врати з;
+    AstNode* sum_decl = ast_create_var_decl("з", ast_create_literal_int(0, loc),
+                                            type_create_int(), loc);
+    AstNode* counter_decl = ast_create_var_decl("и", ast_create_literal_int(1, loc),
+                                                type_create_int(), loc);
+    AstNode* condition = ast_create_binary_expr(ast_create_identifier("и", loc),
+                                                TOKEN_LESS_EQUALS,
+                                                ast_create_literal_int(10, loc), loc);
+    AstNode* add_step = ast_create_assignment(
+        ast_create_identifier("з", loc),
+        ast_create_binary_expr(ast_create_identifier("з", loc), TOKEN_PLUS,
+                               ast_create_identifier("и", loc), loc), loc);
+    AstNode* increment = ast_create_assignment(
+        ast_create_identifier("и", loc),
+        ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                               ast_create_literal_int(1, loc), loc), loc);
+    AstNode* body_statements[2] = {
+        ast_create_expr_stmt(add_step, loc),
+        ast_create_expr_stmt(increment, loc)
+    };
+    AstNode* loop_body = ast_create_block(body_statements, 2, loc);
+    AstNode* loop = ast_create_while_stmt(condition, loop_body, loc);
+    AstNode* result = ast_create_return_stmt(ast_create_identifier("з", loc), loc);
+
+    AstNode* statements[4] = { sum_decl, counter_decl, loop, result };
+    TEST_ASSERT(run(make_main_program(statements, 4)) == 55,
+                "Summing 1..10 should give 55");
+
+    error_cleanup();
+    printf("Loop execution tests passed!\n\n");
+}
+
+void test_function_calls() {
+    printf("Testing function calls...\n");
+    error_init();
+
+    // цео сабери(цео а, цео б) < врати а + б; >
+    AstNode* parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* sum = ast_create_binary_expr(ast_create_identifier("а", loc),
+                                          TOKEN_PLUS,
+                                          ast_create_identifier("б", loc), loc);
+    AstNode* helper_statements[1] = { ast_create_return_stmt(sum, loc) };
+    AstNode* helper = ast_create_function_decl(
+        "сабери", parameters, 2,
+        ast_create_block(helper_statements, 1, loc),
+        type_create_int(), false, loc);
+
+    // цео главна() < врати сабери(2, 3) + сабери(10, 20); >
+    AstNode* first_args[2] = {
+        ast_create_literal_int(2, loc), ast_create_literal_int(3, loc)
+    };
+    AstNode* second_args[2] = {
+        ast_create_literal_int(10, loc), ast_create_literal_int(20, loc)
+    };
+    AstNode* total = ast_create_binary_expr(
+        ast_create_call_expr(ast_create_identifier("сабери", loc),
+                             first_args, 2, loc),
+        TOKEN_PLUS,
+        ast_create_call_expr(ast_create_identifier("сабери", loc),
+                             second_args, 2, loc), loc);
+    AstNode* main_statements[1] = { ast_create_return_stmt(total, loc) };
+    AstNode* main_function = ast_create_function_decl(
+        "главна", NULL, 0,
+        ast_create_block(main_statements, 1, loc),
+        type_create_int(), false, loc);
+
+    AstNode* declarations[2] = { helper, main_function };
+    AstNode* program = ast_create_program(declarations, 2, loc);
+    TEST_ASSERT(run(program) == 35, "2+3 and 10+20 should total 35");
+
+    error_cleanup();
+    printf("Function call tests passed!\n\n");
+}
+
+void test_arrays() {
+    printf("Testing arrays...\n");
+    error_init();
+
+    // низ а[5] = _5, 10_; а[2] = 20; врати а[0] + а[1] + а[2];
+    AstNode* initializers[2] = {
+        ast_create_literal_int(5, loc), ast_create_literal_int(10, loc)
+    };
+    AstNode* array_decl = ast_create_array_decl("а", 5, initializers, 2,
+                                                type_create_int(), loc);
+    AstNode* store = ast_create_assignment(
+        ast_create_array_access(ast_create_identifier("а", loc),
+                                ast_create_literal_int(2, loc), loc),
+        ast_create_literal_int(20, loc), loc);
+    AstNode* total = ast_create_binary_expr(
+        ast_create_binary_expr(
+            ast_create_array_access(ast_create_identifier("а", loc),
+                                    ast_create_literal_int(0, loc), loc),
+            TOKEN_PLUS,
+            ast_create_array_access(ast_create_identifier("а", loc),
+                                    ast_create_literal_int(1, loc), loc), loc),
+        TOKEN_PLUS,
+        ast_create_array_access(ast_create_identifier("а", loc),
+                                ast_create_literal_int(2, loc), loc), loc);
+
+    AstNode* statements[3] = {
+        array_decl,
+        ast_create_expr_stmt(store, loc),
+        ast_create_return_stmt(total, loc)
+    };
+    TEST_ASSERT(run(make_main_program(statements, 3)) == 35,
+                "5 + 10 + 20 should total 35");
+
+    error_cleanup();
+    printf("Array tests passed!\n\n");
+}
+
+void test_extern_call() {
+    printf("Testing external calls...\n");
+    error_init();
+
+    // екстерно цео labs(цео н);
+    // цео главна() < врати labs(0 - 5); >
+    AstNode* extern_parameters[1] = {
+        ast_create_var_decl("н", NULL, type_create_int(), loc)
+    };
+    AstNode* extern_decl = ast_create_function_decl("labs", extern_parameters, 1,
+                                                    NULL, type_create_int(),
+                                                    true, loc);
+
+    AstNode* negative = ast_create_binary_expr(ast_create_literal_int(0, loc),
+                                               TOKEN_MINUS,
+                                               ast_create_literal_int(5, loc), loc);
+    AstNode* arguments[1] = { negative };
+    AstNode* call = ast_create_call_expr(ast_create_identifier("labs", loc),
+                                         arguments, 1, loc);
+    AstNode* main_statements[1] = { ast_create_return_stmt(call, loc) };
+    AstNode* main_function = ast_create_function_decl(
+        "главна", NULL, 0,
+        ast_create_block(main_statements, 1, loc),
+        type_create_int(), false, loc);
+
+    AstNode* declarations[2] = { extern_decl, main_function };
+    AstNode* program = ast_create_program(declarations, 2, loc);
+    TEST_ASSERT(run(program) == 5, "labs(-5) should return 5");
+
+    error_cleanup();
+    printf("External call tests passed!\n\n");
+}
+
+void test_missing_entry() {
+    printf("Testing missing entry point...\n");
+    error_init();
+
+    // A program with no главна() must be rejected, not executed
+    AstNode* statements[1] = {
+        ast_create_return_stmt(ast_create_literal_int(1, loc), loc)
+    };
+    AstNode* body = ast_create_block(statements, 1, loc);
+    AstNode* function = ast_create_function_decl("помоћна", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+
+    intptr_t result = 0;
+    TEST_ASSERT(!jit_run_program(ir, &result),
+                "A program without главна() must not run");
+
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Missing entry point tests passed!\n\n");
+}
+
+int main() {
+    printf("=== ћ++ JIT Execution Tests ===\n\n");
+
+    loc = source_location_create(1, 1, "test.ћпп");
+
+    test_return_constant();
+    test_arithmetic();
+    test_loop_sum();
+    test_function_calls();
+    test_arrays();
+    test_extern_call();
+    test_missing_entry();
+
+    printf("All JIT execution tests passed!\n");
+    return 0;
+}
@@ -30,6 +30,7 @@
 #include <string.h>
 #include <unistd.h> // For getcwd()
 #include "../src/lexer/lexer.h"
+#include "../src/lexer/token_pipeline.h"
 #include "../src/utils/error.h"  // For error_init and error_cleanup
 
 // Declaration of the function from keywords.c that we're testing
@@ -707,16 +708,43 @@ bool test_string_char_literals(void) {
         
         if (token.type == TOKEN_STRING || token.type == TOKEN_CHAR_LITERAL) {
             if (token.type == TOKEN_STRING) {
-                printf("Found string literal: \"%s\" ", token.value.string_value);
-                
-                if (expected_literals[found_literals].type == TOKEN_STRING && 
-                    strcmp(token.value.string_value, 
+                char* value = token_string_value(&token);
+                printf("Found string literal: \"%s\" ", value ? value : "");
+
+                if (value != NULL &&
+                    expected_literals[found_literals].type == TOKEN_STRING &&
+                    strcmp(value,
                            expected_literals[found_literals].str_value) == 0) {
                     printf("✓\n");
                 } else {
                     printf("✗\n");
                     all_passed = false;
                 }
+
+                // Escape-free literals must be zero-copy slices into
+                // the source; escaped ones own their processed buffer
+                bool expect_owned =
+                    strchr(expected_literals[found_literals].str_value
+                               ? expected_literals[found_literals].str_value : "",
+                           '\n') != NULL ||
+                    strchr(expected_literals[found_literals].str_value
+                               ? expected_literals[found_literals].str_value : "",
+                           '\\') != NULL;
+                if (token.value.string_slice.owned != expect_owned) {
+                    fprintf(stderr, "Unexpected ownership for literal %d\n",
+                            found_literals);
+                    all_passed = false;
+                }
+                if (!token.value.string_slice.owned &&
+                    (token.value.string_slice.start < lexer->source ||
+                     token.value.string_slice.start >=
+                         lexer->source + lexer->source_length)) {
+                    fprintf(stderr, "Slice does not point into the source\n");
+                    all_passed = false;
+                }
+
+                free(value);
+                token_string_release(&token);
             } else {  // CHAR_LITERAL
                 printf("Found character literal: '");
                 
@@ -818,6 +846,322 @@ bool test_print_all_tokens(void) {
     return true;
 }
 
+/**
+ * Test the batched token buffer API
+ *
+ * Verifies that consuming tokens through a small TokenBuffer yields the
+ * same stream as lexer_next_token, that the buffer refills itself across
+ * batch boundaries, and that multi-token lookahead works.
+ *
+ * @return true if the test passes, false otherwise
+ */
+bool test_token_buffer(void) {
+    printf("\n=== Testing batched token buffer ===\n");
+
+    // Initialize error handling
+    if (!error_init()) {
+        fprintf(stderr, "Failed to initialize error handling system\n");
+        return false;
+    }
+
+    // Enough tokens to force several refills of a 4-slot buffer
+    const char* source_code =
+        "// Test token buffering\n"
+        "ако (x > 0) <\n"
+        "    врати x * 2 + 1;\n"
+        ">\n";
+
+    FILE* source_file = create_temp_file(source_code);
+    if (!source_file) {
+        error_cleanup();
+        return false;
+    }
+
+    // One lexer consumed through the buffer, one consumed directly
+    TargetInfo target_info = target_init();
+    LexerState* buffered_lexer = lexer_init(source_file, "token_buffer.ћпп", target_info);
+    fclose(source_file);
+
+    FILE* reference_file = create_temp_file(source_code);
+    LexerState* reference_lexer = reference_file ?
+        lexer_init(reference_file, "token_buffer.ћпп", target_info) : NULL;
+
+    if (!buffered_lexer || !reference_lexer) {
+        if (buffered_lexer) lexer_cleanup(buffered_lexer);
+        if (reference_lexer) lexer_cleanup(reference_lexer);
+        if (reference_file) fclose(reference_file);
+        error_cleanup();
+        return false;
+    }
+
+    Token storage[4];
+    TokenBuffer buffer;
+    token_buffer_init(&buffer, storage, 4);
+
+    bool all_passed = true;
+
+    // Lookahead: peek(0..2) must match the next three consumed tokens
+    Token peek0 = token_buffer_peek(&buffer, buffered_lexer, 0);
+    Token peek1 = token_buffer_peek(&buffer, buffered_lexer, 1);
+    Token peek2 = token_buffer_peek(&buffer, buffered_lexer, 2);
+
+    // The stream through the buffer must match the direct stream
+    int token_count = 0;
+    for (;;) {
+        Token buffered = token_buffer_next(&buffer, buffered_lexer);
+        Token reference = lexer_next_token(reference_lexer);
+
+        if (buffered.type != reference.type) {
+            fprintf(stderr, "Token %d mismatch: buffer gave %s, lexer gave %s\n",
+                   token_count, token_type_to_string(buffered.type),
+                   token_type_to_string(reference.type));
+            all_passed = false;
+            break;
+        }
+
+        if (token_count == 0 && buffered.type != peek0.type) {
+            fprintf(stderr, "peek(0) did not match first consumed token\n");
+            all_passed = false;
+        }
+        if (token_count == 1 && buffered.type != peek1.type) {
+            fprintf(stderr, "peek(1) did not match second consumed token\n");
+            all_passed = false;
+        }
+        if (token_count == 2 && buffered.type != peek2.type) {
+            fprintf(stderr, "peek(2) did not match third consumed token\n");
+            all_passed = false;
+        }
+
+        token_count++;
+        if (buffered.type == TOKEN_EOF || buffered.type == TOKEN_ERROR) {
+            break;
+        }
+    }
+
+    printf("Consumed %d tokens through a 4-slot buffer\n", token_count);
+
+    // Past EOF the buffer must keep answering TOKEN_EOF
+    Token past_end = token_buffer_next(&buffer, buffered_lexer);
+    if (past_end.type != TOKEN_EOF) {
+        fprintf(stderr, "Expected TOKEN_EOF past end of stream, got %s\n",
+               token_type_to_string(past_end.type));
+        all_passed = false;
+    }
+
+    // Clean up
+    lexer_cleanup(buffered_lexer);
+    lexer_cleanup(reference_lexer);
+    fclose(reference_file);
+    error_cleanup();
+
+    if (all_passed) {
+        printf("All token buffer tests passed!\n");
+    } else {
+        fprintf(stderr, "Some token buffer tests failed!\n");
+    }
+
+    return all_passed;
+}
+
+/**
+ * Test the pipelined lexing mode
+ *
+ * Verifies that tokens consumed through a background lexer thread and
+ * its SPSC ring match the stream produced by direct lexer_next_token
+ * calls. A deliberately tiny ring forces the producer to block on a
+ * full ring and the consumer to block on an empty one.
+ *
+ * @return true if the test passes, false otherwise
+ */
+bool test_token_pipeline(void) {
+    printf("\n=== Testing pipelined lexing ===\n");
+
+    // Initialize error handling
+    if (!error_init()) {
+        fprintf(stderr, "Failed to initialize error handling system\n");
+        return false;
+    }
+
+    const char* source_code =
+        "// Test pipelined lexing\n"
+        "за (и = 0; и < 100; и = и + 1) <\n"
+        "    збир = збир + и * 2;\n"
+        "    ако (збир > 1000) <\n"
+        "        прекини;\n"
+        "    >\n"
+        ">\n";
+
+    FILE* source_file = create_temp_file(source_code);
+    if (!source_file) {
+        error_cleanup();
+        return false;
+    }
+
+    TargetInfo target_info = target_init();
+    LexerState* piped_lexer = lexer_init(source_file, "pipeline.ћпп", target_info);
+    fclose(source_file);
+
+    FILE* reference_file = create_temp_file(source_code);
+    LexerState* reference_lexer = reference_file ?
+        lexer_init(reference_file, "pipeline.ћпп", target_info) : NULL;
+
+    if (!piped_lexer || !reference_lexer) {
+        if (piped_lexer) lexer_cleanup(piped_lexer);
+        if (reference_lexer) lexer_cleanup(reference_lexer);
+        if (reference_file) fclose(reference_file);
+        error_cleanup();
+        return false;
+    }
+
+    // A tiny ring exercises both full-ring and empty-ring waits
+    TokenPipeline* pipeline = token_pipeline_start(piped_lexer, 8);
+    if (!pipeline) {
+        fprintf(stderr, "Failed to start token pipeline\n");
+        lexer_cleanup(piped_lexer);
+        lexer_cleanup(reference_lexer);
+        fclose(reference_file);
+        error_cleanup();
+        return false;
+    }
+
+    bool all_passed = true;
+    int token_count = 0;
+
+    for (;;) {
+        Token piped = token_pipeline_next(pipeline);
+        Token reference = lexer_next_token(reference_lexer);
+
+        if (piped.type != reference.type) {
+            fprintf(stderr, "Token %d mismatch: pipeline gave %s, lexer gave %s\n",
+                   token_count, token_type_to_string(piped.type),
+                   token_type_to_string(reference.type));
+            all_passed = false;
+            break;
+        }
+
+        token_count++;
+        if (piped.type == TOKEN_EOF || piped.type == TOKEN_ERROR) {
+            break;
+        }
+    }
+
+    printf("Consumed %d tokens through the pipeline\n", token_count);
+
+    // Past EOF the pipeline must keep answering the final token
+    Token past_end = token_pipeline_next(pipeline);
+    if (past_end.type != TOKEN_EOF) {
+        fprintf(stderr, "Expected TOKEN_EOF past end of stream, got %s\n",
+               token_type_to_string(past_end.type));
+        all_passed = false;
+    }
+
+    // Clean up
+    token_pipeline_stop(pipeline);
+    lexer_cleanup(piped_lexer);
+    lexer_cleanup(reference_lexer);
+    fclose(reference_file);
+    error_cleanup();
+
+    if (all_passed) {
+        printf("All token pipeline tests passed!\n");
+    } else {
+        fprintf(stderr, "Some token pipeline tests failed!\n");
+    }
+
+    return all_passed;
+}
+
+/**
+ * Test the shared source manager behind the lexer
+ *
+ * Verifies that the lexer's buffer is registered for filename lookups,
+ * that offsets resolve to the right line and column, and that source
+ * lines can be excerpted without copying.
+ *
+ * @return true if the test passes, false otherwise
+ */
+bool test_source_manager(void) {
+    printf("\n=== Testing the shared source manager ===\n");
+
+    if (!error_init()) {
+        fprintf(stderr, "Failed to initialize error handling system\n");
+        return false;
+    }
+
+    const char* source_code =
+        "прва = 1;\n"
+        "друга = 2;\n"
+        "трећа = 3;";
+
+    FILE* source_file = create_temp_file(source_code);
+    if (!source_file) {
+        error_cleanup();
+        return false;
+    }
+
+    TargetInfo target_info = target_init();
+    LexerState* lexer = lexer_init(source_file, "test.ћпп", target_info);
+    if (!lexer) {
+        fclose(source_file);
+        error_cleanup();
+        return false;
+    }
+
+    bool passed = true;
+
+    // The error reporter finds the lexer's buffer by filename
+    SourceManager* manager = source_manager_find("test.ћпп");
+    if (manager != lexer->source_manager) {
+        fprintf(stderr, "FAILED: registry lookup did not return the lexer's manager\n");
+        passed = false;
+    }
+
+    // Offsets resolve through the shared line index
+    size_t second_line_offset = strlen("прва = 1;\n");
+    int line = 0, column = 0;
+    lexer_location(lexer, second_line_offset, &line, &column);
+    if (line != 2 || column != 1) {
+        fprintf(stderr, "FAILED: expected 2:1, got %d:%d\n", line, column);
+        passed = false;
+    }
+
+    // Excerpts point into the buffer itself, newline trimmed
+    size_t length = 0;
+    const char* excerpt = source_manager_line(manager, 2, &length);
+    if (!excerpt || length != strlen("друга = 2;") ||
+        strncmp(excerpt, "друга = 2;", length) != 0) {
+        fprintf(stderr, "FAILED: wrong excerpt for line 2\n");
+        passed = false;
+    }
+    if (excerpt && (excerpt < lexer->source ||
+                    excerpt >= lexer->source + lexer->source_length)) {
+        fprintf(stderr, "FAILED: excerpt is not zero-copy\n");
+        passed = false;
+    }
+
+    // A line past the end must be rejected, not invented
+    if (source_manager_line(manager, 4, &length) != NULL) {
+        fprintf(stderr, "FAILED: excerpt past the last line\n");
+        passed = false;
+    }
+
+    // Closing the lexer unregisters the file
+    lexer_cleanup(lexer);
+    fclose(source_file);
+    if (source_manager_find("test.ћпп") != NULL) {
+        fprintf(stderr, "FAILED: manager still registered after cleanup\n");
+        passed = false;
+    }
+
+    cleanup_temp_file();
+    error_cleanup();
+
+    if (passed) {
+        printf("All source manager tests passed!\n");
+    }
+    return passed;
+}
+
 /**
  * Run all lexer tests
  */
@@ -871,7 +1215,25 @@ int main(void) {
         all_tests_passed = false;
         fprintf(stderr, "test_print_all_tokens failed\n");
     }
-    
+
+    // Test batched token buffering
+    if (!test_token_buffer()) {
+        all_tests_passed = false;
+        fprintf(stderr, "test_token_buffer failed\n");
+    }
+
+    // Test pipelined lexing
+    if (!test_token_pipeline()) {
+        all_tests_passed = false;
+        fprintf(stderr, "test_token_pipeline failed\n");
+    }
+
+    // Test the shared source manager
+    if (!test_source_manager()) {
+        all_tests_passed = false;
+        fprintf(stderr, "test_source_manager failed\n");
+    }
+
     cleanup_temp_file();
     
     if (all_tests_passed) {
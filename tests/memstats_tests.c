@@ -0,0 +1,182 @@
+/*
+ * filename: memstats_tests.c
+ *
+ * Purpose:
+ * Test suite for the memory statistics instrumentation of the ћ++
+ * compiler. Validates that the counting allocator tracks live bytes
+ * and high-water marks, attributes allocations to pipeline phases,
+ * and that instrumented compiler components balance their frees.
+ *
+ * Key Components:
+ * - test_disabled_by_default(): Tracking stays inert until enabled
+ * - test_counting_allocator(): mem_alloc/mem_free drive the counters
+ * - test_phase_attribution(): Allocations land in the open phase
+ * - test_ast_balance(): Building and freeing a tree returns to zero
+ * - test_error_balance(): Reporting and cleanup return to zero
+ *
+ * Interactions:
+ * - Uses the utils/memstats.h interface; drives ast.h and error.h
+ *   for the integration tests
+ *
+ * Notes:
+ * - Run with 'make test-memstats'
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/utils/memstats.h"
+#include "../src/utils/timing.h"
+#include "../src/utils/error.h"
+#include "../src/parser/ast.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+void test_disabled_by_default() {
+    printf("Testing that tracking starts disabled...\n");
+
+    TEST_ASSERT(!memstats_enabled(), "Tracking must start disabled");
+    void* block = mem_alloc(128);
+    TEST_ASSERT(block != NULL, "The wrapper must still allocate");
+    TEST_ASSERT(memstats_get_live_bytes() == 0,
+                "Disabled tracking must not count");
+    mem_free(block);
+    TEST_ASSERT(memstats_get_allocation_count() == 0,
+                "Disabled tracking must not count allocations");
+
+    printf("Disabled-by-default tests passed!\n\n");
+}
+
+void test_counting_allocator() {
+    printf("Testing the counting allocator...\n");
+
+    memstats_enable();
+    memstats_reset();
+
+    void* first = mem_alloc(100);
+    void* second = mem_zalloc(50);
+    TEST_ASSERT(first != NULL && second != NULL, "Allocations failed");
+    TEST_ASSERT(((char*)second)[0] == 0, "mem_zalloc must zero the block");
+    TEST_ASSERT(memstats_get_live_bytes() == 150,
+                "Live bytes should track both blocks");
+    TEST_ASSERT(memstats_get_allocation_count() == 2,
+                "Two allocations should be counted");
+
+    mem_free(first);
+    TEST_ASSERT(memstats_get_live_bytes() == 50,
+                "Freeing must subtract the block's own size");
+    TEST_ASSERT(memstats_get_peak_bytes() == 150,
+                "The high-water mark must survive frees");
+
+    char* copy = mem_strdup("провера");
+    TEST_ASSERT(copy != NULL && strcmp(copy, "провера") == 0,
+                "mem_strdup must copy the string");
+    TEST_ASSERT(memstats_get_live_bytes() == 50 + strlen("провера") + 1,
+                "mem_strdup must track the copy");
+    mem_free(copy);
+    mem_free(second);
+    TEST_ASSERT(memstats_get_live_bytes() == 0,
+                "Balanced frees return live bytes to zero");
+
+    printf("Counting allocator tests passed!\n\n");
+}
+
+void test_phase_attribution() {
+    printf("Testing phase attribution...\n");
+
+    timing_enable();
+    memstats_enable();
+    memstats_reset();
+
+    timing_phase_begin(TIMING_PHASE_PARSING);
+    void* inside = mem_alloc(1024);
+    timing_phase_end(TIMING_PHASE_PARSING);
+    void* outside = mem_alloc(16);
+
+    TEST_ASSERT(memstats_get_phase_allocations(TIMING_PHASE_PARSING) == 1,
+                "The parsing phase should own one allocation");
+    TEST_ASSERT(memstats_get_phase_peak(TIMING_PHASE_PARSING) >= 1024,
+                "The parsing peak should cover the block");
+    TEST_ASSERT(memstats_get_phase_allocations(-1) == 1,
+                "Allocations outside phases land in their own bucket");
+    TEST_ASSERT(memstats_get_phase_allocations(TIMING_PHASE_CODEGEN) == 0,
+                "Phases that allocated nothing stay at zero");
+
+    mem_free(inside);
+    mem_free(outside);
+    printf("Phase attribution tests passed!\n\n");
+}
+
+void test_ast_balance() {
+    printf("Testing AST allocation balance...\n");
+    error_init();
+
+    memstats_enable();
+    memstats_reset();
+
+    SourceLocation loc = source_location_create(1, 1, "memstats_test.ћпп");
+    AstNode* value = ast_create_binary_expr(ast_create_literal_int(1, loc),
+                                            TOKEN_PLUS,
+                                            ast_create_literal_int(2, loc), loc);
+    AstNode* statements[1] = { ast_create_return_stmt(value, loc) };
+    AstNode* body = ast_create_block(statements, 1, loc);
+    AstNode* function = ast_create_function_decl("главна", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    TEST_ASSERT(memstats_get_allocation_count() > 0,
+                "Building a tree should allocate");
+    uint64_t live_with_tree = memstats_get_live_bytes();
+    TEST_ASSERT(live_with_tree > 0, "The tree should hold live bytes");
+
+    ast_free(program);
+    TEST_ASSERT(memstats_get_live_bytes() == 0,
+                "Freeing the tree should release every tracked byte");
+
+    error_cleanup();
+    printf("AST allocation balance tests passed!\n\n");
+}
+
+void test_error_balance() {
+    printf("Testing error string balance...\n");
+    error_init();
+
+    memstats_enable();
+    memstats_reset();
+
+    ERROR_SEMANTIC_ERROR("memstats_test.ћпп", 1, 1,
+                        "Tracked test error", "Expected while testing");
+    TEST_ASSERT(memstats_get_live_bytes() > 0,
+                "Reported errors should hold tracked strings");
+
+    error_cleanup();
+    TEST_ASSERT(memstats_get_live_bytes() == 0,
+                "Cleanup should release every error string");
+
+    // The report must render without crashing whatever the numbers are
+    memstats_report();
+
+    printf("Error string balance tests passed!\n\n");
+}
+
+int main() {
+    printf("=== ћ++ Memory Statistics Tests ===\n\n");
+
+    test_disabled_by_default();
+    test_counting_allocator();
+    test_phase_attribution();
+    test_ast_balance();
+    test_error_balance();
+
+    printf("All memory statistics tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,247 @@
+/*
+ * filename: peephole_tests.c
+ *
+ * Purpose:
+ * Test suite for the peephole optimizer of the ћ++ compiler backend.
+ * Validates each rewrite rule on hand-built machine instruction
+ * streams and checks that unrelated instructions survive untouched.
+ *
+ * Key Components:
+ * - test_redundant_moves(): Self moves and no-op arithmetic disappear
+ * - test_inc_dec(): add/sub by one shrink to inc/dec
+ * - test_slot_forwarding(): Stored slots are not immediately reloaded
+ * - test_compare_branch(): setcc/test/jcc collapses onto the compare
+ * - test_stack_traffic(): push/pop pairs cancel or become moves
+ * - test_jump_to_next(): Jumps to the following label are deleted
+ *
+ * Interactions:
+ * - Uses the codegen/peephole.h interface
+ *
+ * Notes:
+ * - Run with 'make test-peephole'
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/codegen/peephole.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+// Shorthand constructors keep the streams readable
+static MachInstruction mov_rr(int dst, int src) {
+    MachInstruction inst = {0};
+    inst.opcode = MACH_MOV_RR; inst.dst = dst; inst.src = src;
+    return inst;
+}
+
+static MachInstruction simple(MachOpcode opcode, int dst, intptr_t imm) {
+    MachInstruction inst = {0};
+    inst.opcode = opcode; inst.dst = dst; inst.imm = imm;
+    return inst;
+}
+
+void test_redundant_moves() {
+    printf("Testing redundant move removal...\n");
+
+    MachInstruction code[4];
+    code[0] = mov_rr(1, 1);                    // deleted
+    code[1] = mov_rr(2, 1);                    // kept
+    code[2] = simple(MACH_ADD_RI, 2, 0);       // deleted
+    code[3] = simple(MACH_RET, 0, 0);
+
+    uint32_t count = 4;
+    int rewrites = peephole_optimize(code, &count);
+    TEST_ASSERT(rewrites == 2, "Two rewrites expected");
+    TEST_ASSERT(count == 2, "Two instructions should remain");
+    TEST_ASSERT(code[0].opcode == MACH_MOV_RR && code[0].src == 1,
+                "The real move must survive");
+    TEST_ASSERT(code[1].opcode == MACH_RET, "Return must survive");
+
+    printf("Redundant move removal tests passed!\n\n");
+}
+
+void test_inc_dec() {
+    printf("Testing inc/dec shrinking...\n");
+
+    MachInstruction code[3];
+    code[0] = simple(MACH_ADD_RI, 3, 1);       // becomes inc
+    code[1] = simple(MACH_SUB_RI, 4, 1);       // becomes dec
+    code[2] = simple(MACH_ADD_RI, 5, 2);       // untouched
+
+    uint32_t count = 3;
+    peephole_optimize(code, &count);
+    TEST_ASSERT(count == 3, "Shrinking does not remove instructions");
+    TEST_ASSERT(code[0].opcode == MACH_INC_R && code[0].dst == 3,
+                "add r, 1 should become inc r");
+    TEST_ASSERT(code[1].opcode == MACH_DEC_R && code[1].dst == 4,
+                "sub r, 1 should become dec r");
+    TEST_ASSERT(code[2].opcode == MACH_ADD_RI && code[2].imm == 2,
+                "add r, 2 must stay an add");
+
+    printf("Inc/dec shrinking tests passed!\n\n");
+}
+
+void test_slot_forwarding() {
+    printf("Testing slot store forwarding...\n");
+
+    // store 1 -> slot 3 / load slot 3 -> 1: the reload disappears;
+    // store 2 -> slot 4 / load slot 4 -> 5: the reload becomes a move
+    MachInstruction code[5];
+    code[0] = simple(MACH_STORE_SLOT, 0, 3); code[0].src = 1;
+    code[1] = simple(MACH_LOAD_SLOT, 1, 3);
+    code[2] = simple(MACH_STORE_SLOT, 0, 4); code[2].src = 2;
+    code[3] = simple(MACH_LOAD_SLOT, 5, 4);
+    code[4] = simple(MACH_LOAD_SLOT, 6, 9);    // other slot, untouched
+
+    uint32_t count = 5;
+    peephole_optimize(code, &count);
+    TEST_ASSERT(count == 4, "The same-register reload should disappear");
+    TEST_ASSERT(code[0].opcode == MACH_STORE_SLOT && code[0].imm == 3,
+                "Stores always survive");
+    TEST_ASSERT(code[2].opcode == MACH_MOV_RR && code[2].dst == 5 &&
+                code[2].src == 2,
+                "A reload into another register should become a move");
+    TEST_ASSERT(code[3].opcode == MACH_LOAD_SLOT && code[3].imm == 9,
+                "Loads of other slots must survive");
+
+    // A label between store and load is a barrier: the load's block
+    // may be entered from elsewhere with different register contents
+    MachInstruction barrier[3];
+    barrier[0] = simple(MACH_STORE_SLOT, 0, 3); barrier[0].src = 1;
+    barrier[1] = simple(MACH_LABEL, 0, 0); barrier[1].label = 2;
+    barrier[2] = simple(MACH_LOAD_SLOT, 1, 3);
+
+    count = 3;
+    peephole_optimize(barrier, &count);
+    TEST_ASSERT(count == 3 && barrier[2].opcode == MACH_LOAD_SLOT,
+                "A reload behind a label must survive");
+
+    printf("Slot store forwarding tests passed!\n\n");
+}
+
+void test_compare_branch() {
+    printf("Testing compare-and-branch collapse...\n");
+
+    // cmp r1, r2 / setlt t / test t, t / jne L: the test is redundant,
+    // the jump takes the setcc condition and the setcc stays
+    MachInstruction code[4];
+    code[0] = mov_rr(0, 0);
+    code[0].opcode = MACH_CMP_RR; code[0].dst = 1; code[0].src = 2;
+    code[1] = simple(MACH_SETCC_R, 5, 0);
+    code[1].condition = COND_LT;
+    code[2] = mov_rr(0, 0);
+    code[2].opcode = MACH_TEST_RR; code[2].dst = 5; code[2].src = 5;
+    code[3] = simple(MACH_JCC, 0, 0);
+    code[3].condition = COND_NE; code[3].label = 7;
+
+    uint32_t count = 4;
+    peephole_optimize(code, &count);
+    TEST_ASSERT(count == 3, "Only the test should be removed");
+    TEST_ASSERT(code[0].opcode == MACH_CMP_RR, "Compare must survive");
+    TEST_ASSERT(code[1].opcode == MACH_SETCC_R, "Setcc result may still be read");
+    TEST_ASSERT(code[2].opcode == MACH_JCC && code[2].label == 7,
+                "Jump target must be preserved");
+    TEST_ASSERT(code[2].condition == COND_LT,
+                "Jump should take the setcc condition");
+
+    // The same chain through jeq negates the condition
+    MachInstruction negated[3];
+    negated[0] = simple(MACH_SETCC_R, 5, 0);
+    negated[0].condition = COND_LT;
+    negated[1] = mov_rr(0, 0);
+    negated[1].opcode = MACH_TEST_RR; negated[1].dst = 5; negated[1].src = 5;
+    negated[2] = simple(MACH_JCC, 0, 0);
+    negated[2].condition = COND_EQ; negated[2].label = 7;
+
+    count = 3;
+    peephole_optimize(negated, &count);
+    TEST_ASSERT(count == 2, "Only the test should be removed");
+    TEST_ASSERT(negated[1].condition == COND_GE,
+                "Jump on zero should take the negated condition");
+
+    // A spill of the setcc result between setcc and test is looked
+    // past: it changes neither the flags nor the tested register
+    MachInstruction spilled[4];
+    spilled[0] = simple(MACH_SETCC_R, 5, 0);
+    spilled[0].condition = COND_GT;
+    spilled[1] = simple(MACH_STORE_SLOT, 0, 2); spilled[1].src = 5;
+    spilled[2] = mov_rr(0, 0);
+    spilled[2].opcode = MACH_TEST_RR; spilled[2].dst = 5; spilled[2].src = 5;
+    spilled[3] = simple(MACH_JCC, 0, 0);
+    spilled[3].condition = COND_NE; spilled[3].label = 7;
+
+    count = 4;
+    peephole_optimize(spilled, &count);
+    TEST_ASSERT(count == 3, "Only the test should be removed");
+    TEST_ASSERT(spilled[1].opcode == MACH_STORE_SLOT,
+                "The spill must survive");
+    TEST_ASSERT(spilled[2].opcode == MACH_JCC &&
+                spilled[2].condition == COND_GT,
+                "Jump should take the setcc condition past the spill");
+
+    printf("Compare-and-branch collapse tests passed!\n\n");
+}
+
+void test_stack_traffic() {
+    printf("Testing stack traffic removal...\n");
+
+    MachInstruction code[5];
+    code[0] = simple(MACH_PUSH_R, 0, 0); code[0].src = 3;   // cancels
+    code[1] = simple(MACH_POP_R, 3, 0);
+    code[2] = simple(MACH_PUSH_R, 0, 0); code[2].src = 4;   // becomes mov
+    code[3] = simple(MACH_POP_R, 6, 0);
+    code[4] = simple(MACH_RET, 0, 0);
+
+    uint32_t count = 5;
+    peephole_optimize(code, &count);
+    TEST_ASSERT(count == 2, "Push/pop traffic should shrink to one move");
+    TEST_ASSERT(code[0].opcode == MACH_MOV_RR && code[0].dst == 6 &&
+                code[0].src == 4,
+                "push a / pop b should become mov b, a");
+    TEST_ASSERT(code[1].opcode == MACH_RET, "Return must survive");
+
+    printf("Stack traffic removal tests passed!\n\n");
+}
+
+void test_jump_to_next() {
+    printf("Testing jump-to-next removal...\n");
+
+    MachInstruction code[4];
+    code[0] = simple(MACH_JMP, 0, 0); code[0].label = 2;    // deleted
+    code[1] = simple(MACH_LABEL, 0, 0); code[1].label = 2;
+    code[2] = simple(MACH_JMP, 0, 0); code[2].label = 9;    // kept
+    code[3] = simple(MACH_LABEL, 0, 0); code[3].label = 4;
+
+    uint32_t count = 4;
+    peephole_optimize(code, &count);
+    TEST_ASSERT(count == 3, "Only the fall-through jump goes away");
+    TEST_ASSERT(code[0].opcode == MACH_LABEL && code[0].label == 2,
+                "Labels are never removed");
+    TEST_ASSERT(code[1].opcode == MACH_JMP && code[1].label == 9,
+                "Jumps elsewhere must survive");
+
+    printf("Jump-to-next removal tests passed!\n\n");
+}
+
+int main() {
+    printf("=== ћ++ Peephole Optimizer Tests ===\n\n");
+
+    test_redundant_moves();
+    test_inc_dec();
+    test_slot_forwarding();
+    test_compare_branch();
+    test_stack_traffic();
+    test_jump_to_next();
+
+    printf("All peephole optimizer tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,258 @@
+/*
+ * filename: semantic_tests.c
+ *
+ * Purpose:
+ * Test suite for the semantic analyzer of the ћ++ compiler.
+ * Validates symbol resolution, call arity checking, array-access
+ * validation, and the incremental hooks used by fused parse + analysis.
+ *
+ * Key Components:
+ * - test_valid_program(): A correct program passes and gets annotated
+ * - test_undeclared_identifier(): Unknown names are reported
+ * - test_call_arity(): Calls must match the declaration's arity
+ * - test_array_bounds(): Constant indices must stay inside the array
+ * - test_fused_hooks(): Per-node hooks work in parser production order
+ *
+ * Interactions:
+ * - Uses the semantic/semantic_analyzer.h interface
+ * - Builds ASTs directly through parser/ast.h constructors
+ *
+ * Notes:
+ * - Run with 'make test-semantic'
+ * - Negative tests print the reported errors; that output is expected
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/semantic/semantic_analyzer.h"
+#include "../src/utils/error.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+// Build an екстерно declaration taking parameter_count parameters
+static AstNode* make_external(const char* name, int parameter_count,
+                              SourceLocation loc) {
+    AstNode* parameters[4];
+    for (int i = 0; i < parameter_count; i++) {
+        parameters[i] = ast_create_var_decl("п", NULL, type_create_int(), loc);
+    }
+    return ast_create_function_decl((char*)name, parameters, parameter_count,
+                                    NULL, type_create_void(), true, loc);
+}
+
+void test_valid_program() {
+    printf("Testing a valid program...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    AstNode* external = make_external("испиши", 1, loc);
+
+    // цео главна(цео н) < низ:3:; низ[2] = 5; испиши(н); врати 0; >
+    AstNode* parameter = ast_create_var_decl("н", NULL, type_create_int(), loc);
+    AstNode* array_decl = ast_create_array_decl("низ", 3, NULL, 0,
+                                                type_create_int(), loc);
+    AstNode* store = ast_create_expr_stmt(
+        ast_create_assignment(
+            ast_create_array_access(ast_create_identifier("низ", loc),
+                                    ast_create_literal_int(2, loc), loc),
+            ast_create_literal_int(5, loc), loc),
+        loc);
+    AstNode* argument = ast_create_identifier("н", loc);
+    AstNode* arguments[1] = { argument };
+    AstNode* call = ast_create_expr_stmt(
+        ast_create_call_expr(ast_create_identifier("испиши", loc),
+                             arguments, 1, loc),
+        loc);
+    AstNode* ret = ast_create_return_stmt(ast_create_literal_int(0, loc), loc);
+
+    AstNode* statements[4] = { array_decl, store, call, ret };
+    AstNode* body = ast_create_block(statements, 4, loc);
+    AstNode* parameters[1] = { parameter };
+    AstNode* function = ast_create_function_decl("главна", parameters, 1, body,
+                                                 type_create_int(), false, loc);
+
+    AstNode* declarations[2] = { external, function };
+    AstNode* program = ast_create_program(declarations, 2, loc);
+
+    SemanticAnalyzer* analyzer = semantic_analyzer_init("test.ћпп");
+    TEST_ASSERT(analyzer != NULL, "Failed to create semantic analyzer");
+
+    TEST_ASSERT(analyze_program(analyzer, program), "Valid program was rejected");
+    TEST_ASSERT(analyzer->error_count == 0, "Valid program produced errors");
+
+    // The parameter reference was resolved and annotated with its type
+    TEST_ASSERT(argument->type_info != NULL, "Identifier was not annotated");
+    TEST_ASSERT(argument->type_info->category == TYPE_INT,
+                "Identifier annotated with wrong type");
+
+    semantic_analyzer_free(analyzer);
+    ast_free(program);
+    error_cleanup();
+    printf("Valid program tests passed!\n\n");
+}
+
+void test_undeclared_identifier() {
+    printf("Testing undeclared identifier detection...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(3, 5, "test.ћпп");
+
+    AstNode* use = ast_create_expr_stmt(ast_create_identifier("непозната", loc), loc);
+    AstNode* statements[1] = { use };
+    AstNode* body = ast_create_block(statements, 1, loc);
+    AstNode* function = ast_create_function_decl("главна", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    SemanticAnalyzer* analyzer = semantic_analyzer_init("test.ћпп");
+    TEST_ASSERT(analyzer != NULL, "Failed to create semantic analyzer");
+
+    TEST_ASSERT(!analyze_program(analyzer, program),
+                "Undeclared identifier was accepted");
+    TEST_ASSERT(analyzer->error_count == 1, "Wrong error count");
+
+    semantic_analyzer_free(analyzer);
+    ast_free(program);
+    error_cleanup();
+    printf("Undeclared identifier tests passed!\n\n");
+}
+
+void test_call_arity() {
+    printf("Testing call arity checking...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(5, 1, "test.ћпп");
+
+    AstNode* external = make_external("испиши", 1, loc);
+
+    // испиши(1, 2) — one argument too many
+    AstNode* arguments[2] = {
+        ast_create_literal_int(1, loc),
+        ast_create_literal_int(2, loc)
+    };
+    AstNode* call = ast_create_expr_stmt(
+        ast_create_call_expr(ast_create_identifier("испиши", loc),
+                             arguments, 2, loc),
+        loc);
+    AstNode* statements[1] = { call };
+    AstNode* body = ast_create_block(statements, 1, loc);
+    AstNode* function = ast_create_function_decl("главна", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[2] = { external, function };
+    AstNode* program = ast_create_program(declarations, 2, loc);
+
+    SemanticAnalyzer* analyzer = semantic_analyzer_init("test.ћпп");
+    TEST_ASSERT(analyzer != NULL, "Failed to create semantic analyzer");
+
+    TEST_ASSERT(!analyze_program(analyzer, program),
+                "Arity mismatch was accepted");
+    TEST_ASSERT(analyzer->error_count == 1, "Wrong error count");
+
+    semantic_analyzer_free(analyzer);
+    ast_free(program);
+    error_cleanup();
+    printf("Call arity tests passed!\n\n");
+}
+
+void test_array_bounds() {
+    printf("Testing array bounds checking...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(7, 1, "test.ћпп");
+
+    // низ:3:; затим низ[7] — constant index out of bounds
+    AstNode* array_decl = ast_create_array_decl("низ", 3, NULL, 0,
+                                                type_create_int(), loc);
+    AstNode* bad_access = ast_create_expr_stmt(
+        ast_create_array_access(ast_create_identifier("низ", loc),
+                                ast_create_literal_int(7, loc), loc),
+        loc);
+    AstNode* statements[2] = { array_decl, bad_access };
+    AstNode* body = ast_create_block(statements, 2, loc);
+    AstNode* function = ast_create_function_decl("главна", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    SemanticAnalyzer* analyzer = semantic_analyzer_init("test.ћпп");
+    TEST_ASSERT(analyzer != NULL, "Failed to create semantic analyzer");
+
+    TEST_ASSERT(!analyze_program(analyzer, program),
+                "Out-of-bounds constant index was accepted");
+    TEST_ASSERT(analyzer->error_count == 1, "Wrong error count");
+
+    semantic_analyzer_free(analyzer);
+    ast_free(program);
+    error_cleanup();
+    printf("Array bounds tests passed!\n\n");
+}
+
+void test_fused_hooks() {
+    printf("Testing fused-mode hooks...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // Drive the hooks in the order a fused parser would: declare the
+    // екстерно function, open the function scope, declare the
+    // parameter, then check each expression node as it is produced
+    AstNode* external = make_external("испиши", 1, loc);
+
+    SemanticAnalyzer* analyzer = semantic_analyzer_init("test.ћпп");
+    TEST_ASSERT(analyzer != NULL, "Failed to create semantic analyzer");
+
+    TEST_ASSERT(semantic_declare(analyzer, external), "Failed to declare external");
+    TEST_ASSERT(semantic_enter_scope(analyzer), "Failed to enter function scope");
+
+    AstNode* parameter = ast_create_var_decl("н", NULL, type_create_int(), loc);
+    TEST_ASSERT(semantic_declare(analyzer, parameter), "Failed to declare parameter");
+
+    // Redeclaring the parameter in the same scope is rejected
+    AstNode* duplicate = ast_create_var_decl("н", NULL, type_create_int(), loc);
+    TEST_ASSERT(!semantic_declare(analyzer, duplicate), "Duplicate was accepted");
+    TEST_ASSERT(analyzer->error_count == 1, "Duplicate was not counted");
+
+    // испиши(н) checked node by node, innermost first
+    AstNode* argument = ast_create_identifier("н", loc);
+    TEST_ASSERT(check_expression(analyzer, argument), "Parameter use was rejected");
+    TEST_ASSERT(argument->type_info != NULL, "Parameter use was not annotated");
+
+    AstNode* callee = ast_create_identifier("испиши", loc);
+    AstNode* arguments[1] = { argument };
+    AstNode* call = ast_create_call_expr(callee, arguments, 1, loc);
+    TEST_ASSERT(check_expression(analyzer, call), "Valid call was rejected");
+
+    TEST_ASSERT(semantic_exit_scope(analyzer), "Failed to exit function scope");
+
+    semantic_analyzer_free(analyzer);
+    ast_free(call);
+    ast_free(duplicate);
+    ast_free(parameter);
+    ast_free(external);
+    error_cleanup();
+    printf("Fused-mode hook tests passed!\n\n");
+}
+
+int main() {
+    printf("=== ћ++ Semantic Analyzer Tests ===\n\n");
+
+    test_valid_program();
+    test_undeclared_identifier();
+    test_call_arity();
+    test_array_bounds();
+    test_fused_hooks();
+
+    printf("All semantic analyzer tests passed!\n");
+    return 0;
+}
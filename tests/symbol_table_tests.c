@@ -0,0 +1,207 @@
+/*
+ * filename: symbol_table_tests.c
+ *
+ * Purpose:
+ * Test suite for the symbol table of the ћ++ compiler.
+ * Validates declaration, single-probe lookup, scope nesting, shadowing,
+ * and table growth while scopes are open.
+ *
+ * Key Components:
+ * - test_global_declarations(): Add and look up global symbols
+ * - test_scope_nesting(): Enter/exit scopes and track scope depth
+ * - test_shadowing(): Inner declarations shadow and restore outer ones
+ * - test_duplicate_rejection(): Same-scope redeclaration fails
+ * - test_table_growth(): Rehashing with open scopes keeps the undo log valid
+ *
+ * Interactions:
+ * - Uses the semantic/symbol_table.h interface
+ * - Symbol names exercise Cyrillic identifiers through utils/intern.h
+ *
+ * Notes:
+ * - Run with 'make test-symbol-table'
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/semantic/symbol_table.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+void test_global_declarations() {
+    printf("Testing global declarations...\n");
+
+    SymbolTable* table = symbol_table_init();
+    TEST_ASSERT(table != NULL, "Failed to create symbol table");
+    TEST_ASSERT(symbol_table_get_current_scope(table) == 0, "New table should start in global scope");
+
+    TEST_ASSERT(symbol_table_add(table, "бројач", SYMBOL_VARIABLE, NULL, NULL),
+                "Failed to add global variable");
+    TEST_ASSERT(symbol_table_add(table, "главна", SYMBOL_FUNCTION, NULL, NULL),
+                "Failed to add global function");
+    TEST_ASSERT(symbol_table_add(table, "низ", SYMBOL_ARRAY, NULL, NULL),
+                "Failed to add global array");
+
+    Symbol* found = symbol_table_lookup(table, "бројач");
+    TEST_ASSERT(found != NULL, "Failed to look up global variable");
+    TEST_ASSERT(found->type == SYMBOL_VARIABLE, "Wrong symbol type for variable");
+    TEST_ASSERT(found->scope_depth == 0, "Global symbol should be at depth 0");
+
+    found = symbol_table_lookup(table, "главна");
+    TEST_ASSERT(found != NULL && found->type == SYMBOL_FUNCTION, "Wrong symbol type for function");
+
+    TEST_ASSERT(symbol_table_lookup(table, "непозната") == NULL,
+                "Lookup of undeclared name should fail");
+
+    symbol_table_free(table);
+    printf("Global declaration tests passed!\n");
+}
+
+void test_scope_nesting() {
+    printf("Testing scope nesting...\n");
+
+    SymbolTable* table = symbol_table_init();
+    TEST_ASSERT(table != NULL, "Failed to create symbol table");
+
+    TEST_ASSERT(!symbol_table_exit_scope(table),
+                "Exiting global scope should fail");
+
+    TEST_ASSERT(symbol_table_enter_scope(table), "Failed to enter scope");
+    TEST_ASSERT(symbol_table_get_current_scope(table) == 1, "Wrong depth after entering scope");
+
+    TEST_ASSERT(symbol_table_add(table, "локална", SYMBOL_VARIABLE, NULL, NULL),
+                "Failed to add local variable");
+    TEST_ASSERT(symbol_table_enter_scope(table), "Failed to enter nested scope");
+    TEST_ASSERT(symbol_table_get_current_scope(table) == 2, "Wrong depth in nested scope");
+
+    // Outer local is still visible from the inner scope
+    Symbol* found = symbol_table_lookup(table, "локална");
+    TEST_ASSERT(found != NULL && found->scope_depth == 1,
+                "Outer local should be visible from nested scope");
+
+    TEST_ASSERT(symbol_table_exit_scope(table), "Failed to exit nested scope");
+    TEST_ASSERT(symbol_table_exit_scope(table), "Failed to exit scope");
+    TEST_ASSERT(symbol_table_get_current_scope(table) == 0, "Should be back in global scope");
+
+    // Leaving the scope removed its declaration
+    TEST_ASSERT(symbol_table_lookup(table, "локална") == NULL,
+                "Local should not survive its scope");
+
+    symbol_table_free(table);
+    printf("Scope nesting tests passed!\n");
+}
+
+void test_shadowing() {
+    printf("Testing shadowing...\n");
+
+    SymbolTable* table = symbol_table_init();
+    TEST_ASSERT(table != NULL, "Failed to create symbol table");
+
+    TEST_ASSERT(symbol_table_add(table, "вредност", SYMBOL_VARIABLE, NULL, NULL),
+                "Failed to add global variable");
+
+    TEST_ASSERT(symbol_table_enter_scope(table), "Failed to enter scope");
+    TEST_ASSERT(symbol_table_add(table, "вредност", SYMBOL_ARRAY, NULL, NULL),
+                "Failed to shadow global variable");
+
+    // Lookup finds the innermost declaration
+    Symbol* found = symbol_table_lookup(table, "вредност");
+    TEST_ASSERT(found != NULL, "Failed to look up shadowing declaration");
+    TEST_ASSERT(found->type == SYMBOL_ARRAY, "Lookup should find the inner declaration");
+    TEST_ASSERT(found->scope_depth == 1, "Inner declaration should be at depth 1");
+
+    // Exiting the scope restores the shadowed global
+    TEST_ASSERT(symbol_table_exit_scope(table), "Failed to exit scope");
+    found = symbol_table_lookup(table, "вредност");
+    TEST_ASSERT(found != NULL, "Shadowed global should be restored");
+    TEST_ASSERT(found->type == SYMBOL_VARIABLE, "Restored symbol has wrong type");
+    TEST_ASSERT(found->scope_depth == 0, "Restored symbol should be at depth 0");
+
+    symbol_table_free(table);
+    printf("Shadowing tests passed!\n");
+}
+
+void test_duplicate_rejection() {
+    printf("Testing duplicate rejection...\n");
+
+    SymbolTable* table = symbol_table_init();
+    TEST_ASSERT(table != NULL, "Failed to create symbol table");
+
+    TEST_ASSERT(symbol_table_add(table, "дупликат", SYMBOL_VARIABLE, NULL, NULL),
+                "Failed to add variable");
+    TEST_ASSERT(!symbol_table_add(table, "дупликат", SYMBOL_VARIABLE, NULL, NULL),
+                "Same-scope redeclaration should fail");
+
+    TEST_ASSERT(symbol_table_enter_scope(table), "Failed to enter scope");
+    TEST_ASSERT(symbol_table_add(table, "дупликат", SYMBOL_VARIABLE, NULL, NULL),
+                "Shadowing in a nested scope should succeed");
+    TEST_ASSERT(!symbol_table_add(table, "дупликат", SYMBOL_VARIABLE, NULL, NULL),
+                "Same-scope redeclaration should fail in nested scope too");
+    TEST_ASSERT(symbol_table_exit_scope(table), "Failed to exit scope");
+
+    symbol_table_free(table);
+    printf("Duplicate rejection tests passed!\n");
+}
+
+void test_table_growth() {
+    printf("Testing table growth...\n");
+
+    SymbolTable* table = symbol_table_init();
+    TEST_ASSERT(table != NULL, "Failed to create symbol table");
+
+    TEST_ASSERT(symbol_table_add(table, "глобална", SYMBOL_VARIABLE, NULL, NULL),
+                "Failed to add global variable");
+
+    // Declare enough locals to force several rehashes while the scope is
+    // open; the undo log must survive the growth
+    TEST_ASSERT(symbol_table_enter_scope(table), "Failed to enter scope");
+
+    char name[32];
+    for (int i = 0; i < 200; i++) {
+        snprintf(name, sizeof(name), "пром%d", i);
+        TEST_ASSERT(symbol_table_add(table, name, SYMBOL_VARIABLE, NULL, NULL),
+                    "Failed to add local during growth");
+    }
+
+    for (int i = 0; i < 200; i++) {
+        snprintf(name, sizeof(name), "пром%d", i);
+        Symbol* found = symbol_table_lookup(table, name);
+        TEST_ASSERT(found != NULL && found->scope_depth == 1,
+                    "Lookup failed after table growth");
+    }
+
+    TEST_ASSERT(symbol_table_exit_scope(table), "Failed to exit scope");
+
+    // All locals are gone; the global survived the churn
+    for (int i = 0; i < 200; i++) {
+        snprintf(name, sizeof(name), "пром%d", i);
+        TEST_ASSERT(symbol_table_lookup(table, name) == NULL,
+                    "Local survived its scope after growth");
+    }
+    TEST_ASSERT(symbol_table_lookup(table, "глобална") != NULL,
+                "Global lost after scope churn");
+
+    symbol_table_free(table);
+    printf("Table growth tests passed!\n");
+}
+
+int main() {
+    printf("=== ћ++ Symbol Table Tests ===\n");
+
+    test_global_declarations();
+    test_scope_nesting();
+    test_shadowing();
+    test_duplicate_rejection();
+    test_table_growth();
+
+    printf("\nAll symbol table tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,345 @@
+/*
+ * filename: x86_64_tests.c
+ *
+ * Purpose:
+ * Test suite for the x86-64 register allocator of the ћ++ compiler.
+ * Validates live interval computation over the flat IR, back-edge
+ * extension, callee-saved placement of call-crossing values, and
+ * spilling under register pressure.
+ *
+ * Key Components:
+ * - test_register_names(): Register enum to name mapping
+ * - test_simple_allocation(): Straight-line code allocates without spills
+ * - test_loop_intervals(): A loop variable stays live over the back edge
+ * - test_call_crossing(): Values live across a call get callee-saved registers
+ * - test_spilling(): High pressure spills the furthest-ending intervals
+ *
+ * Interactions:
+ * - Uses the codegen/x86_64.h interface
+ * - Builds ASTs directly through parser/ast.h constructors and lowers
+ *   them with ir/ir.h
+ *
+ * Notes:
+ * - Run with 'make test-x86-64'
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../src/codegen/x86_64.h"
+#include "../src/ir/ir.h"
+#include "../src/utils/error.h"
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("ASSERTION FAILED: %s\n", message); \
+            printf("  in %s at line %d\n", __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+// Is a register one of the System V callee-saved registers?
+static bool is_callee_saved(int reg) {
+    return reg == X86_64_RBX || reg == X86_64_R12 || reg == X86_64_R13 ||
+           reg == X86_64_R14 || reg == X86_64_R15;
+}
+
+void test_register_names() {
+    printf("Testing register names...\n");
+
+    TEST_ASSERT(strcmp(x86_64_get_register_name(X86_64_RAX), "rax") == 0,
+                "Wrong name for rax");
+    TEST_ASSERT(strcmp(x86_64_get_register_name(X86_64_RSP), "rsp") == 0,
+                "Wrong name for rsp");
+    TEST_ASSERT(strcmp(x86_64_get_register_name(X86_64_R15), "r15") == 0,
+                "Wrong name for r15");
+
+    printf("Register name tests passed!\n\n");
+}
+
+void test_simple_allocation() {
+    printf("Testing straight-line allocation...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // цео сабери(цео а, цео б) < врати а + б; >
+    AstNode* parameters[2] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc),
+        ast_create_var_decl("б", NULL, type_create_int(), loc)
+    };
+    AstNode* sum = ast_create_binary_expr(ast_create_identifier("а", loc),
+                                          TOKEN_PLUS,
+                                          ast_create_identifier("б", loc), loc);
+    AstNode* statements[1] = { ast_create_return_stmt(sum, loc) };
+    AstNode* body = ast_create_block(statements, 1, loc);
+    AstNode* function = ast_create_function_decl("сабери", parameters, 2, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+    IrFunction* fn = &ir->functions[0];
+
+    LiveInterval* intervals = NULL;
+    uint32_t interval_count = 0;
+    TEST_ASSERT(x86_64_compute_intervals(fn, &intervals, &interval_count),
+                "Interval computation failed");
+    TEST_ASSERT(interval_count == 3, "Two parameters and the sum make 3 intervals");
+    for (uint32_t i = 1; i < interval_count; i++) {
+        TEST_ASSERT(intervals[i - 1].start <= intervals[i].start,
+                    "Intervals should be sorted by start");
+    }
+    free(intervals);
+
+    X86_64Allocation allocation;
+    TEST_ASSERT(x86_64_allocate_registers(fn, &allocation),
+                "Register allocation failed");
+    TEST_ASSERT(allocation.spill_count == 0, "Three values should not spill");
+    for (uint32_t v = 0; v < fn->value_count; v++) {
+        TEST_ASSERT(allocation.reg_of[v] != X86_64_NO_REGISTER,
+                    "Every value should get a register");
+        TEST_ASSERT(allocation.reg_of[v] != X86_64_RSP &&
+                    allocation.reg_of[v] != X86_64_RBP &&
+                    allocation.reg_of[v] != X86_64_RAX,
+                    "Reserved registers must not be handed out");
+    }
+    // The parameters are simultaneously live, so they get distinct registers
+    TEST_ASSERT(allocation.reg_of[0] != allocation.reg_of[1],
+                "Overlapping values must not share a register");
+
+    x86_64_allocation_free(&allocation);
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Straight-line allocation tests passed!\n\n");
+}
+
+void test_loop_intervals() {
+    printf("Testing back-edge extension...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // цео главна() < цео и = 0; док (и < 10) < и = и + 1; > врати 0; >
+    // The counter's last textual touch is inside the body, but the back
+    // edge carries it to the condition, so its range must grow to cover
+    // the latch terminator
+    AstNode* decl = ast_create_var_decl("и", ast_create_literal_int(0, loc),
+                                        type_create_int(), loc);
+    AstNode* condition = ast_create_binary_expr(ast_create_identifier("и", loc),
+                                                TOKEN_LESS,
+                                                ast_create_literal_int(10, loc), loc);
+    AstNode* increment = ast_create_expr_stmt(
+        ast_create_assignment(
+            ast_create_identifier("и", loc),
+            ast_create_binary_expr(ast_create_identifier("и", loc), TOKEN_PLUS,
+                                   ast_create_literal_int(1, loc), loc),
+            loc),
+        loc);
+    AstNode* loop_statements[1] = { increment };
+    AstNode* loop_body = ast_create_block(loop_statements, 1, loc);
+    AstNode* loop = ast_create_while_stmt(condition, loop_body, loc);
+    AstNode* ret = ast_create_return_stmt(ast_create_literal_int(0, loc), loc);
+
+    AstNode* statements[3] = { decl, loop, ret };
+    AstNode* body = ast_create_block(statements, 3, loc);
+    AstNode* function = ast_create_function_decl("главна", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+    IrFunction* fn = &ir->functions[0];
+    TEST_ASSERT(fn->block_count == 4, "While loop should make 4 blocks");
+
+    // The initializer loads into a temporary and moves it into the
+    // counter's register
+    TEST_ASSERT(fn->instructions[0].opcode == IR_LOAD_CONST &&
+                fn->instructions[1].opcode == IR_MOVE,
+                "Counter initialization should come first");
+    uint32_t counter = fn->instructions[1].dest;
+
+    // Block 2 is the loop body and ends with the back edge jump
+    IrBasicBlock* latch = &fn->blocks[2];
+    uint32_t back_edge = latch->first + latch->count - 1;
+    TEST_ASSERT(fn->instructions[back_edge].opcode == IR_JUMP &&
+                fn->instructions[back_edge].b == 1,
+                "Body should jump back to the condition");
+
+    LiveInterval* intervals = NULL;
+    uint32_t interval_count = 0;
+    TEST_ASSERT(x86_64_compute_intervals(fn, &intervals, &interval_count),
+                "Interval computation failed");
+    bool found = false;
+    for (uint32_t i = 0; i < interval_count; i++) {
+        if (intervals[i].vreg != counter) continue;
+        found = true;
+        TEST_ASSERT(intervals[i].start == 1,
+                    "Counter should be live from its initialization");
+        TEST_ASSERT(intervals[i].end == back_edge,
+                    "Counter should be extended to the back edge");
+    }
+    TEST_ASSERT(found, "Counter interval is missing");
+    free(intervals);
+
+    X86_64Allocation allocation;
+    TEST_ASSERT(x86_64_allocate_registers(fn, &allocation),
+                "Register allocation failed");
+    TEST_ASSERT(allocation.spill_count == 0, "A loop counter should not spill");
+    TEST_ASSERT(allocation.reg_of[counter] != X86_64_NO_REGISTER,
+                "The counter should stay in a register");
+
+    x86_64_allocation_free(&allocation);
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Back-edge extension tests passed!\n\n");
+}
+
+void test_call_crossing() {
+    printf("Testing call-crossing placement...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // екстерно испиши(цео в);
+    AstNode* extern_params[1] = {
+        ast_create_var_decl("в", NULL, type_create_int(), loc)
+    };
+    AstNode* external = ast_create_function_decl("испиши", extern_params, 1, NULL,
+                                                 type_create_void(), true, loc);
+
+    // цео ф(цео а) < испиши(а); врати а; >
+    // а is read after the call, so it must survive in a callee-saved register
+    AstNode* parameters[1] = {
+        ast_create_var_decl("а", NULL, type_create_int(), loc)
+    };
+    AstNode* args[1] = { ast_create_identifier("а", loc) };
+    AstNode* call = ast_create_expr_stmt(
+        ast_create_call_expr(ast_create_identifier("испиши", loc), args, 1, loc),
+        loc);
+    AstNode* ret = ast_create_return_stmt(ast_create_identifier("а", loc), loc);
+    AstNode* statements[2] = { call, ret };
+    AstNode* body = ast_create_block(statements, 2, loc);
+    AstNode* function = ast_create_function_decl("ф", parameters, 1, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[2] = { external, function };
+    AstNode* program = ast_create_program(declarations, 2, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+    IrFunction* fn = &ir->functions[0];
+
+    LiveInterval* intervals = NULL;
+    uint32_t interval_count = 0;
+    TEST_ASSERT(x86_64_compute_intervals(fn, &intervals, &interval_count),
+                "Interval computation failed");
+    bool found = false;
+    for (uint32_t i = 0; i < interval_count; i++) {
+        if (intervals[i].vreg != 0) continue;
+        found = true;
+        TEST_ASSERT(intervals[i].crosses_call,
+                    "The parameter is live across the call");
+    }
+    TEST_ASSERT(found, "Parameter interval is missing");
+    free(intervals);
+
+    X86_64Allocation allocation;
+    TEST_ASSERT(x86_64_allocate_registers(fn, &allocation),
+                "Register allocation failed");
+    TEST_ASSERT(allocation.reg_of[0] != X86_64_NO_REGISTER,
+                "The parameter should stay in a register");
+    TEST_ASSERT(is_callee_saved(allocation.reg_of[0]),
+                "Call-crossing values belong in callee-saved registers");
+
+    x86_64_allocation_free(&allocation);
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Call-crossing placement tests passed!\n\n");
+}
+
+void test_spilling() {
+    printf("Testing spilling under pressure...\n");
+    error_init();
+
+    SourceLocation loc = source_location_create(1, 1, "test.ћпп");
+
+    // Twenty variables initialized up front and all summed at the end:
+    // more simultaneously live values than allocatable registers, so
+    // some must spill while every value still gets a home
+    enum { VARIABLE_COUNT = 20 };
+    char names[VARIABLE_COUNT][16];
+    AstNode* statements[VARIABLE_COUNT + 1];
+    for (int i = 0; i < VARIABLE_COUNT; i++) {
+        snprintf(names[i], sizeof(names[i]), "в%d", i);
+        statements[i] = ast_create_var_decl(names[i],
+                                            ast_create_literal_int(i, loc),
+                                            type_create_int(), loc);
+    }
+    AstNode* sum = ast_create_identifier(names[0], loc);
+    for (int i = 1; i < VARIABLE_COUNT; i++) {
+        sum = ast_create_binary_expr(sum, TOKEN_PLUS,
+                                     ast_create_identifier(names[i], loc), loc);
+    }
+    statements[VARIABLE_COUNT] = ast_create_return_stmt(sum, loc);
+
+    AstNode* body = ast_create_block(statements, VARIABLE_COUNT + 1, loc);
+    AstNode* function = ast_create_function_decl("збир", NULL, 0, body,
+                                                 type_create_int(), false, loc);
+    AstNode* declarations[1] = { function };
+    AstNode* program = ast_create_program(declarations, 1, loc);
+
+    IrProgram* ir = ir_generate(program, "test.ћпп");
+    TEST_ASSERT(ir != NULL, "IR generation failed");
+    IrFunction* fn = &ir->functions[0];
+
+    X86_64Allocation allocation;
+    TEST_ASSERT(x86_64_allocate_registers(fn, &allocation),
+                "Register allocation failed");
+    TEST_ASSERT(allocation.spill_count > 0,
+                "Twenty live values must overflow thirteen registers");
+    TEST_ASSERT(allocation.spill_count < fn->value_count,
+                "Most values should still be in registers");
+
+    LiveInterval* intervals = NULL;
+    uint32_t interval_count = 0;
+    TEST_ASSERT(x86_64_compute_intervals(fn, &intervals, &interval_count),
+                "Interval computation failed");
+    for (uint32_t i = 0; i < interval_count; i++) {
+        uint32_t v = intervals[i].vreg;
+        bool in_register = allocation.reg_of[v] != X86_64_NO_REGISTER;
+        bool in_slot = allocation.slot_of[v] >= 0;
+        TEST_ASSERT(in_register != in_slot,
+                    "Every value gets exactly one home");
+        if (in_slot) {
+            TEST_ASSERT((uint32_t)allocation.slot_of[v] < allocation.spill_count,
+                        "Spill slot out of range");
+        }
+    }
+    free(intervals);
+
+    x86_64_allocation_free(&allocation);
+    ir_program_free(ir);
+    ast_free(program);
+    error_cleanup();
+    printf("Spilling tests passed!\n\n");
+}
+
+int main() {
+    printf("=== ћ++ x86-64 Register Allocator Tests ===\n\n");
+
+    test_register_names();
+    test_simple_allocation();
+    test_loop_intervals();
+    test_call_crossing();
+    test_spilling();
+
+    printf("All x86-64 register allocator tests passed!\n");
+    return 0;
+}